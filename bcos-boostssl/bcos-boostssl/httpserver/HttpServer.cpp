@@ -211,6 +211,7 @@ HttpSession::Ptr HttpServer::buildHttpSession(
     session->setHttpStream(_httpStream);
     session->setRequestHandler(m_httpReqHandler);
     session->setWsUpgradeHandler(m_wsUpgradeHandler);
+    session->setMetricsPath(m_metricsPath);
     session->setNodeId(_nodeId);
 
     return session;
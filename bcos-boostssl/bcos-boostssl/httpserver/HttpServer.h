@@ -83,6 +83,10 @@ public:
         m_httpStreamFactory = std::move(_httpStreamFactory);
     }
 
+    // serve the metrics registry on GET of this target, disabled if empty
+    std::string const& metricsPath() const { return m_metricsPath; }
+    void setMetricsPath(std::string _metricsPath) { m_metricsPath = std::move(_metricsPath); }
+
     bool disableSsl() const { return m_disableSsl; }
     void setDisableSsl(bool _disableSsl) { m_disableSsl = _disableSsl; }
 
@@ -98,6 +102,7 @@ private:
     uint16_t m_listenPort;
     bool m_disableSsl = false;
     std::string m_moduleName;
+    std::string m_metricsPath;
 
     HttpReqHandler m_httpReqHandler;
     WsUpgradeHandler m_wsUpgradeHandler;
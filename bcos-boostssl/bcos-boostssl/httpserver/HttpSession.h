@@ -22,6 +22,7 @@
 #include <bcos-boostssl/httpserver/HttpQueue.h>
 #include <bcos-boostssl/httpserver/HttpStream.h>
 #include <bcos-utilities/BoostLog.h>
+#include <bcos-utilities/Metrics.h>
 #include <bcos-utilities/ThreadPool.h>
 #include <boost/asio/dispatch.hpp>
 #include <boost/asio/ssl/stream.hpp>
@@ -186,6 +187,18 @@ public:
         auto startT = utcTime();
         unsigned version = _httpRequest.version();
         auto self = std::weak_ptr<HttpSession>(shared_from_this());
+        if (!m_metricsPath.empty() && _httpRequest.method() == boost::beast::http::verb::get &&
+            _httpRequest.target() == m_metricsPath)
+        {
+            auto content = bcos::metrics::Registry::instance().exportPrometheus();
+            auto resp = buildHttpResp(boost::beast::http::status::ok, version,
+                bcos::bytes(content.begin(), content.end()), "text/plain; version=0.0.4");
+            queue()->enqueue(resp);
+            HTTP_SESSION(DEBUG) << LOG_BADGE("handleRequest") << LOG_DESC("metrics")
+                                << LOG_KV("size", content.size())
+                                << LOG_KV("timecost", (utcTime() - startT));
+            return;
+        }
         if (m_httpReqHandler)
         {
             std::string request = _httpRequest.body();
@@ -232,14 +245,15 @@ public:
      * @brief: build http response object
      * @param status: http response status
      * @param content: http response content
+     * @param contentType: http response content type
      * @return HttpResponsePtr:
      */
-    HttpResponsePtr buildHttpResp(
-        boost::beast::http::status status, unsigned version, bcos::bytes content)
+    HttpResponsePtr buildHttpResp(boost::beast::http::status status, unsigned version,
+        bcos::bytes content, char const* contentType = "application/json")
     {
         auto msg = std::make_shared<HttpResponse>(status, version);
         msg->set(boost::beast::http::field::server, BOOST_BEAST_VERSION_STRING);
-        msg->set(boost::beast::http::field::content_type, "application/json");
+        msg->set(boost::beast::http::field::content_type, contentType);
         msg->keep_alive(true);  // default , keep alive
         msg->body() = std::move(content);
         msg->prepare_payload();
@@ -269,6 +283,9 @@ public:
     std::string moduleName() { return m_moduleName; }
     void setModuleName(std::string _moduleName) { m_moduleName = std::move(_moduleName); }
 
+    // GET of this target returns the prometheus text of the metrics registry, disabled if empty
+    std::string const& metricsPath() const { return m_metricsPath; }
+    void setMetricsPath(std::string _metricsPath) { m_metricsPath = std::move(_metricsPath); }
 
 private:
     HttpStream::Ptr m_httpStream;
@@ -283,6 +300,7 @@ private:
     std::shared_ptr<std::string> m_nodeId;
 
     std::string m_moduleName = "DEFAULT";
+    std::string m_metricsPath;
 };
 
 }  // namespace bcos::boostssl::http
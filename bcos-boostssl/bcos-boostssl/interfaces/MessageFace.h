@@ -51,6 +51,9 @@ public:
     virtual void setPayload(std::shared_ptr<bcos::bytes>) = 0;
 
     virtual bool encode(bcos::bytes& _buffer) = 0;
+    // encode the fields before the payload only, the payload follows them unchanged on the wire
+    // so both can be written with one gather write; false if the message has no such layout
+    virtual bool encodeHeader(bcos::bytes& /*_buffer*/) { return false; }
     virtual int64_t decode(bytesConstRef _buffer) = 0;
 
     virtual bool isRespPacket() const = 0;
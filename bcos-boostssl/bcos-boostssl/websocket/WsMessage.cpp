@@ -20,6 +20,7 @@
 #include <bcos-boostssl/websocket/Common.h>
 #include <bcos-boostssl/websocket/WsMessage.h>
 #include <boost/asio/detail/socket_ops.hpp>
+#include <cstring>
 #include <iterator>
 
 using namespace bcos;
@@ -29,7 +30,32 @@ using namespace bcos::boostssl::ws;
 // version(2) + type(2) + status(2) + seqLength(2) + ext(2) + payload(N)
 constexpr size_t WsMessage::MESSAGE_MIN_LENGTH = 10;
 
+WsMessageFactory::WsMessageFactory()
+{
+    auto uuid = boost::uuids::random_generator()();
+    std::memcpy(&m_seqPrefix, uuid.data, sizeof(m_seqPrefix));
+}
+
+std::string WsMessageFactory::formatSeq(uint64_t prefix, uint64_t seq)
+{
+    constexpr static std::string_view hexChars = "0123456789abcdef";
+    std::string result(32, '0');
+    for (size_t i = 0; i < 16; ++i)
+    {
+        result[15 - i] = hexChars[(prefix >> (i * 4)) & 0xf];
+        result[31 - i] = hexChars[(seq >> (i * 4)) & 0xf];
+    }
+    return result;
+}
+
 bool WsMessage::encode(bytes& _buffer)
+{
+    encodeHeader(_buffer);
+    _buffer.insert(_buffer.end(), m_payload->begin(), m_payload->end());
+    return true;
+}
+
+bool WsMessage::encodeHeader(bytes& _buffer)
 {
     _buffer.clear();
 
@@ -45,9 +71,8 @@ bool WsMessage::encode(bytes& _buffer)
     _buffer.insert(_buffer.end(), (byte*)&seqLength, (byte*)&seqLength + 2);
     _buffer.insert(_buffer.end(), m_seq.begin(), m_seq.end());
     _buffer.insert(_buffer.end(), (byte*)&ext, (byte*)&ext + 2);
-    _buffer.insert(_buffer.end(), m_payload->begin(), m_payload->end());
 
-    m_length = _buffer.size();
+    m_length = _buffer.size() + m_payload->size();
     return true;
 }
 
@@ -26,6 +26,7 @@
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <atomic>
 #include <iterator>
 #include <memory>
 #include <string>
@@ -89,6 +90,7 @@ public:
 
 
     bool encode(bcos::bytes& _buffer) override;
+    bool encodeHeader(bcos::bytes& _buffer) override;
     int64_t decode(bytesConstRef _buffer) override;
 
     bool isRespPacket() const override
@@ -114,19 +116,18 @@ class WsMessageFactory : public boostssl::MessageFaceFactory
 {
 public:
     using Ptr = std::shared_ptr<WsMessageFactory>;
-    WsMessageFactory() = default;
+    WsMessageFactory();
     WsMessageFactory(const WsMessageFactory&) = delete;
     WsMessageFactory& operator=(const WsMessageFactory&) = delete;
     WsMessageFactory(WsMessageFactory&&) = delete;
     WsMessageFactory& operator=(WsMessageFactory&&) = delete;
     ~WsMessageFactory() override = default;
 
-    std::string newSeq() override
-    {
-        std::string seq = boost::uuids::to_string(boost::uuids::random_generator()());
-        seq.erase(std::remove(seq.begin(), seq.end(), '-'), seq.end());
-        return seq;
-    }
+    // 32 hex chars like the uuid used before, a random prefix of the factory followed by a
+    // monotonic 64-bit counter, unique across processes without a random generator per message
+    std::string newSeq() override { return formatSeq(m_seqPrefix, nextSeq()); }
+    uint64_t nextSeq() { return m_nextSeq.fetch_add(1, std::memory_order_relaxed); }
+    static std::string formatSeq(uint64_t prefix, uint64_t seq);
 
     boostssl::MessageFace::Ptr buildMessage() override
     {
@@ -144,6 +145,10 @@ public:
 
         return msg;
     }
+
+private:
+    uint64_t m_seqPrefix;
+    std::atomic_uint64_t m_nextSeq{1};
 };
 
 }  // namespace bcos::boostssl::ws
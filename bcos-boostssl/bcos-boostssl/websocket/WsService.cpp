@@ -70,6 +70,10 @@ void WsService::start()
     {
         m_timerFactory = std::make_shared<timer::TimerFactory>();
     }
+    if (!m_timerWheel)
+    {
+        m_timerWheel = std::make_shared<TimerWheel>("ws_timeout");
+    }
 
     // start ioc thread
     if (m_ioservicePool)
@@ -143,6 +147,12 @@ void WsService::stop()
     m_taskGroup.cancel();
     m_taskGroup.wait();
 
+    if (m_timerWheel)
+    {
+        m_timerWheel->stop();
+        m_timerWheel.reset();
+    }
+
     if (m_statTimer)
     {
         m_statTimer->stop();
@@ -175,19 +185,30 @@ void WsService::reportConnectedNodes()
     {
         auto writeQueueSize = session->writeQueueSize();
         auto callbackQueueSize = session->callbackQueueSize();
+        auto writeStat = session->writeStatistics();
+        auto bytesPerWrite = writeStat.writes > 0 ? writeStat.bytes / writeStat.writes : 0;
+        auto messagesPerBatch = writeStat.batches > 0 ? writeStat.writes / writeStat.batches : 0;
         if (writeQueueSize > 0 || callbackQueueSize > 0)
         {
             WEBSOCKET_SERVICE(INFO) << LOG_BADGE("stat") << LOG_DESC("session write queue status")
                                     << LOG_KV("endpoint", session->endPoint())
                                     << LOG_KV("writeQueueSize", writeQueueSize)
-                                    << LOG_KV("callbackQueueSize", callbackQueueSize);
+                                    << LOG_KV("callbackQueueSize", callbackQueueSize)
+                                    << LOG_KV("writes", writeStat.writes)
+                                    << LOG_KV("bytesPerWrite", bytesPerWrite)
+                                    << LOG_KV("messagesPerBatch", messagesPerBatch)
+                                    << LOG_KV("maxWriteQueueDepth", writeStat.maxQueueDepth);
         }
         else
         {
             WEBSOCKET_SERVICE(DEBUG) << LOG_BADGE("stat") << LOG_DESC("session write queue status")
                                      << LOG_KV("endpoint", session->endPoint())
                                      << LOG_KV("writeQueueSize", writeQueueSize)
-                                     << LOG_KV("callbackQueueSize", callbackQueueSize);
+                                     << LOG_KV("callbackQueueSize", callbackQueueSize)
+                                     << LOG_KV("writes", writeStat.writes)
+                                     << LOG_KV("bytesPerWrite", bytesPerWrite)
+                                     << LOG_KV("messagesPerBatch", messagesPerBatch)
+                                     << LOG_KV("maxWriteQueueDepth", writeStat.maxQueueDepth);
         }
     }
 }
@@ -397,6 +418,7 @@ std::shared_ptr<WsSession> WsService::newSession(
     session->setEndPoint(endPoint);
     session->setMaxWriteMsgSize(m_config->maxMsgSize());
     session->setSendMsgTimeout(m_config->sendMsgTimeout());
+    session->setTimerWheel(m_timerWheel);
     session->setNodeId(_nodeId);
 
     auto self = std::weak_ptr<WsService>(shared_from_this());
@@ -247,6 +247,8 @@ private:
     IOServicePool::Ptr m_ioservicePool;
 
     std::shared_ptr<boost::asio::io_context> m_timerIoc;
+    // response timeouts of all the sessions
+    TimerWheel::Ptr m_timerWheel;
 };
 
 }  // namespace bcos::boostssl::ws
@@ -22,6 +22,7 @@
 #include <bcos-boostssl/websocket/WsSession.h>
 #include <bcos-utilities/BoostLog.h>
 #include <bcos-utilities/Common.h>
+#include <bcos-utilities/Metrics.h>
 #include <bcos-utilities/ThreadPool.h>
 #include <boost/beast/websocket/rfc6455.hpp>
 #include <boost/beast/websocket/stream.hpp>
@@ -40,6 +41,26 @@ using namespace bcos::boostssl;
 using namespace bcos::boostssl::ws;
 using namespace bcos::boostssl::http;
 
+namespace
+{
+// the header buffers kept for reuse by one session
+constexpr size_t MAX_POOLED_HEADERS = 256;
+
+metrics::Histogram& writeBytesHistogram()
+{
+    static auto& histogram = metrics::Registry::instance().histogram(
+        "bcos_ws_write_bytes", "bytes of the websocket frames written");
+    return histogram;
+}
+
+metrics::Histogram& writeQueueDepthHistogram()
+{
+    static auto& histogram = metrics::Registry::instance().histogram(
+        "bcos_ws_write_queue_depth", "messages queued when the websocket writer takes the queue");
+    return histogram;
+}
+}  // namespace
+
 WsSession::WsSession(tbb::task_group& taskGroup, std::string _moduleName)
   : m_taskGroup(taskGroup), m_moduleName(std::move(_moduleName))
 {
@@ -68,32 +89,31 @@ void WsSession::drop(uint32_t _reason)
 
         WEBSOCKET_SESSION(INFO) << LOG_BADGE("drop") << LOG_KV("reason", _reason)
                                 << LOG_KV("endpoint", m_endPoint)
-                                << LOG_KV("cb size", m_callbacks.size()) << LOG_KV("session", this);
-        Guard lockGuard(x_callback);
+                                << LOG_KV("cb size", callbackQueueSize())
+                                << LOG_KV("session", this);
 
-        for (auto& cbEntry : m_callbacks)
+        for (auto& shard : m_callbackShards)
         {
-            auto callback = cbEntry.second;
-            if (callback->timer)
+            std::unordered_map<std::string, CallBack::Ptr> callbacks;
             {
-                callback->timer->cancel();
+                Guard lockGuard(shard.mutex);
+                callbacks.swap(shard.callbacks);
             }
+            for (auto& cbEntry : callbacks)
+            {
+                auto callback = cbEntry.second;
+                timerWheel().cancel(callback->timeout);
 
-            WEBSOCKET_SESSION(TRACE)
-                << LOG_DESC("the session has been disconnected") << LOG_KV("seq", cbEntry.first);
+                WEBSOCKET_SESSION(TRACE) << LOG_DESC("the session has been disconnected")
+                                         << LOG_KV("seq", cbEntry.first);
 
-            m_taskGroup.run([callback = std::move(callback), error]() {
-                callback->respCallBack(error, nullptr, nullptr);
-            });
+                m_taskGroup.run([callback = std::move(callback), error]() {
+                    callback->respCallBack(error, nullptr, nullptr);
+                });
+            }
         }
     }
 
-    // clear callbacks
-    {
-        Guard lockGuard(x_callback);
-        m_callbacks.clear();
-    }
-
     if (m_wsStreamDelegate)
     {
         m_wsStreamDelegate->close();
@@ -193,10 +213,7 @@ void WsSession::onMessage(bcos::boostssl::MessageFace::Ptr _message)
         auto callback = session->getAndRemoveRespCallback(_message->seq(), _message);
         if (callback)
         {
-            if (callback->timer)
-            {
-                callback->timer->cancel();
-            }
+            session->timerWheel().cancel(callback->timeout);
 
             callback->respCallBack(nullptr, _message, session);
         }
@@ -255,23 +272,34 @@ void WsSession::onWritePacket()
     {
         return;
     }
-    Guard l(x_writeQueue);
-    if (m_writing)
+    size_t depth = 0;
     {
-        return;
+        Guard l(x_writeQueue);
+        if (m_writing)
+        {
+            return;
+        }
+        if (m_writeQueue.empty())
+        {
+            m_writing = false;
+            return;
+        }
+        m_writing = true;
+        // the batch written last time has been cleared, swapping keeps the capacity of both
+        m_writingBatch.swap(m_writeQueue);
+        depth = m_writingBatch.size();
     }
-    if (m_writeQueue.empty())
+    m_writeBatches.fetch_add(1, std::memory_order_relaxed);
+    auto maxDepth = m_maxWriteQueueDepth.load(std::memory_order_relaxed);
+    while (depth > maxDepth &&
+           !m_maxWriteQueueDepth.compare_exchange_weak(maxDepth, depth, std::memory_order_relaxed))
     {
-        m_writing = false;
-        return;
     }
-    m_writing = true;
-    auto msg = m_writeQueue.top();
-    m_writeQueue.pop();
-    asyncWrite(msg->buffer);
+    writeQueueDepthHistogram().observe(depth);
+    asyncWrite(0);
 }
 
-void WsSession::asyncWrite(std::shared_ptr<bcos::bytes> _buffer)
+void WsSession::asyncWrite(size_t _index)
 {
     if (!isConnected())
     {
@@ -284,28 +312,43 @@ void WsSession::asyncWrite(std::shared_ptr<bcos::bytes> _buffer)
     try
     {
         auto self = std::weak_ptr<WsSession>(shared_from_this());
-        // Note: add one simple way to monitor message sending latency
+        auto message = m_writingBatch[_index];
         // Note: the lambda[] should not include session directly, this will cause memory leak
-        m_wsStreamDelegate->asyncWrite(
-            *_buffer, [self, _buffer](boost::beast::error_code _ec, std::size_t) {
-                auto session = self.lock();
-                if (!session)
-                {
-                    return;
-                }
-                if (_ec)
-                {
-                    BCOS_LOG(WARNING) << LOG_BADGE(session->moduleName()) << LOG_BADGE("Session")
-                                      << LOG_BADGE("asyncWrite") << LOG_KV("message", _ec.message())
-                                      << LOG_KV("endpoint", session->endPoint());
-                    return session->drop(WsError::WriteError);
-                }
-                if (session->m_writing)
-                {
-                    session->m_writing = false;
-                }
-                session->onWritePacket();
-            });
+        auto handler = [self, message, _index](boost::beast::error_code _ec, std::size_t _size) {
+            auto session = self.lock();
+            if (!session)
+            {
+                return;
+            }
+            if (_ec)
+            {
+                BCOS_LOG(WARNING) << LOG_BADGE(session->moduleName()) << LOG_BADGE("Session")
+                                  << LOG_BADGE("asyncWrite") << LOG_KV("message", _ec.message())
+                                  << LOG_KV("endpoint", session->endPoint());
+                return session->drop(WsError::WriteError);
+            }
+            session->m_writeCount.fetch_add(1, std::memory_order_relaxed);
+            session->m_writeBytes.fetch_add(_size, std::memory_order_relaxed);
+            writeBytesHistogram().observe(_size);
+            if (_index + 1 < session->m_writingBatch.size())
+            {
+                return session->asyncWrite(_index + 1);
+            }
+            session->releaseHeaderBuffers(session->m_writingBatch);
+            session->m_writing = false;
+            session->onWritePacket();
+        };
+        if (message->header.empty())
+        {
+            m_wsStreamDelegate->asyncWrite(*message->buffer, std::move(handler));
+        }
+        else
+        {
+            // gather the header and the payload into one frame, the payload is not copied
+            m_wsStreamDelegate->asyncWrite(WsConstBuffers{boost::asio::buffer(message->header),
+                                               boost::asio::buffer(*message->buffer)},
+                std::move(handler));
+        }
     }
     catch (const std::exception& _e)
     {
@@ -317,18 +360,51 @@ void WsSession::asyncWrite(std::shared_ptr<bcos::bytes> _buffer)
     }
 }
 
-void WsSession::send(std::shared_ptr<bytes> buffer)
+void WsSession::send(std::shared_ptr<bytes> _buffer)
+{
+    send(bytes(), std::move(_buffer));
+}
+
+void WsSession::send(bytes _header, std::shared_ptr<bytes> _payload)
 {
     auto msg = std::make_shared<Message>();
-    msg->buffer = std::move(buffer);
+    msg->header = std::move(_header);
+    msg->buffer = std::move(_payload);
     {
         Guard lock(x_writeQueue);
         // data to be sent is always enqueue first
-        m_writeQueue.push(msg);
+        m_writeQueue.push_back(std::move(msg));
     }
     onWritePacket();
 }
 
+bytes WsSession::acquireHeaderBuffer()
+{
+    Guard lock(x_headerPool);
+    if (m_headerPool.empty())
+    {
+        return {};
+    }
+    auto buffer = std::move(m_headerPool.back());
+    m_headerPool.pop_back();
+    return buffer;
+}
+
+void WsSession::releaseHeaderBuffers(std::vector<std::shared_ptr<Message>>& _messages)
+{
+    {
+        Guard lock(x_headerPool);
+        for (auto& message : _messages)
+        {
+            if (message->header.capacity() > 0 && m_headerPool.size() < MAX_POOLED_HEADERS)
+            {
+                m_headerPool.push_back(std::move(message->header));
+            }
+        }
+    }
+    _messages.clear();
+}
+
 /**
  * @brief: send message with callback
  * @param _msg: message to be send
@@ -374,8 +450,17 @@ void WsSession::asyncSendMessage(
         return;
     }
 
-    auto buffer = std::make_shared<bytes>();
-    auto r = _msg->encode(*buffer);
+    // encode the header only into a reused buffer and send the payload as is, the whole message
+    // is encoded if it can not be split
+    auto header = acquireHeaderBuffer();
+    auto buffer = _msg->payload();
+    auto r = _msg->encodeHeader(header);
+    if (!r)
+    {
+        header.clear();
+        buffer = std::make_shared<bytes>();
+        r = _msg->encode(*buffer);
+    }
     if (!r)
     {
         if (_respFunc)
@@ -400,19 +485,15 @@ void WsSession::asyncSendMessage(
         auto timeout = _options.timeout > 0 ? _options.timeout : m_sendMsgTimeout;
         if (timeout > 0)
         {
-            // create new timer to handle timeout
-            auto timer = std::make_shared<boost::asio::deadline_timer>(
-                *m_ioc, boost::posix_time::milliseconds(timeout));
-
-            callback->timer = timer;
-            auto self = weak_from_this();
-            timer->async_wait([self, seq](const boost::system::error_code& e) {
-                auto session = self.lock();
-                if (session)
-                {
-                    session->onRespTimeout(e, seq);
-                }
-            });
+            // cancelled by the response, in most cases long before it expires
+            callback->timeout = timerWheel().add(
+                std::chrono::milliseconds(timeout), [self = weak_from_this(), seq]() {
+                    auto session = self.lock();
+                    if (session)
+                    {
+                        session->onRespTimeout(seq);
+                    }
+                });
         }
 
         addRespCallback(seq, callback);
@@ -420,14 +501,18 @@ void WsSession::asyncSendMessage(
 
     {
         boost::asio::post(m_wsStreamDelegate->tcpStream().get_executor(),
-            boost::beast::bind_front_handler(&WsSession::send, shared_from_this(), buffer));
+            [self = shared_from_this(), header = std::move(header),
+                buffer = std::move(buffer)]() mutable {
+                self->send(std::move(header), std::move(buffer));
+            });
     }
 }
 
 void WsSession::addRespCallback(const std::string& _seq, CallBack::Ptr _callback)
 {
-    Guard lockGuard(x_callback);
-    m_callbacks[_seq] = std::move(_callback);
+    auto& shard = callbackShard(_seq);
+    Guard lockGuard(shard.mutex);
+    shard.callbacks[_seq] = std::move(_callback);
 }
 
 WsSession::CallBack::Ptr WsSession::getAndRemoveRespCallback(
@@ -442,26 +527,22 @@ WsSession::CallBack::Ptr WsSession::getAndRemoveRespCallback(
 
     CallBack::Ptr callback = nullptr;
     {
-        Guard lockGuard(x_callback);
+        auto& shard = callbackShard(_seq);
+        Guard lockGuard(shard.mutex);
 
-        auto it = m_callbacks.find(_seq);
-        if (it != m_callbacks.end())
+        auto it = shard.callbacks.find(_seq);
+        if (it != shard.callbacks.end())
         {
-            callback = it->second;
-            m_callbacks.erase(it);
+            callback = std::move(it->second);
+            shard.callbacks.erase(it);
         }
     }
 
     return callback;
 }
 
-void WsSession::onRespTimeout(const boost::system::error_code& _error, const std::string& _seq)
+void WsSession::onRespTimeout(const std::string& _seq)
 {
-    if (_error)
-    {
-        return;
-    }
-
     auto callback = getAndRemoveRespCallback(_seq);
     if (!callback)
     {
@@ -475,3 +556,13 @@ void WsSession::onRespTimeout(const boost::system::error_code& _error, const std
         callback->respCallBack(error, nullptr, nullptr);
     });
 }
+
+TimerWheel& WsSession::timerWheel()
+{
+    if (m_timerWheel)
+    {
+        return *m_timerWheel;
+    }
+    static TimerWheel defaultTimerWheel("ws_timeout");
+    return defaultTimerWheel;
+}
@@ -27,18 +27,21 @@
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/ThreadPool.h>
 #include <bcos-utilities/Timer.h>
+#include <bcos-utilities/TimerWheel.h>
 #include <oneapi/tbb/task_group.h>
 #include <boost/asio/deadline_timer.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/websocket.hpp>
 #include <boost/thread/thread.hpp>
+#include <array>
 #include <atomic>
 #include <mutex>
 #include <queue>
 #include <shared_mutex>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace bcos::boostssl::ws
 {
@@ -114,6 +117,10 @@ public:
     std::shared_ptr<boost::asio::io_context> ioc() const { return m_ioc; }
     void setIoc(std::shared_ptr<boost::asio::io_context> _ioc) { m_ioc = std::move(_ioc); }
 
+    // the wheel of the response timeouts, a process wide one is used if not set
+    TimerWheel& timerWheel();
+    void setTimerWheel(TimerWheel::Ptr _timerWheel) { m_timerWheel = std::move(_timerWheel); }
+
     void setVersion(uint16_t _version) { m_version.store(_version); }
     uint16_t version() const { return m_version.load(); }
 
@@ -138,10 +145,32 @@ public:
         return m_writeQueue.size();
     }
 
+    struct WriteStatistics
+    {
+        // websocket frames written
+        uint64_t writes = 0;
+        uint64_t bytes = 0;
+        // times the write queue was taken as a whole
+        uint64_t batches = 0;
+        uint64_t maxQueueDepth = 0;
+    };
+    WriteStatistics writeStatistics() const
+    {
+        return WriteStatistics{.writes = m_writeCount.load(std::memory_order_relaxed),
+            .bytes = m_writeBytes.load(std::memory_order_relaxed),
+            .batches = m_writeBatches.load(std::memory_order_relaxed),
+            .maxQueueDepth = m_maxWriteQueueDepth.load(std::memory_order_relaxed)};
+    }
+
     std::size_t callbackQueueSize()
     {
-        bcos::Guard lockGuard(x_callback);
-        return m_callbacks.size();
+        std::size_t size = 0;
+        for (auto& shard : m_callbackShards)
+        {
+            bcos::Guard lockGuard(shard.mutex);
+            size += shard.callbacks.size();
+        }
+        return size;
     }
 
     std::string nodeId() { return m_nodeId; }
@@ -161,19 +190,23 @@ public:
     {
         using Ptr = std::shared_ptr<CallBack>;
         RespCallBack respCallBack;
-        std::shared_ptr<boost::asio::deadline_timer> timer;
+        TimerWheel::Handle timeout;
     };
     virtual void addRespCallback(const std::string& _seq, CallBack::Ptr _callback);
     CallBack::Ptr getAndRemoveRespCallback(
         const std::string& _seq, std::shared_ptr<MessageFace> _message = nullptr);
-    virtual void onRespTimeout(const boost::system::error_code& _error, const std::string& _seq);
+    virtual void onRespTimeout(const std::string& _seq);
 
     virtual void onWsAccept(boost::beast::error_code _ec);
 
     virtual void asyncRead();
-    virtual void asyncWrite(std::shared_ptr<bcos::bytes> _buffer);
+    // write the message _index of the taken batch, the next one is written from its handler
+    virtual void asyncWrite(size_t _index);
 
+    // the whole encoded message
     virtual void send(std::shared_ptr<bcos::bytes> _buffer);
+    // the payload is written after the encoded header as is
+    virtual void send(bcos::bytes _header, std::shared_ptr<bcos::bytes> _payload);
 
     // async read
     virtual void onReadPacket(boost::beast::flat_buffer& _buffer);
@@ -181,6 +214,8 @@ public:
 
     struct Message : public bcos::ObjectCounter<Message>
     {
+        // empty if buffer is the whole encoded message
+        bcos::bytes header;
         std::shared_ptr<bcos::bytes> buffer;
     };
 
@@ -207,9 +242,20 @@ protected:
 
     //
     WsStreamDelegate::Ptr m_wsStreamDelegate;
-    // callbacks
-    mutable bcos::Mutex x_callback;
-    std::unordered_map<std::string, CallBack::Ptr> m_callbacks;
+    // callbacks, sharded by the hash of the seq so the sdk requests in flight do not contend on
+    // one lock
+    struct CallbackShard
+    {
+        mutable bcos::Mutex mutex;
+        std::unordered_map<std::string, CallBack::Ptr> callbacks;
+    };
+    constexpr static size_t CALLBACK_SHARD_COUNT = 16;
+    CallbackShard& callbackShard(std::string const& _seq)
+    {
+        return m_callbackShards[std::hash<std::string>{}(_seq) % CALLBACK_SHARD_COUNT];
+    }
+    std::array<CallbackShard, CALLBACK_SHARD_COUNT> m_callbackShards;
+    TimerWheel::Ptr m_timerWheel;
 
     // callback handler
     WsConnectHandler m_connectHandler;
@@ -223,10 +269,24 @@ protected:
 
     // ioc
     std::shared_ptr<boost::asio::io_context> m_ioc;
-    // send message queue
+    // send message queue, taken as a whole by the writer so the queued messages are written back
+    // to back without locking it again
     mutable bcos::Mutex x_writeQueue;
-    std::priority_queue<std::shared_ptr<Message>> m_writeQueue;
+    std::vector<std::shared_ptr<Message>> m_writeQueue;
     std::atomic_bool m_writing = {false};
+    // only touched by the writer
+    std::vector<std::shared_ptr<Message>> m_writingBatch;
+
+    // the header buffers of the written messages, reused for encoding
+    bcos::bytes acquireHeaderBuffer();
+    void releaseHeaderBuffers(std::vector<std::shared_ptr<Message>>& _messages);
+    mutable bcos::Mutex x_headerPool;
+    std::vector<bcos::bytes> m_headerPool;
+
+    std::atomic_uint64_t m_writeCount = 0;
+    std::atomic_uint64_t m_writeBytes = 0;
+    std::atomic_uint64_t m_writeBatches = 0;
+    std::atomic_uint64_t m_maxWriteQueueDepth = 0;
 };
 
 class WsSessionFactory
@@ -38,6 +38,7 @@
 #include <boost/system/detail/error_code.hpp>
 #include <boost/thread/thread.hpp>
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -45,6 +46,8 @@
 namespace bcos::boostssl::ws
 {
 using WsStreamRWHandler = std::function<void(boost::system::error_code, std::size_t)>;
+// the encoded header and the payload of one message
+using WsConstBuffers = std::array<boost::asio::const_buffer, 2>;
 using WsStreamHandshakeHandler = std::function<void(boost::system::error_code)>;
 
 template <typename STREAM>
@@ -141,6 +144,13 @@ public:
         m_stream->async_write(boost::asio::buffer(_buffer), _handler);
     }
 
+    // one websocket frame gathered from the buffers, which must live until the handler runs
+    void asyncWrite(const WsConstBuffers& _buffers, WsStreamRWHandler _handler)
+    {
+        m_stream->binary(true);
+        m_stream->async_write(_buffers, _handler);
+    }
+
     void asyncRead(boost::beast::flat_buffer& _buffer, WsStreamRWHandler _handler)
     {
         m_stream->async_read(_buffer, _handler);
@@ -236,6 +246,12 @@ public:
                          m_rawStream->asyncWrite(_buffer, _handler);
     }
 
+    void asyncWrite(const WsConstBuffers& _buffers, WsStreamRWHandler _handler)
+    {
+        return m_isSsl ? m_sslStream->asyncWrite(_buffers, _handler) :
+                         m_rawStream->asyncWrite(_buffers, _handler);
+    }
+
     void asyncRead(boost::beast::flat_buffer& _buffer, WsStreamRWHandler _handler)
     {
         return m_isSsl ? m_sslStream->asyncRead(_buffer, _handler) :
@@ -51,6 +51,41 @@ BOOST_AUTO_TEST_CASE(test_WsMessage)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_newSeq)
+{
+    BOOST_CHECK_EQUAL(WsMessageFactory::formatSeq(0x0123456789abcdef, 0x10),
+        "0123456789abcdef0000000000000010");
+
+    auto factory = std::make_shared<WsMessageFactory>();
+    auto seq1 = factory->newSeq();
+    auto seq2 = factory->newSeq();
+    // the length of the uuid seq used by the sdk
+    BOOST_CHECK_EQUAL(seq1.size(), 32);
+    BOOST_CHECK_NE(seq1, seq2);
+    BOOST_CHECK_EQUAL(seq1.substr(0, 16), seq2.substr(0, 16));
+    BOOST_CHECK_LT(seq1, seq2);
+    // another factory has another prefix
+    auto otherSeq = std::make_shared<WsMessageFactory>()->newSeq();
+    BOOST_CHECK_NE(otherSeq.substr(0, 16), seq1.substr(0, 16));
+}
+
+BOOST_AUTO_TEST_CASE(test_encodeHeader)
+{
+    std::string data = "HelloWorld.";
+    auto factory = std::make_shared<WsMessageFactory>();
+    auto msg = factory->buildMessage(1, std::make_shared<bytes>(data.begin(), data.end()));
+
+    bytes encoded;
+    BOOST_CHECK(msg->encode(encoded));
+    // a reused buffer is cleared first
+    bytes header(100, 0xff);
+    BOOST_CHECK(msg->encodeHeader(header));
+    BOOST_CHECK_EQUAL(header.size(), WsMessage::MESSAGE_MIN_LENGTH + msg->seq().size());
+    BOOST_CHECK_EQUAL(msg->length(), encoded.size());
+
+    header.insert(header.end(), msg->payload()->begin(), msg->payload()->end());
+    BOOST_CHECK(header == encoded);
+}
 
 BOOST_AUTO_TEST_CASE(test_buildMessage)
 {
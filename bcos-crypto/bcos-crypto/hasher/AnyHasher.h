@@ -19,6 +19,7 @@ public:
 
     virtual void update(std::span<std::byte const> input) = 0;
     virtual void final(std::span<std::byte> output) = 0;
+    virtual void batchHash(BatchInputs inputs, std::span<std::byte> outputs) = 0;
     virtual std::unique_ptr<AnyHasherInterface> clone() const = 0;
     virtual size_t hashSize() const = 0;
 };
@@ -38,6 +39,10 @@ public:
     ~AnyHasherImpl() noexcept override = default;
     void update(std::span<std::byte const> input) override { m_hasher.update(input); }
     void final(std::span<std::byte> output) override { m_hasher.final(output); }
+    void batchHash(BatchInputs inputs, std::span<std::byte> outputs) override
+    {
+        bcos::crypto::hasher::batchHash(m_hasher, inputs, outputs);
+    }
     std::unique_ptr<AnyHasherInterface> clone() const override
     {
         return std::make_unique<AnyHasherImpl<Hasher>>(m_hasher.clone());
@@ -80,10 +85,15 @@ public:
     }
 
     void final(std::span<std::byte> output) { m_anyHasher->final(output); }
+    void batchHash(BatchInputs inputs, std::span<std::byte> outputs)
+    {
+        m_anyHasher->batchHash(inputs, outputs);
+    }
 
     AnyHasher clone() const { return {m_anyHasher->clone()}; }
     size_t hashSize() const { return m_anyHasher->hashSize(); }
 };
 
 static_assert(Hasher<AnyHasher>, "Not a valid Hasher!");
+static_assert(BatchHasher<AnyHasher>, "Not a valid BatchHasher!");
 }  // namespace bcos::crypto::hasher
\ No newline at end of file
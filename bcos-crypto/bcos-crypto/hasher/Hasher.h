@@ -1,6 +1,7 @@
 #pragma once
 #include <bcos-utilities/Ranges.h>
 #include <concepts>
+#include <cstddef>
 #include <span>
 #include <type_traits>
 
@@ -17,4 +18,31 @@ concept Hasher = requires(HasherType hasher, std::span<std::byte> out) {
     } -> std::same_as<HasherType>;
 };
 
+// independent messages hashed together by batchHash
+using BatchInputs = std::span<std::span<std::byte const> const>;
+
+// a hasher able to hash several messages at once, e.g. in simd lanes
+template <class HasherType>
+concept BatchHasher =
+    Hasher<HasherType> && requires(HasherType hasher, BatchInputs inputs,
+                              std::span<std::byte> outputs) { hasher.batchHash(inputs, outputs); };
+
+// hash every input on its own into outputs, the digests are hasher.hashSize() bytes apart
+void batchHash(Hasher auto& hasher, BatchInputs inputs, std::span<std::byte> outputs)
+{
+    if constexpr (BatchHasher<std::remove_cvref_t<decltype(hasher)>>)
+    {
+        hasher.batchHash(inputs, outputs);
+    }
+    else
+    {
+        auto hashSize = hasher.hashSize();
+        for (size_t i = 0; i < inputs.size(); ++i)
+        {
+            hasher.update(inputs[i]);
+            hasher.final(outputs.subspan(i * hashSize, hashSize));
+        }
+    }
+}
+
 }  // namespace bcos::crypto::hasher
\ No newline at end of file
@@ -0,0 +1,216 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief keccak-f[1600] over 4 independent messages at once with avx2
+ * @file KeccakLanes.cpp
+ */
+#include "KeccakLanes.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BCOS_KECCAK_LANES 1
+#include <immintrin.h>
+#endif
+
+using namespace bcos::crypto::hasher::keccak;
+
+#ifdef BCOS_KECCAK_LANES
+namespace
+{
+// 1088 bits rate of the 256 bits capacity
+constexpr size_t RATE = 136;
+constexpr size_t RATE_WORDS = RATE / sizeof(uint64_t);
+
+constexpr std::array<uint64_t, 24> ROUND_CONSTANTS{0x0000000000000001ULL, 0x0000000000008082ULL,
+    0x800000000000808aULL, 0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL, 0x0000000000000088ULL,
+    0x0000000080008009ULL, 0x000000008000000aULL, 0x000000008000808bULL, 0x800000000000008bULL,
+    0x8000000000008089ULL, 0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL, 0x8000000000008080ULL,
+    0x0000000080000001ULL, 0x8000000080008008ULL};
+
+// rotation offset of the lane at x + 5 * y
+constexpr std::array<int, 25> ROTATIONS{0, 1, 62, 28, 27, 36, 44, 6, 55, 20, 3, 10, 43, 25, 39, 41,
+    45, 15, 21, 8, 18, 2, 61, 56, 14};
+
+__attribute__((target("avx2"))) inline __m256i rotateLeft(__m256i value, int offset)
+{
+    return _mm256_or_si256(_mm256_slli_epi64(value, offset), _mm256_srli_epi64(value, 64 - offset));
+}
+
+__attribute__((target("avx2"))) void permute(__m256i (&state)[25])
+{
+    __m256i temp[25];
+    __m256i parity[5];
+    // the steps are unrolled so the indexes are constants and the state stays in registers
+    for (auto roundConstant : ROUND_CONSTANTS)
+    {
+        // theta
+#pragma GCC unroll 5
+        for (size_t x = 0; x < 5; ++x)
+        {
+            parity[x] = _mm256_xor_si256(
+                _mm256_xor_si256(_mm256_xor_si256(state[x], state[x + 5]),
+                    _mm256_xor_si256(state[x + 10], state[x + 15])),
+                state[x + 20]);
+        }
+#pragma GCC unroll 5
+        for (size_t x = 0; x < 5; ++x)
+        {
+            auto delta =
+                _mm256_xor_si256(parity[(x + 4) % 5], rotateLeft(parity[(x + 1) % 5], 1));
+#pragma GCC unroll 5
+            for (size_t y = 0; y < 25; y += 5)
+            {
+                state[x + y] = _mm256_xor_si256(state[x + y], delta);
+            }
+        }
+        // rho and pi
+#pragma GCC unroll 5
+        for (size_t x = 0; x < 5; ++x)
+        {
+#pragma GCC unroll 5
+            for (size_t y = 0; y < 5; ++y)
+            {
+                temp[y + 5 * ((2 * x + 3 * y) % 5)] =
+                    ROTATIONS[x + 5 * y] == 0 ? state[x + 5 * y] :
+                                                rotateLeft(state[x + 5 * y], ROTATIONS[x + 5 * y]);
+            }
+        }
+        // chi
+#pragma GCC unroll 5
+        for (size_t y = 0; y < 25; y += 5)
+        {
+#pragma GCC unroll 5
+            for (size_t x = 0; x < 5; ++x)
+            {
+                state[x + y] = _mm256_xor_si256(temp[x + y],
+                    _mm256_andnot_si256(temp[(x + 1) % 5 + y], temp[(x + 2) % 5 + y]));
+            }
+        }
+        // iota
+        state[0] = _mm256_xor_si256(state[0], _mm256_set1_epi64x((int64_t)roundConstant));
+    }
+}
+
+__attribute__((target("avx2"))) void absorbBlock(
+    __m256i (&state)[25], std::array<std::byte const*, LANES> const& blocks)
+{
+    for (size_t word = 0; word < RATE_WORDS; ++word)
+    {
+        std::array<int64_t, LANES> values;
+        for (size_t lane = 0; lane < LANES; ++lane)
+        {
+            std::memcpy(&values[lane], blocks[lane] + word * sizeof(uint64_t), sizeof(uint64_t));
+        }
+        state[word] = _mm256_xor_si256(
+            state[word], _mm256_set_epi64x(values[3], values[2], values[1], values[0]));
+    }
+}
+
+__attribute__((target("avx2"))) void hashLanes(
+    std::array<std::span<std::byte const>, LANES> const& inputs, size_t length,
+    std::array<std::byte*, LANES> const& outputs, std::byte pad)
+{
+    __m256i state[25];
+    std::fill(std::begin(state), std::end(state), _mm256_setzero_si256());
+
+    std::array<std::byte const*, LANES> blocks;
+    size_t offset = 0;
+    for (; offset + RATE <= length; offset += RATE)
+    {
+        for (size_t lane = 0; lane < LANES; ++lane)
+        {
+            blocks[lane] = inputs[lane].data() + offset;
+        }
+        absorbBlock(state, blocks);
+        permute(state);
+    }
+
+    // the tail with the padding, pad and 0x80 share the byte when the tail is RATE - 1 long
+    std::array<std::array<std::byte, RATE>, LANES> lastBlocks{};
+    for (size_t lane = 0; lane < LANES; ++lane)
+    {
+        std::memcpy(lastBlocks[lane].data(), inputs[lane].data() + offset, length - offset);
+        lastBlocks[lane][length - offset] ^= pad;
+        lastBlocks[lane][RATE - 1] ^= std::byte{0x80};
+        blocks[lane] = lastBlocks[lane].data();
+    }
+    absorbBlock(state, blocks);
+    permute(state);
+
+    for (size_t word = 0; word < DIGEST_SIZE / sizeof(uint64_t); ++word)
+    {
+        alignas(32) std::array<uint64_t, LANES> values;
+        _mm256_store_si256((__m256i*)values.data(), state[word]);
+        for (size_t lane = 0; lane < LANES; ++lane)
+        {
+            std::memcpy(outputs[lane] + word * sizeof(uint64_t), &values[lane], sizeof(uint64_t));
+        }
+    }
+}
+}  // namespace
+#endif
+
+bool bcos::crypto::hasher::keccak::lanesSupported()
+{
+#ifdef BCOS_KECCAK_LANES
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+std::vector<size_t> bcos::crypto::hasher::keccak::hashEqualLengthGroups(
+    std::span<std::span<std::byte const> const> inputs, std::span<std::byte> outputs,
+    [[maybe_unused]] std::byte pad)
+{
+    std::vector<size_t> indexes(inputs.size());
+    std::iota(indexes.begin(), indexes.end(), 0);
+#ifdef BCOS_KECCAK_LANES
+    std::stable_sort(indexes.begin(), indexes.end(),
+        [&inputs](size_t lhs, size_t rhs) { return inputs[lhs].size() < inputs[rhs].size(); });
+
+    std::vector<size_t> rest;
+    auto it = indexes.begin();
+    while (it != indexes.end())
+    {
+        auto length = inputs[*it].size();
+        auto runEnd = std::find_if(
+            it, indexes.end(), [&](size_t index) { return inputs[index].size() != length; });
+        for (; runEnd - it >= (ptrdiff_t)LANES; it += LANES)
+        {
+            std::array<std::span<std::byte const>, LANES> group;
+            std::array<std::byte*, LANES> groupOutputs;
+            for (size_t lane = 0; lane < LANES; ++lane)
+            {
+                group[lane] = inputs[it[lane]];
+                groupOutputs[lane] = outputs.data() + it[lane] * DIGEST_SIZE;
+            }
+            hashLanes(group, length, groupOutputs, pad);
+        }
+        rest.insert(rest.end(), it, runEnd);
+        it = runEnd;
+    }
+    return rest;
+#else
+    return indexes;
+#endif
+}
@@ -0,0 +1,43 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief keccak-f[1600] over 4 independent messages at once with avx2
+ * @file KeccakLanes.h
+ */
+#pragma once
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace bcos::crypto::hasher::keccak
+{
+constexpr static size_t LANES = 4;
+constexpr static size_t DIGEST_SIZE = 32;
+// the keccak256 padding, sha3-256 pads with 0x06
+constexpr static std::byte KECCAK256_PAD{0x01};
+constexpr static std::byte SHA3_256_PAD{0x06};
+
+// true if the cpu runs the lanes, checked once at runtime so the default build stays generic
+bool lanesSupported();
+
+/**
+ * hash the inputs into outputs[i * DIGEST_SIZE], the inputs of the same length are hashed LANES at
+ * a time; only call it when lanesSupported()
+ *
+ * @return the indexes of the inputs left to the scalar hasher
+ */
+std::vector<size_t> hashEqualLengthGroups(std::span<std::span<std::byte const> const> inputs,
+    std::span<std::byte> outputs, std::byte pad);
+}  // namespace bcos::crypto::hasher::keccak
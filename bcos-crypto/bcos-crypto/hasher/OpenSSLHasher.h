@@ -2,6 +2,7 @@
 
 #include "../TrivialObject.h"
 #include "Hasher.h"
+#include "KeccakLanes.h"
 #include <openssl/evp.h>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/throw_exception.hpp>
@@ -135,6 +136,30 @@ public:
         }
     }
 
+    // the keccak family runs equal length inputs in simd lanes, the rest reuse this context
+    void batchHash(BatchInputs inputs, std::span<std::byte> outputs)
+    {
+        if constexpr (hasherType == Keccak256 || hasherType == SHA3_256)
+        {
+            if (keccak::lanesSupported())
+            {
+                auto rest = keccak::hashEqualLengthGroups(inputs, outputs,
+                    hasherType == Keccak256 ? keccak::KECCAK256_PAD : keccak::SHA3_256_PAD);
+                for (auto index : rest)
+                {
+                    update(inputs[index]);
+                    final(outputs.subspan(index * HASH_SIZE, HASH_SIZE));
+                }
+                return;
+            }
+        }
+        for (size_t i = 0; i < inputs.size(); ++i)
+        {
+            update(inputs[i]);
+            final(outputs.subspan(i * HASH_SIZE, HASH_SIZE));
+        }
+    }
+
     constexpr const EVP_MD* chooseMD()
     {
         if constexpr (hasherType == SM3)
@@ -179,5 +204,6 @@ static_assert(Hasher<OpenSSL_SHA3_256_Hasher>, "Assert OpenSSLHasher type");
 static_assert(Hasher<OpenSSL_SHA2_256_Hasher>, "Assert OpenSSLHasher type");
 static_assert(Hasher<OpenSSL_SM3_Hasher>, "Assert OpenSSLHasher type");
 static_assert(Hasher<OpenSSL_Keccak256_Hasher>, "Assert OpenSSLHasher type");
+static_assert(BatchHasher<OpenSSL_Keccak256_Hasher>, "Assert OpenSSLHasher type");
 
 }  // namespace bcos::crypto::hasher::openssl
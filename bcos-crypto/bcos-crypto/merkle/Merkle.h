@@ -249,14 +249,41 @@ private:
         tbb::parallel_for(tbb::blocked_range<size_t>(0, outputSize),
             [this, &input, &output](const tbb::blocked_range<size_t>& range) {
                 auto hasher = m_hasher.clone();
+                auto hashSize = hasher.hashSize();
 
+                // Gather the children of every node in range, then hash the nodes in one batch
+                bcos::bytes buffer;
+                std::vector<size_t> offsets;
+                offsets.reserve(range.size() + 1);
+                offsets.push_back(0);
                 for (auto i = range.begin(); i < range.end(); ++i)
                 {
                     for (auto j = i * width; j < (i + 1) * width && j < RANGES::size(input); ++j)
                     {
-                        hasher.update(input[j]);
+                        auto const& child = input[j];
+                        auto begin = (bcos::byte const*)RANGES::data(child);
+                        buffer.insert(buffer.end(), begin, begin + RANGES::size(child));
                     }
-                    hasher.final(output[i]);
+                    offsets.push_back(buffer.size());
+                }
+
+                std::vector<std::span<std::byte const>> nodes;
+                nodes.reserve(range.size());
+                for (size_t k = 0; k < range.size(); ++k)
+                {
+                    nodes.emplace_back(
+                        (std::byte const*)buffer.data() + offsets[k], offsets[k + 1] - offsets[k]);
+                }
+                bcos::bytes hashes(range.size() * hashSize);
+                bcos::crypto::hasher::batchHash(
+                    hasher, nodes, std::span<std::byte>((std::byte*)hashes.data(), hashes.size()));
+
+                for (auto i = range.begin(); i < range.end(); ++i)
+                {
+                    auto& node = output[i];
+                    bcos::concepts::resizeTo(node, hashSize);
+                    std::copy_n(hashes.data() + (i - range.begin()) * hashSize, hashSize,
+                        (bcos::byte*)RANGES::data(node));
                 }
             });
     }
@@ -17,6 +17,7 @@
  * @file HasherTest.h
  * @date 2022.04.19
  */
+#include <bcos-crypto/hasher/AnyHasher.h>
 #include <bcos-crypto/hasher/OpenSSLHasher.h>
 #include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
 #include <bcos-utilities/testutils/TestPromptFixture.h>
@@ -115,6 +116,59 @@ BOOST_AUTO_TEST_CASE(dynamicRange)
     auto b = bcos::crypto::trivial::DynamicRange<std::vector<char>>;
 }
 
+template <class HasherType>
+void checkBatchHash(HasherType batchHasher)
+{
+    // runs of equal lengths for the lanes, with the padding edges around the 136 bytes rate
+    std::vector<size_t> lengths{0, 0, 0, 0, 1, 137, 32, 32, 32, 32, 32, 135, 135, 135, 135, 136,
+        136, 136, 136, 137, 137, 137, 64, 64, 64, 64, 64, 64, 64, 64, 272, 512, 512, 512, 512};
+    std::vector<bcos::bytes> messages;
+    for (auto length : lengths)
+    {
+        auto& message = messages.emplace_back(length);
+        for (size_t i = 0; i < length; ++i)
+        {
+            message[i] = (bcos::byte)(i * 7 + messages.size());
+        }
+    }
+    std::vector<std::span<std::byte const>> inputs;
+    for (auto& message : messages)
+    {
+        inputs.emplace_back((std::byte const*)message.data(), message.size());
+    }
+
+    std::vector<std::byte> outputs(inputs.size() * 32);
+    batchHash(batchHasher, inputs, outputs);
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        auto hasher = batchHasher.clone();
+        hasher.update(inputs[i]);
+        HashType expected;
+        hasher.final(expected);
+
+        HashType actual;
+        std::copy_n(outputs.begin() + i * 32, 32, actual.begin());
+        BOOST_CHECK_EQUAL(actual, expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(batchHash)
+{
+    checkBatchHash(openssl::OpenSSL_Keccak256_Hasher{});
+    checkBatchHash(openssl::OpenSSL_SHA3_256_Hasher{});
+    checkBatchHash(openssl::OpenSSL_SHA2_256_Hasher{});
+    checkBatchHash(openssl::OpenSSL_SM3_Hasher{});
+    checkBatchHash(AnyHasher{openssl::OpenSSL_Keccak256_Hasher{}});
+
+    // keccak256 of the empty input
+    std::vector<std::span<std::byte const>> inputs(4);
+    std::vector<std::byte> outputs(4 * 32);
+    openssl::OpenSSL_Keccak256_Hasher hasher;
+    hasher.batchHash(inputs, outputs);
+    auto hex = bcos::toHex(std::span((bcos::byte const*)outputs.data() + 3 * 32, 32));
+    BOOST_CHECK_EQUAL(hex, "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace bcos::test
 
@@ -137,6 +137,26 @@ public:
     storage::EntryCachePtr getCodeHashCache() const { return m_codeHashCache; }
     auto backendStorage() const { return m_backendStorage; }
 
+    // the tables known to have no secondary index in this block, the table operations read the
+    // index meta of a table once per block; createIndex forgets its table
+    bool isTableWithoutIndex(std::string_view _tableName) const
+    {
+        bcos::ReadGuard l(x_tablesWithoutIndex);
+        return m_tablesWithoutIndex.contains(_tableName);
+    }
+    void setTableWithoutIndex(std::string_view _tableName, bool _withoutIndex) const
+    {
+        bcos::WriteGuard l(x_tablesWithoutIndex);
+        if (_withoutIndex)
+        {
+            m_tablesWithoutIndex.emplace(_tableName);
+        }
+        else if (auto it = m_tablesWithoutIndex.find(_tableName); it != m_tablesWithoutIndex.end())
+        {
+            m_tablesWithoutIndex.erase(it);
+        }
+    }
+
 private:
     mutable bcos::SharedMutex x_executiveFlows;
     tbb::concurrent_unordered_map<std::string, ExecutiveFlowInterface::Ptr> m_executiveFlows;
@@ -157,6 +177,8 @@ private:
     LedgerCache::Ptr m_ledgerCache;
     std::set<std::string> m_suicides;  // contract address need to selfdestruct
     mutable bcos::SharedMutex x_suicides;
+    mutable std::set<std::string, std::less<>> m_tablesWithoutIndex;
+    mutable bcos::SharedMutex x_tablesWithoutIndex;
     std::shared_ptr<VMFactory> m_vmFactory;
 
     storage::EntryCachePtr m_codeCache = std::make_shared<storage::EntryCache>();
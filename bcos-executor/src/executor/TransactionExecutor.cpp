@@ -82,6 +82,7 @@
 #include <bcos-framework/protocol/LogEntry.h>
 #include <bcos-framework/protocol/Protocol.h>
 #include <bcos-utilities/Error.h>
+#include <bcos-utilities/Metrics.h>
 #include <bcos-utilities/ThreadPool.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
@@ -923,6 +924,10 @@ void TransactionExecutor::executeTransactionsInternal(std::string contractAddres
                                  << LOG_KV("requestTimestamp", requestTimestamp)
                                  << LOG_KV("msg", error ? error->errorMessage() : "ok")
                                  << LOG_KV("timeCost", utcTime() - requestTimestamp);
+        static auto& executeTime = bcos::metrics::Registry::instance().histogram(
+            "bcos_executor_execute_transactions_us",
+            "time of an executeTransactions request of the executor");
+        executeTime.observe((utcTime() - requestTimestamp) * 1000);
         _callback(std::move(error), std::move(outputs));
     };
 
@@ -1143,6 +1148,9 @@ void TransactionExecutor::getHash(bcos::protocol::BlockNumber number,
     auto start = utcTime();
     auto hash = last.storage->hash(m_hashImpl, m_blockContext->features());
     auto end = utcTime();
+    static auto& getHashTime = bcos::metrics::Registry::instance().histogram(
+        "bcos_executor_get_hash_us", "time to calculate the state hash of a block");
+    getHashTime.observe((end - start) * 1000);
     EXECUTOR_NAME_LOG(INFO) << BLOCK_NUMBER(number) << "GetTableHashes success"
                             << LOG_KV("hash", hash.hex()) << LOG_KV("time(ms)", (end - start));
 
@@ -1179,6 +1187,10 @@ void TransactionExecutor::dagExecuteTransactions(
                                  << LOG_KV("requestTimestamp", requestTimestamp)
                                  << LOG_KV("msg", error ? error->errorMessage() : "ok")
                                  << LOG_KV("timeCost", utcTime() - requestTimestamp);
+        static auto& dagExecuteTime = bcos::metrics::Registry::instance().histogram(
+            "bcos_executor_dag_execute_transactions_us",
+            "time of a dagExecuteTransactions request of the executor");
+        dagExecuteTime.observe((utcTime() - requestTimestamp) * 1000);
         _callback(std::move(error), std::move(outputs));
     };
 
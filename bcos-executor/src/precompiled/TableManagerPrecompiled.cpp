@@ -22,6 +22,7 @@
 
 #include "bcos-executor/src/precompiled/common/Common.h"
 #include "bcos-executor/src/precompiled/common/PrecompiledResult.h"
+#include "bcos-executor/src/precompiled/common/TableIndex.h"
 #include "bcos-executor/src/precompiled/common/Utilities.h"
 #include <bcos-framework/protocol/Exceptions.h>
 #include <boost/algorithm/string/classification.hpp>
@@ -42,6 +43,7 @@ constexpr const char* const TABLE_METHOD_DESC = "desc(string)";
 constexpr const char* const TABLE_METHOD_DESC_V32 = "descWithKeyOrder(string)";
 constexpr const char* const TABLE_METHOD_CREATE_V320 =
     "createTable(string,(uint8,string,string[]))";
+constexpr const char* const TABLE_METHOD_CREATE_INDEX = "createIndex(string,string)";
 
 
 TableManagerPrecompiled::TableManagerPrecompiled(crypto::Hash::Ptr _hashImpl)
@@ -78,6 +80,12 @@ TableManagerPrecompiled::TableManagerPrecompiled(crypto::Hash::Ptr _hashImpl)
             createTableV32(executive, pricer, params);
         },
         protocol::BlockVersion::V3_2_VERSION);
+    registerFunc(
+        getFuncSelector(TABLE_METHOD_CREATE_INDEX, _hashImpl),
+        [this](auto&& executive, auto&& pricer, auto&& params) {
+            createIndex(executive, pricer, params);
+        },
+        protocol::BlockVersion::V3_2_VERSION);
 }
 
 std::shared_ptr<PrecompiledExecResult> TableManagerPrecompiled::call(
@@ -279,6 +287,77 @@ void TableManagerPrecompiled::appendColumns(
     _callParameters->setExecResult(codec.encode(int32_t(CODE_SUCCESS)));
 }
 
+void TableManagerPrecompiled::createIndex(
+    const std::shared_ptr<executor::TransactionExecutive>& _executive,
+    const PrecompiledGas::Ptr& gasPricer, const PrecompiledExecResult::Ptr& _callParameters)
+{
+    // createIndex(string,string)
+    std::string tableName;
+    std::string column;
+    const auto& blockContext = _executive->blockContext();
+    if (!blockContext.features().get(ledger::Features::Flag::feature_table_index))
+    {
+        PRECOMPILED_LOG(INFO) << LOG_BADGE("TableManager") << LOG_DESC("call undefined function!");
+        BOOST_THROW_EXCEPTION(PrecompiledError("TableManager call undefined function!"));
+    }
+    auto codec = CodecWrapper(blockContext.hashHandler(), blockContext.isWasm());
+    codec.decode(_callParameters->params(), tableName, column);
+    tableName = getActualTableName(getTableName(tableName));
+
+    PRECOMPILED_LOG(DEBUG) << BLOCK_NUMBER(blockContext.number())
+                           << LOG_BADGE("TableManagerPrecompiled") << LOG_DESC("createIndex")
+                           << LOG_KV("tableName", tableName) << LOG_KV("column", column);
+    auto existEntry = _executive->storage().getRow(StorageInterface::SYS_TABLES, tableName);
+    if (!existEntry)
+    {
+        PRECOMPILED_LOG(DEBUG) << LOG_BADGE("TableManagerPrecompiled")
+                               << LOG_DESC("table not exists") << LOG_KV("tableName", tableName);
+        _callParameters->setExecResult(codec.encode(int32_t(CODE_TABLE_NOT_EXIST)));
+        return;
+    }
+    // only the tables created by createTable of v3.2 have their columns recorded in s_tables,
+    // s_tables save them as __v320_table_info__<keyOrder>,<keyField>,<columns>
+    auto keyAndValue = existEntry->get();
+    if (!keyAndValue.starts_with(V320_TABLE_INFO_PREFIX))
+    {
+        PRECOMPILED_LOG(DEBUG) << LOG_BADGE("TableManagerPrecompiled")
+                               << LOG_DESC("only v3.2 table can create index")
+                               << LOG_KV("tableName", tableName);
+        _callParameters->setExecResult(codec.encode(int32_t(CODE_TABLE_INVALIDATE_FIELD)));
+        return;
+    }
+    std::vector<std::string> fields;
+    boost::split(fields, std::string(keyAndValue.substr(V320_TABLE_INFO_PREFIX.size())),
+        boost::is_any_of(","));
+    auto it = std::find(fields.begin() + std::min<size_t>(fields.size(), 2), fields.end(), column);
+    if (it == fields.end())
+    {
+        PRECOMPILED_LOG(DEBUG) << LOG_BADGE("TableManagerPrecompiled")
+                               << LOG_DESC("index column not found") << LOG_KV("column", column);
+        _callParameters->setExecResult(codec.encode(int32_t(CODE_TABLE_INVALIDATE_FIELD)));
+        return;
+    }
+    auto columnIndex = (uint32_t)std::distance(fields.begin() + 2, it);
+
+    TableIndex tableIndex(_executive, tableName);
+    if (tableIndex.contains(columnIndex))
+    {
+        PRECOMPILED_LOG(DEBUG) << LOG_BADGE("TableManagerPrecompiled")
+                               << LOG_DESC("index already exists") << LOG_KV("column", column);
+        _callParameters->setExecResult(codec.encode(int32_t(CODE_TABLE_INDEX_ALREADY_EXIST)));
+        return;
+    }
+    auto indexed = tableIndex.create(columnIndex);
+    PRECOMPILED_LOG(INFO) << BLOCK_NUMBER(blockContext.number())
+                          << LOG_BADGE("TableManagerPrecompiled") << LOG_DESC("createIndex success")
+                          << LOG_KV("tableName", tableName) << LOG_KV("column", column)
+                          << LOG_KV("indexedRows", indexed);
+    // the existing rows are indexed in this transaction, so the cost grows with the table
+    gasPricer->appendOperation(InterfaceOpcode::CreateTable);
+    gasPricer->appendOperation(InterfaceOpcode::Set, indexed + 1);
+    _callParameters->setExecResult(codec.encode(int32_t(CODE_SUCCESS)));
+}
+
 void TableManagerPrecompiled::openTable(
     const std::shared_ptr<executor::TransactionExecutive>& _executive,
     const PrecompiledGas::Ptr& gasPricer, const PrecompiledExecResult::Ptr& _callParameters)
@@ -51,6 +51,8 @@ private:
         const PrecompiledGas::Ptr& gasPricer, PrecompiledExecResult::Ptr const& _callParameters);
     void appendColumns(const std::shared_ptr<executor::TransactionExecutive>& _executive,
         const PrecompiledGas::Ptr& gasPricer, PrecompiledExecResult::Ptr const& _callParameters);
+    void createIndex(const std::shared_ptr<executor::TransactionExecutive>& _executive,
+        const PrecompiledGas::Ptr& gasPricer, PrecompiledExecResult::Ptr const& _callParameters);
     void openTable(const std::shared_ptr<executor::TransactionExecutive>& _executive,
         const PrecompiledGas::Ptr& gasPricer, PrecompiledExecResult::Ptr const& _callParameters);
     void desc(const std::shared_ptr<executor::TransactionExecutive>& _executive,
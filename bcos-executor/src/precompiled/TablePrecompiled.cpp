@@ -20,6 +20,7 @@
 
 #include "TablePrecompiled.h"
 #include "bcos-executor/src/precompiled/common/PrecompiledResult.h"
+#include "bcos-executor/src/precompiled/common/TableIndex.h"
 #include "bcos-executor/src/precompiled/common/Utilities.h"
 #include <bcos-framework/protocol/Exceptions.h>
 #include <boost/algorithm/string/classification.hpp>
@@ -178,6 +179,64 @@ static void processEntryByValueCond(
     }
 }
 
+// visit the rows matching valueCondition in key order until processEntry returns false, returns
+// the number of index entries read
+template <typename Functor>
+static size_t processEntryByIndex(const std::shared_ptr<executor::TransactionExecutive>& _executive,
+    const std::string& tableName, const TableIndex& tableIndex, TableIndex::Scan scan,
+    precompiled::Condition& valueCondition, Functor&& processEntry)
+{
+    auto keyCondition = valueCondition.at(0);
+    auto keys = tableIndex.keys(std::move(scan));
+    for (auto const& key : keys)
+    {
+        if (keyCondition && !keyCondition->isValid(key))
+        {
+            continue;
+        }
+        auto tableEntry = _executive->storage().getRow(tableName, key);
+        if (!tableEntry)
+        {
+            continue;
+        }
+        auto values = tableEntry->getObject<std::vector<std::string>>();
+        if (!valueCondition.isValid(values))
+        {
+            continue;
+        }
+        if (!processEntry(key, std::move(values)))
+        {
+            break;
+        }
+    }
+    return keys.size();
+}
+
+static size_t selectByIndex(const std::shared_ptr<executor::TransactionExecutive>& _executive,
+    const std::string& tableName, const TableIndex& tableIndex, TableIndex::Scan scan,
+    precompiled::Condition& valueCondition, std::vector<EntryTuple>& entries,
+    bool toLexicographic = false)
+{
+    auto offset = valueCondition.getLimit().first;
+    auto total = valueCondition.getLimit().second;
+    if (total == 0)
+    {
+        return 0;
+    }
+    size_t validCount = 0;
+    return processEntryByIndex(_executive, tableName, tableIndex, std::move(scan), valueCondition,
+        [&](std::string_view key, std::vector<std::string> values) {
+            if (validCount >= offset)
+            {
+                entries.emplace_back(
+                    toLexicographic ? toLexicographicOrder(key) : std::string(key),
+                    std::move(values));
+            }
+            ++validCount;
+            return validCount < offset + total;
+        });
+}
+
 TablePrecompiled::TablePrecompiled(crypto::Hash::Ptr _hashImpl) : Precompiled(_hashImpl)
 {
     registerFunc(getFuncSelector(TABLE_METHOD_SELECT_KEY, _hashImpl),
@@ -540,10 +599,20 @@ void TablePrecompiled::selectByConditionV32(const std::string& tableName,
         buildConditions(valueCondition, std::move(conditions), limit, tableInfo.info_v320);
 
     std::vector<EntryTuple> entries({});
+    size_t scannedIndexKeys = 0;
     // when limitcount==0, skip select operation directly
     if (std::get<1>(limit) > 0)
     {
-        if (useValueCond)
+        TableIndex tableIndex(_executive, tableName);
+        auto indexScan =
+            useValueCond ? tableIndex.plan(*valueCondition) : std::optional<TableIndex::Scan>();
+        if (indexScan)
+        {
+            // the entries are in key order and limited as the scan over the table
+            scannedIndexKeys = selectByIndex(_executive, tableName, tableIndex,
+                std::move(*indexScan), *valueCondition, entries, _isNumericalOrder);
+        }
+        else if (useValueCond)
         {
             auto func = [_executive, &tableName, &entries, _isNumericalOrder](
                             const std::vector<std::string>& tableKeyList,
@@ -581,10 +650,11 @@ void TablePrecompiled::selectByConditionV32(const std::string& tableName,
         }
     }
     PRECOMPILED_LOG(TRACE) << LOG_BADGE("TablePrecompiled") << LOG_BADGE("SELECT")
-                           << LOG_KV("entries.size", entries.size());
+                           << LOG_KV("entries.size", entries.size())
+                           << LOG_KV("scannedIndexKeys", scannedIndexKeys);
     // update the memory gas and the computation gas
     gasPricer->updateMemUsed(entries.size());
-    gasPricer->appendOperation(InterfaceOpcode::Select, entries.size());
+    gasPricer->appendOperation(InterfaceOpcode::Select, entries.size() + scannedIndexKeys);
     _callParameters->setExecResult(codec.encode(entries));
 }
 
@@ -661,6 +731,38 @@ void TablePrecompiled::countV32(const std::string& tableName,
     uint32_t singleCount = 0;
     uint32_t singleCountByKey = 0;
     uint32_t singleCountByKeyMax = valueCondition->getKeyLimit().second;
+
+    TableIndex tableIndex(_executive, tableName);
+    auto indexScan =
+        useValueCond ? tableIndex.plan(*valueCondition) : std::optional<TableIndex::Scan>();
+    if (indexScan)
+    {
+        size_t matchedCount = 0;
+        size_t scannedIndexKeys = 0;
+        if (indexScan->exact)
+        {
+            // every index entry in the range is a matched row, no need to read the rows
+            matchedCount = tableIndex.keys(std::move(*indexScan)).size();
+            scannedIndexKeys = matchedCount;
+        }
+        else
+        {
+            scannedIndexKeys = processEntryByIndex(_executive, tableName, tableIndex,
+                std::move(*indexScan), *valueCondition,
+                [&](std::string_view, std::vector<std::string>) {
+                    ++matchedCount;
+                    return true;
+                });
+        }
+        totalCount = (uint32_t)std::min<size_t>(matchedCount, UINT32_MAX);
+        PRECOMPILED_LOG(TRACE) << LOG_BADGE("TablePrecompiled") << LOG_BADGE("COUNT")
+                               << LOG_KV("totalCount", totalCount)
+                               << LOG_KV("scannedIndexKeys", scannedIndexKeys);
+        gasPricer->appendOperation(InterfaceOpcode::Select, 1 + scannedIndexKeys);
+        _callParameters->setExecResult(codec.encode(uint32_t(totalCount)));
+        return;
+    }
+
     do
     {
         auto tableKeyList = _executive->storage().getPrimaryKeys(tableName, *keyCondition);
@@ -756,6 +858,12 @@ void TablePrecompiled::insert(const std::string& tableName,
         return;
     }
 
+    TableIndex tableIndex(_executive, tableName);
+    if (!tableIndex.empty())
+    {
+        gasPricer->appendOperation(InterfaceOpcode::Set, tableIndex.update(key, nullptr, &values));
+    }
+
     Entry entry;
     entry.setObject(std::move(values));
 
@@ -815,6 +923,12 @@ void TablePrecompiled::updateByKey(const std::string& tableName,
     }
 
     auto values = existEntry->getObject<std::vector<std::string>>();
+    TableIndex tableIndex(_executive, tableName);
+    std::vector<std::string> oldValues;
+    if (!tableIndex.empty())
+    {
+        oldValues = values;
+    }
     for (const auto& kv : updateFields)
     {
         auto& field = std::get<0>(kv);
@@ -840,6 +954,11 @@ void TablePrecompiled::updateByKey(const std::string& tableName,
         auto index = std::distance(columns.begin(), it);
         values[index] = value;
     }
+    if (!tableIndex.empty())
+    {
+        gasPricer->appendOperation(
+            InterfaceOpcode::Set, tableIndex.update(key, &oldValues, &values));
+    }
     Entry updateEntry;
     updateEntry.setObject(std::move(values));
     _executive->storage().setRow(tableName, key, std::move(updateEntry));
@@ -912,18 +1031,29 @@ void TablePrecompiled::updateByCondition(const std::string& tableName,
         updateValue.emplace_back(std::move(p));
     }
 
+    TableIndex tableIndex(_executive, tableName);
+    size_t indexChanges = 0;
     auto entries = _executive->storage().getRows(tableName, tableKeyList);
     for (size_t i = 0; i < entries.size(); ++i)
     {
         auto&& entry = entries[i];
         auto values = entry->getObject<std::vector<std::string>>();
+        auto oldValues = tableIndex.empty() ? std::vector<std::string>() : values;
         for (auto& kv : updateValue)
         {
             values[kv.first] = kv.second;
         }
+        if (!tableIndex.empty())
+        {
+            indexChanges += tableIndex.update(tableKeyList[i], &oldValues, &values);
+        }
         entry->setObject(std::move(values));
         _executive->storage().setRow(tableName, tableKeyList[i], std::move(entry.value()));
     }
+    if (!tableIndex.empty())
+    {
+        gasPricer->appendOperation(InterfaceOpcode::Set, indexChanges);
+    }
     PRECOMPILED_LOG(DEBUG) << LOG_BADGE("TablePrecompiled") << LOG_BADGE("UPDATE")
                            << LOG_KV("selectKeySize", tableKeyList.size())
                            << LOG_KV("affectedRows", entries.size());
@@ -998,30 +1128,50 @@ void TablePrecompiled::updateByConditionV32(const std::string& tableName,
     }
 
     uint32_t affectedRows = 0;
+    size_t scannedIndexKeys = 0;
+    size_t indexChanges = 0;
+    TableIndex tableIndex(_executive, tableName);
+    auto updateEntries = [&](std::vector<EntryTuple>& entries) {
+        for (auto& entryTuple : entries)
+        {
+            auto& values = std::get<1>(entryTuple);
+            auto oldValues = tableIndex.empty() ? std::vector<std::string>() : values;
+            for (auto& kv : updateValue)
+            {
+                values[kv.first] = kv.second;
+            }
+            if (!tableIndex.empty())
+            {
+                indexChanges += tableIndex.update(std::get<0>(entryTuple), &oldValues, &values);
+            }
+            storage::Entry entry;
+            entry.setObject(values);
+            _executive->storage().setRow(tableName, std::get<0>(entryTuple), std::move(entry));
+        }
+        affectedRows += entries.size();
+    };
     // when limitcount==0, skip update operation directly
     if (std::get<1>(limitTuple) > 0)
     {
-        if (useValueCond)
+        auto indexScan =
+            useValueCond ? tableIndex.plan(*valueCondition) : std::optional<TableIndex::Scan>();
+        if (indexScan)
         {
-            auto func = [_executive, &tableName, &updateValue, &affectedRows](
+            // select first, updating the indexed column while scanning its index may revisit rows
+            std::vector<EntryTuple> entries({});
+            scannedIndexKeys = selectByIndex(
+                _executive, tableName, tableIndex, std::move(*indexScan), *valueCondition, entries);
+            updateEntries(entries);
+        }
+        else if (useValueCond)
+        {
+            auto func = [_executive, &tableName, &updateEntries](
                             const std::vector<std::string>& tableKeyList,
                             std::optional<precompiled::Condition> _valueCondition) {
                 std::vector<EntryTuple> entries({});
                 size_t validCount = selectByValueCond(
                     _executive, tableName, tableKeyList, entries, _valueCondition);
-                for (auto& entryTuple : entries)
-                {
-                    auto& values = std::get<1>(entryTuple);
-                    for (auto& kv : updateValue)
-                    {
-                        values[kv.first] = kv.second;
-                    }
-                    storage::Entry entry;
-                    entry.setObject(values);
-                    _executive->storage().setRow(
-                        tableName, std::get<0>(entryTuple), std::move(entry));
-                }
-                affectedRows += entries.size();
+                updateEntries(entries);
                 return std::pair<size_t, size_t>{validCount, entries.size()};
             };
             processEntryByValueCond(
@@ -1030,26 +1180,28 @@ void TablePrecompiled::updateByConditionV32(const std::string& tableName,
         else
         {
             auto tableKeyList = _executive->storage().getPrimaryKeys(tableName, *keyCondition);
-            auto entries = _executive->storage().getRows(tableName, tableKeyList);
-            for (size_t i = 0; i < entries.size(); ++i)
+            auto rows = _executive->storage().getRows(tableName, tableKeyList);
+            std::vector<EntryTuple> entries;
+            entries.reserve(rows.size());
+            for (size_t i = 0; i < rows.size(); ++i)
             {
-                auto&& entry = entries[i];
-                auto values = entry->getObject<std::vector<std::string>>();
-                for (auto& kv : updateValue)
-                {
-                    values[kv.first] = kv.second;
-                }
-                entry->setObject(std::move(values));
-                _executive->storage().setRow(tableName, tableKeyList[i], std::move(entry.value()));
+                entries.emplace_back(std::move(tableKeyList[i]),
+                    rows[i]->getObject<std::vector<std::string>>());
             }
-            affectedRows = tableKeyList.size();
+            updateEntries(entries);
         }
     }
     PRECOMPILED_LOG(DEBUG) << LOG_BADGE("TablePrecompiled") << LOG_BADGE("UPDATE")
                            << LOG_KV("selectSize", affectedRows)
-                           << LOG_KV("affectedRows", affectedRows);
+                           << LOG_KV("affectedRows", affectedRows)
+                           << LOG_KV("scannedIndexKeys", scannedIndexKeys);
     gasPricer->setMemUsed(affectedRows * columns.size());
     gasPricer->appendOperation(InterfaceOpcode::Update, affectedRows);
+    if (!tableIndex.empty())
+    {
+        gasPricer->appendOperation(InterfaceOpcode::Select, scannedIndexKeys);
+        gasPricer->appendOperation(InterfaceOpcode::Set, indexChanges);
+    }
     _callParameters->setExecResult(codec.encode((int32_t)affectedRows));
 }
 
@@ -1084,6 +1236,13 @@ void TablePrecompiled::removeByKey(const std::string& tableName,
         _callParameters->setExecResult(codec.encode(int32_t(CODE_REMOVE_KEY_NOT_EXIST)));
         return;
     }
+    TableIndex tableIndex(_executive, tableName);
+    if (!tableIndex.empty())
+    {
+        auto values = existEntry->getObject<std::vector<std::string>>();
+        gasPricer->appendOperation(
+            InterfaceOpcode::Remove, tableIndex.update(key, &values, nullptr));
+    }
     Entry deletedEntry;
     deletedEntry.setStatus(Entry::DELETED);
     _executive->storage().setRow(tableName, key, std::move(deletedEntry));
@@ -1121,6 +1280,18 @@ void TablePrecompiled::removeByCondition(const std::string& tableName,
 
     auto tableKeyList = _executive->storage().getPrimaryKeys(tableName, *keyCondition);
 
+    TableIndex tableIndex(_executive, tableName);
+    if (!tableIndex.empty())
+    {
+        size_t indexChanges = 0;
+        auto rows = _executive->storage().getRows(tableName, tableKeyList);
+        for (size_t i = 0; i < rows.size(); ++i)
+        {
+            auto values = rows[i]->getObject<std::vector<std::string>>();
+            indexChanges += tableIndex.update(tableKeyList[i], &values, nullptr);
+        }
+        gasPricer->appendOperation(InterfaceOpcode::Remove, indexChanges);
+    }
     for (auto& tableKey : tableKeyList)
     {
         Entry deletedEntry;
@@ -1168,25 +1339,44 @@ void TablePrecompiled::removeByConditionV32(const std::string& tableName,
     }
 
     uint32_t removedRows = 0;
+    size_t scannedIndexKeys = 0;
+    size_t indexChanges = 0;
+    TableIndex tableIndex(_executive, tableName);
+    auto removeEntries = [&](std::vector<EntryTuple> const& entries) {
+        for (auto& entry : entries)
+        {
+            if (!tableIndex.empty())
+            {
+                indexChanges +=
+                    tableIndex.update(std::get<0>(entry), &std::get<1>(entry), nullptr);
+            }
+            storage::Entry deletedEntry;
+            deletedEntry.setStatus(Entry::DELETED);
+            _executive->storage().setRow(tableName, std::get<0>(entry), std::move(deletedEntry));
+        }
+        removedRows += entries.size();
+    };
     // when limitcount==0, skip remove operation directly
     if (std::get<1>(limitTuple) > 0)
     {
-        if (useValueCond)
+        auto indexScan =
+            useValueCond ? tableIndex.plan(*valueCondition) : std::optional<TableIndex::Scan>();
+        if (indexScan)
+        {
+            std::vector<EntryTuple> entries({});
+            scannedIndexKeys = selectByIndex(
+                _executive, tableName, tableIndex, std::move(*indexScan), *valueCondition, entries);
+            removeEntries(entries);
+        }
+        else if (useValueCond)
         {
-            auto func = [_executive, &tableName, &removedRows](
+            auto func = [_executive, &tableName, &removeEntries](
                             const std::vector<std::string>& tableKeyList,
                             std::optional<precompiled::Condition> _valueCondition) {
                 std::vector<EntryTuple> entries({});
                 size_t validCount = selectByValueCond(
                     _executive, tableName, tableKeyList, entries, _valueCondition);
-                for (auto& entry : entries)
-                {
-                    storage::Entry deletedEntry;
-                    deletedEntry.setStatus(Entry::DELETED);
-                    _executive->storage().setRow(
-                        tableName, std::get<0>(entry), std::move(deletedEntry));
-                }
-                removedRows += entries.size();
+                removeEntries(entries);
                 return std::pair<size_t, size_t>{validCount, entries.size()};
             };
             processEntryByValueCond(
@@ -1195,18 +1385,30 @@ void TablePrecompiled::removeByConditionV32(const std::string& tableName,
         else
         {
             auto tableKeyList = _executive->storage().getPrimaryKeys(tableName, *keyCondition);
-            for (auto& tableKey : tableKeyList)
+            std::vector<EntryTuple> entries;
+            entries.reserve(tableKeyList.size());
+            // the values are only needed to find the index entries of the removed rows
+            auto rows = tableIndex.empty() ?
+                            std::vector<std::optional<storage::Entry>>(tableKeyList.size()) :
+                            _executive->storage().getRows(tableName, tableKeyList);
+            for (size_t i = 0; i < tableKeyList.size(); ++i)
             {
-                storage::Entry deletedEntry;
-                deletedEntry.setStatus(Entry::DELETED);
-                _executive->storage().setRow(tableName, tableKey, std::move(deletedEntry));
+                entries.emplace_back(std::move(tableKeyList[i]),
+                    rows[i] ? rows[i]->getObject<std::vector<std::string>>() :
+                              std::vector<std::string>());
             }
-            removedRows = tableKeyList.size();
+            removeEntries(entries);
         }
     }
     PRECOMPILED_LOG(DEBUG) << LOG_BADGE("TablePrecompiled") << LOG_BADGE("REMOVE")
-                           << LOG_KV("removedRows", removedRows);
+                           << LOG_KV("removedRows", removedRows)
+                           << LOG_KV("scannedIndexKeys", scannedIndexKeys);
     gasPricer->setMemUsed(removedRows);
     gasPricer->appendOperation(InterfaceOpcode::Remove, removedRows);
+    if (!tableIndex.empty())
+    {
+        gasPricer->appendOperation(InterfaceOpcode::Select, scannedIndexKeys);
+        gasPricer->appendOperation(InterfaceOpcode::Remove, indexChanges);
+    }
     _callParameters->setExecResult(codec.encode((int32_t)removedRows));
 }
\ No newline at end of file
@@ -86,6 +86,7 @@ const int CODE_TABLE_KEY_VALUE_LENGTH_OVERFLOW = -50005;
 const int CODE_TABLE_FIELD_VALUE_LENGTH_OVERFLOW = -50006;
 const int CODE_TABLE_DUPLICATE_FIELD = -50007;
 const int CODE_TABLE_INVALIDATE_FIELD = -50008;
+const int CODE_TABLE_INDEX_ALREADY_EXIST = -50009;
 
 const int TX_COUNT_LIMIT_MIN = 1;
 const int TX_GAS_LIMIT_MIN = 100000;
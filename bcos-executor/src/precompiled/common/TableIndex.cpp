@@ -0,0 +1,322 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief secondary indexes of the user tables
+ * @file TableIndex.cpp
+ */
+
+#include "TableIndex.h"
+#include <bcos-framework/ledger/Features.h>
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/join.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <limits>
+
+using namespace bcos;
+using namespace bcos::storage;
+using namespace bcos::precompiled;
+
+namespace
+{
+constexpr std::string_view INDEX_TABLE_PREFIX = "s_index_";
+constexpr std::string_view INDEX_COLUMNS_KEY = "#columns";
+constexpr std::string_view INDEX_VALUE_FIELD = "key";
+// ends the value part of an index key, every escaped 0x00 of the value is followed by 0xff
+constexpr std::string_view VALUE_SEPARATOR{"\0\0", 2};
+// the smallest suffix greater than all the keys of one value
+constexpr std::string_view VALUE_END{"\0\1", 2};
+
+std::string columnPrefix(uint32_t _column)
+{
+    auto prefix = std::to_string(_column);
+    prefix.push_back(':');
+    return prefix;
+}
+
+void appendEscaped(std::string& _out, std::string_view _value)
+{
+    for (auto c : _value)
+    {
+        _out.push_back(c);
+        if (c == '\0')
+        {
+            _out.push_back('\xff');
+        }
+    }
+}
+}  // namespace
+
+TableIndex::TableIndex(
+    std::shared_ptr<executor::TransactionExecutive> _executive, std::string _tableName)
+  : m_executive(std::move(_executive)),
+    m_tableName(std::move(_tableName)),
+    m_indexTableName(getIndexTableName(m_tableName))
+{
+    auto const& blockContext = m_executive->blockContext();
+    if (!blockContext.features().get(ledger::Features::Flag::feature_table_index) ||
+        blockContext.isTableWithoutIndex(m_tableName))
+    {
+        return;
+    }
+    std::optional<Entry> entry;
+    if (m_executive->storage().openTable(m_indexTableName))
+    {
+        entry = m_executive->storage().getRow(m_indexTableName, INDEX_COLUMNS_KEY);
+    }
+    if (!entry)
+    {
+        // only createIndex adds an index, it forgets the table again
+        blockContext.setTableWithoutIndex(m_tableName, true);
+        return;
+    }
+    std::vector<std::string> columns;
+    boost::split(columns, std::string(entry->get()), boost::is_any_of(","));
+    for (auto const& column : columns)
+    {
+        if (!column.empty())
+        {
+            m_columns.push_back(boost::lexical_cast<uint32_t>(column));
+        }
+    }
+}
+
+std::string TableIndex::getIndexTableName(std::string_view _tableName)
+{
+    std::string name(INDEX_TABLE_PREFIX);
+    name.append(_tableName);
+    return name;
+}
+
+std::string TableIndex::encodeKey(uint32_t _column, std::string_view _value, std::string_view _key)
+{
+    auto indexKey = columnPrefix(_column);
+    indexKey.reserve(indexKey.size() + _value.size() + VALUE_SEPARATOR.size() + _key.size());
+    appendEscaped(indexKey, _value);
+    indexKey.append(VALUE_SEPARATOR);
+    indexKey.append(_key);
+    return indexKey;
+}
+
+std::string_view TableIndex::decodeKey(std::string_view _indexKey)
+{
+    auto pos = _indexKey.find(':');
+    if (pos == std::string_view::npos)
+    {
+        return {};
+    }
+    for (auto i = pos + 1; i + 1 < _indexKey.size(); ++i)
+    {
+        if (_indexKey[i] != '\0')
+        {
+            continue;
+        }
+        if (_indexKey[i + 1] == '\0')
+        {
+            return _indexKey.substr(i + VALUE_SEPARATOR.size());
+        }
+        // skip the escaped 0xff
+        ++i;
+    }
+    return {};
+}
+
+bool TableIndex::contains(uint32_t _column) const
+{
+    return std::find(m_columns.begin(), m_columns.end(), _column) != m_columns.end();
+}
+
+size_t TableIndex::create(uint32_t _column)
+{
+    auto& storage = m_executive->storage();
+    if (!storage.openTable(m_indexTableName))
+    {
+        storage.createTable(m_indexTableName, std::string(INDEX_VALUE_FIELD));
+    }
+
+    size_t indexed = 0;
+    storage::Condition condition;
+    size_t offset = 0;
+    while (true)
+    {
+        condition.limit(offset, USER_TABLE_MAX_LIMIT_COUNT);
+        auto keys = storage.getPrimaryKeys(m_tableName, condition);
+        auto rows = storage.getRows(m_tableName, keys);
+        for (size_t i = 0; i < rows.size(); ++i)
+        {
+            if (!rows[i])
+            {
+                continue;
+            }
+            auto values = rows[i]->getObject<std::vector<std::string>>();
+            // the rows inserted before appendColumns have no value of the new columns
+            if (_column >= values.size())
+            {
+                continue;
+            }
+            Entry entry;
+            entry.importFields({keys[i]});
+            storage.setRow(m_indexTableName, encodeKey(_column, values[_column], keys[i]),
+                std::move(entry));
+            ++indexed;
+        }
+        offset += keys.size();
+        if (keys.size() < (size_t)USER_TABLE_MAX_LIMIT_COUNT)
+        {
+            break;
+        }
+    }
+
+    m_columns.push_back(_column);
+    std::vector<std::string> columns;
+    columns.reserve(m_columns.size());
+    std::transform(m_columns.begin(), m_columns.end(), std::back_inserter(columns),
+        [](uint32_t column) { return std::to_string(column); });
+    Entry meta;
+    meta.importFields({boost::join(columns, ",")});
+    storage.setRow(m_indexTableName, INDEX_COLUMNS_KEY, std::move(meta));
+    m_executive->blockContext().setTableWithoutIndex(m_tableName, false);
+    return indexed;
+}
+
+size_t TableIndex::update(std::string_view _key, std::vector<std::string> const* _oldValues,
+    std::vector<std::string> const* _newValues)
+{
+    size_t changes = 0;
+    for (auto column : m_columns)
+    {
+        auto const* oldValue =
+            (_oldValues && column < _oldValues->size()) ? &(*_oldValues)[column] : nullptr;
+        auto const* newValue =
+            (_newValues && column < _newValues->size()) ? &(*_newValues)[column] : nullptr;
+        if (oldValue && newValue && *oldValue == *newValue)
+        {
+            continue;
+        }
+        if (oldValue)
+        {
+            Entry deletedEntry;
+            deletedEntry.setStatus(Entry::DELETED);
+            m_executive->storage().setRow(
+                m_indexTableName, encodeKey(column, *oldValue, _key), std::move(deletedEntry));
+            ++changes;
+        }
+        if (newValue)
+        {
+            Entry entry;
+            entry.importFields({std::string(_key)});
+            m_executive->storage().setRow(
+                m_indexTableName, encodeKey(column, *newValue, _key), std::move(entry));
+            ++changes;
+        }
+    }
+    return changes;
+}
+
+std::optional<TableIndex::Scan> TableIndex::plan(precompiled::Condition& _valueCondition) const
+{
+    for (auto column : m_columns)
+    {
+        auto condition = _valueCondition.at(column + 1);
+        if (!condition)
+        {
+            continue;
+        }
+
+        Scan scan{.column = column};
+        auto prefix = columnPrefix(column);
+        scan.condition.startsWith(prefix);
+        bool ranged = false;
+        bool exact = condition->m_repeatableConditions.empty();
+        for (auto const& [cmp, value] : condition->m_conditions)
+        {
+            if (cmp == Condition::Comparator::ENDS_WITH)
+            {
+                exact = false;
+                continue;
+            }
+            auto bound = prefix;
+            appendEscaped(bound, value);
+            switch (cmp)
+            {
+            case Condition::Comparator::GT:
+                bound.append(VALUE_END);
+                scan.condition.GE(bound);
+                break;
+            case Condition::Comparator::GE:
+                scan.condition.GE(bound);
+                break;
+            case Condition::Comparator::LT:
+                scan.condition.LT(bound);
+                break;
+            case Condition::Comparator::LE:
+                bound.append(VALUE_END);
+                scan.condition.LT(bound);
+                break;
+            case Condition::Comparator::STARTS_WITH:
+                scan.condition.startsWith(bound);
+                break;
+            default:
+                break;
+            }
+            ranged = true;
+        }
+        if (!ranged)
+        {
+            continue;
+        }
+        if (condition->m_hasConflictCond)
+        {
+            scan.condition.m_hasConflictCond = true;
+        }
+
+        // the key condition and the conditions of the other columns are checked on the rows
+        auto keyCondition = _valueCondition.at(0);
+        if (keyCondition &&
+            (!keyCondition->m_conditions.empty() || !keyCondition->m_repeatableConditions.empty()))
+        {
+            exact = false;
+        }
+        if (_valueCondition.size() - (_valueCondition.contains(0) ? 1 : 0) > 1)
+        {
+            exact = false;
+        }
+        scan.exact = exact;
+        return scan;
+    }
+    return std::nullopt;
+}
+
+std::vector<std::string> TableIndex::keys(Scan _scan) const
+{
+    if (_scan.condition.m_hasConflictCond)
+    {
+        return {};
+    }
+    // one query for the whole range: the storage layers merge their dirty and deleted keys
+    // without applying the limit, so a page of the merged keys does not tell where the next page
+    // starts; the rows are ordered by the table keys, which needs all the keys in the range anyway
+    _scan.condition.limit(0, std::numeric_limits<uint32_t>::max());
+    auto indexKeys = m_executive->storage().getPrimaryKeys(m_indexTableName, _scan.condition);
+    std::vector<std::string> keys;
+    keys.reserve(indexKeys.size());
+    for (auto const& indexKey : indexKeys)
+    {
+        keys.emplace_back(decodeKey(indexKey));
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
@@ -0,0 +1,82 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief secondary indexes of the user tables
+ * @file TableIndex.h
+ */
+
+#pragma once
+
+#include "bcos-executor/src/executive/TransactionExecutive.h"
+#include "bcos-executor/src/precompiled/common/Common.h"
+#include "bcos-executor/src/precompiled/common/Condition.h"
+
+namespace bcos::precompiled
+{
+/**
+ * @brief the secondary indexes of a v3.2 user table, all index entries of table t live in the
+ * companion table s_index_t, which is written in the same transaction as the rows of t
+ *
+ * the index entry of a row is keyed by <column>:<escaped value>\0\0<primary key>, the 0x00 bytes
+ * of the value are escaped as 0x00 0xff so that the order of the index keys is the order of the
+ * values, a value condition on an indexed column becomes one range scan over s_index_t;
+ * the meta row #columns holds the indexed column positions, it sorts before all index entries
+ */
+class TableIndex
+{
+public:
+    // the index range of a value condition, exact means no row filter is needed after the scan
+    struct Scan
+    {
+        uint32_t column = 0;
+        storage::Condition condition;
+        bool exact = false;
+    };
+
+    // loads the indexed columns of _tableName, the indexes only take effect with
+    // feature_table_index
+    TableIndex(std::shared_ptr<executor::TransactionExecutive> _executive, std::string _tableName);
+
+    static std::string getIndexTableName(std::string_view _tableName);
+    static std::string encodeKey(uint32_t _column, std::string_view _value, std::string_view _key);
+    static std::string_view decodeKey(std::string_view _indexKey);
+
+    bool empty() const { return m_columns.empty(); }
+    bool contains(uint32_t _column) const;
+    std::vector<uint32_t> const& columns() const { return m_columns; }
+    std::string const& indexTableName() const { return m_indexTableName; }
+
+    // indexes every existing row of _column, returns the number of index entries written
+    size_t create(uint32_t _column);
+
+    // keeps the index entries of the row _key in step with its values, nullptr means no row,
+    // returns the number of index entries written or deleted
+    size_t update(std::string_view _key, std::vector<std::string> const* _oldValues,
+        std::vector<std::string> const* _newValues);
+
+    // the range of the first indexed column which has a range condition, nullopt if there is none
+    std::optional<Scan> plan(precompiled::Condition& _valueCondition) const;
+
+    // the primary keys in _scan, sorted in the order of the table keys, so that the offset and the
+    // count of a condition pick the same rows as the scan over the table
+    std::vector<std::string> keys(Scan _scan) const;
+
+private:
+    std::shared_ptr<executor::TransactionExecutive> m_executive;
+    std::string m_tableName;
+    std::string m_indexTableName;
+    std::vector<uint32_t> m_columns;
+};
+}  // namespace bcos::precompiled
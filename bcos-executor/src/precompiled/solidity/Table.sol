@@ -48,6 +48,10 @@ abstract contract TableManager {
     // 只能新增字段，不能删除字段，新增的字段默认值为空，不能与原有字段重复
     function appendColumns(string memory path, string[] memory newColumns) public virtual returns (int32);
 
+    // 为字段创建二级索引，已有记录会在同一交易中建立索引，索引字段上的条件查询按索引顺序返回
+    // 只支持createTable创建的表，不能为key字段创建索引
+    function createIndex(string memory path, string memory column) public virtual returns (int32);
+
     // 获取表信息
     function descWithKeyOrder(string memory tableName) public view virtual returns (TableInfo memory);
 }
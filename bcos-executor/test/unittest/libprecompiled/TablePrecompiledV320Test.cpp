@@ -20,6 +20,7 @@
 
 #include "libprecompiled/PreCompiledFixture.h"
 #include "precompiled/TableManagerPrecompiled.h"
+#include "precompiled/common/TableIndex.h"
 #include <bcos-utilities/testutils/TestPromptFixture.h>
 #include <algorithm>
 #include <map>
@@ -51,7 +52,7 @@ public:
         const std::vector<std::string>& value, const std::string& callAddress, int _errorCode = 0,
         bool errorInTableManager = false)
     {
-        nextBlock(_number, protocol::BlockVersion::V3_6_1_VERSION);
+        nextBlock(_number, blockVersion);
         TableInfoTupleV320 tableInfoTuple = std::make_tuple(keyOrder, key, value);
         bytes in = codec->encodeWithSig(
             "createTable(string,(uint8,string,string[]))", tableName, tableInfoTuple);
@@ -148,7 +149,7 @@ public:
     ExecutionMessage::UniquePtr appendColumns(protocol::BlockNumber _number,
         const std::string& tableName, const std::vector<std::string>& values, int _errorCode = 0)
     {
-        nextBlock(_number, protocol::BlockVersion::V3_6_1_VERSION);
+        nextBlock(_number, blockVersion);
         bytes in = codec->encodeWithSig("appendColumns(string,string[])", tableName, values);
         auto tx =
             fakeTransaction(cryptoSuite, keyPair, "", in, std::to_string(100), 10000, "1", "1");
@@ -185,6 +186,46 @@ public:
         return result2;
     };
 
+    ExecutionMessage::UniquePtr createIndex(protocol::BlockNumber _number,
+        const std::string& tableName, const std::string& column, int _errorCode = 0)
+    {
+        nextBlock(_number, blockVersion);
+        bytes in = codec->encodeWithSig("createIndex(string,string)", tableName, column);
+        auto tx =
+            fakeTransaction(cryptoSuite, keyPair, "", in, std::to_string(100), 10000, "1", "1");
+        sender = boost::algorithm::hex_lower(std::string(tx->sender()));
+        auto hash = tx->hash();
+        txpool->hash2Transaction.emplace(hash, tx);
+        auto params2 = std::make_unique<NativeExecutionMessage>();
+        params2->setTransactionHash(hash);
+        params2->setContextID(100);
+        params2->setSeq(1000);
+        params2->setDepth(0);
+        params2->setFrom(sender);
+        params2->setTo(isWasm ? TABLE_MANAGER_NAME : TABLE_MANAGER_ADDRESS);
+        params2->setOrigin(sender);
+        params2->setStaticCall(false);
+        params2->setGasAvailable(gas);
+        params2->setData(std::move(in));
+        params2->setType(NativeExecutionMessage::TXHASH);
+
+        // call precompiled
+        std::promise<ExecutionMessage::UniquePtr> executePromise2;
+        executor->dmcExecuteTransaction(std::move(params2),
+            [&](bcos::Error::UniquePtr&& error, ExecutionMessage::UniquePtr&& result) {
+                BOOST_CHECK(!error);
+                executePromise2.set_value(std::move(result));
+            });
+        auto result2 = executePromise2.get_future().get();
+
+        if (_errorCode != 0)
+        {
+            BOOST_CHECK(result2->data().toBytes() == codec->encode(int32_t(_errorCode)));
+        }
+        commitBlock(_number);
+        return result2;
+    };
+
     ExecutionMessage::UniquePtr openTable(
         protocol::BlockNumber _number, std::string const& _path, int _errorCode = 0)
     {
@@ -206,7 +247,7 @@ public:
         params2->setGasAvailable(gas);
         params2->setData(std::move(in));
         params2->setType(NativeExecutionMessage::TXHASH);
-        nextBlock(_number, protocol::BlockVersion::V3_6_1_VERSION);
+        nextBlock(_number, blockVersion);
 
         std::promise<ExecutionMessage::UniquePtr> executePromise2;
         executor->dmcExecuteTransaction(std::move(params2),
@@ -226,7 +267,7 @@ public:
 
     ExecutionMessage::UniquePtr desc(protocol::BlockNumber _number, std::string const& tableName)
     {
-        nextBlock(_number, protocol::BlockVersion::V3_6_1_VERSION);
+        nextBlock(_number, blockVersion);
         bytes in = codec->encodeWithSig("descWithKeyOrder(string)", tableName);
         auto tx =
             fakeTransaction(cryptoSuite, keyPair, "", in, std::to_string(101), 100001, "1", "1");
@@ -262,7 +303,7 @@ public:
     ExecutionMessage::UniquePtr insert(protocol::BlockNumber _number, const std::string& key,
         const std::vector<std::string>& values, const std::string& callAddress)
     {
-        nextBlock(_number, protocol::BlockVersion::V3_6_1_VERSION);
+        nextBlock(_number, blockVersion);
         EntryTuple entryTuple = {key, values};
         bytes in = codec->encodeWithSig("insert((string,string[]))", entryTuple);
         auto tx =
@@ -318,7 +359,7 @@ public:
     ExecutionMessage::UniquePtr selectByKey(
         protocol::BlockNumber _number, const std::string& key, const std::string& callAddress)
     {
-        nextBlock(_number, protocol::BlockVersion::V3_6_1_VERSION);
+        nextBlock(_number, blockVersion);
         bytes in = codec->encodeWithSig("select(string)", key);
         auto tx =
             fakeTransaction(cryptoSuite, keyPair, "", in, std::to_string(101), 100001, "1", "1");
@@ -374,7 +415,7 @@ public:
         const std::vector<ConditionTupleV320>& keyCond, const LimitTuple& limit,
         const std::string& callAddress)
     {
-        nextBlock(_number, protocol::BlockVersion::V3_6_1_VERSION);
+        nextBlock(_number, blockVersion);
         bytes in =
             codec->encodeWithSig("select((uint8,string,string)[],(uint32,uint32))", keyCond, limit);
         auto tx =
@@ -430,7 +471,7 @@ public:
     ExecutionMessage::UniquePtr count(protocol::BlockNumber _number,
         const std::vector<ConditionTupleV320>& keyCond, const std::string& callAddress)
     {
-        nextBlock(_number, protocol::BlockVersion::V3_6_1_VERSION);
+        nextBlock(_number, blockVersion);
         bytes in = codec->encodeWithSig("count((uint8,string,string)[])", keyCond);
         auto tx =
             fakeTransaction(cryptoSuite, keyPair, "", in, std::to_string(101), 100001, "1", "1");
@@ -486,7 +527,7 @@ public:
         const std::vector<precompiled::UpdateFieldTuple>& _updateFields,
         const std::string& callAddress, bool _isErrorInTable = false)
     {
-        nextBlock(_number, protocol::BlockVersion::V3_6_1_VERSION);
+        nextBlock(_number, blockVersion);
         bytes in = codec->encodeWithSig("update(string,(string,string)[])", key, _updateFields);
         auto tx =
             fakeTransaction(cryptoSuite, keyPair, "", in, std::to_string(101), 100001, "1", "1");
@@ -551,7 +592,7 @@ public:
         const std::vector<precompiled::UpdateFieldTuple>& _updateFields,
         const std::string& callAddress)
     {
-        nextBlock(_number, protocol::BlockVersion::V3_6_1_VERSION);
+        nextBlock(_number, blockVersion);
         bytes in = codec->encodeWithSig(
             "update((uint8,string,string)[],(uint32,uint32),(string,string)[])", conditions, _limit,
             _updateFields);
@@ -615,7 +656,7 @@ public:
     ExecutionMessage::UniquePtr removeByKey(
         protocol::BlockNumber _number, const std::string& key, const std::string& callAddress)
     {
-        nextBlock(_number, protocol::BlockVersion::V3_6_1_VERSION);
+        nextBlock(_number, blockVersion);
         bytes in = codec->encodeWithSig("remove(string)", key);
         auto tx =
             fakeTransaction(cryptoSuite, keyPair, "", in, std::to_string(101), 100001, "1", "1");
@@ -671,7 +712,7 @@ public:
         const std::vector<ConditionTupleV320>& keyCond, const LimitTuple& limit,
         const std::string& callAddress)
     {
-        nextBlock(_number, protocol::BlockVersion::V3_6_1_VERSION);
+        nextBlock(_number, blockVersion);
         bytes in =
             codec->encodeWithSig("remove((uint8,string,string)[],(uint32,uint32))", keyCond, limit);
         auto tx =
@@ -726,6 +767,7 @@ public:
 
     std::string tableTestAddress;
     std::string sender;
+    protocol::BlockVersion blockVersion = protocol::BlockVersion::V3_6_1_VERSION;
 };
 
 struct ConditionNative
@@ -4558,5 +4600,116 @@ BOOST_AUTO_TEST_CASE(mixConditionTest)
     }
 }
 
+BOOST_AUTO_TEST_CASE(indexTest)
+{
+    blockVersion = protocol::BlockVersion::V3_7_0_VERSION;
+    auto callAddress = tableTestAddress;
+    bcos::protocol::BlockNumber number = 1;
+    auto fillZero = [](int _num, int _width) {
+        std::stringstream stream;
+        stream << std::setfill('0') << std::setw(_width) << std::right << _num;
+        return stream.str();
+    };
+    auto countFunc = [this, &number, &callAddress](
+                         const std::vector<ConditionTupleV320>& conds) {
+        auto r1 = count(number++, conds, callAddress);
+        uint32_t countRes = 0;
+        codec->decode(r1->data(), countRes);
+        return countRes;
+    };
+    auto ageEQ = [](const std::string& age) {
+        return ConditionTupleV320{(uint8_t)storage::Condition::Comparator::EQ, "age", age};
+    };
+
+    creatTable(number++, "t_test_index", 0, "id", {"name", "age"}, callAddress);
+    // the indexes take effect with feature_table_index
+    BOOST_CHECK_NE(createIndex(number++, "t_test_index", "age")->status(), 0);
+    storage::Entry feature;
+    feature.setObject(ledger::SystemConfigEntry{"1", 0});
+    storage->setRows(ledger::SYS_CONFIG, std::vector<std::string>{"feature_table_index"},
+        std::vector<std::string>{std::string(feature.get())});
+
+    // rows before the index are indexed by createIndex, rows after it by insert
+    for (int i = 0; i < 20; ++i)
+    {
+        if (i == 10)
+        {
+            createIndex(number++, "t_test_index", "age");
+        }
+        boost::log::core::get()->set_logging_enabled(false);
+        insert(number++, fillZero(i, 2), {i % 2 ? "odd" : "even", fillZero(i % 10, 2)},
+            callAddress);
+        boost::log::core::get()->set_logging_enabled(true);
+    }
+
+    createIndex(number++, "t_test_index", "age", CODE_TABLE_INDEX_ALREADY_EXIST);
+    createIndex(number++, "t_test_index", "id", CODE_TABLE_INVALIDATE_FIELD);
+    createIndex(number++, "t_test_index", "not_exist", CODE_TABLE_INVALIDATE_FIELD);
+    createIndex(number++, "t_not_exist", "age", CODE_TABLE_NOT_EXIST);
+
+    // range select returns the entries in key order, the same as without the index
+    {
+        ConditionTupleV320 cond = {(uint8_t)storage::Condition::Comparator::GE, "age", "07"};
+        auto r1 = selectByCondition(number++, {cond}, {0, 500}, callAddress);
+        std::vector<EntryTuple> entries;
+        codec->decode(r1->data(), entries);
+        std::vector<EntryTuple> expected = {{"07", {"odd", "07"}}, {"08", {"even", "08"}},
+            {"09", {"odd", "09"}}, {"17", {"odd", "07"}}, {"18", {"even", "08"}},
+            {"19", {"odd", "09"}}};
+        BOOST_CHECK(entries == expected);
+
+        r1 = selectByCondition(number++, {cond}, {1, 2}, callAddress);
+        codec->decode(r1->data(), entries);
+        expected = {{"08", {"even", "08"}}, {"09", {"odd", "09"}}};
+        BOOST_CHECK(entries == expected);
+    }
+
+    // count by the index only, and with the conditions of the other fields
+    {
+        ConditionTupleV320 lt = {(uint8_t)storage::Condition::Comparator::LT, "age", "03"};
+        BOOST_CHECK_EQUAL(countFunc({lt}), 6);
+        BOOST_CHECK_EQUAL(countFunc({ageEQ("05")}), 2);
+        ConditionTupleV320 name = {(uint8_t)storage::Condition::Comparator::EQ, "name", "even"};
+        BOOST_CHECK_EQUAL(countFunc({lt, name}), 4);
+        ConditionTupleV320 key = {(uint8_t)storage::Condition::Comparator::GE, "id", "10"};
+        BOOST_CHECK_EQUAL(countFunc({lt, key}), 3);
+    }
+
+    // the index follows update and remove
+    {
+        UpdateFieldTuple updateField = {"age", "50"};
+        auto r1 = updateByCondition(number++, {ageEQ("05")}, {0, 500}, {updateField}, callAddress);
+        BOOST_CHECK(r1->data().toBytes() == codec->encode(int32_t(2)));
+        BOOST_CHECK_EQUAL(countFunc({ageEQ("05")}), 0);
+        BOOST_CHECK_EQUAL(countFunc({ageEQ("50")}), 2);
+
+        updateField = {"age", "60"};
+        updateByKey(number++, "15", {updateField}, callAddress);
+        BOOST_CHECK_EQUAL(countFunc({ageEQ("50")}), 1);
+        BOOST_CHECK_EQUAL(countFunc({ageEQ("60")}), 1);
+
+        removeByKey(number++, "00", callAddress);
+        BOOST_CHECK_EQUAL(countFunc({ageEQ("00")}), 1);
+
+        ConditionTupleV320 ge = {(uint8_t)storage::Condition::Comparator::GE, "age", "50"};
+        r1 = removeByCondition(number++, {ge}, {0, 500}, callAddress);
+        BOOST_CHECK(r1->data().toBytes() == codec->encode(int32_t(2)));
+        BOOST_CHECK_EQUAL(countFunc({ge}), 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(indexKeyTest)
+{
+    std::string value("a\0b", 3);
+    auto key = TableIndex::encodeKey(1, value, "pk");
+    BOOST_CHECK_EQUAL(TableIndex::decodeKey(key), "pk");
+    BOOST_CHECK_EQUAL(TableIndex::decodeKey(TableIndex::encodeKey(0, "", "")), "");
+
+    // the order of the index keys is the order of the values
+    BOOST_CHECK(TableIndex::encodeKey(1, "a", "z") < TableIndex::encodeKey(1, value, "a"));
+    BOOST_CHECK(TableIndex::encodeKey(1, value, "z") < TableIndex::encodeKey(1, "a\1", "a"));
+    BOOST_CHECK(TableIndex::encodeKey(1, "ab", "z") < TableIndex::encodeKey(1, "b", "a"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace bcos::test
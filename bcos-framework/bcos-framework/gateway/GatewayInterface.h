@@ -82,6 +82,21 @@ public:
         bcos::crypto::NodeIDPtr _srcNodeID, bcos::crypto::NodeIDPtr _dstNodeID,
         bytesConstRef _payload, ErrorRespFunc _errorRespFunc) = 0;
 
+    /**
+     * @brief: send message to a single node with the ownership of the payload, the gateway in
+     * the same process sends it to the peers without copying it
+     * @param _payload: message content, must not be modified after the call
+     * @return void
+     */
+    virtual void asyncSendSharedMessageByNodeID(const std::string& _groupID, int _moduleID,
+        bcos::crypto::NodeIDPtr _srcNodeID, bcos::crypto::NodeIDPtr _dstNodeID,
+        std::shared_ptr<bytes> _payload, ErrorRespFunc _errorRespFunc)
+    {
+        asyncSendMessageByNodeID(_groupID, _moduleID, std::move(_srcNodeID),
+            std::move(_dstNodeID), bytesConstRef(_payload->data(), _payload->size()),
+            std::move(_errorRespFunc));
+    }
+
     /**
      * @brief: send message to multiple nodes
      * @param _groupID: groupID
@@ -49,6 +49,7 @@ public:
         feature_balance_precompiled,
         feature_balance_policy1,
         feature_paillier_add_raw,
+        feature_table_index,  // secondary indexes of the v3.2 user tables
     };
 
 private:
@@ -31,6 +31,7 @@
 #include <bcos-crypto/interfaces/crypto/CommonType.h>
 #include <bcos-utilities/Error.h>
 #include <gsl/span>
+#include <atomic>
 #include <map>
 
 
@@ -120,6 +121,58 @@ public:
         std::function<void(Error::Ptr, protocol::TransactionReceipt::ConstPtr, MerkleProofPtr)>
             _onGetTx) = 0;
 
+    /**
+     * @brief async get a batch of transaction receipts by transaction hash list
+     * @param _txHashList transaction hash list
+     * @param _onGetReceipts the receipts in the order of _txHashList, the error of the first
+     *                       receipt not found if any of them is missing; the default
+     *                       implementation queries them one by one
+     */
+    virtual void asyncGetBatchReceiptsByHashList(crypto::HashListPtr _txHashList,
+        std::function<void(Error::Ptr, std::vector<protocol::TransactionReceipt::ConstPtr>)>
+            _onGetReceipts)
+    {
+        if (_txHashList->empty())
+        {
+            _onGetReceipts(nullptr, {});
+            return;
+        }
+        struct Context
+        {
+            Context(size_t _size, decltype(_onGetReceipts) _callback)
+              : receipts(_size), errors(_size), pending(_size), callback(std::move(_callback))
+            {}
+            std::vector<protocol::TransactionReceipt::ConstPtr> receipts;
+            std::vector<Error::Ptr> errors;
+            std::atomic_size_t pending;
+            decltype(_onGetReceipts) callback;
+        };
+        auto context = std::make_shared<Context>(_txHashList->size(), std::move(_onGetReceipts));
+        for (size_t i = 0; i < _txHashList->size(); ++i)
+        {
+            asyncGetTransactionReceiptByHash((*_txHashList)[i], false,
+                [context, i](Error::Ptr _error, protocol::TransactionReceipt::ConstPtr _receipt,
+                    MerkleProofPtr) {
+                    context->errors[i] = std::move(_error);
+                    context->receipts[i] = std::move(_receipt);
+                    if (context->pending.fetch_sub(1) != 1)
+                    {
+                        return;
+                    }
+                    Error::Ptr error;
+                    for (size_t index = 0; index < context->receipts.size() && !error; ++index)
+                    {
+                        error = context->errors[index];
+                        if (!error && !context->receipts[index])
+                        {
+                            error = BCOS_ERROR_PTR(-1, "receipt not found");
+                        }
+                    }
+                    context->callback(std::move(error), std::move(context->receipts));
+                });
+        }
+    }
+
     /**
      * @brief async get total transaction count and latest block number
      * @param _callback callback totalTxCount, totalFailedTxCount, and latest block number
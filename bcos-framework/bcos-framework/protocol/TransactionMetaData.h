@@ -47,8 +47,32 @@ public:
 
     virtual std::string_view source() const = 0;
     virtual void setSource(std::string source) = 0;
+
+    // the advisory conflict key set by the sealer, see conflictKeyOf
+    virtual uint32_t conflictKey() const = 0;
+    virtual void setConflictKey(uint32_t conflictKey) = 0;
 };
 
+/**
+ * the transactions of the same sender to the same contract are expected to touch the same state,
+ * the parallel scheduler of the followers uses the keys in the proposal to plan its passes; the
+ * keys never change the result, a wrong key only costs a re-execution; 0 means no hint
+ */
+inline uint32_t conflictKeyOf(std::string_view to, std::string_view sender)
+{
+    // fnv-1a, stable across the nodes
+    uint32_t key = 2166136261U;
+    auto mix = [&key](auto const& bytes) {
+        for (auto byte : bytes)
+        {
+            key = (key ^ (uint8_t)byte) * 16777619U;
+        }
+    };
+    mix(to);
+    mix(sender);
+    return key == 0 ? 1 : key;
+}
+
 using TransactionMetaDataList = std::vector<TransactionMetaData::Ptr>;
 using TransactionMetaDataListPtr = std::shared_ptr<TransactionMetaDataList>;
 }  // namespace protocol
@@ -3,6 +3,7 @@
 #include "Common.h"
 #include "bcos-crypto/interfaces/crypto/Hash.h"
 #include "bcos-framework/protocol/Protocol.h"
+#include "bcos-framework/storage2/GetSize.h"
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/Error.h>
 #include <boost/archive/basic_archive.hpp>
@@ -289,6 +290,57 @@ public:
         return entryHash;
     }
 
+    // append the input hash() digests for blockVersion >= 3.1, false if the entry is clean and
+    // its hash is zero, so callers can hash many entries in one batch
+    bool appendHashInput(std::string_view table, std::string_view key, bcos::bytes& buffer) const
+    {
+        if (m_status != MODIFIED && m_status != DELETED)
+        {
+            return false;
+        }
+        buffer.insert(buffer.end(), table.begin(), table.end());
+        buffer.insert(buffer.end(), key.begin(), key.end());
+        if (m_status == MODIFIED)
+        {
+            auto data = get();
+            buffer.insert(buffer.end(), data.begin(), data.end());
+        }
+        return true;
+    }
+
+    // The bytes of the entry with its heap buffer, counted by the capacity of the storage2 caches
+    friend int64_t tag_invoke(
+        storage2::memory_storage::GetSize /*unused*/, Entry const& entry) noexcept
+    {
+        auto payload = std::visit(
+            [](auto const& value) -> int64_t {
+                namespace memory_storage = storage2::memory_storage;
+                using Value = std::remove_cvref_t<decltype(value)>;
+                if constexpr (std::same_as<Value, SBOBuffer>)
+                {
+                    return 0;
+                }
+                else if constexpr (std::same_as<Value, std::string>)
+                {
+                    return memory_storage::heapBytes(value);
+                }
+                else if constexpr (std::same_as<Value, std::shared_ptr<std::string>>)
+                {
+                    return value ? sizeof(std::string) + memory_storage::heapBytes(*value) : 0;
+                }
+                else if constexpr (memory_storage::IsSharedPtr<Value>::value)
+                {
+                    return value ? sizeof(*value) + value->capacity() : 0;
+                }
+                else
+                {
+                    return value.capacity();
+                }
+            },
+            entry.m_value);
+        return (int64_t)sizeof(Entry) + payload;
+    }
+
 private:
     [[nodiscard]] auto outputValueView(const ValueType& value) const& -> std::string_view
     {
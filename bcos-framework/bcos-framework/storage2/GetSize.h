@@ -0,0 +1,67 @@
+#pragma once
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace bcos::storage2::memory_storage
+{
+
+// clang-format off
+template <class Object>
+concept HasMemberSize = requires(Object object) { { object.size() } -> std::integral; };
+// clang-format on
+
+template <class Object>
+struct IsSharedPtr : std::false_type
+{
+};
+template <class Object>
+struct IsSharedPtr<std::shared_ptr<Object>> : std::true_type
+{
+};
+
+// The heap bytes of a string, 0 while it stays in the small string buffer
+inline int64_t heapBytes(std::string const& string) noexcept
+{
+    auto const* data = (const char*)string.data();
+    auto const* self = (const char*)std::addressof(string);
+    if (data >= self && data < self + sizeof(string))
+    {
+        return 0;
+    }
+    return (int64_t)string.capacity() + 1;
+}
+
+// 对象占用的字节数，包括堆上的数据，MemoryStorage的容量和内存统计以此计算
+// The bytes an object takes with its heap payload, the capacity and the memory statistics of
+// MemoryStorage count in it; a type holding heap data customizes it with a
+// tag_invoke(GetSize, Object const&) found by ADL
+inline constexpr struct GetSize
+{
+    template <class Object>
+    int64_t operator()(Object const& object) const
+    {
+        if constexpr (requires {
+                          { tag_invoke(*this, object) } -> std::integral;
+                      })
+        {
+            return tag_invoke(*this, object);
+        }
+        else if constexpr (IsSharedPtr<Object>::value)
+        {
+            return sizeof(Object) + (object ? (*this)(*object) : 0);
+        }
+        else if constexpr (HasMemberSize<Object>)
+        {
+            return sizeof(Object) + object.size();
+        }
+        else
+        {
+            return sizeof(Object);
+        }
+    }
+} getSize{};
+
+}  // namespace bcos::storage2::memory_storage
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "GetSize.h"
 #include "Storage.h"
 #include "bcos-task/AwaitableValue.h"
 #include "bcos-utilities/NullLock.h"
@@ -13,8 +14,10 @@
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index_container.hpp>
 #include <boost/throw_exception.hpp>
+#include <atomic>
 #include <functional>
 #include <mutex>
+#include <numeric>
 #include <thread>
 #include <type_traits>
 #include <utility>
@@ -23,11 +26,6 @@
 namespace bcos::storage2::memory_storage
 {
 
-// clang-format off
-template <class Object>
-concept HasMemberSize = requires(Object object) { { object.size() } -> std::integral; };
-// clang-format on
-
 struct Empty
 {
 };
@@ -42,6 +40,37 @@ enum Attribute : int
     CONCURRENT = 1 << 1,
     MRU = 1 << 2,
     LOGICAL_DELETION = 1 << 3,
+    // CLOCK淘汰，读只在共享锁下设置访问位，写和淘汰才需要独占锁
+    // Evict by CLOCK, a read only sets the reference bit under the shared lock, the exclusive lock
+    // is left to the writes and the eviction
+    CLOCK = 1 << 4,
+};
+
+// The reference bit of CLOCK, set by the concurrent readers and cleared by the eviction
+struct ReferenceBit
+{
+    mutable std::atomic_bool referenced = false;
+
+    ReferenceBit() = default;
+    ReferenceBit(const ReferenceBit& other) noexcept
+      : referenced(other.referenced.load(std::memory_order_relaxed))
+    {}
+    ReferenceBit& operator=(const ReferenceBit& other) noexcept
+    {
+        referenced.store(
+            other.referenced.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+    ~ReferenceBit() noexcept = default;
+
+    void touch() const noexcept
+    {
+        // Only write when it changes, the hot entries stay clean in the other cores' caches
+        if (!referenced.load(std::memory_order_relaxed))
+        {
+            referenced.store(true, std::memory_order_relaxed);
+        }
+    }
 };
 
 template <class KeyType, class ValueType = Empty, Attribute attribute = Attribute::NONE,
@@ -53,13 +82,16 @@ public:
     constexpr static bool withConcurrent = (attribute & Attribute::CONCURRENT) != 0;
     constexpr static bool withMRU = (attribute & Attribute::MRU) != 0;
     constexpr static bool withLogicalDeletion = (attribute & Attribute::LOGICAL_DELETION) != 0;
+    constexpr static bool withClock = (attribute & Attribute::CLOCK) != 0;
+    constexpr static bool withCapacity = withMRU || withClock;
 
 private:
     constexpr static unsigned BUCKETS_COUNT = 64;  // Magic number 64
     constexpr unsigned getBucketSize() { return withConcurrent ? BUCKETS_COUNT : 1; }
     static_assert(!withConcurrent || !std::is_void_v<BucketHasher>);
+    static_assert(!withMRU || !withClock);
 
-    constexpr static unsigned DEFAULT_CAPACITY = 32 * 1024 * 1024;  // For mru
+    constexpr static unsigned DEFAULT_CAPACITY = 32 * 1024 * 1024;  // For mru and clock
     using Mutex = tbb::spin_rw_mutex;
     using Lock = std::conditional_t<withConcurrent, typename tbb::spin_rw_mutex::scoped_lock,
         utilities::NullLock>;
@@ -70,12 +102,14 @@ private:
     {
         KeyType key;
         [[no_unique_address]] DataValueType value;
+        [[no_unique_address]] std::conditional_t<withClock, ReferenceBit, Empty> reference;
     };
 
     using IndexType = std::conditional_t<withOrdered,
         boost::multi_index::ordered_unique<boost::multi_index::member<Data, KeyType, &Data::key>>,
         boost::multi_index::hashed_unique<boost::multi_index::member<Data, KeyType, &Data::key>>>;
-    using Container = std::conditional_t<withMRU,
+    // The sequenced index is the recency list of mru and the ring of clock
+    using Container = std::conditional_t<withCapacity,
         boost::multi_index_container<Data,
             boost::multi_index::indexed_by<IndexType, boost::multi_index::sequenced<>>>,
         boost::multi_index_container<Data, boost::multi_index::indexed_by<IndexType>>>;
@@ -83,12 +117,12 @@ private:
     {
         Container container;
         [[no_unique_address]] BucketMutex mutex;  // For concurrent
-        [[no_unique_address]] std::conditional_t<withMRU, int64_t, Empty> capacity = {};  // For mru
+        [[no_unique_address]] std::conditional_t<withCapacity, int64_t, Empty> capacity = {};
     };
     using Buckets = std::conditional_t<withConcurrent, std::vector<Bucket>, std::array<Bucket, 1>>;
 
     Buckets m_buckets;
-    [[no_unique_address]] std::conditional_t<withMRU, int64_t, Empty> m_maxCapacity;
+    [[no_unique_address]] std::conditional_t<withCapacity, int64_t, Empty> m_maxCapacity;
 
     Bucket& getBucket(auto const& key) & noexcept
     {
@@ -126,21 +160,41 @@ private:
         while (bucket.capacity > m_maxCapacity && !bucket.container.empty())
         {
             auto const& item = index.front();
-            bucket.capacity -= getSize(item.value);
+            bucket.capacity -= getSize(item.key) + getValueSize(item.value);
             index.pop_front();
         }
     }
 
-    static int64_t getSize(auto const& object)
+    void evictByClock(Bucket& bucket)
+        requires withClock
     {
-        using ObjectType = std::remove_cvref_t<decltype(object)>;
-        if constexpr (HasMemberSize<ObjectType>)
+        auto& index = bucket.container.template get<1>();
+        while (bucket.capacity > m_maxCapacity && !bucket.container.empty())
         {
-            return object.size();
+            // Second chance for the referenced ones, every pass clears a bit so it ends
+            auto it = index.begin();
+            if (it->reference.referenced.load(std::memory_order_relaxed))
+            {
+                it->reference.referenced.store(false, std::memory_order_relaxed);
+                index.relocate(index.end(), it);
+                continue;
+            }
+            bucket.capacity -= getSize(it->key) + getValueSize(it->value);
+            index.erase(it);
         }
+    }
 
-        // Treat any no-size() object as trivial, TODO: fix it
-        return sizeof(ObjectType);
+    static int64_t getValueSize(DataValueType const& value)
+    {
+        if constexpr (withLogicalDeletion)
+        {
+            auto const* existsValue = std::get_if<ValueType>(std::addressof(value));
+            return existsValue ? getSize(*existsValue) : 0;
+        }
+        else
+        {
+            return getSize(value);
+        }
     }
 
     friend auto tag_invoke(
@@ -174,7 +228,7 @@ public:
         {
             m_buckets = decltype(m_buckets)(std::min(buckets, getBucketSize()));
         }
-        if constexpr (withMRU)
+        if constexpr (withCapacity)
         {
             m_maxCapacity = DEFAULT_CAPACITY;
         }
@@ -186,7 +240,7 @@ public:
     ~MemoryStorage() noexcept = default;
 
     void setMaxCapacity(int64_t capacity)
-        requires withMRU
+        requires withCapacity
     {
         m_maxCapacity = capacity;
     }
@@ -231,6 +285,10 @@ public:
                     lock.upgrade_to_writer();
                     storage.updateMRUAndCheck(bucket, it);
                 }
+                else if constexpr (std::decay_t<decltype(storage)>::withClock)
+                {
+                    it->reference.touch();
+                }
             }
             else
             {
@@ -255,6 +313,10 @@ public:
             {
                 storage.updateMRUAndCheck(bucket, it);
             }
+            else if constexpr (std::decay_t<decltype(storage)>::withClock)
+            {
+                it->reference.touch();
+            }
 
             if constexpr (std::decay_t<decltype(storage)>::withLogicalDeletion)
             {
@@ -280,9 +342,9 @@ public:
             Lock lock(bucket.mutex, true);
             auto const& index = bucket.container.template get<0>();
 
-            std::conditional_t<std::decay_t<decltype(storage)>::withMRU, int64_t, Empty>
+            std::conditional_t<std::decay_t<decltype(storage)>::withCapacity, int64_t, Empty>
                 updatedCapacity;
-            if constexpr (std::decay_t<decltype(storage)>::withMRU)
+            if constexpr (std::decay_t<decltype(storage)>::withCapacity)
             {
                 updatedCapacity = getSize(value);
             }
@@ -298,10 +360,13 @@ public:
             }
             if (it != index.end() && std::equal_to<Key>{}(it->key, key))
             {
-                if constexpr (std::decay_t<decltype(storage)>::withMRU)
+                if constexpr (std::decay_t<decltype(storage)>::withCapacity)
+                {
+                    updatedCapacity -= getValueSize(it->value);
+                }
+                if constexpr (std::decay_t<decltype(storage)>::withClock)
                 {
-                    auto& existsValue = it->value;
-                    updatedCapacity -= getSize(existsValue);
+                    it->reference.touch();
                 }
 
                 bucket.container.modify(
@@ -311,6 +376,10 @@ public:
             }
             else
             {
+                if constexpr (std::decay_t<decltype(storage)>::withCapacity)
+                {
+                    updatedCapacity += getSize(key);
+                }
                 it = bucket.container.emplace_hint(
                     it, Data{.key = KeyType(std::forward<decltype(key)>(key)),
                             .value = std::forward<decltype(value)>(value)});
@@ -321,6 +390,11 @@ public:
                 bucket.capacity += updatedCapacity;
                 storage.updateMRUAndCheck(bucket, it);
             }
+            else if constexpr (std::decay_t<decltype(storage)>::withClock)
+            {
+                bucket.capacity += updatedCapacity;
+                storage.evictByClock(bucket);
+            }
         }
 
         return {};
@@ -349,9 +423,13 @@ public:
                     }
                 }
 
-                if constexpr (std::decay_t<decltype(storage)>::withMRU)
+                if constexpr (std::decay_t<decltype(storage)>::withCapacity)
                 {
-                    bucket.capacity -= getSize(existsValue);
+                    // The key stays with the deleted mark
+                    bucket.capacity -= getValueSize(existsValue) +
+                                       (std::decay_t<decltype(storage)>::withLogicalDeletion ?
+                                               0 :
+                                               getSize(it->key));
                 }
 
                 if constexpr (std::decay_t<decltype(storage)>::withLogicalDeletion)
@@ -370,6 +448,10 @@ public:
                 if constexpr (std::decay_t<decltype(storage)>::withLogicalDeletion)
                 {
                     it = bucket.container.emplace_hint(it, Data{.key = key, .value = Deleted{}});
+                    if constexpr (std::decay_t<decltype(storage)>::withCapacity)
+                    {
+                        bucket.capacity += getSize(it->key);
+                    }
                 }
             }
         }
@@ -425,6 +507,39 @@ public:
 
         return allEmpty;
     }
+
+    // The keys and values of each bucket sized by getSize, kept up to date with a capacity, or it
+    // walks every entry so call it on a storage that no longer changes, e.g. an immutable layer
+    std::vector<int64_t> bucketBytes()
+    {
+        std::vector<int64_t> result;
+        result.reserve(m_buckets.size());
+        for (auto& bucket : m_buckets)
+        {
+            Lock lock(bucket.mutex, false);
+            if constexpr (withCapacity)
+            {
+                result.emplace_back(bucket.capacity);
+            }
+            else
+            {
+                int64_t total = 0;
+                for (auto const& data : bucket.container)
+                {
+                    total += getSize(data.key) + getValueSize(data.value);
+                }
+                result.emplace_back(total);
+            }
+        }
+
+        return result;
+    }
+
+    int64_t bytes()
+    {
+        auto buckets = bucketBytes();
+        return std::accumulate(buckets.begin(), buckets.end(), int64_t(0));
+    }
 };
 
 }  // namespace bcos::storage2::memory_storage
\ No newline at end of file
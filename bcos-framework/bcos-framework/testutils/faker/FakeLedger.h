@@ -171,7 +171,7 @@ public:
         {
             auto tx = blockTxs ? blockTxs->at(i) : block->transaction(i);
             auto txHash = tx->hash();
-            std::shared_ptr<bcos::bytes> txData;
+            auto txData = std::make_shared<bcos::bytes>();
             tx->encode(*txData);
             m_txsHashToData[txHash] = txData;
         }
@@ -1,5 +1,6 @@
 #pragma once
 #include "../storage/Entry.h"
+#include "../storage2/GetSize.h"
 #include "bcos-utilities/Common.h"
 #include "bcos-utilities/Exceptions.h"
 #include "bcos-utilities/Overloaded.h"
@@ -63,6 +64,13 @@ public:
     }
     const char* data() const& noexcept { return m_tableAndKey.data(); }
     size_t size() const noexcept { return m_tableAndKey.size(); }
+
+    friend int64_t tag_invoke(
+        storage2::memory_storage::GetSize /*unused*/, StateKey const& stateKey) noexcept
+    {
+        return (int64_t)sizeof(StateKey) +
+               storage2::memory_storage::heapBytes(stateKey.m_tableAndKey);
+    }
 };
 
 class StateKeyView
@@ -20,8 +20,12 @@
 #pragma once
 #include "../Common.h"
 #include <bcos-crypto/interfaces/crypto/KeyInterface.h>
+#include <bcos-utilities/BinaryLog.h>
 
 #define TXPOOL_LOG(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE("TXPOOL")
+// deferred-format TXPOOL_LOG for the hot paths, see BCOS_BINARY_LOG
+#define TXPOOL_BINARY_LOG(LEVEL, ...) BCOS_BINARY_LOG(LEVEL, "TXPOOL", __VA_ARGS__)
+#define TXPOOL_METRIC_LOG(LEVEL, ...) BCOS_BINARY_LOG(LEVEL, "TXPOOL", "[METRIC]" __VA_ARGS__)
 
 namespace bcos
 {
@@ -148,7 +148,8 @@ BOOST_AUTO_TEST_CASE(feature)
         "feature_balance",
         "feature_balance_precompiled",
         "feature_balance_policy1",
-        "feature_paillier_add_raw"
+        "feature_paillier_add_raw",
+        "feature_table_index"
     };
     // clang-format on
     for (size_t i = 0; i < keys.size(); ++i)
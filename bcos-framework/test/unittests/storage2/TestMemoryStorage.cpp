@@ -139,11 +139,11 @@ BOOST_AUTO_TEST_CASE(mru)
 {
     task::syncWait([]() -> task::Task<void> {
         MemoryStorage<int, storage::Entry, Attribute(ORDERED | MRU), std::hash<int>> storage(1);
-        storage.setMaxCapacity(1000);
 
         // write 10 100byte value
         storage::Entry entry;
         entry.set(std::string(100, 'a'));
+        storage.setMaxCapacity((getSize(0) + getSize(entry)) * 10);
         co_await storage2::writeSome(
             storage, RANGES::iota_view<int, int>(0, 10), RANGES::repeat_view(entry));
 
@@ -172,6 +172,66 @@ BOOST_AUTO_TEST_CASE(mru)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(clock)
+{
+    task::syncWait([]() -> task::Task<void> {
+        MemoryStorage<int, storage::Entry, Attribute(ORDERED | CLOCK)> storage;
+        storage::Entry entry;
+        entry.set(std::string(100, 'a'));
+        storage.setMaxCapacity((getSize(0) + getSize(entry)) * 10);
+
+        co_await storage2::writeSome(
+            storage, RANGES::iota_view<int, int>(0, 10), RANGES::repeat_view(entry));
+        // 0 - 4 get a second chance
+        auto values = co_await storage2::readSome(storage, RANGES::iota_view<int, int>(0, 5));
+        for (auto&& value : values)
+        {
+            BOOST_REQUIRE(value);
+        }
+
+        co_await storage2::writeSome(
+            storage, RANGES::iota_view<int, int>(10, 15), RANGES::repeat_view(entry));
+        for (auto i : RANGES::views::iota(0, 15))
+        {
+            auto value = co_await storage2::readOne(storage, i);
+            BOOST_CHECK_EQUAL(value.has_value(), i < 5 || i >= 10);
+        }
+        BOOST_CHECK_EQUAL(storage.bytes(), (getSize(0) + getSize(entry)) * 10);
+    }());
+}
+
+BOOST_AUTO_TEST_CASE(entrySize)
+{
+    task::syncWait([]() -> task::Task<void> {
+        storage::Entry small;
+        small.set("small");
+        storage::Entry large;
+        large.set(std::string(1000, 'a'));
+        BOOST_CHECK_EQUAL(getSize(small), (int64_t)sizeof(storage::Entry));
+        BOOST_CHECK_GE(getSize(large), (int64_t)sizeof(storage::Entry) + 1000);
+        BOOST_CHECK_EQUAL(getSize(std::make_shared<storage::Entry>(large)),
+            (int64_t)sizeof(std::shared_ptr<storage::Entry>) + getSize(large));
+
+        MemoryStorage<int, storage::Entry, Attribute(CONCURRENT | MRU), std::hash<int>> storage(4);
+        co_await storage2::writeSome(
+            storage, RANGES::iota_view<int, int>(0, 8), RANGES::repeat_view(large));
+        auto buckets = storage.bucketBytes();
+        BOOST_CHECK_EQUAL(buckets.size(), 4);
+        BOOST_CHECK_EQUAL(storage.bytes(), (getSize(0) + getSize(large)) * 8);
+
+        co_await storage2::writeOne(storage, 0, small);
+        co_await storage2::removeOne(storage, 1);
+        BOOST_CHECK_EQUAL(storage.bytes(), (getSize(0) + getSize(large)) * 6 + getSize(0) +
+                                               getSize(small));
+
+        MemoryStorage<int, storage::Entry, Attribute(ORDERED | LOGICAL_DELETION)> layer;
+        co_await storage2::writeSome(
+            layer, RANGES::iota_view<int, int>(0, 8), RANGES::repeat_view(large));
+        co_await storage2::removeOne(layer, 1);
+        BOOST_CHECK_EQUAL(layer.bytes(), (getSize(0) + getSize(large)) * 7 + getSize(0));
+    }());
+}
+
 BOOST_AUTO_TEST_CASE(logicalDeletion)
 {
     task::syncWait([]() -> task::Task<void> {
@@ -24,6 +24,7 @@
 #include <bcos-front/FrontService.h>
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/Exceptions.h>
+#include <bcos-utilities/Metrics.h>
 #include <boost/uuid/random_generator.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <random>
@@ -505,30 +506,7 @@ void FrontService::onReceiveMessage(const std::string& _groupID,
                          << LOG_KV("groupID", _groupID) << LOG_KV("nodeID", _nodeID->hex())
                          << LOG_KV("length", _data.size());
 
-        if (message->isResponse())
-        {
-            handleCallback(nullptr, message->payload(), uuid, moduleID, _nodeID);
-        }
-        else
-        {
-            auto it = m_moduleID2MessageDispatcher.find(moduleID);
-            if (it != m_moduleID2MessageDispatcher.end())
-            {
-                auto callback = it->second;
-                // construct shared_ptr<bytes> from message->payload() first for
-                // thead safe
-                bytes buffer(message->payload().begin(), message->payload().end());
-                m_asyncGroup.run([uuid, callback = std::move(callback), buffer = std::move(buffer),
-                                     message = std::move(message), _nodeID] {
-                    callback(_nodeID, uuid, bytesConstRef(buffer.data(), buffer.size()));
-                });
-            }
-            else
-            {
-                FRONT_LOG(WARNING) << LOG_DESC("unable find the register module message dispather")
-                                   << LOG_KV("moduleID", moduleID) << LOG_KV("uuid", uuid);
-            }
-        }
+        dispatchMessage(moduleID, uuid, message->isResponse(), _nodeID, message->payload());
     }
     catch (const std::exception& e)
     {
@@ -544,6 +522,40 @@ void FrontService::onReceiveMessage(const std::string& _groupID,
     }
 }
 
+/**
+ * @brief: dispatch a decoded message to the waiting callback or the module
+ * @param _moduleID: moduleID
+ * @param _uuid: uuid identify this message
+ * @param _isResponse: if the message is a response
+ * @param _nodeID: the node send the message
+ * @param _payload: message payload
+ * @return void
+ */
+void FrontService::dispatchMessage(int _moduleID, const std::string& _uuid, bool _isResponse,
+    const bcos::crypto::NodeIDPtr& _nodeID, bytesConstRef _payload)
+{
+    if (_isResponse)
+    {
+        handleCallback(nullptr, _payload, _uuid, _moduleID, _nodeID);
+        return;
+    }
+    auto it = m_moduleID2MessageDispatcher.find(_moduleID);
+    if (it == m_moduleID2MessageDispatcher.end())
+    {
+        FRONT_LOG(WARNING) << LOG_DESC("unable find the register module message dispather")
+                           << LOG_KV("moduleID", _moduleID) << LOG_KV("uuid", _uuid);
+        return;
+    }
+    auto callback = it->second;
+    // construct shared_ptr<bytes> from message->payload() first for
+    // thead safe
+    bytes buffer(_payload.begin(), _payload.end());
+    m_asyncGroup.run(
+        [uuid = _uuid, callback = std::move(callback), buffer = std::move(buffer), _nodeID] {
+            callback(_nodeID, uuid, bytesConstRef(buffer.data(), buffer.size()));
+        });
+}
+
 /**
  * @brief: receive broadcast message from gateway
  * @param _groupID: groupID
@@ -572,6 +584,31 @@ void FrontService::sendMessage(int _moduleID, bcos::crypto::NodeIDPtr _nodeID,
     const std::string& _uuid, bytesConstRef _data, bool isResponse,
     ReceiveMsgFunc _receiveMsgCallback)
 {
+    // the message to this node never leaves the process, dispatch it without the encoding and
+    // the gateway
+    if (_nodeID && m_nodeID && _nodeID->data() == m_nodeID->data())
+    {
+        static auto& localMessages = bcos::metrics::Registry::instance().counter(
+            "bcos_front_local_messages_total", "messages dispatched to this node without encoding");
+        localMessages.inc();
+        try
+        {
+            dispatchMessage(_moduleID, _uuid, isResponse, m_nodeID, _data);
+        }
+        catch (const std::exception& e)
+        {
+            FRONT_LOG(ERROR) << LOG_DESC("sendMessage to self failed") << LOG_KV("uuid", _uuid)
+                             << LOG_KV("failed", boost::diagnostic_information(e));
+        }
+        if (_receiveMsgCallback)
+        {
+            m_asyncGroup.run([_receiveMsgCallback = std::move(_receiveMsgCallback)]() {
+                _receiveMsgCallback(nullptr);
+            });
+        }
+        return;
+    }
+
     auto message = messageFactory()->buildMessage();
     message->setModuleID(_moduleID);
     message->setUuid(std::make_shared<bytes>(_uuid.begin(), _uuid.end()));
@@ -584,9 +621,10 @@ void FrontService::sendMessage(int _moduleID, bcos::crypto::NodeIDPtr _nodeID,
     auto buffer = std::make_shared<bytes>();
     message->encode(*buffer.get());
 
-    // call gateway interface to send the message
-    m_gatewayInterface->asyncSendMessageByNodeID(m_groupID, _moduleID, m_nodeID, _nodeID,
-        bytesConstRef(buffer->data(), buffer->size()), [_receiveMsgCallback](Error::Ptr _error) {
+    // call gateway interface to send the message, the encoded buffer is handed over so the remote
+    // path sends it without another copy
+    m_gatewayInterface->asyncSendSharedMessageByNodeID(m_groupID, _moduleID, m_nodeID, _nodeID,
+        std::move(buffer), [_receiveMsgCallback](Error::Ptr _error) {
             if (_receiveMsgCallback)
             {
                 _receiveMsgCallback(_error);
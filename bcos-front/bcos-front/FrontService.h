@@ -264,6 +264,9 @@ protected:
         std::string const& _uuid, int _moduleID, bcos::crypto::NodeIDPtr _nodeID);
     void notifyGroupNodeInfo(
         const std::string& _groupID, bcos::gateway::GroupNodeInfo::Ptr _groupNodeInfo);
+    // dispatch a decoded message to the waiting callback or the registered module
+    void dispatchMessage(int _moduleID, const std::string& _uuid, bool _isResponse,
+        const bcos::crypto::NodeIDPtr& _nodeID, bytesConstRef _payload);
 
     virtual void protocolNegotiate(bcos::gateway::GroupNodeInfo::Ptr _groupNodeInfo);
 
@@ -179,6 +179,34 @@ BOOST_AUTO_TEST_CASE(testFrontService_asyncSendMessageByNodeID_callback)
     }
 }
 
+BOOST_AUTO_TEST_CASE(testFrontService_sendToSelf)
+{
+    auto frontService = buildFrontService();
+    auto selfNodeID = frontService->nodeID();
+    std::string data(1000, 's');
+    int moduleID = 2000;
+
+    // the request and the response are dispatched without the gateway
+    frontService->registerModuleMessageDispatcher(moduleID,
+        [&frontService, moduleID](bcos::crypto::NodeIDPtr _nodeID, const std::string& _id,
+            bytesConstRef _data) {
+            BOOST_CHECK_EQUAL(_nodeID->hex(), frontService->nodeID()->hex());
+            frontService->asyncSendResponse(_id, moduleID, _nodeID, _data, nullptr);
+        });
+    std::promise<bool> p;
+    frontService->asyncSendMessageByNodeID(moduleID, selfNodeID,
+        bytesConstRef((unsigned char*)data.data(), data.size()), 1000,
+        [&p, &data, selfNodeID](Error::Ptr _error, bcos::crypto::NodeIDPtr _nodeID,
+            bytesConstRef _data, const std::string&, std::function<void(bytesConstRef)>) {
+            BOOST_CHECK(_error == nullptr);
+            BOOST_CHECK_EQUAL(_nodeID->hex(), selfNodeID->hex());
+            BOOST_CHECK_EQUAL(std::string(_data.begin(), _data.end()), data);
+            p.set_value(true);
+        });
+    p.get_future().get();
+    BOOST_CHECK(frontService->callback().empty());
+}
+
 BOOST_AUTO_TEST_CASE(testFrontService_asyncSendMessageByNodeIDcmak_timeout)
 {
     auto frontService = buildFrontService();
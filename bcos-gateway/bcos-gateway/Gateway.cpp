@@ -39,6 +39,7 @@
 #include <bcos-gateway/libp2p/P2PMessage.h>
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/Exceptions.h>
+#include <bcos-utilities/Metrics.h>
 #include <json/json.h>
 #include <algorithm>
 #include <random>
@@ -162,6 +163,23 @@ void Gateway::asyncGetGroupNodeInfo(
 void Gateway::asyncSendMessageByNodeID(const std::string& _groupID, int _moduleID,
     NodeIDPtr _srcNodeID, NodeIDPtr _dstNodeID, bytesConstRef _payload,
     ErrorRespFunc _errorRespFunc)
+{
+    sendMessageByNodeID(_groupID, _moduleID, std::move(_srcNodeID), std::move(_dstNodeID),
+        _payload, nullptr, std::move(_errorRespFunc));
+}
+
+void Gateway::asyncSendSharedMessageByNodeID(const std::string& _groupID, int _moduleID,
+    NodeIDPtr _srcNodeID, NodeIDPtr _dstNodeID, std::shared_ptr<bytes> _payload,
+    ErrorRespFunc _errorRespFunc)
+{
+    auto payload = bytesConstRef(_payload->data(), _payload->size());
+    sendMessageByNodeID(_groupID, _moduleID, std::move(_srcNodeID), std::move(_dstNodeID),
+        payload, std::move(_payload), std::move(_errorRespFunc));
+}
+
+void Gateway::sendMessageByNodeID(const std::string& _groupID, int _moduleID,
+    NodeIDPtr _srcNodeID, NodeIDPtr _dstNodeID, bytesConstRef _payload,
+    std::shared_ptr<bytes> _ownedPayload, ErrorRespFunc _errorRespFunc)
 {
     auto p2pIDs =
         m_gatewayNodeManager->peersRouterTable()->queryP2pIDs(_groupID, _dstNodeID->hex());
@@ -196,7 +214,8 @@ void Gateway::asyncSendMessageByNodeID(const std::string& _groupID, int _moduleI
 
     message->setPacketType(GatewayMessageType::PeerToPeerMessage);
     message->setSeq(m_p2pInterface->messageFactory()->newSeq());
-    message->setPayload(std::make_shared<bytes>(_payload.begin(), _payload.end()));
+    message->setPayload(_ownedPayload ? std::move(_ownedPayload) :
+                                        std::make_shared<bytes>(_payload.begin(), _payload.end()));
     message->setExtAttributes(msgExtAttr);
 
     auto options = message->options();
@@ -205,6 +224,13 @@ void Gateway::asyncSendMessageByNodeID(const std::string& _groupID, int _moduleI
     options->setSrcNodeID(_srcNodeID->encode());
     options->dstNodeIDs().push_back(_dstNodeID->encode());
 
+    static auto& sentMessages = bcos::metrics::Registry::instance().counter(
+        "bcos_gateway_sent_messages_total", "p2p messages sent to the peers");
+    static auto& sentBytes = bcos::metrics::Registry::instance().counter(
+        "bcos_gateway_sent_bytes_total", "payload bytes of the p2p messages sent to the peers");
+    sentMessages.inc();
+    sentBytes.inc(_payload.size());
+
     auto retry = std::make_shared<Retry>(std::move(_srcNodeID), std::move(_dstNodeID),
         std::move(message), m_p2pInterface, std::move(_errorRespFunc), _moduleID);
     retry->insertP2pIDs(p2pIDs);
@@ -372,9 +398,16 @@ void Gateway::onReceiveP2PMessage(
         return;
     }
 
+    static auto& receivedMessages = bcos::metrics::Registry::instance().counter(
+        "bcos_gateway_received_messages_total", "p2p messages received from the peers");
+    static auto& receivedBytes = bcos::metrics::Registry::instance().counter(
+        "bcos_gateway_received_bytes_total",
+        "payload bytes of the p2p messages received from the peers");
     auto options = _msg->options();
-    auto msgPayload = _msg->payload();
-    auto payload = bytesConstRef(msgPayload->data(), msgPayload->size());
+    // references the session receive buffer, _msg keeps it alive until the callback
+    auto payload = _msg->payloadView();
+    receivedMessages.inc();
+    receivedBytes.inc(payload.size());
     // groupID
     auto groupID = options->groupID();
     // moduleID
@@ -460,7 +493,7 @@ void Gateway::onReceiveBroadcastMessage(
     }
 
     auto options = _msg->options();
-    auto payload = _msg->payload();
+    auto payload = _msg->payloadView();
 
     // groupID
     auto groupID = options->groupID();
@@ -471,8 +504,7 @@ void Gateway::onReceiveBroadcastMessage(
     // Notice: moduleID not set the previous version, try to decode from front message
     if (moduleID == 0)
     {
-        moduleID =
-            front::FrontMessage::tryDecodeModuleID(bytesConstRef(payload->data(), payload->size()));
+        moduleID = front::FrontMessage::tryDecodeModuleID(payload);
     }
 
     if (moduleID == 0)
@@ -480,7 +512,7 @@ void Gateway::onReceiveBroadcastMessage(
         GATEWAY_LOG(TRACE) << LOG_BADGE("onReceiveBroadcastMessage")
                            << LOG_DESC("front message module id not found")
                            << LOG_KV("groupID", groupID) << LOG_KV("moduleID", moduleID)
-                           << LOG_KV("seq", _msg->seq()) << LOG_KV("payload size", payload->size());
+                           << LOG_KV("seq", _msg->seq()) << LOG_KV("payload size", payload.size());
     }
 
     // Readonly filter
@@ -512,8 +544,8 @@ void Gateway::onReceiveBroadcastMessage(
         m_gatewayNodeManager->keyFactory()->createKey(*(_msg->options()->srcNodeID()));
 
     auto type = _msg->ext();
-    m_gatewayNodeManager->localRouterTable()->asyncBroadcastMsg(type, groupID, moduleID,
-        srcNodeIDPtr, bytesConstRef(_msg->payload()->data(), _msg->payload()->size()));
+    m_gatewayNodeManager->localRouterTable()->asyncBroadcastMsg(
+        type, groupID, moduleID, srcNodeIDPtr, payload);
 }
 
 void bcos::gateway::Gateway::enableReadOnlyMode()
@@ -135,9 +135,9 @@ public:
 
             try
             {
-                auto payload = message->payload();
+                auto payload = message->payloadView();
                 int respCode =
-                    boost::lexical_cast<int>(std::string(payload->begin(), payload->end()));
+                    boost::lexical_cast<int>(std::string(payload.begin(), payload.end()));
                 // the peer gateway not response not ok ,it means the gateway not dispatch the
                 // message successfully,find another gateway and try again
                 if (respCode != bcos::protocol::CommonError::SUCCESS)
@@ -164,8 +164,8 @@ public:
             catch (const std::exception& e)
             {
                 GATEWAY_LOG(ERROR) << LOG_BADGE("trySendMessage and receive response exception")
-                                   << LOG_KV("payload", std::string(message->payload()->begin(),
-                                                            message->payload()->end()))
+                                   << LOG_KV("payload", std::string(message->payloadView().begin(),
+                                                            message->payloadView().end()))
                                    << LOG_KV("packetType", message->packetType())
                                    << LOG_KV("src", message->options() ?
                                                         toHex(*(message->options()->srcNodeID())) :
@@ -253,6 +253,9 @@ public:
     void asyncSendMessageByNodeID(const std::string& _groupID, int _moduleID,
         bcos::crypto::NodeIDPtr _srcNodeID, bcos::crypto::NodeIDPtr _dstNodeID,
         bytesConstRef _payload, ErrorRespFunc _errorRespFunc) override;
+    void asyncSendSharedMessageByNodeID(const std::string& _groupID, int _moduleID,
+        bcos::crypto::NodeIDPtr _srcNodeID, bcos::crypto::NodeIDPtr _dstNodeID,
+        std::shared_ptr<bytes> _payload, ErrorRespFunc _errorRespFunc) override;
 
     /**
      * @brief: send message to multiple nodes
@@ -362,6 +365,12 @@ protected:
     bool checkGroupInfo(bcos::group::GroupInfo::Ptr _groupInfo);
 
 private:
+    // _ownedPayload holds _payload when the caller handed it over, null if it must be copied
+    void sendMessageByNodeID(const std::string& _groupID, int _moduleID,
+        bcos::crypto::NodeIDPtr _srcNodeID, bcos::crypto::NodeIDPtr _dstNodeID,
+        bytesConstRef _payload, std::shared_ptr<bytes> _ownedPayload,
+        ErrorRespFunc _errorRespFunc);
+
     std::string m_gatewayServiceName;
     GatewayConfig::Ptr m_gatewayConfig;
     // p2p service interface
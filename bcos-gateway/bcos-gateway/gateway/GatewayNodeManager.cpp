@@ -106,7 +106,7 @@ void GatewayNodeManager::onReceiveStatusSeq(
         return;
     }
     auto statusSeq = boost::asio::detail::socket_ops::network_to_host_long(
-        *((uint32_t*)_msg->payload()->data()));
+        *((uint32_t*)_msg->payloadView().data()));
     auto const& from = (_msg->srcP2PNodeID().size() > 0) ? _msg->srcP2PNodeID() : _session->p2pID();
     auto statusSeqChanged = statusChanged(from, statusSeq);
     if (!statusSeqChanged)
@@ -141,7 +141,7 @@ void GatewayNodeManager::onReceiveNodeStatus(
         return;
     }
     auto gatewayNodeStatus = m_gatewayNodeStatusFactory->createGatewayNodeStatus();
-    gatewayNodeStatus->decode(bytesConstRef(_msg->payload()->data(), _msg->payload()->size()));
+    gatewayNodeStatus->decode(_msg->payloadView());
     auto const& from = (!_msg->srcP2PNodeID().empty()) ? _msg->srcP2PNodeID() : _session->p2pID();
 
     NODE_MANAGER_LOG(INFO) << LOG_DESC("onReceiveNodeStatus") << LOG_KV("from", from)
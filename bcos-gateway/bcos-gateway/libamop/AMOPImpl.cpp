@@ -501,7 +501,7 @@ void AMOPImpl::dispatcherAMOPMessage(
         return;
     }
     // zero copy overhead
-    auto amopMessage = m_messageFactory->buildMessage(ref(*_message->payload()));
+    auto amopMessage = m_messageFactory->buildMessage(_message->payloadView());
     auto amopMsgType = amopMessage->type();
     auto fromNodeID =
         _message->srcP2PNodeID().empty() ? _session->p2pID() : _message->srcP2PNodeID();
@@ -131,6 +131,9 @@ public:
         bcos::bytes& _buffer) = 0;
 
     virtual int32_t decode(const bytesConstRef& _buffer) = 0;
+    // the buffer passed to the next decode is held by _owner, the decoded message may reference it
+    // instead of copying out of it
+    virtual void setBufferOwner(std::shared_ptr<bytes> /*_owner*/) {}
 
     virtual bool encode(EncodedMessage& _buffer) = 0;
 
@@ -10,6 +10,7 @@
 #include "bcos-gateway/libnetwork/Message.h"
 #include "bcos-utilities/BoostLog.h"
 #include "bcos-utilities/CompositeBuffer.h"
+#include "bcos-utilities/Metrics.h"
 #include <bcos-gateway/libnetwork/ASIOInterface.h>  // for ASIOIn...
 #include <bcos-gateway/libnetwork/Common.h>         // for SESSIO...
 #include <bcos-gateway/libnetwork/Host.h>           // for Host
@@ -25,6 +26,52 @@
 using namespace bcos;
 using namespace bcos::gateway;
 
+RecvBufferPool& RecvBufferPool::instance()
+{
+    static RecvBufferPool pool;
+    return pool;
+}
+
+std::shared_ptr<bytes> RecvBufferPool::acquire(size_t _size)
+{
+    static auto& allocated = metrics::Registry::instance().counter(
+        "bcos_gateway_recv_buffers_allocated_total", "session receive buffers allocated");
+    static auto& reused = metrics::Registry::instance().counter(
+        "bcos_gateway_recv_buffers_reused_total", "session receive buffers taken from the pool");
+
+    std::unique_ptr<bytes> buffer;
+    {
+        std::unique_lock lock(m_mutex);
+        auto it = m_freeBuffers.find(_size);
+        if (it != m_freeBuffers.end() && !it->second.empty())
+        {
+            buffer = std::move(it->second.back());
+            it->second.pop_back();
+        }
+    }
+    if (buffer)
+    {
+        reused.inc();
+    }
+    else
+    {
+        allocated.inc();
+        buffer = std::make_unique<bytes>(_size);
+    }
+    return {buffer.release(), [this](bytes* _buffer) { release(_buffer); }};
+}
+
+void RecvBufferPool::release(bytes* _buffer)
+{
+    std::unique_ptr<bytes> buffer(_buffer);
+    std::unique_lock lock(m_mutex);
+    auto& freeBuffers = m_freeBuffers[buffer->size()];
+    if (freeBuffers.size() < MAX_FREE_BUFFERS)
+    {
+        freeBuffers.push_back(std::move(buffer));
+    }
+}
+
 
 Session::Session(size_t _recvBufferSize, bool _forceSize)
   : m_maxRecvBufferSize(_recvBufferSize < MIN_SESSION_RECV_BUFFER_SIZE ?
@@ -549,6 +596,8 @@ void Session::doRead()
                     {
                         auto writeBuffer = recvBuffer.asWriteBuffer();
                         auto readBuffer = recvBuffer.asReadBuffer();
+                        // the payload may reference the read buffer instead of being copied
+                        message->setBufferOwner(recvBuffer.buffer());
                         // Note: the decode function may throw exception
                         ssize_t result = message->decode(readBuffer);
                         if (result > 0)
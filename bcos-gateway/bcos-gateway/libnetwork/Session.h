@@ -24,7 +24,9 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace bcos
 {
@@ -33,13 +35,33 @@ namespace gateway
 class Host;
 class SocketFace;
 
+// process wide free lists of the session receive buffers, by size
+class RecvBufferPool
+{
+public:
+    static RecvBufferPool& instance();
+
+    // the buffer returns to the pool when the session and the messages decoded in place from it
+    // have all released it
+    std::shared_ptr<bytes> acquire(size_t _size);
+
+private:
+    void release(bytes* _buffer);
+
+    // idle buffers kept per size, 16M for the default 512K buffer
+    constexpr static size_t MAX_FREE_BUFFERS = 32;
+
+    std::mutex m_mutex;
+    std::unordered_map<size_t, std::vector<std::unique_ptr<bytes>>> m_freeBuffers;
+};
+
 class SessionRecvBuffer : public bcos::ObjectCounter<SessionRecvBuffer>
 {
 public:
-    SessionRecvBuffer(size_t _bufferSize) : m_recvBufferSize(_bufferSize)
-    {
-        m_recvBuffer.resize(_bufferSize);
-    }
+    SessionRecvBuffer(size_t _bufferSize)
+      : m_recvBuffer(RecvBufferPool::instance().acquire(_bufferSize)),
+        m_recvBufferSize(_bufferSize)
+    {}
 
     SessionRecvBuffer(const SessionRecvBuffer&) = delete;
     SessionRecvBuffer(SessionRecvBuffer&&) = delete;
@@ -53,6 +75,9 @@ public:
 
     inline size_t recvBufferSize() const { return m_recvBufferSize; }
 
+    // held by the messages whose payload references the read buffer
+    std::shared_ptr<bytes> const& buffer() const { return m_recvBuffer; }
+
     bool onRead(std::size_t _dataSize)
     {
         if (m_readPos + _dataSize <= m_writePos)
@@ -79,22 +104,24 @@ public:
     {
         if (_bufferSize > m_recvBufferSize)
         {
-            m_recvBuffer.resize(_bufferSize);
-            m_recvBufferSize = _bufferSize;
-
+            switchBuffer(_bufferSize);
             return true;
         }
 
         return false;
     }
 
-    // void realloc() {}
-
     void moveToHeader()
     {
-        if (m_writePos > m_readPos)
+        if (m_recvBuffer.use_count() > 1)
         {
-            memmove(m_recvBuffer.data(), m_recvBuffer.data() + m_readPos, m_writePos - m_readPos);
+            // the decoded messages still reference the data before readPos, continue in another
+            // buffer instead of overwriting it
+            switchBuffer(m_recvBufferSize);
+        }
+        else if (m_writePos > m_readPos)
+        {
+            memmove(m_recvBuffer->data(), m_recvBuffer->data() + m_readPos, m_writePos - m_readPos);
             m_writePos -= m_readPos;
             m_readPos = 0;
         }
@@ -107,19 +134,31 @@ public:
 
     inline bcos::bytesConstRef asReadBuffer() const
     {
-        return {m_recvBuffer.data() + m_readPos, m_writePos - m_readPos};
+        return {m_recvBuffer->data() + m_readPos, m_writePos - m_readPos};
     }
 
     inline bcos::bytesConstRef asWriteBuffer() const
     {
-        return {m_recvBuffer.data() + m_writePos, m_recvBufferSize - m_writePos};
+        return {m_recvBuffer->data() + m_writePos, m_recvBufferSize - m_writePos};
     }
 
 private:
+    // the unread data is moved to the header of a new buffer
+    void switchBuffer(size_t _bufferSize)
+    {
+        auto buffer = RecvBufferPool::instance().acquire(_bufferSize);
+        std::copy(m_recvBuffer->begin() + m_readPos, m_recvBuffer->begin() + m_writePos,
+            buffer->begin());
+        m_recvBuffer = std::move(buffer);
+        m_recvBufferSize = _bufferSize;
+        m_writePos -= m_readPos;
+        m_readPos = 0;
+    }
+
     // 0         readPos    writePos       m_recvBufferSize
     // |___________|__________|____________|
     //
-    std::vector<byte> m_recvBuffer;
+    std::shared_ptr<bytes> m_recvBuffer;
     //
     size_t m_recvBufferSize;
     // read pos of the buffer
@@ -21,6 +21,7 @@
 #include <bcos-gateway/Common.h>
 #include <bcos-gateway/libp2p/Common.h>
 #include <bcos-gateway/libp2p/P2PMessage.h>
+#include <bcos-utilities/Metrics.h>
 #include <bcos-utilities/ZstdCompress.h>
 #include <boost/asio/detail/socket_ops.hpp>
 
@@ -28,6 +29,16 @@ using namespace bcos;
 using namespace bcos::gateway;
 using namespace bcos::crypto;
 
+namespace
+{
+metrics::Counter& payloadCopies()
+{
+    static auto& counter = metrics::Registry::instance().counter(
+        "bcos_gateway_recv_payload_copies_total", "received p2p payloads copied out of the buffer");
+    return counter;
+}
+}  // namespace
+
 bool P2PMessageOptions::encode(bytes& _buffer)
 {
     // parameters check
@@ -201,7 +212,7 @@ bool P2PMessage::encode(EncodedMessage& _buffer)
     // No data compression is performed
     if (!isCompressSuccess)
     {
-        _buffer.payload = m_payload;
+        _buffer.payload = payload();
     }
 
     bytes headerBuffer;
@@ -266,7 +277,8 @@ bool P2PMessage::encode(bcos::bytes& _buffer)
     }
     else
     {
-        _buffer.insert(_buffer.end(), m_payload->begin(), m_payload->end());
+        auto payload = payloadView();
+        _buffer.insert(_buffer.end(), payload.begin(), payload.end());
     }
 
     // calc total length and modify the length value in the buffer
@@ -282,7 +294,8 @@ bool P2PMessage::encode(bcos::bytes& _buffer)
 /// compress the payload data to be sended
 bool P2PMessage::tryToCompressPayload(bytes& compressData)
 {
-    if (m_payload->size() <= bcos::gateway::c_compressThreshold)
+    auto payload = payloadView();
+    if (payload.size() <= bcos::gateway::c_compressThreshold)
     {
         return false;
     }
@@ -293,7 +306,7 @@ bool P2PMessage::tryToCompressPayload(bytes& compressData)
     }
 
     bool isCompressSuccess =
-        ZstdCompress::compress(ref(*m_payload), compressData, bcos::gateway::c_zstdCompressLevel);
+        ZstdCompress::compress(payload, compressData, bcos::gateway::c_zstdCompressLevel);
     return isCompressSuccess;
 }
 
@@ -327,8 +340,23 @@ int32_t P2PMessage::decodeHeader(const bytesConstRef& _buffer)
     return offset;
 }
 
+std::shared_ptr<bytes> P2PMessage::payload() const
+{
+    if (m_payloadOwner)
+    {
+        std::call_once(m_payloadCopied, [this]() {
+            payloadCopies().inc();
+            // only m_payload is set, the view and its buffer stay valid for concurrent readers
+            m_payload = std::make_shared<bytes>(m_payloadView.begin(), m_payloadView.end());
+        });
+    }
+    return m_payload;
+}
+
 int32_t P2PMessage::decode(const bytesConstRef& _buffer)
 {
+    // set again only if the payload references the buffer
+    auto bufferOwner = std::move(m_payloadOwner);
     // check if packet header fully received
     if (_buffer.size() < P2PMessage::MESSAGE_HEADER_LENGTH)
     {
@@ -391,8 +419,16 @@ int32_t P2PMessage::decode(const bytesConstRef& _buffer)
         // reset ext
         m_ext &= (~bcos::protocol::MessageExtFieldFlag::COMPRESS);
     }
+    else if (bufferOwner && data.size() * IN_PLACE_PAYLOAD_RATIO >= bufferOwner->size())
+    {
+        // only a payload taking a good part of the receive buffer is worth pinning the buffer,
+        // a small one is copied and the buffer is reused by the next read
+        m_payloadView = data;
+        m_payloadOwner = std::move(bufferOwner);
+    }
     else
     {
+        payloadCopies().inc();
         m_payload = std::make_shared<bytes>(data.begin(), data.end());
     }
 
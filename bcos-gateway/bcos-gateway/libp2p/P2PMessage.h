@@ -25,6 +25,7 @@
 #include <bcos-gateway/libnetwork/Common.h>
 #include <bcos-gateway/libnetwork/Message.h>
 #include <bcos-utilities/Common.h>
+#include <mutex>
 #include <vector>
 
 #define CHECK_OFFSET_WITH_THROW_EXCEPTION(offset, length)                                    \
@@ -154,7 +155,7 @@ public:
         }
 
         // estimate the length of msg to be encoded
-        int64_t length = (int64_t)payload()->size() + (int64_t)P2PMessage::MESSAGE_HEADER_LENGTH;
+        int64_t length = (int64_t)payloadView().size() + (int64_t)P2PMessage::MESSAGE_HEADER_LENGTH;
         if (hasOptions() && options() && options()->srcNodeID())
         {
             length += P2PMessageOptions::OPTIONS_MIN_LENGTH;
@@ -180,8 +181,24 @@ public:
     P2PMessageOptions::Ptr options() const { return m_options; }
     void setOptions(P2PMessageOptions::Ptr _options) { m_options = _options; }
 
-    std::shared_ptr<bytes> payload() const { return m_payload; }
-    void setPayload(std::shared_ptr<bytes> _payload) { m_payload = _payload; }
+    // copied out of the receive buffer on the first call if decoded in place, the buffer stays
+    // referenced by the message so the views taken before remain valid; use payloadView to read
+    // it without the copy
+    std::shared_ptr<bytes> payload() const;
+    bytesConstRef payloadView() const
+    {
+        return m_payloadOwner ? m_payloadView : bytesConstRef(m_payload->data(), m_payload->size());
+    }
+    void setPayload(std::shared_ptr<bytes> _payload)
+    {
+        m_payload = _payload;
+        m_payloadOwner.reset();
+        m_payloadView = {};
+    }
+    void setBufferOwner(std::shared_ptr<bytes> _owner) override
+    {
+        m_payloadOwner = std::move(_owner);
+    }
 
     void setRespPacket() { m_ext |= bcos::protocol::MessageExtFieldFlag::RESPONSE; }
     bool encode(bytes& _buffer) override;
@@ -251,7 +268,13 @@ protected:
 
     P2PMessageOptions::Ptr m_options;  ///< options fields
 
-    std::shared_ptr<bytes> m_payload;  ///< payload data
+    mutable std::shared_ptr<bytes> m_payload;  ///< payload data
+    // a payload decoded in place pins the whole receive buffer, at most this many times its size
+    constexpr static size_t IN_PLACE_PAYLOAD_RATIO = 4;
+    // the receive buffer m_payloadView points into, null if the payload is in m_payload
+    mutable std::shared_ptr<bytes> m_payloadOwner;
+    mutable bytesConstRef m_payloadView;
+    mutable std::once_flag m_payloadCopied;
 
     MessageExtAttributes::Ptr m_extAttr = nullptr;  ///< message additional attributes
 };
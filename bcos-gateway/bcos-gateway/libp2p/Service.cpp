@@ -709,8 +709,7 @@ void Service::onReceiveProtocol(
     }
     try
     {
-        auto payload = _message->payload();
-        auto protocolInfo = m_codec->decode(bytesConstRef(payload->data(), payload->size()));
+        auto protocolInfo = m_codec->decode(_message->payloadView());
         // negotiated version
         if (protocolInfo->minVersion() > m_localProtocol->maxVersion() ||
             protocolInfo->maxVersion() < m_localProtocol->minVersion())
@@ -80,7 +80,7 @@ void ServiceV2::onReceivePeersRouterTable(
                               << LOG_KV("code", _error.errorCode()) << LOG_KV("msg", _error.what());
         return;
     }
-    auto routerTable = m_routerTableFactory->createRouterTable(ref(*(_message->payload())));
+    auto routerTable = m_routerTableFactory->createRouterTable(_message->payloadView());
 
     SERVICE2_LOG(INFO) << LOG_BADGE("onReceivePeersRouterTable")
                        << LOG_KV("peer", _session->p2pID())
@@ -170,7 +170,7 @@ void ServiceV2::onReceiveRouterSeq(
         return;
     }
     auto statusSeq = boost::asio::detail::socket_ops::network_to_host_long(
-        *((uint32_t*)_message->payload()->data()));
+        *((uint32_t*)_message->payloadView().data()));
     if (!tryToUpdateSeq(_session->p2pID(), statusSeq))
     {
         return;
@@ -309,7 +309,7 @@ void ServiceV2::onMessage(NetworkException _error, SessionFace::Ptr _session, Me
                                 << LOG_KV("type", p2pMsg->packetType())
                                 << LOG_KV("rsp", p2pMsg->isRespPacket())
                                 << LOG_KV("ttl", p2pMsg->ttl())
-                                << LOG_KV("payLoadSize", p2pMsg->payload()->size());
+                                << LOG_KV("payLoadSize", p2pMsg->payloadView().size());
         }
         Service::onMessage(_error, _session, _message, _p2pSessionWeakPtr);
         return;
@@ -324,7 +324,7 @@ void ServiceV2::onMessage(NetworkException _error, SessionFace::Ptr _session, Me
                               << LOG_KV("dst", p2pMsg->dstP2PNodeID())
                               << LOG_KV("type", p2pMsg->packetType())
                               << LOG_KV("rsp", p2pMsg->isRespPacket())
-                              << LOG_KV("payLoadSize", p2pMsg->payload()->size())
+                              << LOG_KV("payLoadSize", p2pMsg->payloadView().size())
                               << LOG_KV("ttl", ttl);
         return;
     }
@@ -339,7 +339,7 @@ void ServiceV2::onMessage(NetworkException _error, SessionFace::Ptr _session, Me
                             << LOG_KV("dst", p2pMsg->dstP2PNodeIDView())
                             << LOG_KV("type", p2pMsg->packetType()) << LOG_KV("seq", p2pMsg->seq())
                             << LOG_KV("rsp", p2pMsg->isRespPacket()) << LOG_KV("ttl", p2pMsg->ttl())
-                            << LOG_KV("payLoadSize", p2pMsg->payload()->size());
+                            << LOG_KV("payLoadSize", p2pMsg->payloadView().size());
     }
     asyncSendMessageByNodeIDWithMsgForward(p2pMsg, nullptr);
 }
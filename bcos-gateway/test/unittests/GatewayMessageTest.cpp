@@ -474,6 +474,54 @@ BOOST_AUTO_TEST_CASE(test_P2PMessage_compress)
     */
 }
 
+BOOST_AUTO_TEST_CASE(test_P2PMessage_decodeInPlace)
+{
+    auto factory = std::make_shared<P2PMessageFactoryV2>();
+    auto encodeMsg = std::static_pointer_cast<P2PMessage>(factory->buildMessage());
+    encodeMsg->setVersion(1);
+    encodeMsg->setSeq(0x12345678);
+    encodeMsg->setPacketType(GatewayMessageType::Heartbeat);
+    encodeMsg->setPayload(std::make_shared<bytes>(100, 'a'));
+    auto buffer = std::make_shared<bytes>();
+    BOOST_CHECK(encodeMsg->encode(*buffer));
+
+    // the payload references the buffer
+    auto decodeMsg = std::static_pointer_cast<P2PMessage>(factory->buildMessage());
+    decodeMsg->setBufferOwner(buffer);
+    BOOST_CHECK_EQUAL(decodeMsg->decode(ref(*buffer)), buffer->size());
+    auto payload = decodeMsg->payloadView();
+    BOOST_CHECK(payload.data() >= buffer->data());
+    BOOST_CHECK(payload.data() + payload.size() == buffer->data() + buffer->size());
+    BOOST_CHECK(payload.toBytes() == *encodeMsg->payload());
+    BOOST_CHECK_EQUAL(buffer.use_count(), 2);
+    // copied on request, the view taken before still points into the live buffer
+    BOOST_CHECK(*decodeMsg->payload() == *encodeMsg->payload());
+    BOOST_CHECK(decodeMsg->payload() == decodeMsg->payload());
+    BOOST_CHECK(decodeMsg->payload()->data() != payload.data());
+    BOOST_CHECK_EQUAL(buffer.use_count(), 2);
+    BOOST_CHECK(payload.toBytes() == *encodeMsg->payload());
+    BOOST_CHECK(decodeMsg->payloadView().data() == payload.data());
+
+    decodeMsg->setPayload(std::make_shared<bytes>(1, 'b'));
+    BOOST_CHECK_EQUAL(decodeMsg->payloadView().size(), 1);
+
+    // a small payload in a large receive buffer is copied at decode
+    auto largeBuffer = std::make_shared<bytes>(*buffer);
+    largeBuffer->resize(512 * 1024);
+    auto smallMsg = std::static_pointer_cast<P2PMessage>(factory->buildMessage());
+    smallMsg->setBufferOwner(largeBuffer);
+    BOOST_CHECK_EQUAL(smallMsg->decode(ref(*largeBuffer)), buffer->size());
+    BOOST_CHECK_EQUAL(largeBuffer.use_count(), 1);
+    BOOST_CHECK(smallMsg->payloadView().toBytes() == *encodeMsg->payload());
+
+    // not referenced if the message is incomplete
+    auto incompleteMsg = std::static_pointer_cast<P2PMessage>(factory->buildMessage());
+    incompleteMsg->setBufferOwner(buffer);
+    BOOST_CHECK_EQUAL(incompleteMsg->decode(ref(*buffer).getCroppedData(0, buffer->size() - 1)),
+        MessageDecodeStatus::MESSAGE_INCOMPLETE);
+    BOOST_CHECK_EQUAL(buffer.use_count(), 1);
+}
+
 BOOST_AUTO_TEST_CASE(test_P2PMessage_attr)
 {
     auto attr = std::make_shared<GatewayMessageExtAttributes>();
@@ -484,4 +484,45 @@ BOOST_AUTO_TEST_CASE(SessionRecvBufferTest)
     }
 }
 
+BOOST_AUTO_TEST_CASE(SessionRecvBufferPinnedTest)
+{
+    SessionRecvBuffer recvBuffer(1024);
+    auto writeBuffer = recvBuffer.asWriteBuffer();
+    for (size_t i = 0; i < 100; ++i)
+    {
+        const_cast<byte*>(writeBuffer.data())[i] = (byte)i;
+    }
+    recvBuffer.onWrite(100);
+    recvBuffer.onRead(60);
+
+    // not referenced by any message, moved in place
+    auto buffer = recvBuffer.buffer().get();
+    recvBuffer.moveToHeader();
+    BOOST_CHECK_EQUAL(recvBuffer.buffer().get(), buffer);
+    BOOST_CHECK_EQUAL(recvBuffer.dataSize(), 40);
+    BOOST_CHECK_EQUAL(recvBuffer.asReadBuffer()[0], 60);
+
+    // a decoded message still references the read data, the unread data goes to a new buffer
+    recvBuffer.onRead(10);
+    auto pinned = recvBuffer.buffer();
+    recvBuffer.moveToHeader();
+    BOOST_CHECK(recvBuffer.buffer() != pinned);
+    BOOST_CHECK_EQUAL(recvBuffer.buffer()->size(), 1024);
+    BOOST_CHECK_EQUAL(recvBuffer.readPos(), 0);
+    BOOST_CHECK_EQUAL(recvBuffer.dataSize(), 30);
+    BOOST_CHECK_EQUAL(recvBuffer.asReadBuffer()[0], 70);
+    BOOST_CHECK_EQUAL((*pinned)[0], 60);
+
+    // the released buffer is reused
+    auto* released = pinned.get();
+    pinned.reset();
+    SessionRecvBuffer another(1024);
+    BOOST_CHECK_EQUAL(another.buffer().get(), released);
+
+    recvBuffer.resizeBuffer(2048);
+    BOOST_CHECK_EQUAL(recvBuffer.recvBufferSize(), 2048);
+    BOOST_CHECK_EQUAL(recvBuffer.dataSize(), 30);
+    BOOST_CHECK_EQUAL(recvBuffer.asReadBuffer()[29], 99);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
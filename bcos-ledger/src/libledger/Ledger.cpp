@@ -63,6 +63,7 @@
 #include <future>
 #include <iterator>
 #include <memory>
+#include <type_traits>
 #include <utility>
 
 using namespace bcos;
@@ -101,7 +102,7 @@ void Ledger::asyncPreStoreBlockTxs(bcos::protocol::ConstTransactionsPtr _blockTx
         // Note: transactions must be submitted serially, because transaction submissions are
         // transactional, preventing write conflicts
         RecursiveGuard l(m_mutex);
-        auto error = m_storage->setRows(SYS_HASH_2_TX, keys, values);
+        auto error = setTxsOrReceipts(SYS_HASH_2_TX, keys, values);
         LEDGER_LOG(INFO) << LOG_DESC("asyncPreStoreBlockTxs: store uncommitted txs")
                          << LOG_KV("blockNumber", blockNumber)
                          << LOG_KV("blockTxsSize", blockTxsSize)
@@ -212,6 +213,7 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
     number2HeaderEntry.importFields({std::move(headerBuffer)});
     storage->asyncSetRow(SYS_NUMBER_2_BLOCK_HEADER, blockNumberStr, std::move(number2HeaderEntry),
         [setRowCallback](auto&& error) { setRowCallback(std::forward<decltype(error)>(error)); });
+    m_headerCache.insert(header->number(), header);
 
     // number 2 nonce
     auto nonceBlock = m_blockFactory->createBlock();
@@ -288,16 +290,17 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
     if (writeTxsAndReceipts)
     {
         // hash 2 receipts
-        std::vector<std::string> txsHash(block->receiptsSize());
+        std::vector<bcos::crypto::HashType> txsHash(block->receiptsSize());
+        std::vector<std::string_view> txsHashView(block->receiptsSize());
         std::vector<bytes> receipts(block->receiptsSize());
         std::vector<std::string_view> receiptsView(block->receiptsSize());
         tbb::parallel_for(tbb::blocked_range<size_t>(0, block->receiptsSize(), 256),
-            [&transactionsBlock, &block, &failedCount, &totalCount, &txsHash, &receipts,
-                &receiptsView](const tbb::blocked_range<size_t>& range) {
+            [&transactionsBlock, &block, &failedCount, &totalCount, &txsHash, &txsHashView,
+                &receipts, &receiptsView](const tbb::blocked_range<size_t>& range) {
                 for (size_t i = range.begin(); i < range.end(); ++i)
                 {
-                    auto hash = transactionsBlock->transactionHash(i);
-                    txsHash[i] = std::string((char*)hash.data(), hash.size());
+                    txsHash[i] = transactionsBlock->transactionHash(i);
+                    txsHashView[i] = bcos::concepts::bytebuffer::toView(txsHash[i]);
                     auto receipt = block->receipt(i);
                     if (receipt->status() != 0)
                     {
@@ -311,13 +314,17 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
 
         auto start = utcTime();
         auto error =
-            m_storage->setRows(SYS_HASH_2_RECEIPT, txsHash, receiptsView);  // only for tikv
+            setTxsOrReceipts(SYS_HASH_2_RECEIPT, txsHashView, receiptsView);  // only for tikv
         auto writeReceiptsTime = utcTime() - start;
         if (error)
         {
             LEDGER_LOG(ERROR) << LOG_DESC("ledger write receipts failed")
                               << LOG_KV("message", error->errorMessage());
         }
+        else
+        {
+            cacheTransactionsAndReceipts(_blockTxs, block);
+        }
 
         start = utcTime();
         asyncPreStoreBlockTxs(_blockTxs, block, setRowCallback);
@@ -374,10 +381,9 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
             {
                 setRowCallback({}, true);
             }
-            LEDGER_LOG(INFO) << METRIC << LOG_DESC("asyncPrewriteBlock")
-                             << LOG_KV("number", block->blockHeaderConst()->number())
-                             << LOG_KV("totalTxs", totalTxsCount) << LOG_KV("failedTxs", failedTxs)
-                             << LOG_KV("incTxs", totalCount) << LOG_KV("incFailedTxs", failedCount);
+            LEDGER_METRIC_LOG(INFO, "asyncPrewriteBlock", "number",
+                block->blockHeaderConst()->number(), "totalTxs", totalTxsCount, "failedTxs",
+                failedTxs, "incTxs", totalCount, "incFailedTxs", failedCount);
         });
 }
 
@@ -393,20 +399,33 @@ Ledger::needStoreUnsavedTxs(
         return std::make_tuple(false, nullptr, nullptr);
     }
     // supplement the unsaved hash_2_txs
+    std::vector<bytesConstPtr> encodedTxs(_blockTxs->size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, _blockTxs->size(), 256),
+        [&_blockTxs, &encodedTxs](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); ++i)
+            {
+                auto const& tx = (*_blockTxs)[i];
+                if (tx->storeToBackend())
+                {
+                    continue;
+                }
+                auto encodeData = std::make_shared<bytes>();
+                tx->encode(*encodeData);
+                encodedTxs[i] = std::move(encodeData);
+            }
+        });
     auto txsToStore = std::make_shared<std::vector<bytesConstPtr>>();
     size_t unstoredTxs = 0;
     auto txsHash = std::make_shared<HashList>();
-    for (auto const& tx : (*_blockTxs))
+    for (size_t i = 0; i < encodedTxs.size(); ++i)
     {
-        if (tx->storeToBackend())
+        if (!encodedTxs[i])
         {
             continue;
         }
-        bcos::bytes encodeData;
-        tx->encode(encodeData);
         unstoredTxs++;
-        txsHash->emplace_back(tx->hash());
-        txsToStore->emplace_back(std::make_shared<bytes>(std::move(encodeData)));
+        txsHash->emplace_back((*_blockTxs)[i]->hash());
+        txsToStore->emplace_back(std::move(encodedTxs[i]));
     }
     LEDGER_LOG(INFO) << LOG_DESC("asyncPreStoreBlockTxs: needStoreUnsavedTxs")
                      << LOG_KV("txsSize", _blockTxs->size()) << LOG_KV("unstoredTxs", unstoredTxs)
@@ -427,95 +446,210 @@ bcos::Error::Ptr Ledger::storeTransactionsAndReceipts(
         return BCOS_ERROR_PTR(LedgerError::ErrorArgument, "empty block");
     }
     auto start = utcTime();
-    bcos::Error::Ptr error = nullptr;
     auto txSize = std::max(block->transactionsSize(), block->transactionsMetaDataSize());
 
-    std::vector<std::string> txsHash(txSize);
+    // encode the receipts and the unstored transactions in one parallel pass, no lock is held
+    // here, the lock only serializes the transaction writing below
+    std::vector<bcos::crypto::HashType> txsHash(txSize);
+    std::vector<std::string_view> txsHashView(txSize);
     std::vector<bytes> receipts(txSize);
     std::vector<std::string_view> receiptsView(txSize);
+    std::vector<bytes> txs(txSize);
+    std::vector<uint8_t> txsToStore(txSize, 0);
     tbb::parallel_for(tbb::blocked_range<size_t>(0, txSize, 256),
-        [&blockTxs, &block, &txsHash, &receipts, &receiptsView](
+        [&blockTxs, &block, &txsHash, &txsHashView, &receipts, &receiptsView, &txs, &txsToStore](
             const tbb::blocked_range<size_t>& range) {
             for (size_t i = range.begin(); i < range.end(); ++i)
             {
-                auto hash = blockTxs ? blockTxs->at(i)->hash() : block->transaction(i)->hash();
-                txsHash[i] = std::string((char*)hash.data(), hash.size());
+                auto tx = blockTxs ? blockTxs->at(i) : block->transaction(i);
+                txsHash[i] = tx->hash();
+                txsHashView[i] = bcos::concepts::bytebuffer::toView(txsHash[i]);
                 block->receipt(i)->encode(receipts[i]);
                 receiptsView[i] = std::string_view((char*)receipts[i].data(), receipts[i].size());
+                // a synced block comes without blockTxs and all of its transactions are stored,
+                // the ones of a proposed block already stored by asyncPreStoreBlockTxs are skipped
+                if (!blockTxs || !tx->storeToBackend())
+                {
+                    tx->encode(txs[i]);
+                    txsToStore[i] = 1;
+                }
             }
         });
-    auto promise = std::make_shared<std::promise<bcos::Error::Ptr>>();
-    m_threadPool->enqueue([storage = m_storage, promise, keys = std::move(txsHash),
-                              values = std::move(receiptsView)]() mutable {
-        auto err = storage->setRows(SYS_HASH_2_RECEIPT, keys, values);
-        promise->set_value(err);
-    });
-    auto txsToStore = std::make_shared<std::vector<bytes>>();
-    txsToStore->reserve(txSize);
-    auto txsToStoreHash = std::make_shared<HashList>();
-    txsToStoreHash->reserve(txSize);
     std::vector<std::string_view> keys;
     keys.reserve(txSize);
     std::vector<std::string_view> values;
     values.reserve(txSize);
-    auto blockNumber = block->blockHeaderConst()->number();
-
-    RecursiveGuard guard(m_mutex);
-    size_t unstoredTxs = 0;
-    // TODO: usr block level flag to indicate whether the transactions has been stored
-    for (size_t i = 0; i < txSize; i++)
+    for (size_t i = 0; i < txSize; ++i)
     {
-        auto tx = blockTxs ? blockTxs->at(i) : block->transaction(i);
-        if (blockTxs && tx->storeToBackend())
+        if (txsToStore[i])
         {
-            continue;
+            keys.emplace_back(txsHashView[i]);
+            values.emplace_back(bcos::concepts::bytebuffer::toView(txs[i]));
         }
-        bcos::bytes encodeData;
-        tx->encode(encodeData);
-        txsToStoreHash->emplace_back(tx->hash());
-        txsToStore->emplace_back(std::move(encodeData));
-        keys.push_back(bcos::concepts::bytebuffer::toView((*txsToStoreHash)[unstoredTxs]));
-        values.push_back(bcos::concepts::bytebuffer::toView((*txsToStore)[unstoredTxs]));
-        ++unstoredTxs;
-    }
-    if (!keys.empty())
-    {
-        // asyncPreStoreBlockTxs also write txs to DB, needStoreUnsavedTxs is out of lock, so
-        // the transactions may be write twice
-        error = m_storage->setRows(SYS_HASH_2_TX, keys, values);
+    }
+
+    auto blockNumber = block->blockHeaderConst()->number();
+    if (m_segmentStore)
+    {
+        // every append to the segment store is synced, the transactions and the receipts of the
+        // block go in one append to sync once per block
+        RecursiveGuard guard(m_mutex);
+        auto error = m_segmentStore->append(
+            {{.kind = SegmentStore::TRANSACTION, .keys = keys, .values = values},
+                {.kind = SegmentStore::RECEIPT, .keys = txsHashView, .values = receiptsView}});
         if (error)
         {
-            LEDGER_LOG(ERROR) << LOG_DESC("ledger write transactions failed")
+            LEDGER_LOG(ERROR) << LOG_DESC("ledger write transactions and receipts failed")
                               << LOG_KV("code", error->errorCode())
                               << LOG_KV("message", error->errorMessage());
             return error;
         }
-        // set the flag when store success
-        if (blockTxs)
+        if (blockTxs && !keys.empty())
         {
-            for (size_t i = 0; i < block->transactionsSize(); i++)
+            for (auto const& tx : *blockTxs)
             {
-                blockTxs->at(i)->setStoreToBackend(true);
+                tx->setStoreToBackend(true);
             }
         }
     }
-    auto err = promise->get_future().get();
-    if (err)
+    else
     {
-        LEDGER_LOG(ERROR) << LOG_DESC("ledger write receipts failed")
-                          << LOG_KV("code", err->errorCode())
-                          << LOG_KV("message", err->errorMessage());
-        return err;
+        // the receipts are written in the thread pool concurrently with the transactions, the
+        // views refer to this frame, so the promise must be waited on every path below
+        auto promise = std::make_shared<std::promise<bcos::Error::Ptr>>();
+        m_threadPool->enqueue([this, promise, &txsHashView, &receiptsView]() {
+            auto err = setTxsOrReceipts(SYS_HASH_2_RECEIPT, txsHashView, receiptsView);
+            promise->set_value(err);
+        });
+
+        bcos::Error::Ptr error = nullptr;
+        if (!keys.empty())
+        {
+            // asyncPreStoreBlockTxs also write txs to DB, needStoreUnsavedTxs is out of lock, so
+            // the transactions may be write twice
+            RecursiveGuard guard(m_mutex);
+            error = setTxsOrReceipts(SYS_HASH_2_TX, keys, values);
+            if (error)
+            {
+                LEDGER_LOG(ERROR) << LOG_DESC("ledger write transactions failed")
+                                  << LOG_KV("code", error->errorCode())
+                                  << LOG_KV("message", error->errorMessage());
+            }
+            else if (blockTxs)
+            {
+                // set the flag when store success
+                for (auto const& tx : *blockTxs)
+                {
+                    tx->setStoreToBackend(true);
+                }
+            }
+        }
+        auto err = promise->get_future().get();
+        if (error)
+        {
+            return error;
+        }
+        if (err)
+        {
+            LEDGER_LOG(ERROR) << LOG_DESC("ledger write receipts failed")
+                              << LOG_KV("code", err->errorCode())
+                              << LOG_KV("message", err->errorMessage());
+            return err;
+        }
     }
-    auto writeReceiptsTime = utcTime();
+    cacheTransactionsAndReceipts(blockTxs, block);
 
-    LEDGER_LOG(INFO) << LOG_DESC("storeTransactionsAndReceipts finished")
-                     << LOG_KV("blockNumber", blockNumber) << LOG_KV("blockTxsSize", txSize)
-                     << LOG_KV("unStoredTxs", unstoredTxs)
-                     << LOG_KV("timeCost", (utcTime() - start));
+    LEDGER_BINARY_LOG(INFO, "storeTransactionsAndReceipts finished", "blockNumber", blockNumber,
+        "blockTxsSize", txSize, "unStoredTxs", keys.size(), "timeCost", (utcTime() - start));
     return nullptr;
 }
 
+// the approximate bytes a cached object holds, the variable sized fields plus a fixed part for the
+// object and the small fields
+constexpr static size_t c_cachedObjectOverhead = 512;
+static size_t cacheCost(protocol::Transaction const& _transaction)
+{
+    return c_cachedObjectOverhead + _transaction.input().size() +
+           _transaction.signatureData().size() + _transaction.extension().size() +
+           _transaction.abi().size() + _transaction.extraData().size();
+}
+
+static size_t cacheCost(protocol::TransactionReceipt const& _receipt)
+{
+    auto cost = c_cachedObjectOverhead + _receipt.output().size() + _receipt.message().size();
+    for (auto const& log : _receipt.logEntries())
+    {
+        cost += log.address().size() + log.topics().size() * sizeof(h256) + log.data().size();
+    }
+    return cost;
+}
+
+void Ledger::cacheTransactionsAndReceipts(bcos::protocol::ConstTransactionsPtr const& _blockTxs,
+    bcos::protocol::Block::ConstPtr const& _block)
+{
+    for (size_t i = 0; i < _block->receiptsSize(); ++i)
+    {
+        protocol::Transaction::ConstPtr tx;
+        if (_blockTxs && i < _blockTxs->size())
+        {
+            tx = _blockTxs->at(i);
+        }
+        else if (i < _block->transactionsSize())
+        {
+            tx = _block->transaction(i);
+        }
+
+        auto hash = tx ? tx->hash() : _block->transactionHash(i);
+        if (hash == crypto::HashType())
+        {
+            continue;
+        }
+        if (tx)
+        {
+            auto cost = cacheCost(*tx);
+            m_txCache.insert(hash, std::move(tx), cost);
+        }
+        auto receipt = _block->receipt(i);
+        auto cost = cacheCost(*receipt);
+        m_receiptCache.insert(hash, std::move(receipt), cost);
+    }
+}
+
+protocol::Transaction::Ptr Ledger::copyTransaction(protocol::Transaction const& _transaction) const
+{
+    bytes buffer;
+    _transaction.encode(buffer);
+    return m_blockFactory->transactionFactory()->createTransaction(
+        bcos::ref(std::as_const(buffer)), false, false);
+}
+
+protocol::TransactionReceipt::Ptr Ledger::copyReceipt(
+    protocol::TransactionReceipt const& _receipt) const
+{
+    bytes buffer;
+    _receipt.encode(buffer);
+    return m_blockFactory->receiptFactory()->createReceipt(bcos::ref(std::as_const(buffer)));
+}
+
+Error::Ptr Ledger::setTxsOrReceipts(std::string_view _table,
+    std::vector<std::string_view> const& _keys, std::vector<std::string_view> const& _values)
+{
+    if (!m_segmentStore)
+    {
+        return m_storage->setRows(_table, _keys, _values);
+    }
+    auto kind = _table == SYS_HASH_2_TX ? SegmentStore::TRANSACTION : SegmentStore::RECEIPT;
+    return m_segmentStore->append(kind, _keys, _values);
+}
+
+void Ledger::updateCommittedNumber(protocol::BlockNumber _number)
+{
+    auto current = m_committedNumber.load();
+    while (current < _number && !m_committedNumber.compare_exchange_weak(current, _number))
+    {
+    }
+}
+
 void Ledger::asyncGetBlockDataByNumber(bcos::protocol::BlockNumber _blockNumber, int32_t _blockFlag,
     std::function<void(Error::Ptr, bcos::protocol::Block::Ptr)> _onGetBlock)
 {
@@ -610,7 +744,7 @@ void Ledger::asyncGetBlockDataByNumber(bcos::protocol::BlockNumber _blockNumber,
                 auto hashesPtr = std::make_shared<std::vector<std::string>>(std::move(hashes));
                 if ((_blockFlag & TRANSACTIONS) != 0)
                 {
-                    asyncBatchGetTransactions(
+                    asyncBatchGetTransactions<protocol::Transaction::Ptr>(
                         hashesPtr, [block, finally](Error::Ptr&& error,
                                        std::vector<protocol::Transaction::Ptr>&& transactions) {
                             if (error)
@@ -630,7 +764,7 @@ void Ledger::asyncGetBlockDataByNumber(bcos::protocol::BlockNumber _blockNumber,
                 }
                 if ((_blockFlag & RECEIPTS) != 0)
                 {
-                    asyncBatchGetReceipts(
+                    asyncBatchGetReceipts<protocol::TransactionReceipt::Ptr>(
                         hashesPtr, [block, finally](Error::Ptr&& error,
                                        std::vector<protocol::TransactionReceipt::Ptr>&& receipts) {
                             for (auto& it : receipts)
@@ -665,7 +799,7 @@ void Ledger::asyncGetBlockNumber(
     std::function<void(Error::Ptr, bcos::protocol::BlockNumber)> _onGetBlock)
 {
     asyncGetSystemTableEntry(SYS_CURRENT_STATE, SYS_KEY_CURRENT_NUMBER,
-        [callback = std::move(_onGetBlock)](
+        [this, callback = std::move(_onGetBlock)](
             Error::Ptr&& error, std::optional<bcos::storage::Entry>&& entry) {
             if (error)
             {
@@ -690,6 +824,7 @@ void Ledger::asyncGetBlockNumber(
             }
 
             LEDGER_LOG(TRACE) << "GetBlockNumber success" << LOG_KV("blockNumber", blockNumber);
+            updateCommittedNumber(blockNumber);
             callback(nullptr, blockNumber);
         });
 }
@@ -808,7 +943,7 @@ void Ledger::asyncGetBatchTxsByHashList(crypto::HashListPtr _txHashList, bool _w
         hexList->emplace_back(std::move(hex));
     }
 
-    asyncBatchGetTransactions(
+    asyncBatchGetTransactions<protocol::Transaction::Ptr>(
         hexList, [this, callback = std::move(_onGetTx), _txHashList, _withProof](
                      Error::Ptr&& error, std::vector<protocol::Transaction::Ptr>&& transactions) {
             if (error)
@@ -869,6 +1004,36 @@ void Ledger::asyncGetBatchTxsByHashList(crypto::HashListPtr _txHashList, bool _w
         });
 }
 
+void Ledger::asyncGetBatchReceiptsByHashList(crypto::HashListPtr _txHashList,
+    std::function<void(Error::Ptr, std::vector<protocol::TransactionReceipt::ConstPtr>)>
+        _onGetReceipts)
+{
+    LEDGER_LOG(TRACE) << "GetBatchReceiptsByHashList request"
+                      << LOG_KV("hashes", _txHashList->size());
+
+    auto hashes = std::make_shared<std::vector<std::string>>();
+    hashes->reserve(_txHashList->size());
+    for (auto& it : *_txHashList)
+    {
+        hashes->emplace_back(it.begin(), it.end());
+    }
+
+    asyncBatchGetReceipts<protocol::TransactionReceipt::ConstPtr>(hashes,
+        [callback = std::move(_onGetReceipts)](
+            Error::Ptr&& error, std::vector<protocol::TransactionReceipt::ConstPtr>&& receipts) {
+            if (error)
+            {
+                LEDGER_LOG(DEBUG)
+                    << "GetBatchReceiptsByHashList failed: " << error->errorMessage();
+                callback(BCOS_ERROR_WITH_PREV_PTR(LedgerError::GetStorageError,
+                             "GetBatchReceiptsByHashList error", *error),
+                    {});
+                return;
+            }
+            callback(nullptr, std::move(receipts));
+        });
+}
+
 void Ledger::asyncGetTransactionReceiptByHash(bcos::crypto::HashType const& _txHash,
     bool _withProof,
     std::function<void(Error::Ptr, bcos::protocol::TransactionReceipt::ConstPtr, MerkleProofPtr)>
@@ -878,45 +1043,61 @@ void Ledger::asyncGetTransactionReceiptByHash(bcos::crypto::HashType const& _txH
 
     LEDGER_LOG(TRACE) << "GetTransactionReceiptByHash" << LOG_KV("hash", key);
 
+    auto onGetReceipt = [this, callback = std::move(_onGetTx), _withProof](
+                            Error::Ptr error, protocol::TransactionReceipt::ConstPtr receipt) {
+        if (error || !_withProof)
+        {
+            callback(std::move(error), std::move(receipt), nullptr);
+            return;
+        }
+        getReceiptProof(
+            receipt, [receipt, _onGetTx = callback](Error::Ptr _error, MerkleProofPtr _proof) {
+                if (_error)
+                {
+                    LEDGER_LOG(DEBUG) << "GetTransactionReceiptByHash"
+                                      << LOG_KV("code", _error->errorCode())
+                                      << LOG_KV("msg", _error->errorMessage())
+                                      << boost::diagnostic_information(_error);
+                    _onGetTx(std::move(_error), receipt, nullptr);
+                    return;
+                }
+
+                _onGetTx(nullptr, receipt, std::move(_proof));
+            });
+    };
+
+    if (auto receipt = m_receiptCache.get(key))
+    {
+        onGetReceipt(nullptr, std::move(*receipt));
+        return;
+    }
+    if (m_segmentStore)
+    {
+        if (auto value = m_segmentStore->get(SegmentStore::RECEIPT, key))
+        {
+            onGetReceipt(nullptr,
+                m_blockFactory->receiptFactory()->createReceipt(bcos::ref(std::as_const(*value))));
+            return;
+        }
+    }
+
     asyncGetSystemTableEntry(SYS_HASH_2_RECEIPT, bcos::concepts::bytebuffer::toView(key),
-        [this, callback = std::move(_onGetTx), _withProof](
+        [this, onGetReceipt = std::move(onGetReceipt)](
             Error::Ptr&& error, std::optional<bcos::storage::Entry>&& entry) {
             if (error)
             {
                 LEDGER_LOG(DEBUG) << "GetTransactionReceiptByHash: "
                                   << boost::diagnostic_information(error);
-                callback(BCOS_ERROR_WITH_PREV_PTR(
-                             LedgerError::GetStorageError, "GetTransactionReceiptByHash", *error),
-                    nullptr, nullptr);
-
+                onGetReceipt(BCOS_ERROR_WITH_PREV_PTR(LedgerError::GetStorageError,
+                                 "GetTransactionReceiptByHash", *error),
+                    nullptr);
                 return;
             }
 
             auto value = entry->getField(0);
             auto receipt = m_blockFactory->receiptFactory()->createReceipt(
                 bcos::bytesConstRef((bcos::byte*)value.data(), value.size()));
-
-            if (_withProof)
-            {
-                getReceiptProof(receipt,
-                    [receipt, _onGetTx = callback](Error::Ptr _error, MerkleProofPtr _proof) {
-                        if (_error)
-                        {
-                            LEDGER_LOG(DEBUG) << "GetTransactionReceiptByHash"
-                                              << LOG_KV("code", _error->errorCode())
-                                              << LOG_KV("msg", _error->errorMessage())
-                                              << boost::diagnostic_information(_error);
-                            _onGetTx(std::move(_error), receipt, nullptr);
-                            return;
-                        }
-
-                        _onGetTx(nullptr, receipt, std::move(_proof));
-                    });
-            }
-            else
-            {
-                callback(nullptr, receipt, nullptr);
-            }
+            onGetReceipt(nullptr, std::move(receipt));
         });
 }
 
@@ -1243,6 +1424,20 @@ Error::Ptr Ledger::checkEntryValid(Error::UniquePtr&& error,
 void Ledger::asyncGetBlockHeader(bcos::protocol::Block::Ptr block,
     bcos::protocol::BlockNumber blockNumber, std::function<void(Error::Ptr&&)> callback)
 {
+    if (blockNumber <= m_committedNumber)
+    {
+        if (auto header = m_headerCache.get(blockNumber))
+        {
+            // the block takes a mutable header, give it a copy of the shared one
+            bytes buffer;
+            (*header)->encode(buffer);
+            block->setBlockHeader(m_blockFactory->blockHeaderFactory()->createBlockHeader(
+                bcos::ref(std::as_const(buffer))));
+            callback(nullptr);
+            return;
+        }
+    }
+
     m_storage->asyncOpenTable(SYS_NUMBER_2_BLOCK_HEADER,
         [this, blockNumber, block, callback](auto&& error, std::optional<Table>&& table) {
             auto validError = checkTableValid(std::move(error), table, SYS_NUMBER_2_BLOCK_HEADER);
@@ -1267,6 +1462,7 @@ void Ledger::asyncGetBlockHeader(bcos::protocol::Block::Ptr block,
                         bcos::bytesConstRef((bcos::byte*)field.data(), field.size()));
 
                     block->setBlockHeader(std::move(headerPtr));
+                    updateCommittedNumber(blockNumber);
                     callback(nullptr);
                 });
         });
@@ -1311,129 +1507,202 @@ void Ledger::asyncGetBlockTransactionHashes(bcos::protocol::BlockNumber blockNum
         });
 }
 
+template <class TransactionPtr>
 void Ledger::asyncBatchGetTransactions(std::shared_ptr<std::vector<std::string>> hashes,
-    std::function<void(Error::Ptr&&, std::vector<protocol::Transaction::Ptr>&&)> callback)
+    std::function<void(Error::Ptr&&, std::vector<TransactionPtr>&&)> callback)
 {
-    m_storage->asyncOpenTable(
-        SYS_HASH_2_TX, [this, hashes, callback](auto&& error, std::optional<Table>&& table) {
-            auto validError =
-                checkTableValid(std::forward<decltype(error)>(error), table, SYS_HASH_2_TX);
-            if (validError)
+    // serve the recently written transactions from cache or the segments, only the missed ones go
+    // to storage
+    auto transactions = std::make_shared<std::vector<TransactionPtr>>(hashes->size());
+    auto missed = std::make_shared<std::vector<size_t>>();
+    for (size_t i = 0; i < hashes->size(); ++i)
+    {
+        crypto::HashType hash((*hashes)[i], crypto::HashType::StringDataType::FromBinary);
+        if (auto transaction = m_txCache.get(hash))
+        {
+            if constexpr (std::is_same_v<TransactionPtr, protocol::Transaction::ConstPtr>)
             {
-                callback(std::move(validError), std::vector<protocol::Transaction::Ptr>());
-                return;
+                (*transactions)[i] = std::move(*transaction);
             }
-
-            std::vector<std::string_view> hashesView;
-            hashesView.reserve(hashes->size());
-            for (auto& hash : *hashes)
+            else
+            {
+                (*transactions)[i] = copyTransaction(**transaction);
+            }
+            continue;
+        }
+        if (m_segmentStore)
+        {
+            if (auto value = m_segmentStore->get(SegmentStore::TRANSACTION, hash))
             {
-                hashesView.push_back(hash);
+                (*transactions)[i] = m_blockFactory->transactionFactory()->createTransaction(
+                    bcos::ref(std::as_const(*value)), false, false);
+                continue;
             }
+        }
+        missed->push_back(i);
+    }
+    if (missed->empty())
+    {
+        callback(nullptr, std::move(*transactions));
+        return;
+    }
 
-            table->asyncGetRows(hashesView, [this, hashes, callback](auto&& error,
-                                                std::vector<std::optional<Entry>>&& entries) {
-                if (error)
-                {
-                    LEDGER_LOG(DEBUG)
-                        << "Batch get transaction failed " << boost::diagnostic_information(*error);
-                    callback(BCOS_ERROR_WITH_PREV_PTR(LedgerError::GetStorageError,
-                                 "Batch get transaction failed ", *error),
-                        std::vector<protocol::Transaction::Ptr>());
+    m_storage->asyncOpenTable(SYS_HASH_2_TX, [this, hashes, transactions, missed, callback](
+                                                 auto&& error, std::optional<Table>&& table) {
+        auto validError =
+            checkTableValid(std::forward<decltype(error)>(error), table, SYS_HASH_2_TX);
+        if (validError)
+        {
+            callback(std::move(validError), std::vector<TransactionPtr>());
+            return;
+        }
 
-                    return;
-                }
+        std::vector<std::string_view> hashesView;
+        hashesView.reserve(missed->size());
+        for (auto index : *missed)
+        {
+            hashesView.push_back((*hashes)[index]);
+        }
 
-                std::vector<protocol::Transaction::Ptr> transactions;
-                size_t i = 0;
-                for (auto& entry : entries)
-                {
-                    if (!entry.has_value())
-                    {
-                        LEDGER_LOG(TRACE)
-                            << "Get transaction failed: " << LOG_KV("txHash", toHex((*hashes)[i]));
-                    }
-                    else
-                    {
-                        auto field = entry->getField(0);
-                        auto transaction = m_blockFactory->transactionFactory()->createTransaction(
-                            bcos::bytesConstRef((bcos::byte*)field.data(), field.size()), false,
-                            false);
-                        transactions.push_back(std::move(transaction));
-                    }
+        table->asyncGetRows(hashesView, [this, hashes, transactions, missed, callback](
+                                            auto&& error,
+                                            std::vector<std::optional<Entry>>&& entries) {
+            if (error)
+            {
+                LEDGER_LOG(DEBUG) << "Batch get transaction failed "
+                                  << boost::diagnostic_information(*error);
+                callback(BCOS_ERROR_WITH_PREV_PTR(LedgerError::GetStorageError,
+                             "Batch get transaction failed ", *error),
+                    std::vector<TransactionPtr>());
 
-                    ++i;
-                }
-                if (transactions.size() != hashes->size())
+                return;
+            }
+
+            for (size_t i = 0; i < entries.size(); ++i)
+            {
+                auto index = (*missed)[i];
+                auto& entry = entries[i];
+                if (!entry.has_value())
                 {
-                    LEDGER_LOG(DEBUG)
-                        << "Batch get transaction failed, transactions size not match hashesSize"
-                        << LOG_KV("txsSize", transactions.size())
-                        << LOG_KV("hashesSize", hashes->size());
-                    callback(BCOS_ERROR_PTR(LedgerError::CollectAsyncCallbackError,
-                                 "Batch get transaction failed, transactions size not match "
-                                 "hashesSize, txsSize: " +
-                                     std::to_string(transactions.size()) +
-                                     ", hashesSize: " + std::to_string(hashes->size())),
-                        std::move(transactions));
-                    return;
+                    LEDGER_LOG(TRACE)
+                        << "Get transaction failed: " << LOG_KV("txHash", toHex((*hashes)[index]));
+                    continue;
                 }
+                auto field = entry->getField(0);
+                (*transactions)[index] = m_blockFactory->transactionFactory()->createTransaction(
+                    bcos::bytesConstRef((bcos::byte*)field.data(), field.size()), false, false);
+            }
 
-                callback(nullptr, std::move(transactions));
-            });
+            auto end = std::remove(transactions->begin(), transactions->end(), nullptr);
+            transactions->erase(end, transactions->end());
+            if (transactions->size() != hashes->size())
+            {
+                LEDGER_LOG(DEBUG)
+                    << "Batch get transaction failed, transactions size not match hashesSize"
+                    << LOG_KV("txsSize", transactions->size())
+                    << LOG_KV("hashesSize", hashes->size());
+                callback(BCOS_ERROR_PTR(LedgerError::CollectAsyncCallbackError,
+                             "Batch get transaction failed, transactions size not match "
+                             "hashesSize, txsSize: " +
+                                 std::to_string(transactions->size()) +
+                                 ", hashesSize: " + std::to_string(hashes->size())),
+                    std::move(*transactions));
+                return;
+            }
+
+            callback(nullptr, std::move(*transactions));
         });
+    });
 }
 
+template <class ReceiptPtr>
 void Ledger::asyncBatchGetReceipts(std::shared_ptr<std::vector<std::string>> hashes,
-    std::function<void(Error::Ptr&&, std::vector<protocol::TransactionReceipt::Ptr>&&)> callback)
+    std::function<void(Error::Ptr&&, std::vector<ReceiptPtr>&&)> callback)
 {
-    m_storage->asyncOpenTable(
-        SYS_HASH_2_RECEIPT, [this, hashes, callback](auto&& error, std::optional<Table>&& table) {
-            auto validError = checkTableValid(std::move(error), table, SYS_HASH_2_RECEIPT);
-            if (validError)
+    auto receipts = std::make_shared<std::vector<ReceiptPtr>>(hashes->size());
+    auto missed = std::make_shared<std::vector<size_t>>();
+    for (size_t i = 0; i < hashes->size(); ++i)
+    {
+        crypto::HashType hash((*hashes)[i], crypto::HashType::StringDataType::FromBinary);
+        if (auto receipt = m_receiptCache.get(hash))
+        {
+            if constexpr (std::is_same_v<ReceiptPtr, protocol::TransactionReceipt::ConstPtr>)
             {
-                callback(std::move(validError), std::vector<protocol::TransactionReceipt::Ptr>());
-                return;
+                (*receipts)[i] = std::move(*receipt);
             }
+            else
+            {
+                (*receipts)[i] = copyReceipt(**receipt);
+            }
+            continue;
+        }
+        if (m_segmentStore)
+        {
+            if (auto value = m_segmentStore->get(SegmentStore::RECEIPT, hash))
+            {
+                (*receipts)[i] = m_blockFactory->receiptFactory()->createReceipt(
+                    bcos::ref(std::as_const(*value)));
+                continue;
+            }
+        }
+        missed->push_back(i);
+    }
+    if (missed->empty())
+    {
+        callback(nullptr, std::move(*receipts));
+        return;
+    }
 
-            table->asyncGetRows(*hashes, [this, hashes, callback](auto&& error,
-                                             std::vector<std::optional<Entry>>&& entries) {
-                if (error)
-                {
-                    LEDGER_LOG(DEBUG)
-                        << "Batch get receipt failed!" << boost::diagnostic_information(*error);
-                    callback(BCOS_ERROR_WITH_PREV_PTR(
-                                 LedgerError::GetStorageError, "Batch get receipt failed!", *error),
-                        std::vector<protocol::TransactionReceipt::Ptr>());
+    m_storage->asyncOpenTable(SYS_HASH_2_RECEIPT, [this, hashes, receipts, missed, callback](
+                                                      auto&& error, std::optional<Table>&& table) {
+        auto validError = checkTableValid(std::move(error), table, SYS_HASH_2_RECEIPT);
+        if (validError)
+        {
+            callback(std::move(validError), std::vector<ReceiptPtr>());
+            return;
+        }
 
-                    return;
-                }
+        std::vector<std::string_view> hashesView;
+        hashesView.reserve(missed->size());
+        for (auto index : *missed)
+        {
+            hashesView.push_back((*hashes)[index]);
+        }
 
-                size_t i = 0;
-                std::vector<protocol::TransactionReceipt::Ptr> receipts;
-                receipts.reserve(hashes->size());
-                for (auto& entry : entries)
-                {
-                    if (!entry.has_value())
-                    {
-                        LEDGER_LOG(DEBUG) << "Get receipt with empty entry: " << (*hashes)[i];
-                        callback(BCOS_ERROR_PTR(
-                                     LedgerError::GetStorageError, "Batch get transaction failed"),
-                            std::vector<protocol::TransactionReceipt::Ptr>());
-                        return;
-                    }
+        table->asyncGetRows(hashesView, [this, hashes, receipts, missed, callback](auto&& error,
+                                            std::vector<std::optional<Entry>>&& entries) {
+            if (error)
+            {
+                LEDGER_LOG(DEBUG)
+                    << "Batch get receipt failed!" << boost::diagnostic_information(*error);
+                callback(BCOS_ERROR_WITH_PREV_PTR(
+                             LedgerError::GetStorageError, "Batch get receipt failed!", *error),
+                    std::vector<ReceiptPtr>());
 
-                    auto field = entry->getField(0);
-                    auto receipt = m_blockFactory->receiptFactory()->createReceipt(
-                        bcos::bytesConstRef((bcos::byte*)field.data(), field.size()));
-                    receipts.push_back(std::move(receipt));
+                return;
+            }
 
-                    ++i;
+            for (size_t i = 0; i < entries.size(); ++i)
+            {
+                auto index = (*missed)[i];
+                auto& entry = entries[i];
+                if (!entry.has_value())
+                {
+                    LEDGER_LOG(DEBUG) << "Get receipt with empty entry: " << (*hashes)[index];
+                    callback(BCOS_ERROR_PTR(
+                                 LedgerError::GetStorageError, "Batch get transaction failed"),
+                        std::vector<ReceiptPtr>());
+                    return;
                 }
 
-                callback(nullptr, std::move(receipts));
-            });
+                auto field = entry->getField(0);
+                (*receipts)[index] = m_blockFactory->receiptFactory()->createReceipt(
+                    bcos::bytesConstRef((bcos::byte*)field.data(), field.size()));
+            }
+
+            callback(nullptr, std::move(*receipts));
         });
+    });
 }
 
 void Ledger::asyncGetSystemTableEntry(const std::string_view& table, const std::string_view& key,
@@ -1539,10 +1808,11 @@ void Ledger::getTxProof(
                         _onGetProof(std::forward<decltype(_error)>(_error), nullptr);
                         return;
                     }
-                    asyncBatchGetTransactions(std::make_shared<std::vector<std::string>>(_hashList),
+                    asyncBatchGetTransactions<Transaction::ConstPtr>(
+                        std::make_shared<std::vector<std::string>>(_hashList),
                         [this, cryptoSuite = m_blockFactory->cryptoSuite(), _onGetProof,
                             _txHash = std::move(_txHash), blockNumber](
-                            Error::Ptr&& _error, std::vector<Transaction::Ptr>&& _txList) {
+                            Error::Ptr&& _error, std::vector<Transaction::ConstPtr>&& _txList) {
                             if (_error || _txList.empty())
                             {
                                 LEDGER_LOG(DEBUG)
@@ -1555,10 +1825,10 @@ void Ledger::getTxProof(
                             auto merkleProofPtr = std::make_shared<MerkleProof>();
                             bcos::crypto::merkle::Merkle merkle(cryptoSuite->hashImpl()->hasher());
                             auto hashesRange =
-                                _txList |
-                                RANGES::views::transform([](const Transaction::Ptr& transaction) {
-                                    return transaction->hash();
-                                });
+                                _txList | RANGES::views::transform(
+                                              [](const Transaction::ConstPtr& transaction) {
+                                                  return transaction->hash();
+                                              });
 
                             auto merkleTree =
                                 getMerkleTreeFromCache(blockNumber, m_txProofMerkleCache,
@@ -1576,7 +1846,7 @@ void Ledger::getTxProof(
         });
 }
 
-void Ledger::getReceiptProof(protocol::TransactionReceipt::Ptr _receipt,
+void Ledger::getReceiptProof(protocol::TransactionReceipt::ConstPtr _receipt,
     std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof)
 {
     // receipt->number number->txs txs->receipts
@@ -1590,10 +1860,11 @@ void Ledger::getReceiptProof(protocol::TransactionReceipt::Ptr _receipt,
                 return;
             }
 
-            asyncBatchGetReceipts(std::make_shared<std::vector<std::string>>(_hashList),
+            asyncBatchGetReceipts<protocol::TransactionReceipt::ConstPtr>(
+                std::make_shared<std::vector<std::string>>(_hashList),
                 [this, cryptoSuite = this->m_blockFactory->cryptoSuite(), _onGetProof,
                     receiptHash = receiptHash, blockNumber](Error::Ptr&& _error,
-                    std::vector<protocol::TransactionReceipt::Ptr>&& _receiptList) {
+                    std::vector<protocol::TransactionReceipt::ConstPtr>&& _receiptList) {
                     if (_error || _receiptList.empty())
                     {
                         LEDGER_LOG(DEBUG) << LOG_BADGE("getReceiptProof")
@@ -1605,8 +1876,9 @@ void Ledger::getReceiptProof(protocol::TransactionReceipt::Ptr _receipt,
                     bcos::crypto::merkle::Merkle merkle(cryptoSuite->hashImpl()->hasher());
                     auto hashesRange =
                         _receiptList |
-                        RANGES::views::transform(
-                            [](const TransactionReceipt::Ptr& receipt) { return receipt->hash(); });
+                        RANGES::views::transform([](const TransactionReceipt::ConstPtr& receipt) {
+                            return receipt->hash();
+                        });
 
                     auto merkleTree = getMerkleTreeFromCache(blockNumber, m_receiptProofMerkleCache,
                         m_receiptMerkleMtx, "getReceiptProof", merkle, hashesRange);
@@ -28,15 +28,22 @@
 #include "bcos-framework/protocol/ProtocolTypeDef.h"
 #include "bcos-framework/storage/Common.h"
 #include "bcos-framework/storage/StorageInterface.h"
+#include "SegmentStore.h"
 #include "utilities/Common.h"
+#include "utilities/ShardedCache.h"
 #include <bcos-tool/NodeConfig.h>
 #include <bcos-utilities/Common.h>
+#include <bcos-utilities/BinaryLog.h>
 #include <bcos-utilities/Exceptions.h>
 #include <bcos-utilities/ThreadPool.h>
 #include <boost/compute/detail/lru_cache.hpp>
+#include <atomic>
 #include <utility>
 
 #define LEDGER_LOG(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE("LEDGER")
+// deferred-format LEDGER_LOG for the hot paths, see BCOS_BINARY_LOG
+#define LEDGER_BINARY_LOG(LEVEL, ...) BCOS_BINARY_LOG(LEVEL, "LEDGER", __VA_ARGS__)
+#define LEDGER_METRIC_LOG(LEVEL, ...) BCOS_BINARY_LOG(LEVEL, "LEDGER", "[METRIC]" __VA_ARGS__)
 
 namespace bcos::ledger
 {
@@ -45,15 +52,24 @@ class Ledger : public LedgerInterface
 public:
     using CacheType =
         boost::compute::detail::lru_cache<int64_t, std::shared_ptr<std::vector<h256>>>;
+    using TransactionCache = ShardedCache<crypto::HashType, protocol::Transaction::ConstPtr>;
+    using ReceiptCache = ShardedCache<crypto::HashType, protocol::TransactionReceipt::ConstPtr>;
+    using HeaderCache = ShardedCache<protocol::BlockNumber, protocol::BlockHeader::ConstPtr>;
+    // bytes held by the transaction and the receipt caches together
+    constexpr static size_t DEFAULT_HOT_CACHE_SIZE = 128 * 1024 * 1024;
 
     Ledger(bcos::protocol::BlockFactory::Ptr _blockFactory,
-        bcos::storage::StorageInterface::Ptr _storage, int merkleTreeCacheSize = 100)
+        bcos::storage::StorageInterface::Ptr _storage, int merkleTreeCacheSize = 100,
+        size_t hotCacheSize = DEFAULT_HOT_CACHE_SIZE)
       : m_blockFactory(std::move(_blockFactory)),
         m_storage(std::move(_storage)),
         m_threadPool(std::make_shared<ThreadPool>("WriteReceipts", 1)),
         m_merkleTreeCacheSize(merkleTreeCacheSize),
         m_txProofMerkleCache(m_merkleTreeCacheSize),
-        m_receiptProofMerkleCache(m_merkleTreeCacheSize)
+        m_receiptProofMerkleCache(m_merkleTreeCacheSize),
+        m_txCache(hotCacheSize / 2),
+        m_receiptCache(hotCacheSize / 2),
+        m_headerCache(m_merkleTreeCacheSize)
     {}
 
     ~Ledger() override = default;
@@ -91,6 +107,10 @@ public:
             Error::Ptr, bcos::protocol::TransactionReceipt::ConstPtr, MerkleProofPtr)>
             _onGetTx) override;
 
+    void asyncGetBatchReceiptsByHashList(crypto::HashListPtr _txHashList,
+        std::function<void(Error::Ptr, std::vector<protocol::TransactionReceipt::ConstPtr>)>
+            _onGetReceipts) override;
+
     void asyncGetTotalTransactionCount(
         std::function<void(Error::Ptr, int64_t, int64_t, bcos::protocol::BlockNumber)> _callback)
         override;
@@ -116,6 +136,14 @@ public:
     void asyncGetBlockTransactionHashes(bcos::protocol::BlockNumber blockNumber,
         std::function<void(Error::Ptr&&, std::vector<std::string>&&)> callback);
 
+    // store the transactions and receipts in the append-only segments instead of the state db,
+    // the rows written before are still read from the state db
+    void setSegmentStore(SegmentStore::Ptr _segmentStore)
+    {
+        m_segmentStore = std::move(_segmentStore);
+    }
+    SegmentStore::Ptr segmentStore() const { return m_segmentStore; }
+
 private:
     Error::Ptr checkTableValid(Error::UniquePtr&& error,
         const std::optional<bcos::storage::Table>& table, const std::string_view& tableName);
@@ -126,17 +154,24 @@ private:
     void asyncGetBlockHeader(bcos::protocol::Block::Ptr block,
         bcos::protocol::BlockNumber blockNumber, std::function<void(Error::Ptr&&)> callback);
 
+    // TransactionPtr is Transaction::ConstPtr to share the cached objects with the caller, or
+    // Transaction::Ptr to get a copy of them that the caller may modify
+    template <class TransactionPtr>
     void asyncBatchGetTransactions(std::shared_ptr<std::vector<std::string>> hashes,
-        std::function<void(Error::Ptr&&, std::vector<protocol::Transaction::Ptr>&&)> callback);
+        std::function<void(Error::Ptr&&, std::vector<TransactionPtr>&&)> callback);
 
+    template <class ReceiptPtr>
     void asyncBatchGetReceipts(std::shared_ptr<std::vector<std::string>> hashes,
-        std::function<void(Error::Ptr&&, std::vector<protocol::TransactionReceipt::Ptr>&&)>
-            callback);
+        std::function<void(Error::Ptr&&, std::vector<ReceiptPtr>&&)> callback);
+
+    protocol::Transaction::Ptr copyTransaction(protocol::Transaction const& _transaction) const;
+    protocol::TransactionReceipt::Ptr copyReceipt(
+        protocol::TransactionReceipt const& _receipt) const;
 
     void getTxProof(const crypto::HashType& _txHash,
         std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof);
 
-    void getReceiptProof(protocol::TransactionReceipt::Ptr _receipt,
+    void getReceiptProof(protocol::TransactionReceipt::ConstPtr _receipt,
         std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof);
 
     void asyncGetSystemTableEntry(const std::string_view& table, const std::string_view& key,
@@ -157,6 +192,15 @@ private:
     needStoreUnsavedTxs(
         bcos::protocol::ConstTransactionsPtr _blockTxs, bcos::protocol::Block::ConstPtr _block);
 
+    // fill the hot caches with the objects of the block being written
+    void cacheTransactionsAndReceipts(bcos::protocol::ConstTransactionsPtr const& _blockTxs,
+        bcos::protocol::Block::ConstPtr const& _block);
+    void updateCommittedNumber(protocol::BlockNumber _number);
+
+    // write to SYS_HASH_2_TX or SYS_HASH_2_RECEIPT, or to the segment store if it is set
+    Error::Ptr setTxsOrReceipts(std::string_view _table, std::vector<std::string_view> const& _keys,
+        std::vector<std::string_view> const& _values);
+
     bcos::consensus::ConsensusNodeListPtr selectWorkingSealer(
         const bcos::ledger::LedgerConfig& _ledgerConfig, std::int64_t _epochSealerNum);
 
@@ -172,5 +216,16 @@ private:
     RecursiveMutex m_receiptMerkleMtx;
     CacheType m_txProofMerkleCache;
     CacheType m_receiptProofMerkleCache;
+
+    // decoded objects of the recently written blocks, the clients mostly poll the latest blocks;
+    // the objects are shared by all the readers, never hand them out as mutable
+    TransactionCache m_txCache;
+    ReceiptCache m_receiptCache;
+    // the headers are written in the 2pc prewrite, only the ones not newer than the committed
+    // number are served, a rolled back block is overwritten by its successor of the same number
+    HeaderCache m_headerCache;
+    std::atomic<protocol::BlockNumber> m_committedNumber = -1;
+
+    SegmentStore::Ptr m_segmentStore;
 };
 }  // namespace bcos::ledger
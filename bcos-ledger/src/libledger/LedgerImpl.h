@@ -49,8 +49,9 @@ class LedgerImpl : public bcos::concepts::ledger::LedgerBase<LedgerImpl<Hasher,
 
 public:
     LedgerImpl(Hasher hasher, Storage storage, bcos::protocol::BlockFactory::Ptr blockFactory,
-        bcos::storage::StorageInterface::Ptr storageInterface)
-      : Ledger(std::move(blockFactory), storageInterface),
+        bcos::storage::StorageInterface::Ptr storageInterface,
+        size_t hotCacheSize = DEFAULT_HOT_CACHE_SIZE)
+      : Ledger(std::move(blockFactory), storageInterface, 100, hotCacheSize),
         m_hasher(std::move(hasher)),
         m_backupStorage(storageInterface),
         m_storage{std::move(storage)},
@@ -233,15 +234,39 @@ private:
         bcos::concepts::resizeTo(out, RANGES::size(hashes));
         using DataType = RANGES::range_value_t<std::remove_cvref_t<decltype(out)>>;
 
-        constexpr auto tableName =
-            bcos::concepts::transaction::Transaction<DataType> ? SYS_HASH_2_TX : SYS_HASH_2_RECEIPT;
+        constexpr auto isTransaction = bcos::concepts::transaction::Transaction<DataType>;
+        constexpr auto tableName = isTransaction ? SYS_HASH_2_TX : SYS_HASH_2_RECEIPT;
 
         LEDGER_LOG(INFO) << "getTransactions: " << tableName << " " << RANGES::size(hashes);
-        auto entries = storage().getRows(std::string_view{tableName}, hashes);
+        // the rows appended to the segment store first, the rows written before it was enabled
+        // are still in the storage
+        std::vector<size_t> missed;
+        std::vector<std::string_view> missedKeys;
+        auto segmentStore = this->segmentStore();
+        for (auto&& [index, hash] : RANGES::views::enumerate(hashes))
+        {
+            if (segmentStore)
+            {
+                auto value = segmentStore->get(
+                    isTransaction ? SegmentStore::TRANSACTION : SegmentStore::RECEIPT,
+                    crypto::HashType((const bcos::byte*)RANGES::data(hash), RANGES::size(hash)));
+                if (value)
+                {
+                    bcos::concepts::serialize::decode(bcos::ref(std::as_const(*value)), out[index]);
+                    continue;
+                }
+            }
+            missed.emplace_back(index);
+            missedKeys.emplace_back((const char*)RANGES::data(hash), RANGES::size(hash));
+        }
+        if (missed.empty())
+        {
+            co_return;
+        }
+        auto entries = storage().getRows(std::string_view{tableName}, missedKeys);
 
-        bcos::concepts::resizeTo(out, RANGES::size(hashes));
         tbb::parallel_for(tbb::blocked_range<size_t>(0U, RANGES::size(entries)),
-            [&entries, &out](const tbb::blocked_range<size_t>& range) {
+            [&entries, &missed, &out](const tbb::blocked_range<size_t>& range) {
                 for (auto index = range.begin(); index != range.end(); ++index)
                 {
                     if (!entries[index])
@@ -254,7 +279,7 @@ private:
                     auto field = entries[index]->getField(0);
                     auto bytesRef =
                         bcos::bytesConstRef((const bcos::byte*)field.data(), field.size());
-                    bcos::concepts::serialize::decode(bytesRef, out[index]);
+                    bcos::concepts::serialize::decode(bytesRef, out[missed[index]]);
                 }
             });
 
@@ -0,0 +1,606 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief append-only segment files for the transactions and receipts
+ * @file SegmentStore.cpp
+ */
+#include "SegmentStore.h"
+#include "utilities/Common.h"
+#include <bcos-utilities/BoostLog.h>
+#include <boost/filesystem.hpp>
+#include <boost/throw_exception.hpp>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+using namespace bcos;
+using namespace bcos::ledger;
+
+namespace
+{
+constexpr size_t HASH_SIZE = crypto::HashType::SIZE;
+constexpr size_t KEY_SIZE = 1 + HASH_SIZE;
+constexpr size_t INDEX_RECORD_SIZE = KEY_SIZE + sizeof(uint64_t) + sizeof(uint32_t);
+
+// dir/<id>.sidx: [magic(8)][transactions(8)][receipts(8)][bloomBlocks(8)], the bloom blocks, then
+// the index records sorted by [kind][hash]
+constexpr std::string_view SEALED_MAGIC = "BCOSSIX1";
+constexpr size_t SEALED_HEADER_SIZE = SEALED_MAGIC.size() + 3 * sizeof(uint64_t);
+constexpr size_t BLOOM_BLOCK_BITS = 512;
+constexpr size_t BLOOM_BITS_PER_KEY = 10;
+constexpr size_t BLOOM_PROBES = 7;
+
+bool writeAll(int _fd, const bcos::byte* _data, size_t _size, uint64_t _offset)
+{
+    while (_size > 0)
+    {
+        auto written = ::pwrite(_fd, _data, _size, (off_t)_offset);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        _data += written;
+        _size -= written;
+        _offset += written;
+    }
+    return true;
+}
+
+bool readAll(int _fd, bcos::byte* _data, size_t _size, uint64_t _offset)
+{
+    while (_size > 0)
+    {
+        auto got = ::pread(_fd, _data, _size, (off_t)_offset);
+        if (got < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (got <= 0)
+        {
+            return false;
+        }
+        _data += got;
+        _size -= got;
+        _offset += got;
+    }
+    return true;
+}
+
+template <class Integer>
+void putInteger(bcos::byte* _out, Integer _value)
+{
+    for (size_t i = 0; i < sizeof(Integer); ++i)
+    {
+        _out[i] = (bcos::byte)(_value >> (i * 8));
+    }
+}
+
+template <class Integer>
+Integer getInteger(const bcos::byte* _in)
+{
+    Integer value = 0;
+    for (size_t i = 0; i < sizeof(Integer); ++i)
+    {
+        value |= (Integer)_in[i] << (i * 8);
+    }
+    return value;
+}
+
+uint64_t mix(uint64_t _value)
+{
+    _value ^= _value >> 30;
+    _value *= 0xbf58476d1ce4e5b9ULL;
+    _value ^= _value >> 27;
+    _value *= 0x94d049bb133111ebULL;
+    return _value ^ (_value >> 31);
+}
+
+// the bloom hash is persisted, it must not depend on the platform or the build
+uint64_t keyHash(const bcos::byte* _key)
+{
+    uint64_t hash = _key[0];
+    for (size_t i = 0; i < HASH_SIZE; i += sizeof(uint64_t))
+    {
+        hash = mix(hash ^ getInteger<uint64_t>(_key + 1 + i));
+    }
+    return hash;
+}
+
+// one cache line per key: the block is chosen by the hash, the probes are 9 bit slices of a
+// second hash
+template <class Visit>
+bool visitBloom(uint64_t _blocks, const bcos::byte* _key, Visit&& _visit)
+{
+    auto hash = keyHash(_key);
+    auto block = hash % _blocks;
+    auto probes = mix(hash);
+    for (size_t i = 0; i < BLOOM_PROBES; ++i)
+    {
+        auto bit = block * BLOOM_BLOCK_BITS + ((probes >> (i * 9)) & (BLOOM_BLOCK_BITS - 1));
+        if (!_visit(bit / 8, (bcos::byte)(1U << (bit % 8))))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int compareKey(const bcos::byte* _lhs, const bcos::byte* _rhs)
+{
+    return std::memcmp(_lhs, _rhs, KEY_SIZE);
+}
+
+// reads the index records of a segment, only keeps the records whose data is complete, the tail
+// of an interrupted append is dropped
+bcos::bytes readIndex(int _indexFd, uint64_t _dataSize, std::string const& _path)
+{
+    auto indexSize = (uint64_t)::lseek(_indexFd, 0, SEEK_END);
+    bcos::bytes index(indexSize - indexSize % INDEX_RECORD_SIZE);
+    if (!readAll(_indexFd, index.data(), index.size(), 0))
+    {
+        BOOST_THROW_EXCEPTION(
+            BCOS_ERROR(LedgerError::SegmentStoreError, "read index " + _path + " failed"));
+    }
+    for (size_t pos = 0; pos < index.size(); pos += INDEX_RECORD_SIZE)
+    {
+        const auto* record = index.data() + pos;
+        auto offset = getInteger<uint64_t>(record + KEY_SIZE);
+        auto size = getInteger<uint32_t>(record + KEY_SIZE + sizeof(uint64_t));
+        if (record[0] > SegmentStore::RECEIPT || offset + size > _dataSize)
+        {
+            LEDGER_LOG(WARNING) << LOG_BADGE("SegmentStore") << LOG_DESC("drop broken index tail")
+                                << LOG_KV("index", _path)
+                                << LOG_KV("records", pos / INDEX_RECORD_SIZE);
+            index.resize(pos);
+            break;
+        }
+    }
+    return index;
+}
+}  // namespace
+
+SegmentStore::SegmentStore(std::string _path, uint64_t _segmentSize, bool _sync)
+  : m_path(std::move(_path)), m_segmentSize(_segmentSize), m_sync(_sync)
+{
+    boost::filesystem::create_directories(m_path);
+    load();
+}
+
+SegmentStore::~SegmentStore()
+{
+    for (auto& segment : m_segments)
+    {
+        ::close(segment.dataFd);
+        if (segment.indexFd >= 0)
+        {
+            ::close(segment.indexFd);
+        }
+        if (segment.sealed.mapped != nullptr)
+        {
+            ::munmap((void*)segment.sealed.mapped, segment.sealed.mappedSize);
+        }
+    }
+}
+
+std::string SegmentStore::segmentPath(uint32_t _id, std::string_view _suffix) const
+{
+    std::stringstream name;
+    name << std::setw(10) << std::setfill('0') << _id << _suffix;
+    return (boost::filesystem::path(m_path) / name.str()).string();
+}
+
+void SegmentStore::openSegment(uint32_t _id)
+{
+    Segment segment;
+    segment.dataFd = ::open(segmentPath(_id, ".seg").c_str(), O_RDWR | O_CREAT, 0644);
+    segment.indexFd = ::open(segmentPath(_id, ".idx").c_str(), O_RDWR | O_CREAT, 0644);
+    if (segment.dataFd < 0 || segment.indexFd < 0)
+    {
+        auto message = "open segment " + segmentPath(_id, "") + " failed: " + std::strerror(errno);
+        ::close(segment.dataFd);
+        ::close(segment.indexFd);
+        BOOST_THROW_EXCEPTION(BCOS_ERROR(LedgerError::SegmentStoreError, message));
+    }
+    m_segments.push_back(segment);
+}
+
+void SegmentStore::loadActiveSegment(uint32_t _id)
+{
+    openSegment(_id);
+    auto& segment = m_segments.back();
+    auto dataSize = (uint64_t)::lseek(segment.dataFd, 0, SEEK_END);
+    auto indexSize = (uint64_t)::lseek(segment.indexFd, 0, SEEK_END);
+    auto index = readIndex(segment.indexFd, dataSize, segmentPath(_id, ".idx"));
+
+    uint64_t validDataSize = 0;
+    for (size_t pos = 0; pos < index.size(); pos += INDEX_RECORD_SIZE)
+    {
+        const auto* record = index.data() + pos;
+        auto offset = getInteger<uint64_t>(record + KEY_SIZE);
+        auto size = getInteger<uint32_t>(record + KEY_SIZE + sizeof(uint64_t));
+        m_activeIndex[record[0]][crypto::HashType(bcos::bytesConstRef(record + 1, HASH_SIZE))] =
+            Location{.segment = _id, .size = size, .offset = offset};
+        validDataSize = std::max(validDataSize, offset + size);
+    }
+
+    if ((index.size() != indexSize && ::ftruncate(segment.indexFd, (off_t)index.size()) != 0) ||
+        (validDataSize != dataSize && ::ftruncate(segment.dataFd, (off_t)validDataSize) != 0))
+    {
+        BOOST_THROW_EXCEPTION(BCOS_ERROR(LedgerError::SegmentStoreError,
+            "truncate segment " + segmentPath(_id, "") + " failed"));
+    }
+    segment.dataSize = validDataSize;
+    segment.indexSize = index.size();
+}
+
+void SegmentStore::loadSealedSegment(uint32_t _id)
+{
+    openSegment(_id);
+    auto& segment = m_segments.back();
+    segment.dataSize = (uint64_t)::lseek(segment.dataFd, 0, SEEK_END);
+    segment.sealed = mapIndex(_id);
+    if (segment.sealed.mapped == nullptr)
+    {
+        // sealed before the .sidx was synced, build it again from the .idx
+        segment.sealed = sealIndex(
+            _id, readIndex(segment.indexFd, segment.dataSize, segmentPath(_id, ".idx")));
+    }
+    ::close(segment.indexFd);
+    segment.indexFd = -1;
+    for (auto kind : {TRANSACTION, RECEIPT})
+    {
+        m_sealedCounts[kind] += segment.sealed.counts[kind];
+    }
+}
+
+SegmentStore::SealedIndex SegmentStore::mapIndex(uint32_t _id) const
+{
+    auto path = segmentPath(_id, ".sidx");
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return {};
+    }
+    struct stat status;
+    if (::fstat(fd, &status) != 0 || (size_t)status.st_size < SEALED_HEADER_SIZE)
+    {
+        ::close(fd);
+        return {};
+    }
+    auto* mapped = ::mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED)
+    {
+        LEDGER_LOG(WARNING) << LOG_BADGE("SegmentStore") << LOG_DESC("map sealed index failed")
+                            << LOG_KV("index", path) << LOG_KV("error", std::strerror(errno));
+        return {};
+    }
+    // the lookups are binary searches, read ahead only wastes the page cache
+    ::madvise(mapped, (size_t)status.st_size, MADV_RANDOM);
+
+    SealedIndex sealed{.mapped = (const bcos::byte*)mapped, .mappedSize = (size_t)status.st_size};
+    const auto* header = sealed.mapped + SEALED_MAGIC.size();
+    sealed.counts[TRANSACTION] = getInteger<uint64_t>(header);
+    sealed.counts[RECEIPT] = getInteger<uint64_t>(header + sizeof(uint64_t));
+    sealed.bloomBlocks = getInteger<uint64_t>(header + 2 * sizeof(uint64_t));
+    sealed.bloom = sealed.mapped + SEALED_HEADER_SIZE;
+    sealed.records = sealed.bloom + sealed.bloomBlocks * BLOOM_BLOCK_BITS / 8;
+    auto expectSize = SEALED_HEADER_SIZE + sealed.bloomBlocks * BLOOM_BLOCK_BITS / 8 +
+                      (sealed.counts[TRANSACTION] + sealed.counts[RECEIPT]) * INDEX_RECORD_SIZE;
+    if (std::memcmp(sealed.mapped, SEALED_MAGIC.data(), SEALED_MAGIC.size()) != 0 ||
+        sealed.bloomBlocks == 0 || expectSize != sealed.mappedSize)
+    {
+        LEDGER_LOG(WARNING) << LOG_BADGE("SegmentStore") << LOG_DESC("invalid sealed index")
+                            << LOG_KV("index", path);
+        ::munmap(mapped, sealed.mappedSize);
+        return {};
+    }
+    return sealed;
+}
+
+SegmentStore::SealedIndex SegmentStore::sealIndex(uint32_t _id, bcos::bytes _records) const
+{
+    auto count = _records.size() / INDEX_RECORD_SIZE;
+    std::vector<const bcos::byte*> records(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        records[i] = _records.data() + i * INDEX_RECORD_SIZE;
+    }
+    // a hash written twice keeps its last record, the same as the map of the active segment
+    std::stable_sort(records.begin(), records.end(),
+        [](auto* lhs, auto* rhs) { return compareKey(lhs, rhs) < 0; });
+    std::vector<const bcos::byte*> unique;
+    unique.reserve(count);
+    for (auto* record : records)
+    {
+        if (!unique.empty() && compareKey(unique.back(), record) == 0)
+        {
+            unique.back() = record;
+            continue;
+        }
+        unique.push_back(record);
+    }
+
+    uint64_t counts[2] = {0, 0};
+    for (auto* record : unique)
+    {
+        ++counts[record[0]];
+    }
+    auto bloomBlocks =
+        std::max<uint64_t>(1, (unique.size() * BLOOM_BITS_PER_KEY + BLOOM_BLOCK_BITS - 1) /
+                                  BLOOM_BLOCK_BITS);
+    bcos::bytes sealed(SEALED_HEADER_SIZE + bloomBlocks * BLOOM_BLOCK_BITS / 8 +
+                       unique.size() * INDEX_RECORD_SIZE);
+    std::memcpy(sealed.data(), SEALED_MAGIC.data(), SEALED_MAGIC.size());
+    auto* header = sealed.data() + SEALED_MAGIC.size();
+    putInteger(header, counts[TRANSACTION]);
+    putInteger(header + sizeof(uint64_t), counts[RECEIPT]);
+    putInteger(header + 2 * sizeof(uint64_t), bloomBlocks);
+    auto* bloom = sealed.data() + SEALED_HEADER_SIZE;
+    auto* out = bloom + bloomBlocks * BLOOM_BLOCK_BITS / 8;
+    for (auto* record : unique)
+    {
+        visitBloom(bloomBlocks, record, [&](size_t byte, bcos::byte mask) {
+            bloom[byte] |= mask;
+            return true;
+        });
+        std::memcpy(out, record, INDEX_RECORD_SIZE);
+        out += INDEX_RECORD_SIZE;
+    }
+
+    // write aside and rename, a crash never leaves a partial .sidx behind
+    auto path = segmentPath(_id, ".sidx");
+    auto tmpPath = path + ".tmp";
+    auto fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || !writeAll(fd, sealed.data(), sealed.size(), 0) ||
+        (m_sync && ::fsync(fd) != 0) || ::close(fd) != 0 ||
+        ::rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        auto message = "write sealed index " + path + " failed: " + std::strerror(errno);
+        BOOST_THROW_EXCEPTION(BCOS_ERROR(LedgerError::SegmentStoreError, message));
+    }
+
+    auto index = mapIndex(_id);
+    if (index.mapped == nullptr)
+    {
+        BOOST_THROW_EXCEPTION(
+            BCOS_ERROR(LedgerError::SegmentStoreError, "map sealed index " + path + " failed"));
+    }
+    LEDGER_LOG(INFO) << LOG_BADGE("SegmentStore") << LOG_DESC("seal segment") << LOG_KV("id", _id)
+                     << LOG_KV("transactions", counts[TRANSACTION])
+                     << LOG_KV("receipts", counts[RECEIPT]);
+    return index;
+}
+
+void SegmentStore::load()
+{
+    uint32_t count = 0;
+    while (boost::filesystem::exists(segmentPath(count, ".seg")))
+    {
+        ++count;
+    }
+    for (uint32_t id = 0; id + 1 < count; ++id)
+    {
+        loadSealedSegment(id);
+    }
+    loadActiveSegment(count > 0 ? count - 1 : 0);
+    LEDGER_LOG(INFO) << LOG_BADGE("SegmentStore") << LOG_DESC("load segments")
+                     << LOG_KV("path", m_path) << LOG_KV("segments", m_segments.size())
+                     << LOG_KV("transactions", size(TRANSACTION))
+                     << LOG_KV("receipts", size(RECEIPT));
+}
+
+Error::Ptr SegmentStore::append(std::initializer_list<Batch> _batches)
+{
+    size_t count = 0;
+    size_t dataSize = 0;
+    for (auto const& batch : _batches)
+    {
+        if (batch.keys.size() != batch.values.size())
+        {
+            return BCOS_ERROR_PTR(LedgerError::ErrorArgument, "keys and values size mismatch");
+        }
+        for (size_t i = 0; i < batch.keys.size(); ++i)
+        {
+            if (batch.keys[i].size() != HASH_SIZE)
+            {
+                return BCOS_ERROR_PTR(LedgerError::ErrorArgument, "invalid hash key size");
+            }
+            dataSize += batch.values[i].size();
+        }
+        count += batch.keys.size();
+    }
+    if (count == 0)
+    {
+        return nullptr;
+    }
+
+    std::unique_lock writeLock(m_writeMutex);
+    if (m_segments.back().dataSize >= m_segmentSize)
+    {
+        // seal the full segment, its in memory index is replaced by the mapped sorted one
+        auto id = (uint32_t)(m_segments.size() - 1);
+        auto& full = m_segments.back();
+        SealedIndex sealed;
+        try
+        {
+            sealed = sealIndex(id, readIndex(full.indexFd, full.dataSize, segmentPath(id, ".idx")));
+        }
+        catch (std::exception const& e)
+        {
+            LEDGER_LOG(ERROR) << LOG_BADGE("SegmentStore") << LOG_DESC("seal segment failed")
+                              << LOG_KV("id", id) << LOG_KV("error", e.what());
+            return BCOS_ERROR_PTR(LedgerError::SegmentStoreError, e.what());
+        }
+
+        std::unique_lock lock(m_mutex);
+        full.sealed = sealed;
+        ::close(full.indexFd);
+        full.indexFd = -1;
+        for (auto kind : {TRANSACTION, RECEIPT})
+        {
+            m_sealedCounts[kind] += sealed.counts[kind];
+            m_activeIndex[kind].clear();
+        }
+        openSegment(id + 1);
+    }
+    auto id = (uint32_t)(m_segments.size() - 1);
+    // the segment list is only changed by the appenders, it is safe to use it without m_mutex
+    auto segment = m_segments.back();
+
+    bcos::bytes data;
+    data.reserve(dataSize);
+    bcos::bytes index(count * INDEX_RECORD_SIZE);
+    auto* record = index.data();
+    auto offset = segment.dataSize;
+    for (auto const& batch : _batches)
+    {
+        for (size_t i = 0; i < batch.keys.size(); ++i)
+        {
+            auto value = batch.values[i];
+            record[0] = batch.kind;
+            std::memcpy(record + 1, batch.keys[i].data(), HASH_SIZE);
+            putInteger(record + KEY_SIZE, offset);
+            putInteger(record + KEY_SIZE + sizeof(uint64_t), (uint32_t)value.size());
+            data.insert(data.end(), value.begin(), value.end());
+            offset += value.size();
+            record += INDEX_RECORD_SIZE;
+        }
+    }
+
+    // data before index, so a complete index record always points to complete data; one sync of
+    // each file covers all the batches
+    if (!writeAll(segment.dataFd, data.data(), data.size(), segment.dataSize) ||
+        (m_sync && ::fsync(segment.dataFd) != 0) ||
+        !writeAll(segment.indexFd, index.data(), index.size(), segment.indexSize) ||
+        (m_sync && ::fsync(segment.indexFd) != 0))
+    {
+        auto message = std::string("append segment failed: ") + std::strerror(errno);
+        LEDGER_LOG(ERROR) << LOG_BADGE("SegmentStore") << LOG_DESC(message)
+                          << LOG_KV("segment", id);
+        // drop the partial write, the next append starts from the same offsets again
+        [[maybe_unused]] auto ret = ::ftruncate(segment.dataFd, (off_t)segment.dataSize);
+        ret = ::ftruncate(segment.indexFd, (off_t)segment.indexSize);
+        return BCOS_ERROR_PTR(LedgerError::SegmentStoreError, message);
+    }
+
+    std::unique_lock lock(m_mutex);
+    m_segments.back().dataSize += data.size();
+    m_segments.back().indexSize += index.size();
+    for (size_t pos = 0; pos < index.size(); pos += INDEX_RECORD_SIZE)
+    {
+        const auto* written = index.data() + pos;
+        m_activeIndex[written[0]][crypto::HashType(bcos::bytesConstRef(written + 1, HASH_SIZE))] =
+            Location{.segment = id,
+                .size = getInteger<uint32_t>(written + KEY_SIZE + sizeof(uint64_t)),
+                .offset = getInteger<uint64_t>(written + KEY_SIZE)};
+    }
+    return nullptr;
+}
+
+std::optional<SegmentStore::Location> SegmentStore::find(
+    Kind _kind, crypto::HashType const& _hash) const
+{
+    auto it = m_activeIndex[_kind].find(_hash);
+    if (it != m_activeIndex[_kind].end())
+    {
+        return it->second;
+    }
+
+    std::array<bcos::byte, KEY_SIZE> key;
+    key[0] = _kind;
+    std::memcpy(key.data() + 1, _hash.data(), HASH_SIZE);
+    // the newest segment first, the recent transactions are queried the most
+    for (auto id = m_segments.size() - 1; id-- > 0;)
+    {
+        auto const& sealed = m_segments[id].sealed;
+        if (!visitBloom(sealed.bloomBlocks, key.data(),
+                [&](size_t byte, bcos::byte mask) { return (sealed.bloom[byte] & mask) != 0; }))
+        {
+            continue;
+        }
+        size_t low = 0;
+        size_t high = sealed.counts[TRANSACTION] + sealed.counts[RECEIPT];
+        while (low < high)
+        {
+            auto middle = low + (high - low) / 2;
+            const auto* record = sealed.records + middle * INDEX_RECORD_SIZE;
+            auto compare = compareKey(record, key.data());
+            if (compare == 0)
+            {
+                return Location{.segment = (uint32_t)id,
+                    .size = getInteger<uint32_t>(record + KEY_SIZE + sizeof(uint64_t)),
+                    .offset = getInteger<uint64_t>(record + KEY_SIZE)};
+            }
+            if (compare < 0)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<bcos::bytes> SegmentStore::get(Kind _kind, crypto::HashType const& _hash) const
+{
+    Location location;
+    int fd = -1;
+    {
+        std::shared_lock lock(m_mutex);
+        auto found = find(_kind, _hash);
+        if (!found)
+        {
+            return std::nullopt;
+        }
+        location = *found;
+        fd = m_segments[location.segment].dataFd;
+    }
+
+    bcos::bytes value(location.size);
+    if (!readAll(fd, value.data(), value.size(), location.offset))
+    {
+        LEDGER_LOG(ERROR) << LOG_BADGE("SegmentStore") << LOG_DESC("read segment failed")
+                          << LOG_KV("segment", location.segment)
+                          << LOG_KV("offset", location.offset) << LOG_KV("hash", _hash.abridged());
+        return std::nullopt;
+    }
+    return value;
+}
+
+bool SegmentStore::contains(Kind _kind, crypto::HashType const& _hash) const
+{
+    std::shared_lock lock(m_mutex);
+    return find(_kind, _hash).has_value();
+}
+
+size_t SegmentStore::size(Kind _kind) const
+{
+    std::shared_lock lock(m_mutex);
+    return m_sealedCounts[_kind] + m_activeIndex[_kind].size();
+}
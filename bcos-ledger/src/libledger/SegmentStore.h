@@ -0,0 +1,138 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief append-only segment files for the transactions and receipts
+ * @file SegmentStore.h
+ */
+#pragma once
+#include <bcos-crypto/interfaces/crypto/CommonType.h>
+#include <bcos-utilities/Common.h>
+#include <bcos-utilities/Error.h>
+#include <initializer_list>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos::ledger
+{
+/**
+ * @brief the transactions and receipts are written once and never updated, keeping them as random
+ * keys in the state db costs a lot of compaction, SegmentStore appends the encoded objects of each
+ * block contiguously to segment files instead
+ *
+ * dir/<id>.seg holds the encoded objects, dir/<id>.idx holds fixed size index records
+ * [kind(1)][hash(32)][offset(8)][size(4)], the index records are written after the data they
+ * point to, so the data behind the last complete index record is dropped when the store is opened
+ *
+ * only the index of the segment being appended is kept in memory, a full segment is sealed into
+ * dir/<id>.sidx, its records sorted by kind and hash behind a blocked bloom filter, and mapped
+ * read only, so the lookups of the old segments go through the page cache instead of the heap
+ */
+class SegmentStore
+{
+public:
+    using Ptr = std::shared_ptr<SegmentStore>;
+
+    enum Kind : uint8_t
+    {
+        TRANSACTION = 0,
+        RECEIPT = 1,
+    };
+
+    constexpr static uint64_t DEFAULT_SEGMENT_SIZE = 256 << 20;
+
+    // a new segment file is started once the current one grows over _segmentSize
+    explicit SegmentStore(
+        std::string _path, uint64_t _segmentSize = DEFAULT_SEGMENT_SIZE, bool _sync = true);
+    ~SegmentStore();
+
+    SegmentStore(const SegmentStore&) = delete;
+    SegmentStore& operator=(const SegmentStore&) = delete;
+    SegmentStore(SegmentStore&&) = delete;
+    SegmentStore& operator=(SegmentStore&&) = delete;
+
+    struct Batch
+    {
+        Kind kind;
+        std::vector<std::string_view> const& keys;
+        std::vector<std::string_view> const& values;
+    };
+
+    // the keys are the binary hashes, the same as the keys of s_hash_2_tx and s_hash_2_receipt;
+    // all the batches are made durable together, with one sync of the data and one of the index
+    Error::Ptr append(std::initializer_list<Batch> _batches);
+    Error::Ptr append(Kind _kind, std::vector<std::string_view> const& _keys,
+        std::vector<std::string_view> const& _values)
+    {
+        return append({Batch{.kind = _kind, .keys = _keys, .values = _values}});
+    }
+
+    std::optional<bcos::bytes> get(Kind _kind, crypto::HashType const& _hash) const;
+    bool contains(Kind _kind, crypto::HashType const& _hash) const;
+
+    size_t size(Kind _kind) const;
+    std::string const& path() const { return m_path; }
+
+private:
+    struct Location
+    {
+        uint32_t segment = 0;
+        uint32_t size = 0;
+        uint64_t offset = 0;
+    };
+    // the mapped dir/<id>.sidx of a sealed segment
+    struct SealedIndex
+    {
+        const bcos::byte* mapped = nullptr;
+        size_t mappedSize = 0;
+        uint64_t counts[2] = {0, 0};
+        uint64_t bloomBlocks = 0;
+        const bcos::byte* bloom = nullptr;
+        const bcos::byte* records = nullptr;
+    };
+    struct Segment
+    {
+        int dataFd = -1;
+        int indexFd = -1;
+        uint64_t dataSize = 0;
+        uint64_t indexSize = 0;
+        SealedIndex sealed;
+    };
+
+    void load();
+    void openSegment(uint32_t _id);
+    void loadActiveSegment(uint32_t _id);
+    void loadSealedSegment(uint32_t _id);
+    // sorts the index records of a full segment into dir/<id>.sidx and maps it
+    SealedIndex sealIndex(uint32_t _id, bcos::bytes _records) const;
+    SealedIndex mapIndex(uint32_t _id) const;
+    std::optional<Location> find(Kind _kind, crypto::HashType const& _hash) const;
+    std::string segmentPath(uint32_t _id, std::string_view _suffix) const;
+
+    std::string m_path;
+    uint64_t m_segmentSize;
+    bool m_sync;
+
+    // m_writeMutex serializes the appenders, m_mutex protects the index and the segment list
+    std::mutex m_writeMutex;
+    mutable std::shared_mutex m_mutex;
+    std::vector<Segment> m_segments;
+    // the index of the last segment, the one being appended
+    std::unordered_map<crypto::HashType, Location> m_activeIndex[2];
+    uint64_t m_sealedCounts[2] = {0, 0};
+};
+}  // namespace bcos::ledger
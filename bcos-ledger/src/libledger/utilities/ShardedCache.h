@@ -0,0 +1,137 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief size bounded lru cache split into independently locked shards
+ * @file ShardedCache.h
+ */
+#pragma once
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos::ledger
+{
+/**
+ * @brief lru cache for the hot ledger objects, the keys are spread over several shards so that
+ * readers of different keys do not contend on one mutex, each shard evicts its least recently
+ * used entries when it is full; unlike boost lru_cache, insert overwrites an existing entry
+ *
+ * the capacity is counted in the cost given to insert, one per entry by default, so a cache of
+ * variable sized values can be bounded by bytes
+ */
+template <class Key, class Value, class Hash = std::hash<Key>>
+class ShardedCache
+{
+public:
+    explicit ShardedCache(size_t _capacity, size_t _shardCount = 16)
+      : m_shards(std::max<size_t>(_shardCount, 1))
+    {
+        auto shardCapacity = (_capacity + m_shards.size() - 1) / m_shards.size();
+        for (auto& shard : m_shards)
+        {
+            shard = std::make_unique<Shard>();
+            shard->capacity = shardCapacity;
+        }
+    }
+
+    std::optional<Value> get(Key const& _key)
+    {
+        auto& shard = getShard(_key);
+        std::lock_guard lock(shard.mutex);
+        auto it = shard.index.find(_key);
+        if (it == shard.index.end())
+        {
+            return std::nullopt;
+        }
+        shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+        return it->second->value;
+    }
+
+    void insert(Key const& _key, Value _value, size_t _cost = 1)
+    {
+        auto& shard = getShard(_key);
+        std::lock_guard lock(shard.mutex);
+        auto it = shard.index.find(_key);
+        if (it != shard.index.end())
+        {
+            shard.cost -= it->second->cost;
+            shard.entries.erase(it->second);
+            shard.index.erase(it);
+        }
+        // an entry larger than the whole shard would evict everything and still not fit
+        if (_cost > shard.capacity)
+        {
+            return;
+        }
+        while (!shard.entries.empty() && shard.cost + _cost > shard.capacity)
+        {
+            shard.cost -= shard.entries.back().cost;
+            shard.index.erase(shard.entries.back().key);
+            shard.entries.pop_back();
+        }
+        shard.entries.push_front({_key, std::move(_value), _cost});
+        shard.index.emplace(_key, shard.entries.begin());
+        shard.cost += _cost;
+    }
+
+    void clear()
+    {
+        for (auto& shard : m_shards)
+        {
+            std::lock_guard lock(shard->mutex);
+            shard->index.clear();
+            shard->entries.clear();
+            shard->cost = 0;
+        }
+    }
+
+    size_t size() const
+    {
+        size_t total = 0;
+        for (auto const& shard : m_shards)
+        {
+            std::lock_guard lock(shard->mutex);
+            total += shard->entries.size();
+        }
+        return total;
+    }
+
+private:
+    struct Entry
+    {
+        Key key;
+        Value value;
+        size_t cost;
+    };
+    using EntryList = std::list<Entry>;
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        size_t capacity = 0;
+        size_t cost = 0;
+        EntryList entries;
+        std::unordered_map<Key, typename EntryList::iterator, Hash> index;
+    };
+
+    Shard& getShard(Key const& _key) { return *m_shards[Hash{}(_key) % m_shards.size()]; }
+
+    std::vector<std::unique_ptr<Shard>> m_shards;
+};
+}  // namespace bcos::ledger
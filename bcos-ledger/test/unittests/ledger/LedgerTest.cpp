@@ -36,6 +36,7 @@
 #include "bcos-framework/transaction-executor/TransactionExecutor.h"
 #include "bcos-ledger/src/libledger/LedgerMethods.h"
 #include "bcos-ledger/src/libledger/utilities/Common.h"
+#include "bcos-ledger/src/libledger/utilities/ShardedCache.h"
 #include "bcos-task/Wait.h"
 #include "bcos-tool/BfsFileFactory.h"
 #include "bcos-tool/ConsensusNode.h"
@@ -1474,5 +1475,115 @@ BOOST_AUTO_TEST_CASE(replaceBinary)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(shardedCache)
+{
+    // one shard, so the eviction order does not depend on the hash of the keys
+    ShardedCache<int64_t, std::string> cache(4, 1);
+    for (int64_t i = 0; i < 4; ++i)
+    {
+        cache.insert(i, std::to_string(i));
+    }
+    BOOST_CHECK_EQUAL(cache.size(), 4);
+    BOOST_CHECK_EQUAL(*cache.get(1), "1");
+
+    // overwrite
+    cache.insert(1, "one");
+    BOOST_CHECK_EQUAL(*cache.get(1), "one");
+    BOOST_CHECK_EQUAL(cache.size(), 4);
+
+    // 0 is the least recently used one
+    cache.insert(5, "5");
+    BOOST_CHECK(!cache.get(0));
+    BOOST_CHECK_EQUAL(*cache.get(1), "one");
+    BOOST_CHECK_EQUAL(*cache.get(5), "5");
+    BOOST_CHECK_EQUAL(cache.size(), 4);
+
+    // a cost of 2 evicts 2 and 3, the recently used 1 and 5 are kept
+    cache.insert(6, "6", 2);
+    BOOST_CHECK(!cache.get(2));
+    BOOST_CHECK(!cache.get(3));
+    BOOST_CHECK_EQUAL(*cache.get(1), "one");
+    BOOST_CHECK_EQUAL(*cache.get(6), "6");
+    BOOST_CHECK_EQUAL(cache.size(), 3);
+
+    // larger than the capacity, not cached
+    cache.insert(7, "7", 5);
+    BOOST_CHECK(!cache.get(7));
+    BOOST_CHECK_EQUAL(cache.size(), 3);
+
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.size(), 0);
+    BOOST_CHECK(!cache.get(1));
+}
+
+BOOST_AUTO_TEST_CASE(hotCache)
+{
+    initFixture();
+    initChain(3);
+
+    auto block = m_fakeBlocks->at(2);
+    auto hashList = std::make_shared<protocol::HashList>();
+    for (size_t i = 0; i < block->transactionsSize(); ++i)
+    {
+        hashList->emplace_back(block->transactionHash(i));
+    }
+
+    auto getTransactions = [&hashList](Ledger& ledger) {
+        std::promise<protocol::TransactionsPtr> promise;
+        ledger.asyncGetBatchTxsByHashList(hashList, false,
+            [&promise](Error::Ptr error, protocol::TransactionsPtr transactions,
+                std::shared_ptr<std::map<std::string, MerkleProofPtr>>) {
+                BOOST_CHECK(!error);
+                promise.set_value(std::move(transactions));
+            });
+        return promise.get_future().get();
+    };
+    auto getReceipts = [&hashList](Ledger& ledger) {
+        std::promise<std::vector<TransactionReceipt::ConstPtr>> promise;
+        ledger.asyncGetBatchReceiptsByHashList(
+            hashList, [&promise](Error::Ptr error,
+                          std::vector<TransactionReceipt::ConstPtr> receipts) {
+                BOOST_CHECK(!error);
+                promise.set_value(std::move(receipts));
+            });
+        return promise.get_future().get();
+    };
+
+    // the transactions handed out are copies, modifying them does not change the cached ones
+    auto transactions = getTransactions(*m_ledger);
+    BOOST_REQUIRE_EQUAL(transactions->size(), hashList->size());
+    for (size_t i = 0; i < transactions->size(); ++i)
+    {
+        BOOST_CHECK_EQUAL((*transactions)[i]->hash().hex(), (*hashList)[i].hex());
+        (*transactions)[i]->setExtraData("modified");
+    }
+    for (auto const& transaction : *getTransactions(*m_ledger))
+    {
+        BOOST_CHECK_NE(transaction->extraData(), "modified");
+    }
+
+    auto receipts = getReceipts(*m_ledger);
+    BOOST_REQUIRE_EQUAL(receipts.size(), hashList->size());
+    for (size_t i = 0; i < receipts.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(receipts[i]->hash().hex(), block->receipt(i)->hash().hex());
+    }
+
+    // a ledger without the hot cache reads the same objects from storage
+    auto uncachedLedger = std::make_shared<Ledger>(m_blockFactory, m_storage, 5, 0);
+    auto storedTransactions = getTransactions(*uncachedLedger);
+    BOOST_REQUIRE_EQUAL(storedTransactions->size(), hashList->size());
+    for (size_t i = 0; i < storedTransactions->size(); ++i)
+    {
+        BOOST_CHECK_EQUAL((*storedTransactions)[i]->hash().hex(), (*hashList)[i].hex());
+    }
+    auto storedReceipts = getReceipts(*uncachedLedger);
+    BOOST_REQUIRE_EQUAL(storedReceipts.size(), receipts.size());
+    for (size_t i = 0; i < storedReceipts.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(storedReceipts[i]->hash().hex(), receipts[i]->hash().hex());
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace bcos::test
@@ -0,0 +1,154 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file SegmentStoreTest.cpp
+ */
+
+#include "bcos-ledger/src/libledger/SegmentStore.h"
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+
+using namespace bcos;
+using namespace bcos::ledger;
+
+namespace bcos::test
+{
+struct SegmentStoreFixture
+{
+    SegmentStoreFixture()
+      : path((boost::filesystem::temp_directory_path() /
+              boost::filesystem::unique_path("segment-%%%%-%%%%"))
+                 .string())
+    {}
+    ~SegmentStoreFixture() { boost::filesystem::remove_all(path); }
+
+    static std::string_view view(crypto::HashType const& hash)
+    {
+        return {(const char*)hash.data(), hash.size()};
+    }
+
+    std::string path;
+};
+
+BOOST_FIXTURE_TEST_SUITE(SegmentStoreTest, SegmentStoreFixture)
+
+BOOST_AUTO_TEST_CASE(appendAndGet)
+{
+    std::vector<crypto::HashType> hashes{crypto::HashType(1), crypto::HashType(2)};
+    std::vector<std::string> values{"transaction1", "transaction2"};
+    {
+        // a tiny segment size, every append starts a new segment
+        SegmentStore store(path, 16);
+        BOOST_CHECK(!store.append(SegmentStore::TRANSACTION, {view(hashes[0]), view(hashes[1])},
+            {values[0], values[1]}));
+        BOOST_CHECK(!store.append(SegmentStore::RECEIPT, {view(hashes[0])}, {"receipt1"}));
+
+        BOOST_CHECK_EQUAL(store.size(SegmentStore::TRANSACTION), 2);
+        BOOST_CHECK_EQUAL(store.size(SegmentStore::RECEIPT), 1);
+        auto value = store.get(SegmentStore::TRANSACTION, hashes[1]);
+        BOOST_REQUIRE(value);
+        BOOST_CHECK_EQUAL(std::string((const char*)value->data(), value->size()), values[1]);
+        BOOST_CHECK(!store.get(SegmentStore::RECEIPT, hashes[1]));
+        BOOST_CHECK(store.append(SegmentStore::RECEIPT, {"short"}, {"receipt"}));
+    }
+
+    // reopen
+    SegmentStore store(path, 16);
+    BOOST_CHECK_EQUAL(store.size(SegmentStore::TRANSACTION), 2);
+    auto value = store.get(SegmentStore::RECEIPT, hashes[0]);
+    BOOST_REQUIRE(value);
+    BOOST_CHECK_EQUAL(std::string((const char*)value->data(), value->size()), "receipt1");
+}
+
+BOOST_AUTO_TEST_CASE(dropIncompleteTail)
+{
+    crypto::HashType hash(1);
+    {
+        SegmentStore store(path);
+        BOOST_CHECK(!store.append(SegmentStore::TRANSACTION, {view(hash)}, {"transaction1"}));
+    }
+    // an interrupted append: garbage data without an index, and a partial index record
+    {
+        std::ofstream data(path + "/0000000000.seg", std::ios::app | std::ios::binary);
+        data << "garbage";
+        std::ofstream index(path + "/0000000000.idx", std::ios::app | std::ios::binary);
+        index << "partial";
+    }
+
+    SegmentStore store(path);
+    BOOST_CHECK_EQUAL(store.size(SegmentStore::TRANSACTION), 1);
+    BOOST_CHECK_EQUAL(boost::filesystem::file_size(path + "/0000000000.seg"), 12);
+
+    crypto::HashType hash2(2);
+    BOOST_CHECK(!store.append(SegmentStore::TRANSACTION, {view(hash2)}, {"transaction2"}));
+    auto value = store.get(SegmentStore::TRANSACTION, hash2);
+    BOOST_REQUIRE(value);
+    BOOST_CHECK_EQUAL(std::string((const char*)value->data(), value->size()), "transaction2");
+    value = store.get(SegmentStore::TRANSACTION, hash);
+    BOOST_REQUIRE(value);
+    BOOST_CHECK_EQUAL(std::string((const char*)value->data(), value->size()), "transaction1");
+}
+
+BOOST_AUTO_TEST_CASE(sealedSegments)
+{
+    std::vector<crypto::HashType> hashes;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        hashes.emplace_back(crypto::HashType(i + 1));
+    }
+    auto check = [&](SegmentStore const& store) {
+        BOOST_CHECK_EQUAL(store.size(SegmentStore::TRANSACTION), hashes.size());
+        BOOST_CHECK_EQUAL(store.size(SegmentStore::RECEIPT), hashes.size());
+        for (size_t i = 0; i < hashes.size(); ++i)
+        {
+            auto value = store.get(SegmentStore::RECEIPT, hashes[i]);
+            BOOST_REQUIRE(value);
+            BOOST_CHECK_EQUAL(std::string((const char*)value->data(), value->size()),
+                "receipt" + std::to_string(i));
+        }
+        BOOST_CHECK(!store.contains(SegmentStore::TRANSACTION, crypto::HashType(1000)));
+    };
+    {
+        // a transaction and its receipt per append, in one sync, 10 blocks per segment
+        SegmentStore store(path, 200);
+        for (size_t i = 0; i < hashes.size(); ++i)
+        {
+            auto transaction = "transaction" + std::to_string(i);
+            auto receipt = "receipt" + std::to_string(i);
+            std::vector<std::string_view> keys{view(hashes[i])};
+            std::vector<std::string_view> transactions{transaction};
+            std::vector<std::string_view> receipts{receipt};
+            BOOST_CHECK(!store.append({{.kind = SegmentStore::TRANSACTION,
+                                           .keys = keys,
+                                           .values = transactions},
+                {.kind = SegmentStore::RECEIPT, .keys = keys, .values = receipts}}));
+        }
+        check(store);
+    }
+    BOOST_CHECK(boost::filesystem::exists(path + "/0000000000.sidx"));
+
+    // the sealed indexes are mapped instead of loaded
+    check(SegmentStore(path, 200));
+
+    // a missing sealed index is built again from the segment index
+    boost::filesystem::remove(path + "/0000000000.sidx");
+    check(SegmentStore(path, 200));
+    BOOST_CHECK(boost::filesystem::exists(path + "/0000000000.sidx"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
@@ -20,9 +20,13 @@
 #pragma once
 #include <bcos-framework/Common.h>
 #include <bcos-framework/consensus/ConsensusTypeDef.h>
+#include <bcos-utilities/BinaryLog.h>
 #include <bcos-utilities/Exceptions.h>
 
 #define CONSENSUS_LOG(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE("CONSENSUS") << LOG_BADGE("Core")
+// deferred-format CONSENSUS_LOG for the hot paths, see BCOS_BINARY_LOG
+#define CONSENSUS_METRIC_LOG(LEVEL, ...) \
+    BCOS_BINARY_LOG(LEVEL, "CONSENSUS", "[Core][METRIC]" __VA_ARGS__)
 namespace bcos::consensus
 {
 const IndexType NON_CONSENSUS_NODE = (IndexType)(-1);
@@ -20,6 +20,7 @@
  */
 #include "StateMachine.h"
 #include "Common.h"
+#include <bcos-utilities/Metrics.h>
 
 using namespace bcos;
 using namespace bcos::consensus;
@@ -116,16 +117,16 @@ void StateMachine::apply(ssize_t, ProposalInterface::ConstPtr _lastAppliedPropos
                 return;
             }
             auto execT = (double)(utcTime() - startT) / (double)(block->transactionsHashSize());
-            CONSENSUS_LOG(INFO) << METRIC << LOG_DESC("asyncExecuteBlock success")
-                                << LOG_KV("sysBlock", _sysBlock)
-                                << LOG_KV("number", _blockHeader->number())
-                                << LOG_KV("result", _blockHeader->hash().abridged())
-                                << LOG_KV("txsSize", block->transactionsHashSize())
-                                << LOG_KV("txsRoot", _blockHeader->txsRoot().abridged())
-                                << LOG_KV("receiptsRoot", _blockHeader->receiptsRoot().abridged())
-                                << LOG_KV("stateRoot", _blockHeader->stateRoot().abridged())
-                                << LOG_KV("timeCost", (utcTime() - startT))
-                                << LOG_KV("execPerTx", execT);
+            static auto& executeBlockTime = metrics::Registry::instance().histogram(
+                "bcos_pbft_execute_block_us", "time to execute a proposal by the scheduler");
+            executeBlockTime.observe((utcTime() - startT) * 1000);
+            CONSENSUS_METRIC_LOG(INFO, "asyncExecuteBlock success", "sysBlock", _sysBlock,
+                "number", _blockHeader->number(), "result", _blockHeader->hash().abridged(),
+                "txsSize", block->transactionsHashSize(), "txsRoot",
+                _blockHeader->txsRoot().abridged(), "receiptsRoot",
+                _blockHeader->receiptsRoot().abridged(), "stateRoot",
+                _blockHeader->stateRoot().abridged(), "timeCost", (utcTime() - startT),
+                "execPerTx", execT);
             if (_blockHeader->number() != blockHeader->number())
             {
                 CONSENSUS_LOG(WARNING) << LOG_DESC("asyncExecuteBlock exception")
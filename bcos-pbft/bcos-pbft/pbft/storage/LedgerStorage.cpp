@@ -23,6 +23,7 @@
 #include <bcos-framework/protocol/CommonError.h>
 #include <bcos-framework/protocol/ProtocolTypeDef.h>
 #include <bcos-framework/storage/Table.h>
+#include <bcos-utilities/Metrics.h>
 
 using namespace bcos;
 using namespace bcos::consensus;
@@ -378,12 +379,13 @@ void LedgerStorage::commitStableCheckPoint(PBFTProposalInterface::Ptr _stablePro
             }
             auto commitPerTx =
                 (double)(utcTime() - startT) / (double)(_blockInfo->transactionsHashSize());
-            PBFT_STORAGE_LOG(INFO)
-                << METRIC << LOG_DESC("commitStableCheckPoint success")
-                << LOG_KV("index", _blockHeader->number())
-                << LOG_KV("hash", _ledgerConfig->hash().abridged())
-                << LOG_KV("txs", _blockInfo->transactionsHashSize())
-                << LOG_KV("timeCost", utcTime() - startT) << LOG_KV("commitPerTx", commitPerTx);
+            static auto& commitBlockTime = metrics::Registry::instance().histogram(
+                "bcos_pbft_commit_block_us", "time to commit a stable checkpoint");
+            commitBlockTime.observe((utcTime() - startT) * 1000);
+            PBFT_STORAGE_METRIC_LOG(INFO, "commitStableCheckPoint success", "index",
+                _blockHeader->number(), "hash", _ledgerConfig->hash().abridged(), "txs",
+                _blockInfo->transactionsHashSize(), "timeCost", utcTime() - startT, "commitPerTx",
+                commitPerTx);
             auto txsSize = _blockInfo->transactionsHashSize();
             // Note:Here the thread pool is used to asynchronize the operation of PBFT finalize to
             // prevent the commitBlock from calling the callback synchronously and affecting the
@@ -19,12 +19,16 @@
  */
 #pragma once
 #include <bcos-framework/Common.h>
+#include <bcos-utilities/BinaryLog.h>
 #include <bcos-utilities/Exceptions.h>
 #include <stdint.h>
 
 #define PBFT_LOG(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE("CONSENSUS") << LOG_BADGE("PBFT")
 #define PBFT_STORAGE_LOG(LEVEL) \
     BCOS_LOG(LEVEL) << LOG_BADGE("CONSENSUS") << LOG_BADGE("PBFT") << LOG_BADGE("STORAGE")
+// deferred-format PBFT_STORAGE_LOG for the hot paths, see BCOS_BINARY_LOG
+#define PBFT_STORAGE_METRIC_LOG(LEVEL, ...) \
+    BCOS_BINARY_LOG(LEVEL, "CONSENSUS", "[PBFT][STORAGE][METRIC]" __VA_ARGS__)
 
 namespace bcos::consensus
 {
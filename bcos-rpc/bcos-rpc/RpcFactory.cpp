@@ -345,6 +345,10 @@ bcos::rpc::JsonRpcImpl_2_0::Ptr RpcFactory::buildJsonRpc(int sendTxTimeout,
     {
         httpServer->setHttpReqHandler(std::bind(&bcos::rpc::JsonRpcInterface::onRPCRequest,
             jsonRpcInterface, std::placeholders::_1, std::placeholders::_2));
+        if (m_nodeConfig)
+        {
+            httpServer->setMetricsPath(m_nodeConfig->rpcMetricsPath());
+        }
     }
     return jsonRpcInterface;
 }
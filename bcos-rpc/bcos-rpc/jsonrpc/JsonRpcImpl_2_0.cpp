@@ -49,6 +49,7 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <tuple>
 
 using namespace std;
 using namespace bcos;
@@ -100,7 +101,7 @@ void JsonRpcImpl_2_0::handleRpcRequest(
 
         if (session->isConnected())
         {
-            // TODO: no need to copy resp
+            // the response buffer is moved into the message payload without copy
             auto buffer = std::make_shared<bcos::bytes>(std::move(resp));
 
             auto msg = messageFactory->buildMessage();
@@ -245,37 +246,42 @@ void bcos::rpc::toJsonResp(Json::Value& jResp, bcos::protocol::Transaction const
     }
 }
 
-void bcos::rpc::toJsonResp(Json::Value& jResp, std::string_view _txHash,
-    protocol::TransactionStatus status,
+// return the contractAddress and the checksumContractAddress of the receipt
+static std::tuple<std::string, std::string> toContractAddress(
     bcos::protocol::TransactionReceipt const& transactionReceipt, bool _isWasm,
     crypto::Hash& hashImpl)
 {
-    jResp["version"] = transactionReceipt.version();
     std::string contractAddress = string(transactionReceipt.contractAddress());
-
-    if (!contractAddress.empty() && !_isWasm)
+    if (contractAddress.empty() || _isWasm)
     {
-        std::string checksumContractAddr = contractAddress;
-        toChecksumAddress(checksumContractAddr, hashImpl.hash(contractAddress).hex());
-
-        if (!contractAddress.starts_with("0x") && !contractAddress.starts_with("0X"))
-        {
-            contractAddress = "0x" + contractAddress;
-        }
+        return {contractAddress, contractAddress};
+    }
 
-        if (!checksumContractAddr.starts_with("0x") && !checksumContractAddr.starts_with("0X"))
-        {
-            checksumContractAddr = "0x" + checksumContractAddr;
-        }
+    std::string checksumContractAddr = contractAddress;
+    toChecksumAddress(checksumContractAddr, hashImpl.hash(contractAddress).hex());
 
-        jResp["contractAddress"] = contractAddress;
-        jResp["checksumContractAddress"] = checksumContractAddr;
+    if (!contractAddress.starts_with("0x") && !contractAddress.starts_with("0X"))
+    {
+        contractAddress = "0x" + contractAddress;
     }
-    else
+
+    if (!checksumContractAddr.starts_with("0x") && !checksumContractAddr.starts_with("0X"))
     {
-        jResp["contractAddress"] = contractAddress;
-        jResp["checksumContractAddress"] = contractAddress;
+        checksumContractAddr = "0x" + checksumContractAddr;
     }
+    return {std::move(contractAddress), std::move(checksumContractAddr)};
+}
+
+void bcos::rpc::toJsonResp(Json::Value& jResp, std::string_view _txHash,
+    protocol::TransactionStatus status,
+    bcos::protocol::TransactionReceipt const& transactionReceipt, bool _isWasm,
+    crypto::Hash& hashImpl)
+{
+    jResp["version"] = transactionReceipt.version();
+    auto [contractAddress, checksumContractAddr] =
+        toContractAddress(transactionReceipt, _isWasm, hashImpl);
+    jResp["contractAddress"] = std::move(contractAddress);
+    jResp["checksumContractAddress"] = std::move(checksumContractAddr);
 
     jResp["gasUsed"] = transactionReceipt.gasUsed().str(16);
     jResp["status"] = transactionReceipt.status();
@@ -391,6 +397,177 @@ void bcos::rpc::toJsonResp(Json::Value& jResp, bcos::protocol::Block& block, boo
     jResp["transactions"] = jTxs;
 }
 
+void bcos::rpc::toJsonResp(JsonWriter& writer, bcos::protocol::Transaction const& transaction)
+{
+    auto const& nonce = transaction.nonce();
+    auto sender = transaction.sender();
+    writer.member("version", transaction.version());
+    writer.hexMember("hash", transaction.hash().ref());
+    writer.key("nonce");
+    writer.hexValue(bytesConstRef((const bcos::byte*)nonce.data(), nonce.size()), {});
+    writer.member("blockLimit", transaction.blockLimit());
+    writer.member("to", transaction.to());
+    writer.hexMember("input", transaction.input());
+    writer.hexMember("from", bytesConstRef((const bcos::byte*)sender.data(), sender.size()));
+    writer.member("importTime", transaction.importTime());
+    writer.member("chainID", transaction.chainId());
+    writer.member("groupID", transaction.groupId());
+    writer.member("abi", transaction.abi());
+    writer.hexMember("signature", transaction.signatureData());
+    writer.member("extraData", transaction.extraData());
+    if (transaction.version() >= int32_t(bcos::protocol::TransactionVersion::V1_VERSION))
+    {
+        writer.member("value", transaction.value());
+        writer.member("gasPrice", transaction.gasPrice());
+        writer.member("gasLimit", transaction.gasLimit());
+        writer.member("maxFeePerGas", transaction.maxFeePerGas());
+        writer.member("maxPriorityFeePerGas", transaction.maxPriorityFeePerGas());
+    }
+    if (transaction.version() >= (int32_t)bcos::protocol::TransactionVersion::V2_VERSION)
+    {
+        writer.key("extension");
+        writer.startArray();
+        for (auto ext : transaction.extension())
+        {
+            writer.value(ext);
+        }
+        writer.endArray();
+    }
+}
+
+void bcos::rpc::toJsonResp(JsonWriter& writer, std::string_view _txHash,
+    protocol::TransactionStatus status,
+    bcos::protocol::TransactionReceipt const& transactionReceipt, bool _isWasm,
+    crypto::Hash& hashImpl)
+{
+    writer.member("version", transactionReceipt.version());
+    auto [contractAddress, checksumContractAddr] =
+        toContractAddress(transactionReceipt, _isWasm, hashImpl);
+    writer.member("contractAddress", contractAddress);
+    writer.member("checksumContractAddress", checksumContractAddr);
+    writer.member("gasUsed", transactionReceipt.gasUsed().str(16));
+    writer.member("status", transactionReceipt.status());
+    writer.member("blockNumber", transactionReceipt.blockNumber());
+    writer.hexMember("output", transactionReceipt.output());
+    writer.member("message", transactionReceipt.message());
+    writer.member("transactionHash", _txHash);
+    if (status == protocol::TransactionStatus::None)
+    {
+        writer.hexMember("hash", transactionReceipt.hash().ref());
+    }
+    else
+    {
+        writer.member("hash", "0x");
+    }
+
+    writer.key("logEntries");
+    writer.startArray();
+    for (const auto& logEntry : transactionReceipt.logEntries())
+    {
+        writer.startObject();
+        writer.member("address", logEntry.address());
+        writer.key("topics");
+        writer.startArray();
+        for (const auto& topic : logEntry.topics())
+        {
+            writer.hexValue(topic);
+        }
+        writer.endArray();
+        writer.hexMember("data", logEntry.data());
+        writer.endObject();
+    }
+    writer.endArray();
+    if (transactionReceipt.version() >= int32_t(bcos::protocol::TransactionVersion::V1_VERSION))
+    {
+        writer.member("effectiveGasPrice", transactionReceipt.effectiveGasPrice());
+    }
+}
+
+void bcos::rpc::toJsonResp(JsonWriter& writer, bcos::protocol::BlockHeader const& blockHeader)
+{
+    writer.hexMember("hash", blockHeader.hash().ref());
+    writer.member("version", blockHeader.version());
+    writer.hexMember("txsRoot", blockHeader.txsRoot().ref());
+    writer.hexMember("receiptsRoot", blockHeader.receiptsRoot().ref());
+    writer.hexMember("stateRoot", blockHeader.stateRoot().ref());
+    writer.member("number", blockHeader.number());
+    writer.member("gasUsed", blockHeader.gasUsed().str(16));
+    writer.member("timestamp", blockHeader.timestamp());
+    writer.member("sealer", blockHeader.sealer());
+    writer.hexMember("extraData", blockHeader.extraData());
+
+    writer.key("consensusWeights");
+    writer.startArray();
+    for (const auto& wei : blockHeader.consensusWeights())
+    {
+        writer.value(wei);
+    }
+    writer.endArray();
+
+    writer.key("sealerList");
+    writer.startArray();
+    for (const auto& sealer : blockHeader.sealerList())
+    {
+        writer.hexValue(bcos::ref(sealer));
+    }
+    writer.endArray();
+
+    writer.key("parentInfo");
+    writer.startArray();
+    for (const auto& p : blockHeader.parentInfo())
+    {
+        writer.startObject();
+        writer.member("blockNumber", p.blockNumber);
+        writer.hexMember("blockHash", p.blockHash.ref());
+        writer.endObject();
+    }
+    writer.endArray();
+
+    writer.key("signatureList");
+    writer.startArray();
+    for (const auto& sign : blockHeader.signatureList())
+    {
+        writer.startObject();
+        writer.member("sealerIndex", sign.index);
+        writer.hexMember("signature", bcos::ref(sign.signature));
+        writer.endObject();
+    }
+    writer.endArray();
+}
+
+void bcos::rpc::toJsonResp(JsonWriter& writer, bcos::protocol::Block& block, bool _onlyTxHash)
+{
+    // header
+    auto blockHeader = block.blockHeaderConst();
+    if (blockHeader)
+    {
+        toJsonResp(writer, *blockHeader);
+    }
+    auto txSize = _onlyTxHash ? block.transactionsMetaDataSize() : block.transactionsSize();
+    // roughly the encoded size of the transactions, avoid reallocating the buffer
+    writer.reserve(txSize * (_onlyTxHash ? 70 : 1024));
+
+    writer.key("transactions");
+    writer.startArray();
+    for (std::size_t index = 0; index < txSize; ++index)
+    {
+        if (_onlyTxHash)
+        {
+            // Note: should not call transactionHash for in the common cases transactionHash maybe
+            // empty
+            writer.hexValue(block.transactionMetaData(index)->hash());
+        }
+        else
+        {
+            auto transaction = block.transaction(index);
+            writer.startObject();
+            toJsonResp(writer, *transaction);
+            writer.endObject();
+        }
+    }
+    writer.endArray();
+}
+
 void JsonRpcImpl_2_0::call(std::string_view _groupID, std::string_view _nodeName,
     std::string_view _to, std::string_view _data, RespFunc _respFunc)
 {
@@ -565,6 +742,22 @@ void JsonRpcImpl_2_0::addProofToResponse(
         [&jResp, &_key](const auto& item) { jResp[_key].append(item.hex()); });
 }
 
+void JsonRpcImpl_2_0::addProofToResponse(
+    JsonWriter& writer, std::string_view _key, ledger::MerkleProofPtr const& _merkleProofPtr)
+{
+    if (!_merkleProofPtr)
+    {
+        return;
+    }
+    writer.key(_key);
+    writer.startArray();
+    for (const auto& item : *_merkleProofPtr)
+    {
+        writer.hexValue(item, {});
+    }
+    writer.endArray();
+}
+
 void JsonRpcImpl_2_0::getTransaction(std::string_view _groupID, std::string_view _nodeName,
     std::string_view _txHash, bool _requireProof, RespFunc _respFunc)
 {
@@ -622,6 +815,77 @@ void JsonRpcImpl_2_0::getTransaction(std::string_view _groupID, std::string_view
         });
 }
 
+void JsonRpcImpl_2_0::getTransactionBatch(std::string_view _groupID, std::string_view _nodeName,
+    std::vector<std::string> const& _txHashes, bool _requireProof,
+    std::vector<RespFunc> _respFuncs)
+{
+    RPC_IMPL_LOG(TRACE) << LOG_DESC("getTransactionBatch") << LOG_KV("size", _txHashes.size())
+                        << LOG_KV("requireProof", _requireProof) << LOG_KV("group", _groupID)
+                        << LOG_KV("node", _nodeName);
+
+    auto hashListPtr = std::make_shared<bcos::crypto::HashList>();
+    hashListPtr->reserve(_txHashes.size());
+    for (const auto& txHash : _txHashes)
+    {
+        hashListPtr->emplace_back(txHash, bcos::crypto::HashType::FromHex);
+    }
+
+    auto nodeService = getNodeService(_groupID, _nodeName, "getTransaction");
+    auto ledger = nodeService->ledger();
+    checkService(ledger, "ledger");
+    auto self = std::weak_ptr<JsonRpcImpl_2_0>(shared_from_this());
+    ledger->asyncGetBatchTxsByHashList(hashListPtr, _requireProof,
+        [self, m_groupID = std::string(_groupID), m_nodeName = std::string(_nodeName),
+            m_txHashes = _txHashes, hashListPtr, _requireProof,
+            m_respFuncs = std::move(_respFuncs)](Error::Ptr _error,
+            bcos::protocol::TransactionsPtr _transactionsPtr,
+            std::shared_ptr<std::map<std::string, ledger::MerkleProofPtr>>
+                _transactionProofsPtr) mutable {
+            // the batch fails when any of the transactions is missing, fall back to query them
+            // one by one to respond each of the requests correctly
+            if ((_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS) ||
+                !_transactionsPtr || _transactionsPtr->size() != m_txHashes.size())
+            {
+                auto rpc = self.lock();
+                if (!rpc)
+                {
+                    for (auto& respFunc : m_respFuncs)
+                    {
+                        Json::Value jResp;
+                        respFunc(BCOS_ERROR_PTR(JsonRpcError::InternalError, "rpc is stopped"),
+                            jResp);
+                    }
+                    return;
+                }
+                RPC_IMPL_LOG(DEBUG) << LOG_BADGE("getTransactionBatch")
+                                    << LOG_DESC("batch query failed, query one by one")
+                                    << LOG_KV("size", m_txHashes.size())
+                                    << LOG_KV("code", _error ? _error->errorCode() : 0);
+                rpc->JsonRpcInterface::getTransactionBatch(
+                    m_groupID, m_nodeName, m_txHashes, _requireProof, std::move(m_respFuncs));
+                return;
+            }
+
+            for (size_t i = 0; i < m_respFuncs.size(); ++i)
+            {
+                Json::Value jResp;
+                toJsonResp(jResp, *(*_transactionsPtr)[i]);
+                if (_requireProof && _transactionProofsPtr)
+                {
+                    auto it = _transactionProofsPtr->find((*hashListPtr)[i].hex());
+                    if (it != _transactionProofsPtr->end())
+                    {
+                        // for compatibility
+                        addProofToResponse(
+                            jResp, "transactionProof", std::make_shared<ledger::MerkleProof>());
+                        addProofToResponse(jResp, "txProof", it->second);
+                    }
+                }
+                m_respFuncs[i](nullptr, jResp);
+            }
+        });
+}
+
 void JsonRpcImpl_2_0::getTransactionReceipt(std::string_view _groupID, std::string_view _nodeName,
     std::string_view _txHash, bool _requireProof, RespFunc _respFunc)
 {
@@ -708,6 +972,226 @@ void JsonRpcImpl_2_0::getTransactionReceipt(std::string_view _groupID, std::stri
         });
 }
 
+void JsonRpcImpl_2_0::writeReceiptResponse(JsonWriter& writer, crypto::HashType const& _hash,
+    protocol::TransactionReceipt const& _receipt, bool _requireProof,
+    ledger::MerkleProofPtr const& _receiptProof, protocol::Transaction const* _transaction,
+    bool _withTxProof, bool _isWasm, crypto::Hash& _hashImpl)
+{
+    writer.startObject();
+    toJsonResp(writer, _hash.hexPrefixed(), protocol::TransactionStatus::None, _receipt, _isWasm,
+        _hashImpl);
+    if (_requireProof && _receiptProof)
+    {
+        addProofToResponse(writer, "receiptProof", std::make_shared<ledger::MerkleProof>());
+        // for compatibility
+        addProofToResponse(writer, "txReceiptProof", _receiptProof);
+    }
+    if (_transaction)
+    {
+        auto sender = _transaction->sender();
+        writer.hexMember("input", _transaction->input());
+        writer.hexMember("from", bytesConstRef((const bcos::byte*)sender.data(), sender.size()));
+        writer.member("to", _transaction->to());
+        writer.member("extraData", _transaction->extraData());
+    }
+    else
+    {
+        for (auto key : {"input", "from", "to", "extraData"})
+        {
+            writer.key(key);
+            writer.null();
+        }
+    }
+    writer.key("transactionProof");
+    if (_withTxProof)
+    {
+        // for compatibility
+        writer.startArray();
+        writer.endArray();
+    }
+    else
+    {
+        writer.null();
+    }
+    writer.endObject();
+}
+
+void JsonRpcImpl_2_0::getTransactionReceiptStream(std::string_view _groupID,
+    std::string_view _nodeName, std::string_view _txHash, bool _requireProof,
+    StreamRespFunc _respFunc)
+{
+    RPC_IMPL_LOG(TRACE) << LOG_DESC("getTransactionReceiptStream") << LOG_KV("txHash", _txHash)
+                        << LOG_KV("requireProof", _requireProof) << LOG_KV("group", _groupID)
+                        << LOG_KV("node", _nodeName);
+
+    auto hash = bcos::crypto::HashType(_txHash, bcos::crypto::HashType::FromHex);
+
+    auto nodeService = getNodeService(_groupID, _nodeName, "getTransactionReceipt");
+    auto ledger = nodeService->ledger();
+
+    checkService(ledger, "ledger");
+    auto hashImpl = nodeService->blockFactory()->cryptoSuite()->hashImpl();
+
+    auto groupInfo = m_groupManager->getGroupInfo(_groupID);
+    if (!groupInfo)
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(JsonRpcError::GroupNotExist,
+            "The group " + std::string(_groupID) + " does not exist!"));
+    }
+
+    bool isWasm = groupInfo->wasm();
+    ledger->asyncGetTransactionReceiptByHash(hash, _requireProof,
+        [m_txHash = std::string(_txHash), hash, _requireProof, m_respFunc = std::move(_respFunc),
+            ledger, hashImpl, isWasm](Error::Ptr _error,
+            protocol::TransactionReceipt::ConstPtr _transactionReceiptPtr,
+            ledger::MerkleProofPtr _merkleProofPtr) mutable {
+            if (_error && (_error->errorCode() != bcos::protocol::CommonError::SUCCESS))
+            {
+                RPC_IMPL_LOG(INFO)
+                    << LOG_BADGE("getTransactionReceipt failed") << LOG_KV("txHash", m_txHash)
+                    << LOG_KV("requireProof", _requireProof)
+                    << LOG_KV("code", _error ? _error->errorCode() : 0)
+                    << LOG_KV("message", _error ? _error->errorMessage() : "success");
+
+                m_respFunc(_error, [](JsonWriter& writer) { writer.null(); });
+                return;
+            }
+
+            // fetch the transaction for input, from, to and extraData
+            auto hashListPtr = std::make_shared<bcos::crypto::HashList>();
+            hashListPtr->push_back(hash);
+            ledger->asyncGetBatchTxsByHashList(hashListPtr, _requireProof,
+                [m_txHash = std::move(m_txHash), hash, _requireProof,
+                    m_respFunc = std::move(m_respFunc), hashImpl = std::move(hashImpl), isWasm,
+                    receipt = std::move(_transactionReceiptPtr),
+                    receiptProof = std::move(_merkleProofPtr)](Error::Ptr _error,
+                    bcos::protocol::TransactionsPtr _transactionsPtr,
+                    std::shared_ptr<std::map<std::string, ledger::MerkleProofPtr>>
+                        _transactionProofsPtr) {
+                    protocol::Transaction::ConstPtr transaction;
+                    if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
+                    {
+                        RPC_IMPL_LOG(WARNING)
+                            << LOG_BADGE("getTransactionReceipt") << LOG_DESC("getTransaction")
+                            << LOG_KV("hexPreTxHash", m_txHash)
+                            << LOG_KV("code", _error->errorCode())
+                            << LOG_KV("message", _error->errorMessage());
+                    }
+                    else if (_transactionsPtr && !_transactionsPtr->empty())
+                    {
+                        transaction = _transactionsPtr->front();
+                    }
+                    bool withTxProof = transaction && _requireProof && _transactionProofsPtr &&
+                                       !_transactionProofsPtr->empty();
+
+                    m_respFunc(nullptr, [&](JsonWriter& writer) {
+                        writeReceiptResponse(writer, hash, *receipt, _requireProof, receiptProof,
+                            transaction.get(), withTxProof, isWasm, *hashImpl);
+                    });
+                });
+        });
+}
+
+void JsonRpcImpl_2_0::getTransactionReceiptBatch(std::string_view _groupID,
+    std::string_view _nodeName, std::vector<std::string> const& _txHashes, bool _requireProof,
+    std::vector<StreamRespFunc> _respFuncs)
+{
+    // the ledger has no batch query of the receipt proofs
+    if (_requireProof)
+    {
+        JsonRpcInterface::getTransactionReceiptBatch(
+            _groupID, _nodeName, _txHashes, _requireProof, std::move(_respFuncs));
+        return;
+    }
+    RPC_IMPL_LOG(TRACE) << LOG_DESC("getTransactionReceiptBatch")
+                        << LOG_KV("size", _txHashes.size()) << LOG_KV("group", _groupID)
+                        << LOG_KV("node", _nodeName);
+
+    auto hashListPtr = std::make_shared<bcos::crypto::HashList>();
+    hashListPtr->reserve(_txHashes.size());
+    for (const auto& txHash : _txHashes)
+    {
+        hashListPtr->emplace_back(txHash, bcos::crypto::HashType::FromHex);
+    }
+
+    auto nodeService = getNodeService(_groupID, _nodeName, "getTransactionReceipt");
+    auto ledger = nodeService->ledger();
+    checkService(ledger, "ledger");
+    auto hashImpl = nodeService->blockFactory()->cryptoSuite()->hashImpl();
+    auto groupInfo = m_groupManager->getGroupInfo(_groupID);
+    if (!groupInfo)
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(JsonRpcError::GroupNotExist,
+            "The group " + std::string(_groupID) + " does not exist!"));
+    }
+    bool isWasm = groupInfo->wasm();
+
+    auto self = std::weak_ptr<JsonRpcImpl_2_0>(shared_from_this());
+    ledger->asyncGetBatchReceiptsByHashList(hashListPtr,
+        [self, ledger, hashImpl, isWasm, hashListPtr, m_groupID = std::string(_groupID),
+            m_nodeName = std::string(_nodeName), m_txHashes = _txHashes,
+            m_respFuncs = std::move(_respFuncs)](Error::Ptr _error,
+            std::vector<protocol::TransactionReceipt::ConstPtr> _receipts) mutable {
+            // the batch fails when any of the receipts is missing, fall back to query them one by
+            // one to respond each of the requests correctly
+            if ((_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS) ||
+                _receipts.size() != m_txHashes.size())
+            {
+                auto rpc = self.lock();
+                if (!rpc)
+                {
+                    for (auto& respFunc : m_respFuncs)
+                    {
+                        respFunc(BCOS_ERROR_PTR(JsonRpcError::InternalError, "rpc is stopped"),
+                            [](JsonWriter& writer) { writer.null(); });
+                    }
+                    return;
+                }
+                RPC_IMPL_LOG(DEBUG) << LOG_BADGE("getTransactionReceiptBatch")
+                                    << LOG_DESC("batch query failed, query one by one")
+                                    << LOG_KV("size", m_txHashes.size())
+                                    << LOG_KV("code", _error ? _error->errorCode() : 0);
+                rpc->JsonRpcInterface::getTransactionReceiptBatch(
+                    m_groupID, m_nodeName, m_txHashes, false, std::move(m_respFuncs));
+                return;
+            }
+
+            // fetch the transactions for input, from, to and extraData
+            ledger->asyncGetBatchTxsByHashList(hashListPtr, false,
+                [hashImpl = std::move(hashImpl), isWasm, hashListPtr,
+                    receipts = std::move(_receipts), m_respFuncs = std::move(m_respFuncs)](
+                    Error::Ptr _error, bcos::protocol::TransactionsPtr _transactionsPtr,
+                    std::shared_ptr<std::map<std::string, ledger::MerkleProofPtr>>) {
+                    // the transactions found, a missing one is written as null
+                    std::map<crypto::HashType, protocol::Transaction const*> transactions;
+                    if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
+                    {
+                        RPC_IMPL_LOG(WARNING)
+                            << LOG_BADGE("getTransactionReceiptBatch")
+                            << LOG_DESC("getTransaction") << LOG_KV("code", _error->errorCode())
+                            << LOG_KV("message", _error->errorMessage());
+                    }
+                    else if (_transactionsPtr)
+                    {
+                        for (auto const& transaction : *_transactionsPtr)
+                        {
+                            transactions.emplace(transaction->hash(), transaction.get());
+                        }
+                    }
+                    for (size_t i = 0; i < m_respFuncs.size(); ++i)
+                    {
+                        auto const& hash = (*hashListPtr)[i];
+                        auto it = transactions.find(hash);
+                        m_respFuncs[i](nullptr, [&](JsonWriter& writer) {
+                            writeReceiptResponse(writer, hash, *receipts[i], false, nullptr,
+                                it != transactions.end() ? it->second : nullptr, false, isWasm,
+                                *hashImpl);
+                        });
+                    }
+                });
+        });
+}
+
 void JsonRpcImpl_2_0::getBlockByHash(std::string_view _groupID, std::string_view _nodeName,
     std::string_view _blockHash, bool _onlyHeader, bool _onlyTxHash, RespFunc _respFunc)
 {
@@ -789,6 +1273,95 @@ void JsonRpcImpl_2_0::getBlockByNumber(std::string_view _groupID, std::string_vi
         });
 }
 
+void JsonRpcImpl_2_0::getBlockByHashStream(std::string_view _groupID, std::string_view _nodeName,
+    std::string_view _blockHash, bool _onlyHeader, bool _onlyTxHash, StreamRespFunc _respFunc)
+{
+    RPC_IMPL_LOG(TRACE) << LOG_DESC("getBlockByHashStream") << LOG_KV("blockHash", _blockHash)
+                        << LOG_KV("onlyHeader", _onlyHeader) << LOG_KV("onlyTxHash", _onlyTxHash)
+                        << LOG_KV("group", _groupID) << LOG_KV("node", _nodeName);
+
+    auto nodeService = getNodeService(_groupID, _nodeName, "getBlockByHash");
+    auto ledger = nodeService->ledger();
+    checkService(ledger, "ledger");
+    auto self = std::weak_ptr<JsonRpcImpl_2_0>(shared_from_this());
+    ledger->asyncGetBlockNumberByHash(
+        bcos::crypto::HashType(_blockHash, bcos::crypto::HashType::FromHex),
+        [m_groupID = std::string(_groupID), m_nodeName = std::string(_nodeName),
+            m_blockHash = std::string(_blockHash), _onlyHeader, _onlyTxHash,
+            m_respFunc = std::move(_respFunc),
+            self](Error::Ptr _error, protocol::BlockNumber blockNumber) {
+            if (!_error || _error->errorCode() == bcos::protocol::CommonError::SUCCESS)
+            {
+                auto rpc = self.lock();
+                if (rpc)
+                {
+                    // call getBlockByNumber
+                    return rpc->getBlockByNumberStream(m_groupID, m_nodeName, blockNumber,
+                        _onlyHeader, _onlyTxHash, std::move(m_respFunc));
+                }
+            }
+            else
+            {
+                RPC_IMPL_LOG(INFO)
+                    << LOG_BADGE("getBlockByHash failed") << LOG_KV("blockHash", m_blockHash)
+                    << LOG_KV("onlyHeader", _onlyHeader) << LOG_KV("onlyTxHash", _onlyTxHash)
+                    << LOG_KV("code", _error ? _error->errorCode() : 0)
+                    << LOG_KV("message", _error ? _error->errorMessage() : "success");
+                m_respFunc(_error, [](JsonWriter& writer) { writer.null(); });
+            }
+        });
+}
+
+void JsonRpcImpl_2_0::getBlockByNumberStream(std::string_view _groupID,
+    std::string_view _nodeName, int64_t _blockNumber, bool _onlyHeader, bool _onlyTxHash,
+    StreamRespFunc _respFunc)
+{
+    RPC_IMPL_LOG(TRACE) << LOG_DESC("getBlockByNumberStream") << LOG_KV("blockNumber", _blockNumber)
+                        << LOG_KV("onlyHeader", _onlyHeader) << LOG_KV("onlyTxHash", _onlyTxHash)
+                        << LOG_KV("group", _groupID) << LOG_KV("node", _nodeName);
+
+    auto nodeService = getNodeService(_groupID, _nodeName, "getBlockByNumber");
+    auto ledger = nodeService->ledger();
+    checkService(ledger, "ledger");
+    auto flag = _onlyHeader ?
+                    bcos::ledger::HEADER :
+                    (_onlyTxHash ? bcos::ledger::HEADER | bcos::ledger::TRANSACTIONS_HASH :
+                                   bcos::ledger::HEADER | bcos::ledger::TRANSACTIONS);
+    ledger->asyncGetBlockDataByNumber(_blockNumber, flag,
+        [_blockNumber, _onlyHeader, _onlyTxHash, m_respFunc = std::move(_respFunc)](
+            Error::Ptr _error, protocol::Block::Ptr _block) {
+            if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
+            {
+                RPC_IMPL_LOG(INFO)
+                    << LOG_BADGE("getBlockByNumber failed") << LOG_KV("blockNumber", _blockNumber)
+                    << LOG_KV("onlyHeader", _onlyHeader) << LOG_KV("onlyTxHash", _onlyTxHash)
+                    << LOG_KV("code", _error ? _error->errorCode() : 0)
+                    << LOG_KV("message", _error ? _error->errorMessage() : "success");
+                m_respFunc(_error, [](JsonWriter& writer) { writer.null(); });
+                return;
+            }
+
+            m_respFunc(_error, [&_block, _onlyHeader, _onlyTxHash](JsonWriter& writer) {
+                auto blockHeader = _block ? _block->blockHeaderConst() : nullptr;
+                if (!_block || (_onlyHeader && !blockHeader))
+                {
+                    writer.null();
+                    return;
+                }
+                writer.startObject();
+                if (_onlyHeader)
+                {
+                    toJsonResp(writer, *blockHeader);
+                }
+                else
+                {
+                    toJsonResp(writer, *_block, _onlyTxHash);
+                }
+                writer.endObject();
+            });
+        });
+}
+
 void JsonRpcImpl_2_0::getBlockHashByNumber(
     std::string_view _groupID, std::string_view _nodeName, int64_t _blockNumber, RespFunc _respFunc)
 {
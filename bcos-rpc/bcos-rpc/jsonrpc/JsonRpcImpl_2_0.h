@@ -41,7 +41,7 @@ public:
     JsonRpcImpl_2_0(GroupManager::Ptr _groupManager,
         bcos::gateway::GatewayInterface::Ptr _gatewayInterface,
         std::shared_ptr<boostssl::ws::WsService> _wsService);
-    ~JsonRpcImpl_2_0() override = default;
+    ~JsonRpcImpl_2_0() override { stopBatchDispatch(); }
 
     void setClientID(std::string_view _clientID) { m_clientID = _clientID; }
 
@@ -120,6 +120,25 @@ public:
 
     void getGroupBlockNumber(RespFunc _respFunc) override;
 
+    void getTransactionReceiptStream(std::string_view _groupID, std::string_view _nodeName,
+        std::string_view _txHash, bool _requireProof, StreamRespFunc _respFunc) override;
+
+    void getBlockByHashStream(std::string_view _groupID, std::string_view _nodeName,
+        std::string_view _blockHash, bool _onlyHeader, bool _onlyTxHash,
+        StreamRespFunc _respFunc) override;
+
+    void getBlockByNumberStream(std::string_view _groupID, std::string_view _nodeName,
+        int64_t _blockNumber, bool _onlyHeader, bool _onlyTxHash,
+        StreamRespFunc _respFunc) override;
+
+    void getTransactionBatch(std::string_view _groupID, std::string_view _nodeName,
+        std::vector<std::string> const& _txHashes, bool _requireProof,
+        std::vector<RespFunc> _respFuncs) override;
+
+    void getTransactionReceiptBatch(std::string_view _groupID, std::string_view _nodeName,
+        std::vector<std::string> const& _txHashes, bool _requireProof,
+        std::vector<StreamRespFunc> _respFuncs) override;
+
     void setNodeInfo(const NodeInfo& _nodeInfo) { m_nodeInfo = _nodeInfo; }
     NodeInfo nodeInfo() const { return m_nodeInfo; }
     GroupManager::Ptr groupManager() { return m_groupManager; }
@@ -134,6 +153,14 @@ protected:
 
     static void addProofToResponse(
         Json::Value& jResp, const std::string& _key, ledger::MerkleProofPtr _merkleProofPtr);
+    static void addProofToResponse(
+        JsonWriter& writer, std::string_view _key, ledger::MerkleProofPtr const& _merkleProofPtr);
+    // the receipt with the input, from, to and extraData of its transaction, which is written as
+    // null if not found
+    static void writeReceiptResponse(JsonWriter& writer, crypto::HashType const& _hash,
+        protocol::TransactionReceipt const& _receipt, bool _requireProof,
+        ledger::MerkleProofPtr const& _receiptProof, protocol::Transaction const* _transaction,
+        bool _withTxProof, bool _isWasm, crypto::Hash& _hashImpl);
 
     virtual void handleRpcRequest(std::shared_ptr<boostssl::MessageFace> _msg,
         std::shared_ptr<boostssl::ws::WsSession> _session);
@@ -196,4 +223,13 @@ void toJsonResp(Json::Value& jResp, std::string_view _txHash, protocol::Transact
     bcos::protocol::TransactionReceipt const& transactionReceiptPtr, bool _isWasm,
     crypto::Hash& hashImpl);
 
+// streaming encoders, write the same members as the Json::Value based ones into the object
+// currently opened on the writer
+void toJsonResp(JsonWriter& writer, bcos::protocol::Transaction const& transaction);
+void toJsonResp(JsonWriter& writer, bcos::protocol::BlockHeader const& blockHeader);
+void toJsonResp(JsonWriter& writer, bcos::protocol::Block& block, bool _onlyTxHash);
+void toJsonResp(JsonWriter& writer, std::string_view _txHash, protocol::TransactionStatus status,
+    bcos::protocol::TransactionReceipt const& transactionReceipt, bool _isWasm,
+    crypto::Hash& hashImpl);
+
 }  // namespace bcos::rpc
\ No newline at end of file
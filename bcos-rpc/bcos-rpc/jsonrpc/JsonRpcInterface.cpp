@@ -1,13 +1,8 @@
 #include "JsonRpcInterface.h"
 #include <json/forwards.h>
-#include <boost/beast/core/ostream.hpp>
-#include <boost/iostreams/device/array.hpp>
-#include <boost/iostreams/device/back_inserter.hpp>
-#include <boost/iostreams/filtering_stream.hpp>
-#include <boost/iostreams/stream.hpp>
-#include <iterator>
-#include <ostream>
-#include <sstream>
+#include <atomic>
+#include <map>
+#include <tuple>
 
 using namespace bcos::rpc;
 
@@ -19,12 +14,6 @@ void JsonRpcInterface::initMethod()
         &JsonRpcInterface::sendTransactionI, this, std::placeholders::_1, std::placeholders::_2);
     m_methodToFunc["getTransaction"] = std::bind(
         &JsonRpcInterface::getTransactionI, this, std::placeholders::_1, std::placeholders::_2);
-    m_methodToFunc["getTransactionReceipt"] = std::bind(&JsonRpcInterface::getTransactionReceiptI,
-        this, std::placeholders::_1, std::placeholders::_2);
-    m_methodToFunc["getBlockByHash"] = std::bind(
-        &JsonRpcInterface::getBlockByHashI, this, std::placeholders::_1, std::placeholders::_2);
-    m_methodToFunc["getBlockByNumber"] = std::bind(
-        &JsonRpcInterface::getBlockByNumberI, this, std::placeholders::_1, std::placeholders::_2);
     m_methodToFunc["getBlockHashByNumber"] = std::bind(&JsonRpcInterface::getBlockHashByNumberI,
         this, std::placeholders::_1, std::placeholders::_2);
     m_methodToFunc["getBlockNumber"] = std::bind(
@@ -66,15 +55,136 @@ void JsonRpcInterface::initMethod()
     m_methodToFunc["getGroupNodeInfo"] = std::bind(
         &JsonRpcInterface::getGroupNodeInfoI, this, std::placeholders::_1, std::placeholders::_2);
 
+    // the methods with large responses, write the result without building a Json::Value
+    m_methodToStreamFunc["getTransactionReceipt"] =
+        std::bind(&JsonRpcInterface::getTransactionReceiptI, this, std::placeholders::_1,
+            std::placeholders::_2);
+    m_methodToStreamFunc["getBlockByHash"] = std::bind(
+        &JsonRpcInterface::getBlockByHashI, this, std::placeholders::_1, std::placeholders::_2);
+    m_methodToStreamFunc["getBlockByNumber"] = std::bind(
+        &JsonRpcInterface::getBlockByNumberI, this, std::placeholders::_1, std::placeholders::_2);
+
     for (const auto& method : m_methodToFunc)
     {
         RPC_IMPL_LOG(INFO) << LOG_BADGE("initMethod") << LOG_KV("method", method.first);
     }
-    RPC_IMPL_LOG(INFO) << LOG_BADGE("initMethod") << LOG_KV("size", m_methodToFunc.size());
+    for (const auto& method : m_methodToStreamFunc)
+    {
+        RPC_IMPL_LOG(INFO) << LOG_BADGE("initMethod") << LOG_KV("streamMethod", method.first);
+    }
+    RPC_IMPL_LOG(INFO) << LOG_BADGE("initMethod")
+                       << LOG_KV("size", m_methodToFunc.size() + m_methodToStreamFunc.size());
+}
+
+void JsonRpcInterface::getTransactionReceiptStream(std::string_view _groupID,
+    std::string_view _nodeName, std::string_view _txHash, bool _requireProof,
+    StreamRespFunc _respFunc)
+{
+    getTransactionReceipt(
+        _groupID, _nodeName, _txHash, _requireProof, toRespFunc(std::move(_respFunc)));
+}
+
+void JsonRpcInterface::getBlockByHashStream(std::string_view _groupID, std::string_view _nodeName,
+    std::string_view _blockHash, bool _onlyHeader, bool _onlyTxHash, StreamRespFunc _respFunc)
+{
+    getBlockByHash(_groupID, _nodeName, _blockHash, _onlyHeader, _onlyTxHash,
+        toRespFunc(std::move(_respFunc)));
+}
+
+void JsonRpcInterface::getBlockByNumberStream(std::string_view _groupID,
+    std::string_view _nodeName, int64_t _blockNumber, bool _onlyHeader, bool _onlyTxHash,
+    StreamRespFunc _respFunc)
+{
+    getBlockByNumber(_groupID, _nodeName, _blockNumber, _onlyHeader, _onlyTxHash,
+        toRespFunc(std::move(_respFunc)));
+}
+
+// fill the error of the response with the exception thrown while handling the request
+static void setResponseError(JsonResponse& _response, const std::exception& _e)
+{
+    if (const auto* rpcException = dynamic_cast<const JsonRpcException*>(&_e))
+    {
+        _response.error.code = rpcException->code();
+    }
+    else
+    {
+        // server internal error or unexpected error
+        _response.error.code = JsonRpcError::InvalidRequest;
+    }
+    _response.error.message = std::string(_e.what());
+}
+
+static bcos::Error::Ptr toError(const std::exception& _e)
+{
+    JsonResponse response;
+    setResponseError(response, _e);
+    return BCOS_ERROR_PTR(response.error.code, response.error.message);
+}
+
+// the error response of a request whose id is unknown, the id is null
+static bcos::bytes toNullIDResponse(JsonResponse::Error const& _error)
+{
+    bcos::bytes out;
+    JsonWriter writer(out);
+    writer.startObject();
+    writer.key("error");
+    writer.startObject();
+    writer.member("code", _error.code);
+    writer.member("message", _error.message);
+    writer.endObject();
+    writer.key("id");
+    writer.null();
+    writer.member("jsonrpc", "2.0");
+    writer.endObject();
+    return out;
+}
+
+void JsonRpcInterface::getTransactionBatch(std::string_view _groupID, std::string_view _nodeName,
+    std::vector<std::string> const& _txHashes, bool _requireProof,
+    std::vector<RespFunc> _respFuncs)
+{
+    for (size_t i = 0; i < _txHashes.size(); ++i)
+    {
+        // a copy is passed, so the request can still be answered if the call throws
+        try
+        {
+            getTransaction(_groupID, _nodeName, _txHashes[i], _requireProof, _respFuncs[i]);
+        }
+        catch (const std::exception& e)
+        {
+            Json::Value result;
+            _respFuncs[i](toError(e), result);
+        }
+    }
+}
+
+void JsonRpcInterface::getTransactionReceiptBatch(std::string_view _groupID,
+    std::string_view _nodeName, std::vector<std::string> const& _txHashes, bool _requireProof,
+    std::vector<StreamRespFunc> _respFuncs)
+{
+    for (size_t i = 0; i < _txHashes.size(); ++i)
+    {
+        try
+        {
+            getTransactionReceiptStream(
+                _groupID, _nodeName, _txHashes[i], _requireProof, _respFuncs[i]);
+        }
+        catch (const std::exception& e)
+        {
+            _respFuncs[i](toError(e), [](JsonWriter& writer) { writer.null(); });
+        }
+    }
 }
 
 void JsonRpcInterface::onRPCRequest(std::string_view _requestBody, Sender _sender)
 {
+    auto begin = _requestBody.find_first_not_of(" \t\r\n");
+    if (begin != std::string_view::npos && _requestBody[begin] == '[')
+    {
+        onRPCBatchRequest(_requestBody, std::move(_sender));
+        return;
+    }
+
     JsonRequest request;
     JsonResponse response;
     try
@@ -84,47 +194,15 @@ void JsonRpcInterface::onRPCRequest(std::string_view _requestBody, Sender _sende
         response.jsonrpc = request.jsonrpc;
         response.id = request.id;
 
-        const auto& method = request.method;
-        auto it = m_methodToFunc.find(method);
-        if (it == m_methodToFunc.end())
-        {
-            BOOST_THROW_EXCEPTION(JsonRpcException(
-                JsonRpcError::MethodNotFound, "The method does not exist/is not available."));
-        }
         RPC_IMPL_LOG(TRACE) << LOG_BADGE("onRPCRequest") << LOG_KV("request", _requestBody);
-        it->second(
-            request.params, [response, _sender](Error::Ptr _error, Json::Value& _result) mutable {
-                if (_error && (_error->errorCode() != bcos::protocol::CommonError::SUCCESS))
-                {
-                    // error
-                    response.error.code = _error->errorCode();
-                    response.error.message = _error->errorMessage();
-                }
-                else
-                {
-                    response.result.swap(_result);
-                }
-                auto strResp = toStringResponse(std::move(response));
-                RPC_IMPL_LOG(TRACE)
-                    << LOG_BADGE("onRPCRequest")
-                    << LOG_KV("response",
-                           std::string_view((const char*)strResp.data(), strResp.size()));
-                _sender(std::move(strResp));
-            });
+        dispatchRequest(request, _sender);
 
         // success response
         return;
     }
-    catch (const JsonRpcException& e)
-    {
-        response.error.code = e.code();
-        response.error.message = std::string(e.what());
-    }
     catch (const std::exception& e)
     {
-        // server internal error or unexpected error
-        response.error.code = JsonRpcError::InvalidRequest;
-        response.error.message = std::string(e.what());
+        setResponseError(response, e);
     }
 
     auto strResp = toStringResponse(response);
@@ -136,10 +214,283 @@ void JsonRpcInterface::onRPCRequest(std::string_view _requestBody, Sender _sende
     _sender(strResp);
 }
 
+void JsonRpcInterface::dispatchRequest(JsonRequest const& _request, Sender _sender)
+{
+    JsonResponse response;
+    response.jsonrpc = _request.jsonrpc;
+    response.id = _request.id;
+
+    StreamRespFunc respFunc = [response = std::move(response), _sender = std::move(_sender)](
+                                  Error::Ptr _error, ResultWriter _resultWriter) mutable {
+        if (_error && (_error->errorCode() != bcos::protocol::CommonError::SUCCESS))
+        {
+            // error
+            response.error.code = _error->errorCode();
+            response.error.message = _error->errorMessage();
+        }
+        auto strResp = toStringResponse(response, _resultWriter);
+        RPC_IMPL_LOG(TRACE) << LOG_BADGE("onRPCRequest")
+                            << LOG_KV("response", std::string_view((const char*)strResp.data(),
+                                                      strResp.size()));
+        _sender(std::move(strResp));
+    };
+
+    const auto& method = _request.method;
+    auto streamIt = m_methodToStreamFunc.find(method);
+    if (streamIt != m_methodToStreamFunc.end())
+    {
+        streamIt->second(_request.params, std::move(respFunc));
+        return;
+    }
+
+    auto it = m_methodToFunc.find(method);
+    if (it == m_methodToFunc.end())
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(
+            JsonRpcError::MethodNotFound, "The method does not exist/is not available."));
+    }
+    it->second(_request.params, toRespFunc(std::move(respFunc)));
+}
+
+void JsonRpcInterface::onRPCBatchRequest(std::string_view _requestBody, Sender _sender)
+{
+    Json::Value root;
+    Json::Reader jsonReader;
+    JsonResponse::Error error;
+    if (!jsonReader.parse(_requestBody.begin(), _requestBody.end(), root) || !root.isArray())
+    {
+        error.code = JsonRpcError::ParseError;
+        error.message = "Invalid JSON was received by the server.";
+    }
+    else if (root.empty() || root.size() > MAX_BATCH_REQUEST_SIZE)
+    {
+        error.code = JsonRpcError::InvalidRequest;
+        error.message = "The batch request is empty or exceeds the size limit " +
+                        std::to_string(MAX_BATCH_REQUEST_SIZE);
+    }
+    if (error.code != 0)
+    {
+        RPC_IMPL_LOG(DEBUG) << LOG_BADGE("onRPCBatchRequest") << LOG_DESC("invalid batch request")
+                            << LOG_KV("request", _requestBody) << LOG_KV("message", error.message);
+        _sender(toNullIDResponse(error));
+        return;
+    }
+
+    // collect the responses by index, the batch is answered after all the requests responded
+    struct BatchContext
+    {
+        explicit BatchContext(size_t _size, Sender _sender)
+          : requests(_size),
+            notifications(_size),
+            responses(_size),
+            pending(_size),
+            sender(std::move(_sender))
+        {}
+        std::vector<JsonRequest> requests;
+        // the requests without id, handled but not answered
+        std::vector<bool> notifications;
+        std::vector<bcos::bytes> responses;
+        std::atomic_size_t pending;
+        Sender sender;
+    };
+    auto context = std::make_shared<BatchContext>(root.size(), std::move(_sender));
+    auto itemSender = [context](size_t _index) -> Sender {
+        return [context, _index](bcos::bytes _response) {
+            if (!context->notifications[_index])
+            {
+                context->responses[_index] = std::move(_response);
+            }
+            if (context->pending.fetch_sub(1) != 1)
+            {
+                return;
+            }
+            // nothing is sent back for a batch of notifications only
+            size_t totalSize = context->responses.size() + 1;
+            for (const auto& item : context->responses)
+            {
+                totalSize += item.size();
+            }
+            bcos::bytes out;
+            out.reserve(totalSize);
+            for (const auto& item : context->responses)
+            {
+                if (item.empty())
+                {
+                    continue;
+                }
+                out.push_back(out.empty() ? '[' : ',');
+                out.insert(out.end(), item.begin(), item.end());
+            }
+            if (!out.empty())
+            {
+                out.push_back(']');
+            }
+            context->sender(std::move(out));
+        };
+    };
+
+    // the getTransaction or getTransactionReceipt requests of the same node, fetched by one
+    // ledger call, keyed by method, group, node and requireProof
+    std::map<std::tuple<std::string, std::string, std::string, bool>, std::vector<size_t>>
+        groupedRequests;
+    std::vector<size_t> dispatchIndexes;
+    dispatchIndexes.reserve(root.size());
+    for (Json::ArrayIndex i = 0; i < root.size(); ++i)
+    {
+        try
+        {
+            auto& request = context->requests[i];
+            parseRpcRequestJson(root[i], request);
+            context->notifications[i] = !root[i].isMember("id");
+            auto const& params = request.params;
+            if ((request.method == "getTransaction" || request.method == "getTransactionReceipt") &&
+                params.size() >= 4 && params[0u].isString() && params[1u].isString() &&
+                params[2u].isString() && params[3u].isBool())
+            {
+                groupedRequests[{request.method, params[0u].asString(), params[1u].asString(),
+                                    params[3u].asBool()}]
+                    .push_back(i);
+                continue;
+            }
+            dispatchIndexes.push_back(i);
+        }
+        catch (const std::exception& e)
+        {
+            JsonResponse errorResponse;
+            setResponseError(errorResponse, e);
+            itemSender(i)(toNullIDResponse(errorResponse.error));
+        }
+    }
+
+    RPC_IMPL_LOG(TRACE) << LOG_BADGE("onRPCBatchRequest") << LOG_KV("size", root.size())
+                        << LOG_KV("groups", groupedRequests.size())
+                        << LOG_KV("dispatch", dispatchIndexes.size());
+
+    auto dispatchOne = [this, context, itemSender](size_t _index) {
+        auto const& request = context->requests[_index];
+        try
+        {
+            dispatchRequest(request, itemSender(_index));
+        }
+        catch (const std::exception& e)
+        {
+            JsonResponse errorResponse;
+            errorResponse.jsonrpc = request.jsonrpc;
+            errorResponse.id = request.id;
+            setResponseError(errorResponse, e);
+            itemSender(_index)(toStringResponse(std::move(errorResponse)));
+        }
+    };
+
+    for (auto& [key, indexes] : groupedRequests)
+    {
+        if (indexes.size() == 1)
+        {
+            dispatchIndexes.push_back(indexes.front());
+            continue;
+        }
+        std::vector<std::string> txHashes;
+        std::vector<StreamRespFunc> respFuncs;
+        txHashes.reserve(indexes.size());
+        respFuncs.reserve(indexes.size());
+        // every item is answered once, either by the batch or by the fallback dispatch below
+        auto answered = std::make_shared<std::vector<std::atomic_bool>>(indexes.size());
+        for (size_t position = 0; position < indexes.size(); ++position)
+        {
+            auto index = indexes[position];
+            txHashes.emplace_back(context->requests[index].params[2u].asString());
+            JsonResponse itemResponse;
+            itemResponse.jsonrpc = context->requests[index].jsonrpc;
+            itemResponse.id = context->requests[index].id;
+            respFuncs.emplace_back([itemResponse = std::move(itemResponse),
+                                       sender = itemSender(index), answered, position](
+                                       Error::Ptr _error, ResultWriter _resultWriter) mutable {
+                if ((*answered)[position].exchange(true))
+                {
+                    return;
+                }
+                if (_error && (_error->errorCode() != bcos::protocol::CommonError::SUCCESS))
+                {
+                    itemResponse.error.code = _error->errorCode();
+                    itemResponse.error.message = _error->errorMessage();
+                }
+                sender(toStringResponse(itemResponse, _resultWriter));
+            });
+        }
+        m_batchPool->enqueue([this, dispatchOne, key = key, indexes = indexes,
+                                 txHashes = std::move(txHashes), respFuncs = std::move(respFuncs),
+                                 answered]() mutable {
+            auto const& [method, groupID, nodeName, requireProof] = key;
+            try
+            {
+                if (method == "getTransaction")
+                {
+                    std::vector<RespFunc> txRespFuncs;
+                    txRespFuncs.reserve(respFuncs.size());
+                    for (auto& respFunc : respFuncs)
+                    {
+                        txRespFuncs.emplace_back(toRespFunc(std::move(respFunc)));
+                    }
+                    getTransactionBatch(
+                        groupID, nodeName, txHashes, requireProof, std::move(txRespFuncs));
+                }
+                else
+                {
+                    getTransactionReceiptBatch(
+                        groupID, nodeName, txHashes, requireProof, std::move(respFuncs));
+                }
+            }
+            catch (const std::exception& e)
+            {
+                RPC_IMPL_LOG(DEBUG) << LOG_BADGE("onRPCBatchRequest")
+                                    << LOG_DESC("batch query failed, dispatch the rest")
+                                    << LOG_KV("method", method) << LOG_KV("message", e.what());
+                for (size_t position = 0; position < indexes.size(); ++position)
+                {
+                    if (!(*answered)[position].exchange(true))
+                    {
+                        dispatchOne(indexes[position]);
+                    }
+                }
+            }
+        });
+    }
+
+    for (auto index : dispatchIndexes)
+    {
+        m_batchPool->enqueue([dispatchOne, index]() { dispatchOne(index); });
+    }
+}
+
 void bcos::rpc::parseRpcRequestJson(std::string_view _requestBody, JsonRequest& _jsonRequest)
 {
     Json::Value root;
     Json::Reader jsonReader;
+    bool parsed = false;
+    try
+    {
+        parsed = jsonReader.parse(_requestBody.begin(), _requestBody.end(), root);
+    }
+    catch (const std::exception& e)
+    {
+        RPC_IMPL_LOG(ERROR) << LOG_BADGE("parseRpcRequestJson") << LOG_KV("request", _requestBody)
+                            << LOG_KV("message", boost::diagnostic_information(e));
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(JsonRpcError::ParseError, "Invalid JSON was received by the server."));
+    }
+
+    if (!parsed)
+    {
+        RPC_IMPL_LOG(ERROR) << LOG_BADGE("parseRpcRequestJson") << LOG_KV("request", _requestBody)
+                            << LOG_KV("message", "invalid request json object");
+        BOOST_THROW_EXCEPTION(JsonRpcException(
+            JsonRpcError::InvalidRequest, "The JSON sent is not a valid Request object."));
+    }
+    parseRpcRequestJson(root, _jsonRequest);
+}
+
+void bcos::rpc::parseRpcRequestJson(const Json::Value& root, JsonRequest& _jsonRequest)
+{
     std::string errorMessage;
 
     try
@@ -149,9 +500,9 @@ void bcos::rpc::parseRpcRequestJson(std::string_view _requestBody, JsonRequest&
         int64_t id = 0;
         do
         {
-            if (!jsonReader.parse(_requestBody.begin(), _requestBody.end(), root))
+            if (!root.isObject())
             {
-                errorMessage = "invalid request json object";
+                errorMessage = "request is not a json object";
                 break;
             }
 
@@ -193,23 +544,19 @@ void bcos::rpc::parseRpcRequestJson(std::string_view _requestBody, JsonRequest&
             _jsonRequest.id = id;
             _jsonRequest.params = jParams;
 
-            // RPC_IMPL_LOG(DEBUG) << LOG_BADGE("parseRpcRequestJson") << LOG_KV("method", method)
-            //                     << LOG_KV("requestMessage", _requestBody);
-
             // success return
             return;
         } while (0);
     }
     catch (const std::exception& e)
     {
-        RPC_IMPL_LOG(ERROR) << LOG_BADGE("parseRpcRequestJson") << LOG_KV("request", _requestBody)
+        RPC_IMPL_LOG(ERROR) << LOG_BADGE("parseRpcRequestJson")
                             << LOG_KV("message", boost::diagnostic_information(e));
         BOOST_THROW_EXCEPTION(
             JsonRpcException(JsonRpcError::ParseError, "Invalid JSON was received by the server."));
     }
 
-    RPC_IMPL_LOG(ERROR) << LOG_BADGE("parseRpcRequestJson") << LOG_KV("request", _requestBody)
-                        << LOG_KV("message", errorMessage);
+    RPC_IMPL_LOG(ERROR) << LOG_BADGE("parseRpcRequestJson") << LOG_KV("message", errorMessage);
 
     BOOST_THROW_EXCEPTION(JsonRpcException(
         JsonRpcError::InvalidRequest, "The JSON sent is not a valid Request object."));
@@ -218,33 +565,42 @@ void bcos::rpc::parseRpcRequestJson(std::string_view _requestBody, JsonRequest&
 
 bcos::bytes bcos::rpc::toStringResponse(JsonResponse _jsonResponse)
 {
-    auto jResp = toJsonResponse(std::move(_jsonResponse));
-    std::unique_ptr<Json::StreamWriter> writer(Json::StreamWriterBuilder().newStreamWriter());
-    class JsonSink
-    {
-    public:
-        typedef char char_type;
-        typedef boost::iostreams::sink_tag category;
-
-        JsonSink(bcos::bytes& buffer) : m_buffer(buffer) {}
-
-        std::streamsize write(const char* s, std::streamsize n)
-        {
-            m_buffer.insert(m_buffer.end(), (bcos::byte*)s, (bcos::byte*)s + n);
-            return n;
-        }
-
-        bcos::bytes& m_buffer;
-    };
+    return toStringResponse(_jsonResponse,
+        [&_jsonResponse](JsonWriter& _writer) { _writer.value(_jsonResponse.result); });
+}
 
+bcos::bytes bcos::rpc::toStringResponse(
+    JsonResponse const& _jsonResponse, ResultWriter const& _resultWriter)
+{
     bcos::bytes out;
-    boost::iostreams::stream<JsonSink> outputStream(out);
-
-    writer->write(jResp, &outputStream);
-    writer.reset();
+    JsonWriter writer(out);
+    writer.startObject();
+    if (_jsonResponse.error.code != 0)
+    {  // error
+        writer.key("error");
+        writer.startObject();
+        writer.member("code", _jsonResponse.error.code);
+        writer.member("message", _jsonResponse.error.message);
+        writer.endObject();
+    }
+    writer.member("id", _jsonResponse.id);
+    writer.member("jsonrpc", _jsonResponse.jsonrpc);
+    if (_jsonResponse.error.code == 0)
+    {  // success
+        writer.key("result");
+        _resultWriter(writer);
+    }
+    writer.endObject();
     return out;
 }
 
+RespFunc bcos::rpc::toRespFunc(StreamRespFunc _respFunc)
+{
+    return [respFunc = std::move(_respFunc)](Error::Ptr _error, Json::Value& _result) {
+        respFunc(std::move(_error), [&_result](JsonWriter& _writer) { _writer.value(_result); });
+    };
+}
+
 Json::Value bcos::rpc::toJsonResponse(JsonResponse _jsonResponse)
 {
     Json::Value jResp;
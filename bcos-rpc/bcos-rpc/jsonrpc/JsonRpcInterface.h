@@ -24,21 +24,34 @@
 #include <bcos-framework/multigroup/GroupInfo.h>
 #include <bcos-framework/protocol/CommonError.h>
 #include <bcos-rpc/jsonrpc/Common.h>
+#include <bcos-rpc/jsonrpc/JsonWriter.h>
 #include <bcos-utilities/Error.h>
+#include <bcos-utilities/ThreadPool.h>
 #include <json/json.h>
 #include <util/tc_json.h>
+#include <algorithm>
 #include <functional>
+#include <thread>
 
 namespace bcos::rpc
 {
 using Sender = std::function<void(bcos::bytes)>;
 using RespFunc = std::function<void(bcos::Error::Ptr, Json::Value&)>;
+// writes exactly one json value as the result of the response, only valid while the
+// StreamRespFunc that receives it is running
+using ResultWriter = std::function<void(JsonWriter&)>;
+using StreamRespFunc = std::function<void(bcos::Error::Ptr, ResultWriter)>;
 
 class JsonRpcInterface
 {
 public:
     using Ptr = std::shared_ptr<JsonRpcInterface>;
-    JsonRpcInterface() { initMethod(); }
+    JsonRpcInterface()
+      : m_batchPool(std::make_shared<bcos::ThreadPool>(
+            "rpcBatch", std::max(std::thread::hardware_concurrency(), 1U)))
+    {
+        initMethod();
+    }
     JsonRpcInterface(const JsonRpcInterface&) = default;
     JsonRpcInterface(JsonRpcInterface&&) = default;
     JsonRpcInterface& operator=(const JsonRpcInterface&) = default;
@@ -119,13 +132,59 @@ public:
 
     virtual void getGroupBlockNumber(RespFunc _respFunc) = 0;
 
+    // the streaming variants write the result straight into the response buffer without building
+    // a Json::Value, the default implementation falls back to the Json::Value based methods
+    virtual void getTransactionReceiptStream(std::string_view _groupID,
+        std::string_view _nodeName, std::string_view _txHash, bool _requireProof,
+        StreamRespFunc _respFunc);
+
+    virtual void getBlockByHashStream(std::string_view _groupID, std::string_view _nodeName,
+        std::string_view _blockHash, bool _onlyHeader, bool _onlyTxHash, StreamRespFunc _respFunc);
+
+    virtual void getBlockByNumberStream(std::string_view _groupID, std::string_view _nodeName,
+        int64_t _blockNumber, bool _onlyHeader, bool _onlyTxHash, StreamRespFunc _respFunc);
+
+    // the getTransaction requests of the same node in a batch request, _respFuncs[i] responds
+    // _txHashes[i], the default implementation handles them one by one
+    virtual void getTransactionBatch(std::string_view _groupID, std::string_view _nodeName,
+        std::vector<std::string> const& _txHashes, bool _requireProof,
+        std::vector<RespFunc> _respFuncs);
+
+    // the getTransactionReceipt requests of the same node in a batch request, the same as
+    // getTransactionBatch
+    virtual void getTransactionReceiptBatch(std::string_view _groupID, std::string_view _nodeName,
+        std::vector<std::string> const& _txHashes, bool _requireProof,
+        std::vector<StreamRespFunc> _respFuncs);
+
 public:
+    // the max number of requests in one batch request
+    static constexpr size_t MAX_BATCH_REQUEST_SIZE = 1000;
+
+    // handle a request object or a batch request array
     void onRPCRequest(std::string_view _requestBody, Sender _sender);
 
+protected:
+    // waits for the batch requests being dispatched, called by the destructor of the
+    // implementation before the members the handlers use are destroyed
+    void stopBatchDispatch()
+    {
+        if (m_batchPool)
+        {
+            m_batchPool->stop();
+        }
+    }
+
 private:
     void initMethod();
+    void dispatchRequest(JsonRequest const& _request, Sender _sender);
+    void onRPCBatchRequest(std::string_view _requestBody, Sender _sender);
 
     std::unordered_map<std::string, std::function<void(Json::Value, RespFunc)>> m_methodToFunc;
+    std::unordered_map<std::string, std::function<void(Json::Value, StreamRespFunc)>>
+        m_methodToStreamFunc;
+    // the items of the batch requests are dispatched here instead of the network thread, the
+    // handlers may access the storage synchronously before responding
+    std::shared_ptr<bcos::ThreadPool> m_batchPool;
 
 
     std::string_view toView(const Json::Value& value)
@@ -166,22 +225,22 @@ private:
             std::move(_respFunc));
     }
 
-    void getTransactionReceiptI(const Json::Value& req, RespFunc _respFunc)
+    void getTransactionReceiptI(const Json::Value& req, StreamRespFunc _respFunc)
     {
-        getTransactionReceipt(toView(req[0u]), toView(req[1u]), toView(req[2u]), req[3u].asBool(),
-            std::move(_respFunc));
+        getTransactionReceiptStream(toView(req[0u]), toView(req[1u]), toView(req[2u]),
+            req[3u].asBool(), std::move(_respFunc));
     }
 
-    void getBlockByHashI(const Json::Value& req, RespFunc _respFunc)
+    void getBlockByHashI(const Json::Value& req, StreamRespFunc _respFunc)
     {
-        getBlockByHash(toView(req[0u]), toView(req[1u]), toView(req[2u]),
+        getBlockByHashStream(toView(req[0u]), toView(req[1u]), toView(req[2u]),
             (req.size() > 3 ? req[3u].asBool() : true), (req.size() > 4 ? req[4u].asBool() : true),
             std::move(_respFunc));
     }
 
-    void getBlockByNumberI(const Json::Value& req, RespFunc _respFunc)
+    void getBlockByNumberI(const Json::Value& req, StreamRespFunc _respFunc)
     {
-        getBlockByNumber(toView(req[0u]), toView(req[1u]), req[2u].asInt64(),
+        getBlockByNumberStream(toView(req[0u]), toView(req[1u]), req[2u].asInt64(),
             (req.size() > 3 ? req[3u].asBool() : true), (req.size() > 4 ? req[4u].asBool() : true),
             std::move(_respFunc));
     }
@@ -289,7 +348,11 @@ private:
     }
 };
 void parseRpcRequestJson(std::string_view _requestBody, JsonRequest& _jsonRequest);
+void parseRpcRequestJson(const Json::Value& root, JsonRequest& _jsonRequest);
 bcos::bytes toStringResponse(JsonResponse _jsonResponse);
+bcos::bytes toStringResponse(JsonResponse const& _jsonResponse, ResultWriter const& _resultWriter);
+// adapt a streaming response callback to the Json::Value based methods
+RespFunc toRespFunc(StreamRespFunc _respFunc);
 Json::Value toJsonResponse(JsonResponse _jsonResponse);
 
 
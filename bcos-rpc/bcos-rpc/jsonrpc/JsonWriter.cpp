@@ -0,0 +1,164 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief streaming json writer for the rpc responses
+ * @file JsonWriter.cpp
+ */
+
+#include "JsonWriter.h"
+#include <cmath>
+
+using namespace bcos;
+using namespace bcos::rpc;
+
+void JsonWriter::value(double _value)
+{
+    if (!std::isfinite(_value)) [[unlikely]]
+    {
+        null();
+        return;
+    }
+    separate();
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), _value);
+    append(std::string_view(buffer, result.ptr - buffer));
+    m_needComma = true;
+}
+
+void JsonWriter::value(const Json::Value& _value)
+{
+    switch (_value.type())
+    {
+    case Json::nullValue:
+        null();
+        break;
+    case Json::intValue:
+        value(_value.asInt64());
+        break;
+    case Json::uintValue:
+        value(_value.asUInt64());
+        break;
+    case Json::realValue:
+        value(_value.asDouble());
+        break;
+    case Json::booleanValue:
+        value(_value.asBool());
+        break;
+    case Json::stringValue:
+    {
+        const char* begin = nullptr;
+        const char* end = nullptr;
+        if (_value.getString(&begin, &end))
+        {
+            value(std::string_view(begin, end - begin));
+        }
+        else
+        {
+            value(std::string_view());
+        }
+        break;
+    }
+    case Json::arrayValue:
+    {
+        startArray();
+        for (const auto& item : _value)
+        {
+            value(item);
+        }
+        endArray();
+        break;
+    }
+    case Json::objectValue:
+    {
+        startObject();
+        for (auto it = _value.begin(); it != _value.end(); ++it)
+        {
+            const char* end = nullptr;
+            const char* name = it.memberName(&end);
+            key(std::string_view(name, end - name));
+            value(*it);
+        }
+        endObject();
+        break;
+    }
+    }
+}
+
+void JsonWriter::hexValue(bcos::bytesConstRef _data, std::string_view _prefix)
+{
+    static constexpr std::string_view hexChars = "0123456789abcdef";
+    separate();
+    auto offset = m_buffer.size();
+    m_buffer.resize(offset + _data.size() * 2 + _prefix.size() + 2);
+    auto* out = m_buffer.data() + offset;
+    *out++ = '"';
+    out = std::copy(_prefix.begin(), _prefix.end(), out);
+    for (auto ch : _data)
+    {
+        *out++ = hexChars[(ch >> 4) & 0x0f];
+        *out++ = hexChars[ch & 0x0f];
+    }
+    *out = '"';
+    m_needComma = true;
+}
+
+void JsonWriter::writeString(std::string_view _value)
+{
+    static constexpr std::string_view hexChars = "0123456789abcdef";
+    put('"');
+    auto begin = _value.begin();
+    for (auto it = _value.begin(); it != _value.end(); ++it)
+    {
+        auto ch = (unsigned char)*it;
+        if (ch >= 0x20 && ch != '"' && ch != '\\') [[likely]]
+        {
+            continue;
+        }
+        append(std::string_view(begin, it));
+        switch (ch)
+        {
+        case '"':
+            append("\\\"");
+            break;
+        case '\\':
+            append("\\\\");
+            break;
+        case '\b':
+            append("\\b");
+            break;
+        case '\f':
+            append("\\f");
+            break;
+        case '\n':
+            append("\\n");
+            break;
+        case '\r':
+            append("\\r");
+            break;
+        case '\t':
+            append("\\t");
+            break;
+        default:
+        {
+            char escaped[] = {'\\', 'u', '0', '0', hexChars[ch >> 4], hexChars[ch & 0x0f]};
+            append(std::string_view(escaped, sizeof(escaped)));
+            break;
+        }
+        }
+        begin = it + 1;
+    }
+    append(std::string_view(begin, _value.end()));
+    put('"');
+}
@@ -0,0 +1,147 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief streaming json writer for the rpc responses
+ * @file JsonWriter.h
+ */
+
+#pragma once
+
+#include <bcos-utilities/Common.h>
+#include <bcos-utilities/FixedBytes.h>
+#include <json/json.h>
+#include <charconv>
+#include <concepts>
+#include <string_view>
+
+namespace bcos::rpc
+{
+/**
+ * @brief write compact json text directly into a byte buffer, no intermediate Json::Value is
+ * built, the buffer can be handed over to the network layer without copy
+ */
+class JsonWriter
+{
+public:
+    explicit JsonWriter(bcos::bytes& _buffer) : m_buffer(_buffer) {}
+
+    void startObject()
+    {
+        separate();
+        put('{');
+        m_needComma = false;
+    }
+    void endObject()
+    {
+        put('}');
+        m_needComma = true;
+    }
+    void startArray()
+    {
+        separate();
+        put('[');
+        m_needComma = false;
+    }
+    void endArray()
+    {
+        put(']');
+        m_needComma = true;
+    }
+
+    void key(std::string_view _key)
+    {
+        separate();
+        writeString(_key);
+        put(':');
+        m_needComma = false;
+    }
+
+    void value(std::string_view _value)
+    {
+        separate();
+        writeString(_value);
+        m_needComma = true;
+    }
+    void value(const char* _value) { value(std::string_view(_value)); }
+    void value(const std::string& _value) { value(std::string_view(_value)); }
+    void value(bool _value)
+    {
+        separate();
+        append(_value ? std::string_view("true") : std::string_view("false"));
+        m_needComma = true;
+    }
+    template <std::integral Integer>
+        requires(!std::same_as<Integer, bool>)
+    void value(Integer _value)
+    {
+        separate();
+        char buffer[24];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), _value);
+        append(std::string_view(buffer, result.ptr - buffer));
+        m_needComma = true;
+    }
+    void value(double _value);
+    // walk an existing Json::Value, used by the methods that still build a dom
+    void value(const Json::Value& _value);
+    void null()
+    {
+        separate();
+        append("null");
+        m_needComma = true;
+    }
+
+    // write the binary data as a quoted hex string, "0x" prefixed by default
+    void hexValue(bcos::bytesConstRef _data, std::string_view _prefix = "0x");
+    template <unsigned N>
+    void hexValue(const bcos::FixedBytes<N>& _data, std::string_view _prefix = "0x")
+    {
+        hexValue(_data.ref(), _prefix);
+    }
+
+    template <class Value>
+    void member(std::string_view _key, Value&& _value)
+    {
+        key(_key);
+        value(std::forward<Value>(_value));
+    }
+    void hexMember(std::string_view _key, bcos::bytesConstRef _data)
+    {
+        key(_key);
+        hexValue(_data);
+    }
+
+    void reserve(size_t _size) { m_buffer.reserve(m_buffer.size() + _size); }
+    bcos::bytes& buffer() { return m_buffer; }
+
+private:
+    void separate()
+    {
+        if (m_needComma)
+        {
+            put(',');
+        }
+    }
+    void put(char _ch) { m_buffer.push_back((bcos::byte)_ch); }
+    void append(std::string_view _data)
+    {
+        m_buffer.insert(m_buffer.end(), (const bcos::byte*)_data.data(),
+            (const bcos::byte*)_data.data() + _data.size());
+    }
+    void writeString(std::string_view _value);
+
+    bcos::bytes& m_buffer;
+    bool m_needComma = false;
+};
+}  // namespace bcos::rpc
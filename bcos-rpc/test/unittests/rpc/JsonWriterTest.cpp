@@ -0,0 +1,108 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file JsonWriterTest.cpp
+ */
+
+#include <bcos-rpc/jsonrpc/JsonRpcInterface.h>
+#include <bcos-rpc/jsonrpc/JsonWriter.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::rpc;
+
+namespace bcos::test
+{
+static std::string toString(bcos::bytes const& _data)
+{
+    return {(const char*)_data.data(), _data.size()};
+}
+
+BOOST_FIXTURE_TEST_SUITE(testJsonWriter, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(writeValues)
+{
+    bcos::bytes out;
+    JsonWriter writer(out);
+    writer.startObject();
+    writer.member("number", -1);
+    writer.member("text", "a\"b\\c\n\x01");
+    writer.key("list");
+    writer.startArray();
+    writer.value(true);
+    writer.null();
+    writer.value(uint64_t(18446744073709551615ULL));
+    writer.endArray();
+    writer.hexMember("data", bcos::bytesConstRef((const bcos::byte*)"\x01\xab", 2));
+    writer.key("hash");
+    writer.hexValue(bcos::h256(1), {});
+    writer.endObject();
+
+    BOOST_CHECK_EQUAL(toString(out),
+        "{\"number\":-1,\"text\":\"a\\\"b\\\\c\\n\\u0001\",\"list\":[true,null,"
+        "18446744073709551615],\"data\":\"0x01ab\",\"hash\":"
+        "\"0000000000000000000000000000000000000000000000000000000000000001\"}");
+
+    Json::Value root;
+    Json::Reader reader;
+    auto text = toString(out);
+    BOOST_CHECK(reader.parse(text, root));
+    BOOST_CHECK_EQUAL(root["text"].asString(), "a\"b\\c\n\x01");
+}
+
+BOOST_AUTO_TEST_CASE(writeJsonValue)
+{
+    Json::Value value;
+    value["str"] = "value";
+    value["int"] = 10;
+    value["real"] = 1.5;
+    value["array"] = Json::Value(Json::arrayValue);
+    value["array"].append(Json::Value(Json::objectValue));
+    value["array"].append("item");
+
+    bcos::bytes out;
+    JsonWriter writer(out);
+    writer.value(value);
+
+    Json::Value parsed;
+    Json::Reader reader;
+    BOOST_CHECK(reader.parse(toString(out), parsed));
+    BOOST_CHECK(parsed == value);
+}
+
+BOOST_AUTO_TEST_CASE(response)
+{
+    JsonResponse response;
+    response.jsonrpc = "2.0";
+    response.id = 1;
+    response.result = "0x1";
+    BOOST_CHECK_EQUAL(
+        toString(toStringResponse(response)), "{\"id\":1,\"jsonrpc\":\"2.0\",\"result\":\"0x1\"}");
+
+    response.error.code = JsonRpcError::MethodNotFound;
+    response.error.message = "not found";
+    BOOST_CHECK_EQUAL(toString(toStringResponse(response)),
+        "{\"error\":{\"code\":-32601,\"message\":\"not found\"},\"id\":1,\"jsonrpc\":\"2.0\"}");
+
+    response.error.code = 0;
+    auto streamed = toStringResponse(response, [](JsonWriter& writer) {
+        writer.startArray();
+        writer.value(1);
+        writer.endArray();
+    });
+    BOOST_CHECK_EQUAL(toString(streamed), "{\"id\":1,\"jsonrpc\":\"2.0\",\"result\":[1]}");
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
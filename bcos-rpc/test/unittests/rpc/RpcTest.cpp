@@ -37,6 +37,7 @@
 #include <bcos-rpc/validator/CallValidator.h>
 #include <bcos-utilities/Exceptions.h>
 #include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <future>
 
 using namespace bcos;
 using namespace bcos::rpc;
@@ -71,5 +72,118 @@ BOOST_AUTO_TEST_CASE(jsonRpcTest)
         BOOST_CHECK(intValue > 0);
     });
 }
+
+BOOST_AUTO_TEST_CASE(batchRequestTest)
+{
+    auto rpc = factory->buildLocalRpc(groupInfo, nodeService);
+    rpc->groupManager()->updateGroupInfo(groupInfo);
+
+    auto request = "[{\"jsonrpc\":\"2.0\",\"method\":\"getBlockNumber\",\"params\":[\"" +
+                   groupId +
+                   "\",\"\"],\"id\":1},{\"jsonrpc\":\"2.0\",\"method\":\"notExists\","
+                   "\"params\":[],\"id\":2},{\"jsonrpc\":\"2.0\"}]";
+    std::promise<bcos::bytes> promise;
+    rpc->jsonRpcImpl()->onRPCRequest(
+        request, [&promise](bcos::bytes _response) { promise.set_value(std::move(_response)); });
+    auto response = promise.get_future().get();
+
+    Json::Value root;
+    Json::Reader reader;
+    BOOST_CHECK(reader.parse(std::string((const char*)response.data(), response.size()), root));
+    BOOST_CHECK(root.isArray());
+    BOOST_CHECK_EQUAL(root.size(), 3);
+    // the responses are in the order of the requests
+    BOOST_CHECK_EQUAL(root[0u]["id"].asInt64(), 1);
+    BOOST_CHECK(root[0u]["result"].asInt64() > 0);
+    BOOST_CHECK_EQUAL(root[1u]["id"].asInt64(), 2);
+    BOOST_CHECK_EQUAL(root[1u]["error"]["code"].asInt(), JsonRpcError::MethodNotFound);
+    BOOST_CHECK_EQUAL(root[2u]["error"]["code"].asInt(), JsonRpcError::InvalidRequest);
+    // the id of an invalid request is unknown
+    BOOST_CHECK(root[2u]["id"].isNull());
+
+    std::promise<bcos::bytes> emptyPromise;
+    rpc->jsonRpcImpl()->onRPCRequest("[]", [&emptyPromise](bcos::bytes _response) {
+        emptyPromise.set_value(std::move(_response));
+    });
+    response = emptyPromise.get_future().get();
+    BOOST_CHECK(reader.parse(std::string((const char*)response.data(), response.size()), root));
+    BOOST_CHECK_EQUAL(root["error"]["code"].asInt(), JsonRpcError::InvalidRequest);
+    BOOST_CHECK(root["id"].isNull());
+
+    // the notifications are handled but not answered
+    auto getBlockNumber = "{\"jsonrpc\":\"2.0\",\"method\":\"getBlockNumber\",\"params\":[\"" +
+                          groupId + "\",\"\"]";
+    auto notification = "[" + getBlockNumber + "}," + getBlockNumber + ",\"id\":3}]";
+    std::promise<bcos::bytes> notificationPromise;
+    rpc->jsonRpcImpl()->onRPCRequest(notification, [&notificationPromise](bcos::bytes _response) {
+        notificationPromise.set_value(std::move(_response));
+    });
+    response = notificationPromise.get_future().get();
+    BOOST_CHECK(reader.parse(std::string((const char*)response.data(), response.size()), root));
+    BOOST_CHECK_EQUAL(root.size(), 1);
+    BOOST_CHECK_EQUAL(root[0u]["id"].asInt64(), 3);
+
+    std::promise<bcos::bytes> silentPromise;
+    rpc->jsonRpcImpl()->onRPCRequest(
+        "[{\"jsonrpc\":\"2.0\",\"method\":\"notExists\",\"params\":[]}]",
+        [&silentPromise](bcos::bytes _response) { silentPromise.set_value(std::move(_response)); });
+    BOOST_CHECK(silentPromise.get_future().get().empty());
+}
+
+// counts the batch transaction queries to tell the merged requests from the dispatched ones
+class CountingLedger : public FakeLedger
+{
+public:
+    using FakeLedger::FakeLedger;
+    void asyncGetBatchTxsByHashList(crypto::HashListPtr _txHashList, bool _withProof,
+        std::function<void(Error::Ptr, bcos::protocol::TransactionsPtr,
+            std::shared_ptr<std::map<std::string, bcos::ledger::MerkleProofPtr>>)>
+            _onGetTx) override
+    {
+        ++m_batchQueries;
+        FakeLedger::asyncGetBatchTxsByHashList(
+            std::move(_txHashList), _withProof, std::move(_onGetTx));
+    }
+    std::atomic_size_t m_batchQueries = 0;
+};
+
+BOOST_AUTO_TEST_CASE(batchGetTransactionTest)
+{
+    auto ledger = std::make_shared<CountingLedger>(m_blockFactory, 20, 10, 10);
+    auto block = ledger->ledgerData()[1];
+    BOOST_CHECK(ledger->storeTransactionsAndReceipts(nullptr, block) == nullptr);
+    auto service = std::make_shared<rpc::NodeService>(
+        ledger, scheduler, txPool, nullptr, nullptr, m_blockFactory);
+    auto rpc = factory->buildLocalRpc(groupInfo, service);
+    rpc->groupManager()->updateGroupInfo(groupInfo);
+
+    std::string request = "[";
+    for (size_t i = 0; i < 3; ++i)
+    {
+        request += (i > 0 ? "," : "");
+        request += "{\"jsonrpc\":\"2.0\",\"method\":\"getTransaction\",\"params\":[\"" +
+                   groupId + "\",\"\",\"" + block->transaction(i)->hash().hex() +
+                   "\",false],\"id\":" + std::to_string(i + 10) + "}";
+    }
+    request += "]";
+    std::promise<bcos::bytes> promise;
+    rpc->jsonRpcImpl()->onRPCRequest(
+        request, [&promise](bcos::bytes _response) { promise.set_value(std::move(_response)); });
+    auto response = promise.get_future().get();
+
+    Json::Value root;
+    Json::Reader reader;
+    BOOST_CHECK(reader.parse(std::string((const char*)response.data(), response.size()), root));
+    BOOST_CHECK_EQUAL(root.size(), 3);
+    for (Json::ArrayIndex i = 0; i < root.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(root[i]["id"].asInt64(), i + 10);
+        BOOST_CHECK_EQUAL(
+            root[i]["result"]["hash"].asString(), block->transaction(i)->hash().hexPrefixed());
+    }
+    // the three transactions are fetched by one ledger query
+    BOOST_CHECK_EQUAL(ledger->m_batchQueries, 1);
+    ledger->stop();
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace bcos::test
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include <bcos-tool/VersionConverter.h>
 #include <bcos-utilities/Error.h>
 #include <bcos-utilities/ITTAPI.h>
+#include <bcos-utilities/Metrics.h>
 #include <bcos-utilities/Overloaded.h>
 #include <ittnotify.h>
 #include <boost/exception/diagnostic_information.hpp>
@@ -197,10 +198,13 @@ void SchedulerImpl::executeBlock(bcos::protocol::Block::Ptr block, bool verify,
     m_exeWorker.enqueue(
         [this, block = std::move(block), verify, callback = std::move(_callback)]() mutable {
             __itt_frame_begin_v3(ITT_DOMAIN_SCHEDULER_EXECUTE, nullptr);
+            static auto& executeBlockTime = bcos::metrics::Registry::instance().histogram(
+                "bcos_scheduler_execute_block_us", "time to execute a block by the scheduler");
             executeBlockInternal(std::move(block), verify,
-                [callback = std::move(callback)](bcos::Error::Ptr&& err,
+                [callback = std::move(callback), startT = utcSteadyTimeUs()](bcos::Error::Ptr&& err,
                     bcos::protocol::BlockHeader::Ptr&& header, bool isSysBlock) {
                     __itt_frame_end_v3(ITT_DOMAIN_SCHEDULER_EXECUTE, nullptr);
+                    executeBlockTime.observe(utcSteadyTimeUs() - startT);
                     callback(std::move(err), std::move(header), isSysBlock);
                 });
         });
@@ -460,10 +464,14 @@ void SchedulerImpl::commitBlock(bcos::protocol::BlockHeader::Ptr header,
     __itt_frame_begin_v3(ITT_DOMAIN_SCHEDULER_COMMIT, nullptr);
     SCHEDULER_LOG(DEBUG) << BLOCK_NUMBER(header->number()) << "CommitBlock request";
 
+    static auto& commitBlockTime = bcos::metrics::Registry::instance().histogram(
+        "bcos_scheduler_commit_block_us", "time to commit a block by the scheduler");
     auto requestBlockNumber = header->number();
-    auto callback = [requestBlockNumber, _callback = std::move(_callback)](
+    auto callback = [requestBlockNumber, _callback = std::move(_callback),
+                        startT = utcSteadyTimeUs()](
                         bcos::Error::Ptr&& error, bcos::ledger::LedgerConfig::Ptr&& config) {
         __itt_frame_end_v3(ITT_DOMAIN_SCHEDULER_COMMIT, nullptr);
+        commitBlockTime.observe(utcSteadyTimeUs() - startT);
         SCHEDULER_LOG(DEBUG) << METRIC << BLOCK_NUMBER(requestBlockNumber) << "CommitBlock response"
                              << LOG_KV(error ? "error" : "ok", error ? error->what() : "ok");
         _callback(error == nullptr ? nullptr : std::move(error), std::move(config));
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the rocksdb column family of each class of data
+ * @file ColumnFamily.h
+ */
+#pragma once
+
+#include <bcos-framework/ledger/LedgerTypeDef.h>
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace bcos::storage
+{
+/**
+ * the classes of data with different access patterns, each one stored in its own column family
+ * when storage.enable_column_families is on; the state stays in the default column family, so
+ * the state rows and KeyPage pages of an existing db never move
+ */
+enum class DataClass : uint8_t
+{
+    STATE = 0,
+    // s_hash_2_tx, large values written once and read by hash
+    TRANSACTION,
+    // s_hash_2_receipt, large values written once and read by hash
+    RECEIPT,
+    // headers, nonces and the number/hash indexes, small and read by every module
+    HEADER,
+};
+constexpr static size_t DATA_CLASS_COUNT = 4;
+constexpr static std::array<std::string_view, DATA_CLASS_COUNT> COLUMN_FAMILY_NAMES{
+    "default", "transactions", "receipts", "headers"};
+
+inline DataClass dataClassOf(std::string_view table)
+{
+    if (table == ledger::SYS_HASH_2_TX)
+    {
+        return DataClass::TRANSACTION;
+    }
+    if (table == ledger::SYS_HASH_2_RECEIPT)
+    {
+        return DataClass::RECEIPT;
+    }
+    if (table == ledger::SYS_NUMBER_2_BLOCK_HEADER || table == ledger::SYS_BLOCK_NUMBER_2_NONCES ||
+        table == ledger::SYS_HASH_2_NUMBER || table == ledger::SYS_NUMBER_2_HASH ||
+        table == ledger::SYS_NUMBER_2_TXS)
+    {
+        return DataClass::HEADER;
+    }
+    return DataClass::STATE;
+}
+
+// the tables moved out of the default column family
+constexpr static std::array<std::string_view, 7> COLUMN_FAMILY_TABLES{ledger::SYS_HASH_2_TX,
+    ledger::SYS_HASH_2_RECEIPT, ledger::SYS_NUMBER_2_BLOCK_HEADER,
+    ledger::SYS_BLOCK_NUMBER_2_NONCES, ledger::SYS_HASH_2_NUMBER, ledger::SYS_NUMBER_2_HASH,
+    ledger::SYS_NUMBER_2_TXS};
+}  // namespace bcos::storage
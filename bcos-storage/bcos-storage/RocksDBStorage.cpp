@@ -25,6 +25,7 @@
 #include "bcos-utilities/Common.h"
 #include "rocksdb/convenience.h"
 #include <bcos-utilities/Error.h>
+#include <bcos-utilities/Metrics.h>
 #include <rocksdb/cleanable.h>
 #include <rocksdb/options.h>
 #include <rocksdb/slice.h>
@@ -46,8 +47,11 @@ using namespace std;
 #define STORAGE_ROCKSDB_LOG(LEVEL) BCOS_LOG(LEVEL) << "[STORAGE-RocksDB]"
 
 RocksDBStorage::RocksDBStorage(std::unique_ptr<rocksdb::DB, std::function<void(rocksdb::DB*)>>&& db,
-    const bcos::security::DataEncryptInterface::Ptr dataEncryption)
-  : m_db(std::move(db)), m_dataEncryption(dataEncryption)
+    const bcos::security::DataEncryptInterface::Ptr dataEncryption,
+    std::vector<rocksdb::ColumnFamilyHandle*> columnFamilies)
+  : m_db(std::move(db)),
+    m_columnFamilies(std::move(columnFamilies)),
+    m_dataEncryption(dataEncryption)
 {
     m_writeBatch = std::make_shared<WriteBatch>();
 }
@@ -64,7 +68,8 @@ void RocksDBStorage::asyncGetPrimaryKeys(std::string_view _table,
 
     ReadOptions read_options;
     read_options.total_order_seek = true;
-    auto iter = std::unique_ptr<rocksdb::Iterator>(m_db->NewIterator(read_options));
+    auto iter = std::unique_ptr<rocksdb::Iterator>(
+        m_db->NewIterator(read_options, columnFamily(_table)));
 
     // check performance
     for (iter->Seek(keyPrefix); iter->Valid() && iter->key().starts_with(keyPrefix); iter->Next())
@@ -103,7 +108,7 @@ void RocksDBStorage::asyncGetRow(std::string_view _table, std::string_view _key,
         auto dbKey = toDBKey(_table, _key);
 
         auto status = m_db->Get(
-            ReadOptions(), m_db->DefaultColumnFamily(), Slice(dbKey.data(), dbKey.size()), &value);
+            ReadOptions(), columnFamily(_table), Slice(dbKey.data(), dbKey.size()), &value);
 
         if (!value.empty() && nullptr != m_dataEncryption)
         {
@@ -187,7 +192,7 @@ void RocksDBStorage::asyncGetRows(std::string_view _table,
 
         std::vector<PinnableSlice> values(keys.size());
         std::vector<Status> statusList(keys.size());
-        m_db->MultiGet(ReadOptions(), m_db->DefaultColumnFamily(), slices.size(), slices.data(),
+        m_db->MultiGet(ReadOptions(), columnFamily(_table), slices.size(), slices.data(),
             values.data(), statusList.data());
         tbb::parallel_for(tbb::blocked_range<size_t>(0, keys.size()),
             [&](const tbb::blocked_range<size_t>& range) {
@@ -257,7 +262,7 @@ void RocksDBStorage::asyncSetRow(std::string_view _table, std::string_view _key,
             STORAGE_ROCKSDB_LOG(TRACE)
                 << LOG_DESC("asyncSetRow delete") << LOG_KV("table", _table)
                 << LOG_KV("key", boost::algorithm::hex_lower(std::string(_key)));
-            status = m_db->Delete(options, dbKey);
+            status = m_db->Delete(options, columnFamily(_table), dbKey);
         }
         else
         {
@@ -273,7 +278,7 @@ void RocksDBStorage::asyncSetRow(std::string_view _table, std::string_view _key,
                 value = m_dataEncryption->encrypt(value);
             }
 
-            status = m_db->Put(options, dbKey, value);
+            status = m_db->Put(options, columnFamily(_table), dbKey, value);
         }
 
         if (!status.ok())
@@ -317,7 +322,7 @@ void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorag
         std::atomic_uint64_t deleteCount{0};
         atomic_bool isTableValid = true;
 
-        tbb::concurrent_vector<std::tuple<Entry::Status, std::string,
+        tbb::concurrent_vector<std::tuple<Entry::Status, rocksdb::ColumnFamilyHandle*, std::string,
             std::variant<std::monostate, std::string, Entry>>>
             dataChanges;
         storage.parallelTraverse(true, [&](const std::string_view& table,
@@ -337,8 +342,8 @@ void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorag
                                                << LOG_KV("key", toHex(key));
                 }
                 ++deleteCount;
-                dataChanges.emplace_back(
-                    std::tuple{entry.status(), std::move(dbKey), std::monostate{}});
+                dataChanges.emplace_back(std::tuple{
+                    entry.status(), columnFamily(table), std::move(dbKey), std::monostate{}});
             }
             else
             {
@@ -355,36 +360,38 @@ void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorag
                 {
                     std::string encryptValue(value);
                     encryptValue = m_dataEncryption->encrypt(encryptValue);
-                    dataChanges.emplace_back(
-                        std::tuple{entry.status(), std::move(dbKey), std::move(encryptValue)});
+                    dataChanges.emplace_back(std::tuple{entry.status(), columnFamily(table),
+                        std::move(dbKey), std::move(encryptValue)});
                 }
                 else
                 {
-                    dataChanges.emplace_back(std::tuple{entry.status(), std::move(dbKey), entry});
+                    dataChanges.emplace_back(
+                        std::tuple{entry.status(), columnFamily(table), std::move(dbKey), entry});
                 }
             }
             return true;
         });
         auto encode = utcSteadyTime();
-        for (auto& [status, key, value] : dataChanges)
+        for (auto& [status, family, key, value] : dataChanges)
         {
             if (status == Entry::DELETED)
             {
-                m_writeBatch->Delete(key);
+                m_writeBatch->Delete(family, key);
             }
             else
             {
                 auto& localKey = key;
+                auto* localFamily = family;
                 std::visit(
-                    [this, &localKey](auto&& valueStr) {
+                    [this, &localKey, localFamily](auto&& valueStr) {
                         using ValueType = std::decay_t<decltype(valueStr)>;
                         if constexpr (std::same_as<ValueType, std::string>)
                         {
-                            m_writeBatch->Put(localKey, valueStr);
+                            m_writeBatch->Put(localFamily, localKey, valueStr);
                         }
                         else if constexpr (std::same_as<ValueType, Entry>)
                         {
-                            m_writeBatch->Put(localKey, valueStr.get());
+                            m_writeBatch->Put(localFamily, localKey, valueStr.get());
                         }
                         else
                         {
@@ -407,6 +414,9 @@ void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorag
             return;
         }
         auto end = utcSteadyTime();
+        static auto& prepareTime = bcos::metrics::Registry::instance().histogram(
+            "bcos_storage_prepare_us", "time to encode the write batch of a block");
+        prepareTime.observe((end - start) * 1000);
         STORAGE_ROCKSDB_LOG(INFO) << LOG_DESC("asyncPrepare finished")
                                   << LOG_KV("blockNumber", param.number) << LOG_KV("put", putCount)
                                   << LOG_KV("delete", deleteCount)
@@ -454,6 +464,9 @@ void RocksDBStorage::asyncCommit(
         }
     }
     auto end = utcSteadyTime();
+    static auto& commitTime = bcos::metrics::Registry::instance().histogram(
+        "bcos_storage_commit_us", "time to write the batch of a block into rocksdb");
+    commitTime.observe((end - start) * 1000);
     __itt_task_end(ittapi::ITT_DOMAINS::instance().ITT_DOMAIN_STORAGE);
     callback(nullptr, 0);
     STORAGE_ROCKSDB_LOG(INFO) << LOG_DESC("asyncCommit finished")
@@ -555,6 +568,7 @@ bcos::Error::Ptr RocksDBStorage::setRows(std::string_view tableName,
             }
         });
     auto writeBatch = WriteBatch();
+    auto* family = columnFamily(tableName);
     size_t dataSize = 0;
     for (size_t i = 0; i < keys.size(); ++i)
     {
@@ -562,12 +576,12 @@ bcos::Error::Ptr RocksDBStorage::setRows(std::string_view tableName,
         if (m_dataEncryption)
         {
             dataSize += realKeys[i].size() + encryptedValues[i].size();
-            writeBatch.Put(realKeys[i], encryptedValues[i]);
+            writeBatch.Put(family, realKeys[i], encryptedValues[i]);
         }
         else
         {
             dataSize += realKeys[i].size() + values[i].size();
-            writeBatch.Put(realKeys[i], values[i]);
+            writeBatch.Put(family, realKeys[i], values[i]);
         }
     }
     WriteOptions options;
@@ -611,7 +625,7 @@ bcos::Error::Ptr RocksDBStorage::deleteRows(std::string_view table,
             auto writeBatch = WriteBatch();
             for (size_t i = 0; i < keys.size(); ++i)
             {
-                writeBatch.Delete(realKeys[i]);
+                writeBatch.Delete(columnFamily(table), realKeys[i]);
             }
             WriteOptions options;
             auto status = m_db->Write(options, &writeBatch);
@@ -623,6 +637,46 @@ bcos::Error::Ptr RocksDBStorage::deleteRows(std::string_view table,
     return err;
 }
 
+void RocksDBStorage::asyncCompactTable(std::string_view table)
+{
+    std::unique_lock lock(x_compaction);
+    if (!m_pendingCompactions.emplace(table).second)
+    {
+        return;
+    }
+    if (!m_compactionPool)
+    {
+        m_compactionPool = std::make_unique<bcos::ThreadPool>("compaction", 1);
+    }
+    m_compactionPool->enqueue([this, table = std::string(table)]() {
+        {
+            // deletes made from now on are covered by a new request
+            std::unique_lock lock(x_compaction);
+            m_pendingCompactions.erase(table);
+        }
+        compactTable(table);
+    });
+}
+
+void RocksDBStorage::compactTable(std::string_view table) noexcept
+{
+    // every key of the table is in [table:, table;)
+    auto begin = std::string(table) + TABLE_KEY_SPLIT;
+    auto end = std::string(table) + (char)(TABLE_KEY_SPLIT[0] + 1);
+    rocksdb::Slice beginKey(begin);
+    rocksdb::Slice endKey(end);
+    CompactRangeOptions options;
+    // let the automatic compactions run meanwhile; the bottommost level is left to them too, the
+    // tombstones are dropped when the range is merged into it
+    options.exclusive_manual_compaction = false;
+    auto start = utcSteadyTime();
+    auto status = m_db->CompactRange(options, columnFamily(table), &beginKey, &endKey);
+    // nobody waits for the result, and a compaction cut by stop is not a db failure
+    STORAGE_ROCKSDB_LOG(INFO) << LOG_DESC("compactTable") << LOG_KV("table", table)
+                              << LOG_KV("status", status.ToString())
+                              << LOG_KV("time(ms)", utcSteadyTime() - start);
+}
+
 bcos::Error::Ptr RocksDBStorage::checkStatus(rocksdb::Status const& status)
 {
     if (status.ok() || status.IsNotFound())
@@ -653,6 +707,17 @@ void RocksDBStorage::stop()
         STORAGE_ROCKSDB_LOG(INFO) << LOG_DESC("rocksdb has already been stopped");
         return;
     }
+    std::unique_ptr<bcos::ThreadPool> compactionPool;
+    {
+        std::unique_lock lock(x_compaction);
+        compactionPool = std::move(m_compactionPool);
+    }
+    if (compactionPool)
+    {
+        // abort the running manual compaction instead of waiting for it
+        m_db->DisableManualCompaction();
+        compactionPool->stop();
+    }
     CancelAllBackgroundWork(m_db.get(), true);
     STORAGE_ROCKSDB_LOG(INFO) << LOG_DESC("rocksdb stopped");
 }
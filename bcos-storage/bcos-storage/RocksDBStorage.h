@@ -23,10 +23,13 @@
  */
 #pragma once
 
+#include "ColumnFamily.h"
 #include <bcos-framework/storage/StorageInterface.h>
 #include <bcos-security/DataEncryption.h>
+#include <bcos-utilities/ThreadPool.h>
 #include <rocksdb/db.h>
 #include <tbb/parallel_for.h>
+#include <set>
 
 namespace rocksdb
 {
@@ -39,8 +42,10 @@ class RocksDBStorage : public TransactionalStorageInterface
 {
 public:
     using Ptr = std::shared_ptr<RocksDBStorage>;
+    // columnFamilies is indexed by DataClass, empty to keep every table in the default one
     explicit RocksDBStorage(std::unique_ptr<rocksdb::DB, std::function<void(rocksdb::DB*)>>&& db,
-        const bcos::security::DataEncryptInterface::Ptr dataEncryption);
+        const bcos::security::DataEncryptInterface::Ptr dataEncryption,
+        std::vector<rocksdb::ColumnFamilyHandle*> columnFamilies = {});
 
     ~RocksDBStorage() {}
 
@@ -83,15 +88,39 @@ public:
         std::string_view, const std::variant<const gsl::span<std::string_view const>,
                               const gsl::span<std::string const>>&) noexcept override;
 
+    // queue a compaction of the key range of the table on a background thread, it drops the
+    // tombstones left by deleteRows; a table already waiting is not queued twice
+    void asyncCompactTable(std::string_view table);
+
     rocksdb::DB& rocksDB() { return *m_db; }
+    std::vector<rocksdb::ColumnFamilyHandle*> const& columnFamilies() const
+    {
+        return m_columnFamilies;
+    }
+    rocksdb::ColumnFamilyHandle* columnFamily(DataClass dataClass) const
+    {
+        return m_columnFamilies.empty() ? m_db->DefaultColumnFamily() :
+                                          m_columnFamilies[(size_t)dataClass];
+    }
+    rocksdb::ColumnFamilyHandle* columnFamily(std::string_view table) const
+    {
+        return columnFamily(dataClassOf(table));
+    }
 
     void stop() override;
 
 private:
     Error::Ptr checkStatus(rocksdb::Status const& status);
+    void compactTable(std::string_view table) noexcept;
     std::shared_ptr<rocksdb::WriteBatch> m_writeBatch = nullptr;
     std::mutex m_writeBatchMutex;
     std::unique_ptr<rocksdb::DB, std::function<void(rocksdb::DB*)>> m_db;
+    // owned by the deleter of m_db
+    std::vector<rocksdb::ColumnFamilyHandle*> m_columnFamilies;
+    std::mutex x_compaction;
+    std::set<std::string, std::less<>> m_pendingCompactions;
+    // created on the first compaction, declared after m_db to be joined before the db is closed
+    std::unique_ptr<bcos::ThreadPool> m_compactionPool;
 
     // Security Storage
     bcos::security::DataEncryptInterface::Ptr m_dataEncryption{nullptr};
@@ -1,4 +1,5 @@
 #pragma once
+#include "ColumnFamily.h"
 #include "bcos-concepts/ByteBuffer.h"
 #include "bcos-concepts/Exception.h"
 #include "bcos-framework/storage/Entry.h"
@@ -9,12 +10,14 @@
 #include "bcos-utilities/Error.h"
 #include "bcos-utilities/Overloaded.h"
 #include <oneapi/tbb/concurrent_vector.h>
+#include <oneapi/tbb/parallel_for.h>
 #include <oneapi/tbb/parallel_for_each.h>
 #include <oneapi/tbb/parallel_pipeline.h>
 #include <rocksdb/db.h>
 #include <rocksdb/iterator.h>
 #include <rocksdb/slice.h>
 #include <boost/throw_exception.hpp>
+#include <cstring>
 #include <functional>
 #include <type_traits>
 #include <variant>
@@ -64,6 +67,9 @@ constexpr inline size_t getRocksDBKeyPairSize(
 }
 
 constexpr static auto ROCKSDB_WRITE_CHUNK_SIZE = 64;
+// a merge larger than it is encoded into sub batches concurrently, then written as one batch
+constexpr static size_t ROCKSDB_PARALLEL_COMMIT_BYTES = 64 * 1024 * 1024;
+constexpr static size_t ROCKSDB_SUB_BATCH_BYTES = 16 * 1024 * 1024;
 
 template <class KeyType, class ValueType, Resolver<KeyType> KeyResolver,
     Resolver<ValueType> ValueResolver>
@@ -71,20 +77,79 @@ class RocksDBStorage2
 {
 private:
     ::rocksdb::DB& m_rocksDB;
+    // indexed by storage::DataClass, empty to keep every table in the default column family
+    std::vector<::rocksdb::ColumnFamilyHandle*> m_columnFamilies;
     [[no_unique_address]] KeyResolver m_keyResolver;
     [[no_unique_address]] ValueResolver m_valueResolver;
+    size_t m_parallelCommitBytes = ROCKSDB_PARALLEL_COMMIT_BYTES;
+
+    // the column family of the table of an encoded key, the same one RocksDBStorage uses
+    ::rocksdb::ColumnFamilyHandle* columnFamily(auto const& encodedKey) const
+    {
+        if (m_columnFamilies.empty())
+        {
+            return m_rocksDB.DefaultColumnFamily();
+        }
+        std::string_view tableAndKey(RANGES::data(encodedKey), RANGES::size(encodedKey));
+        return m_columnFamilies[(size_t)storage::dataClassOf(
+            tableAndKey.substr(0, tableAndKey.find(':')))];
+    }
+
+    static void checkStatus(::rocksdb::Status const& status)
+    {
+        if (!status.ok())
+        {
+            BOOST_THROW_EXCEPTION(RocksDBException{} << error::ErrorMessage(status.ToString()));
+        }
+    }
+
+    /**
+     * joins the sub batches of a split merge into one batch, so the merge is still a single
+     * atomic DB::Write and a crash never leaves part of a block; a batch is its 12 bytes header
+     * (sequence and fixed32 count) followed by the records, so the records are copied in parallel
+     * after one header holding the total count
+     */
+    static ::rocksdb::WriteBatch joinBatches(std::vector<::rocksdb::WriteBatch>& batches)
+    {
+        std::vector<size_t> offsets(batches.size() + 1, ROCKSDB_SEP_HEADER_SIZE);
+        uint32_t count = 0;
+        for (size_t index = 0; index < batches.size(); ++index)
+        {
+            offsets[index + 1] =
+                offsets[index] + batches[index].GetDataSize() - ROCKSDB_SEP_HEADER_SIZE;
+            count += batches[index].Count();
+        }
+
+        std::string rep(offsets.back(), '\0');
+        for (size_t byte = 0; byte < sizeof(count); ++byte)
+        {
+            rep[ROCKSDB_SEP_HEADER_SIZE - sizeof(count) + byte] =
+                static_cast<char>((count >> (byte * 8)) & 0xff);
+        }
+        tbb::parallel_for(size_t(0), batches.size(), [&](size_t index) {
+            std::memcpy(rep.data() + offsets[index],
+                batches[index].Data().data() + ROCKSDB_SEP_HEADER_SIZE,
+                offsets[index + 1] - offsets[index]);
+            batches[index] = ::rocksdb::WriteBatch();
+        });
+        return ::rocksdb::WriteBatch(std::move(rep));
+    }
 
 public:
     RocksDBStorage2(::rocksdb::DB& rocksDB) : m_rocksDB(rocksDB) {}
-    RocksDBStorage2(
-        ::rocksdb::DB& rocksDB, KeyResolver&& keyResolver, ValueResolver&& valueResolver)
+    RocksDBStorage2(::rocksdb::DB& rocksDB, KeyResolver&& keyResolver,
+        ValueResolver&& valueResolver,
+        std::vector<::rocksdb::ColumnFamilyHandle*> columnFamilies = {})
       : m_rocksDB(rocksDB),
+        m_columnFamilies(std::move(columnFamilies)),
         m_keyResolver(std::forward<KeyResolver>(keyResolver)),
         m_valueResolver(std::forward<ValueResolver>(valueResolver))
     {}
     using Key = KeyType;
     using Value = ValueType;
 
+    void setParallelCommitBytes(size_t bytes) { m_parallelCommitBytes = bytes; }
+
     static auto executeReadSome(RocksDBStorage2& storage, RANGES::input_range auto&& keys)
     {
         auto encodedKeys = keys | RANGES::views::transform([&](auto&& key) {
@@ -97,9 +162,11 @@ public:
         auto rocksDBKeys = encodedKeys | RANGES::views::transform([](const auto& encodedKey) {
             return ::rocksdb::Slice(RANGES::data(encodedKey), RANGES::size(encodedKey));
         }) | RANGES::to<std::vector>();
-        storage.m_rocksDB.MultiGet(::rocksdb::ReadOptions(),
-            storage.m_rocksDB.DefaultColumnFamily(), rocksDBKeys.size(), rocksDBKeys.data(),
-            results.data(), status.data());
+        auto columnFamilies = encodedKeys | RANGES::views::transform([&](const auto& encodedKey) {
+            return storage.columnFamily(encodedKey);
+        }) | RANGES::to<std::vector>();
+        storage.m_rocksDB.MultiGet(::rocksdb::ReadOptions(), rocksDBKeys.size(),
+            columnFamilies.data(), rocksDBKeys.data(), results.data(), status.data());
 
         auto result =
             RANGES::views::zip(results, status) |
@@ -133,10 +200,10 @@ public:
     {
         auto rocksDBKey = storage.m_keyResolver.encode(key);
         std::string result;
-        auto status =
-            storage.m_rocksDB.Get(::rocksdb::ReadOptions(), storage.m_rocksDB.DefaultColumnFamily(),
-                ::rocksdb::Slice(RANGES::data(rocksDBKey), RANGES::size(rocksDBKey)),
-                std::addressof(result));
+        auto status = storage.m_rocksDB.Get(::rocksdb::ReadOptions(),
+            storage.columnFamily(rocksDBKey),
+            ::rocksdb::Slice(RANGES::data(rocksDBKey), RANGES::size(rocksDBKey)),
+            std::addressof(result));
         if (!status.ok())
         {
             if (!status.IsNotFound())
@@ -177,8 +244,9 @@ public:
                         storage.m_keyResolver.encode(std::forward<decltype(key)>(key)),
                         storage.m_valueResolver.encode(std::forward<decltype(value)>(value)));
                     auto const& [keyBuffer, valueBuffer] = *it;
-                    localReservedLength += getRocksDBKeyPairSize(
-                        false, RANGES::size(keyBuffer), RANGES::size(valueBuffer));
+                    localReservedLength +=
+                        getRocksDBKeyPairSize(storage.columnFamily(keyBuffer)->GetID() != 0,
+                            RANGES::size(keyBuffer), RANGES::size(valueBuffer));
                 }
                 totalReservedLength += localReservedLength;
             });
@@ -188,7 +256,8 @@ public:
         ::rocksdb::WriteBatch writeBatch(totalReservedLength);
         for (auto&& [keyBuffer, valueBuffer] : rocksDBKeyValues)
         {
-            writeBatch.Put(::rocksdb::Slice(RANGES::data(keyBuffer), RANGES::size(keyBuffer)),
+            writeBatch.Put(storage.columnFamily(keyBuffer),
+                ::rocksdb::Slice(RANGES::data(keyBuffer), RANGES::size(keyBuffer)),
                 ::rocksdb::Slice(RANGES::data(valueBuffer), RANGES::size(valueBuffer)));
         }
         ::rocksdb::WriteOptions options;
@@ -208,7 +277,7 @@ public:
         auto rocksDBValue = storage.m_valueResolver.encode(key);
 
         ::rocksdb::WriteOptions options;
-        auto status = storage.m_rocksDB.Put(options,
+        auto status = storage.m_rocksDB.Put(options, storage.columnFamily(rocksDBKey),
             ::rocksdb::Slice(RANGES::data(rocksDBKey), RANGES::size(rocksDBKey)),
             ::rocksdb::Slice(RANGES::data(rocksDBValue), RANGES::size(rocksDBValue)));
 
@@ -226,7 +295,8 @@ public:
         for (auto const& key : keys)
         {
             auto encodedKey = storage.m_keyResolver.encode(key);
-            writeBatch.Delete(::rocksdb::Slice(RANGES::data(encodedKey), RANGES::size(encodedKey)));
+            writeBatch.Delete(storage.columnFamily(encodedKey),
+                ::rocksdb::Slice(RANGES::data(encodedKey), RANGES::size(encodedKey)));
         }
 
         ::rocksdb::WriteOptions options;
@@ -267,16 +337,18 @@ public:
                         auto it = rocksDBKeyValues.emplace_back(storage.m_keyResolver.encode(*key),
                             std::make_optional(storage.m_valueResolver.encode(*value)));
                         auto&& [keyBuffer, valueBuffer] = *it;
-                        localReservedLength += getRocksDBKeyPairSize(
-                            false, RANGES::size(keyBuffer), RANGES::size(*valueBuffer));
+                        localReservedLength +=
+                            getRocksDBKeyPairSize(storage.columnFamily(keyBuffer)->GetID() != 0,
+                                RANGES::size(keyBuffer), RANGES::size(*valueBuffer));
                     }
                     else
                     {
                         auto it = rocksDBKeyValues.emplace_back(storage.m_keyResolver.encode(*key),
                             std::tuple_element_t<1, RocksDBKeyValueTuple>{});
                         auto&& [keyBuffer, valueBuffer] = *it;
-                        localReservedLength +=
-                            getRocksDBKeyPairSize(false, RANGES::size(keyBuffer), 0);
+                        localReservedLength += getRocksDBKeyPairSize(
+                            storage.columnFamily(keyBuffer)->GetID() != 0, RANGES::size(keyBuffer),
+                            0);
                     }
                 }
                 totalReservedLength += localReservedLength;
@@ -284,19 +356,44 @@ public:
         }
         mergeGroup.wait();
 
-        ::rocksdb::WriteBatch writeBatch(totalReservedLength);
-        for (auto&& [keyBuffer, valueBuffer] : rocksDBKeyValues)
-        {
+        auto writeRow = [&storage](::rocksdb::WriteBatch& writeBatch, auto const& keyValue) {
+            auto const& [keyBuffer, valueBuffer] = keyValue;
             if (valueBuffer)
             {
-                writeBatch.Put(::rocksdb::Slice(RANGES::data(keyBuffer), RANGES::size(keyBuffer)),
+                writeBatch.Put(storage.columnFamily(keyBuffer),
+                    ::rocksdb::Slice(RANGES::data(keyBuffer), RANGES::size(keyBuffer)),
                     ::rocksdb::Slice(RANGES::data(*valueBuffer), RANGES::size(*valueBuffer)));
             }
             else
             {
-                writeBatch.Delete(
+                writeBatch.Delete(storage.columnFamily(keyBuffer),
                     ::rocksdb::Slice(RANGES::data(keyBuffer), RANGES::size(keyBuffer)));
             }
+        };
+        if (totalReservedLength >= storage.m_parallelCommitBytes)
+        {
+            // the rows are encoded into sub batches in parallel and written as one batch
+            auto batchCount = std::clamp<size_t>(totalReservedLength / ROCKSDB_SUB_BATCH_BYTES, 2,
+                std::max<size_t>(std::thread::hardware_concurrency(), 2));
+            auto rowsPerBatch = (rocksDBKeyValues.size() + batchCount - 1) / batchCount;
+            std::vector<::rocksdb::WriteBatch> batches(batchCount);
+            tbb::parallel_for(size_t(0), batchCount, [&](size_t index) {
+                auto end = std::min(rocksDBKeyValues.size(), (index + 1) * rowsPerBatch);
+                for (auto row = index * rowsPerBatch; row < end; ++row)
+                {
+                    writeRow(batches[index], rocksDBKeyValues[row]);
+                }
+            });
+            auto writeBatch = joinBatches(batches);
+            ::rocksdb::WriteOptions options;
+            checkStatus(storage.m_rocksDB.Write(options, std::addressof(writeBatch)));
+            co_return;
+        }
+
+        ::rocksdb::WriteBatch writeBatch(totalReservedLength);
+        for (auto const& keyValue : rocksDBKeyValues)
+        {
+            writeRow(writeBatch, keyValue);
         }
         ::rocksdb::WriteOptions options;
         auto status = storage.m_rocksDB.Write(options, std::addressof(writeBatch));
@@ -2,6 +2,7 @@
 #include "bcos-framework/storage/StorageInterface.h"
 #include "bcos-table/src/StateStorage.h"
 #include "boost/filesystem.hpp"
+#include <bcos-storage/ColumnFamily.h>
 #include <bcos-storage/RocksDBStorage.h>
 #include <bcos-utilities/DataConvertUtility.h>
 #include <rocksdb/write_batch.h>
@@ -593,6 +594,73 @@ BOOST_AUTO_TEST_CASE(writeReadDelete_1Table)
     writeReadDeleteSingleTable(50000);
 }
 
+BOOST_AUTO_TEST_CASE(columnFamilies)
+{
+    std::string cfPath = "./unittestdb_cf";
+    rocksdb::Options options;
+    options.create_if_missing = true;
+    options.create_missing_column_families = true;
+    std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
+    for (auto name : COLUMN_FAMILY_NAMES)
+    {
+        descriptors.emplace_back(std::string(name), rocksdb::ColumnFamilyOptions(options));
+    }
+    rocksdb::DB* db = nullptr;
+    std::vector<rocksdb::ColumnFamilyHandle*> handles;
+    auto status = rocksdb::DB::Open(
+        rocksdb::DBOptions(options), cfPath, descriptors, &handles, &db);
+    BOOST_REQUIRE(status.ok());
+    BOOST_REQUIRE_EQUAL(handles.size(), DATA_CLASS_COUNT);
+
+    auto storage = std::make_shared<RocksDBStorage>(
+        std::unique_ptr<rocksdb::DB, std::function<void(rocksdb::DB*)>>(db,
+            [handles](rocksdb::DB* db) {
+                for (auto* handle : handles)
+                {
+                    db->DestroyColumnFamilyHandle(handle);
+                }
+                delete db;
+            }),
+        nullptr, handles);
+
+    auto state = std::make_shared<StateStorage>(nullptr);
+    for (auto table : {std::string_view(ledger::SYS_HASH_2_TX), std::string_view(testTableName),
+             std::string_view(ledger::SYS_NUMBER_2_BLOCK_HEADER)})
+    {
+        Entry entry;
+        entry.importFields({"value"});
+        state->asyncSetRow(
+            table, "key", std::move(entry), [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+    }
+    bcos::protocol::TwoPCParams params;
+    params.number = 1;
+    storage->asyncPrepare(params, *state,
+        [](Error::Ptr error, uint64_t, const std::string&) { BOOST_CHECK(!error); });
+    storage->asyncCommit(params, [](Error::Ptr error, uint64_t) { BOOST_CHECK(!error); });
+
+    // every row is in the column family of its table only
+    auto check = [&](std::string_view table, DataClass dataClass) {
+        auto dbKey = toDBKey(table, "key");
+        for (size_t i = 0; i < DATA_CLASS_COUNT; ++i)
+        {
+            std::string value;
+            auto found = db->Get(rocksdb::ReadOptions(), handles[i], dbKey, &value).ok();
+            BOOST_CHECK_EQUAL(found, i == (size_t)dataClass);
+        }
+        storage->asyncGetRow(table, "key", [](Error::UniquePtr error, std::optional<Entry> entry) {
+            BOOST_CHECK(!error);
+            BOOST_REQUIRE(entry);
+            BOOST_CHECK_EQUAL(entry->getField(0), "value");
+        });
+    };
+    check(ledger::SYS_HASH_2_TX, DataClass::TRANSACTION);
+    check(ledger::SYS_NUMBER_2_BLOCK_HEADER, DataClass::HEADER);
+    check(testTableName, DataClass::STATE);
+
+    storage.reset();
+    boost::filesystem::remove_all(cfPath);
+}
+
 BOOST_AUTO_TEST_CASE(commitAndCheck)
 {
     auto initState = std::make_shared<StateStorage>(rocksDBStorage);
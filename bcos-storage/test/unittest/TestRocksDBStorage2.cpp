@@ -10,6 +10,8 @@
 #include <boost/test/unit_test.hpp>
 #include <algorithm>
 #include <range/v3/view/enumerate.hpp>
+#include <rocksdb/transaction_log.h>
+#include <rocksdb/write_batch.h>
 #include <string_view>
 
 using namespace bcos;
@@ -196,4 +198,63 @@ BOOST_AUTO_TEST_CASE(merge)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(parallelMerge)
+{
+    task::syncWait([this]() -> task::Task<void> {
+        storage2::memory_storage::MemoryStorage<StateKey, StateValue,
+            storage2::memory_storage::ORDERED>
+            memoryStorage;
+
+        auto keys = RANGES::views::iota(0, 1000) | RANGES::views::transform([](int num) {
+            auto tableName = fmt::format("Table~{}", num % 10);
+            auto key = fmt::format("Key~{}", num);
+            auto stateKey = StateKey{std::string_view(tableName), std::string_view(key)};
+            return stateKey;
+        });
+        auto values = RANGES::views::iota(0, 1000) | RANGES::views::transform([](int num) {
+            storage::Entry entry;
+            entry.set(fmt::format("Entry value is: i am a value!!!!!!! {}", num));
+            return entry;
+        });
+        co_await storage2::writeSome(memoryStorage, keys, values);
+        storage::Entry number;
+        number.set("1");
+        co_await storage2::writeOne(memoryStorage,
+            StateKey{ledger::SYS_CURRENT_STATE, ledger::SYS_KEY_CURRENT_NUMBER}, std::move(number));
+
+        RocksDBStorage2<StateKey, StateValue, StateKeyResolver,
+            bcos::storage2::rocksdb::StateValueResolver>
+            rocksDB(*originRocksDB, StateKeyResolver{}, StateValueResolver{});
+        // every merge takes the split path
+        rocksDB.setParallelCommitBytes(0);
+        co_await storage2::merge(rocksDB, memoryStorage);
+
+        auto gotValues = co_await storage2::readSome(rocksDB, keys);
+        for (auto&& [i, value] : RANGES::views::enumerate(gotValues))
+        {
+            BOOST_REQUIRE(value);
+            BOOST_CHECK_EQUAL(
+                value->get(), fmt::format("Entry value is: i am a value!!!!!!! {}", i));
+        }
+        // the sub batches and the block number reach the WAL as one atomic batch
+        std::unique_ptr<rocksdb::TransactionLogIterator> updates;
+        BOOST_REQUIRE(originRocksDB->GetUpdatesSince(1, &updates).ok());
+        size_t batchCount = 0;
+        rocksdb::BatchResult last;
+        for (; updates->Valid(); updates->Next())
+        {
+            last = updates->GetBatch();
+            ++batchCount;
+        }
+        BOOST_CHECK_EQUAL(batchCount, 1);
+        BOOST_REQUIRE(last.writeBatchPtr);
+        BOOST_CHECK_EQUAL(last.writeBatchPtr->Count(), 1001);
+        BOOST_CHECK_NE(last.writeBatchPtr->Data().find("s_current_state:current_number"),
+            std::string::npos);
+        BOOST_CHECK_NE(last.writeBatchPtr->Data().find("Table~9:Key~999"), std::string::npos);
+
+        co_return;
+    }());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -21,6 +21,7 @@
 #include "DownloadingQueue.h"
 #include "bcos-sync/utilities/Common.h"
 #include <bcos-framework/dispatcher/SchedulerTypeDef.h>
+#include <bcos-utilities/Metrics.h>
 #include <future>
 
 using namespace std;
@@ -400,18 +401,15 @@ void DownloadingQueue::applyBlock(Block::Ptr _block)
                     }
                 }
                 auto signature = orgBlockHeader->signatureList();
-                BLKSYNC_LOG(INFO) << METRIC << LOG_BADGE("Download")
-                                  << LOG_DESC("BlockSync: applyBlock success")
-                                  << LOG_KV("number", orgBlockHeader->number())
-                                  << LOG_KV("hash", orgBlockHeader->hash().abridged())
-                                  << LOG_KV("signatureSize", signature.size())
-                                  << LOG_KV("txsSize", _block->transactionsSize())
-                                  << LOG_KV("nextBlock", downloadQueue->m_config->nextBlock())
-                                  << LOG_KV(
-                                         "executedBlock", downloadQueue->m_config->executedBlock())
-                                  << LOG_KV("timeCost", (utcTime() - startT))
-                                  << LOG_KV("node", downloadQueue->m_config->nodeID()->shortHex())
-                                  << LOG_KV("sysBlock", _sysBlock);
+                static auto& applyBlockTime = metrics::Registry::instance().histogram(
+                    "bcos_sync_apply_block_us", "time to execute a downloaded block");
+                applyBlockTime.observe((utcTime() - startT) * 1000);
+                BLKSYNC_METRIC_LOG(INFO, "[Download]BlockSync: applyBlock success", "number",
+                    orgBlockHeader->number(), "hash", orgBlockHeader->hash().abridged(),
+                    "signatureSize", signature.size(), "txsSize", _block->transactionsSize(),
+                    "nextBlock", downloadQueue->m_config->nextBlock(), "executedBlock",
+                    downloadQueue->m_config->executedBlock(), "timeCost", (utcTime() - startT),
+                    "node", downloadQueue->m_config->nodeID()->shortHex(), "sysBlock", _sysBlock);
                 // verify and commit the block
                 downloadQueue->updateCommitQueue(_block);
             }
@@ -600,16 +598,15 @@ void DownloadingQueue::commitBlockState(bcos::protocol::Block::Ptr _block)
             {
                 downloadingQueue->m_config->setExecutedBlock(blockHeader->number());
             }
-            BLKSYNC_LOG(INFO) << BLOCK_NUMBER(blockHeader->number()) << METRIC
-                              << LOG_DESC("commitBlockState success")
-                              << LOG_KV("number", blockHeader->number())
-                              << LOG_KV("hash", blockHeader->hash().abridged())
-                              << LOG_KV(
-                                     "executedBlock", downloadingQueue->m_config->executedBlock())
-                              << LOG_KV("commitBlockTimeCost", (utcTime() - startT))
-                              << LOG_KV("node", downloadingQueue->m_config->nodeID()->shortHex())
-                              << LOG_KV("txsSize", _block->transactionsSize())
-                              << LOG_KV("sealer", blockHeader->sealer());
+            static auto& commitBlockTime = metrics::Registry::instance().histogram(
+                "bcos_sync_commit_block_us", "time to commit a downloaded block");
+            commitBlockTime.observe((utcTime() - startT) * 1000);
+            // the number is a key of the line, no [blk-N] badge in the deferred format
+            BLKSYNC_METRIC_LOG(INFO, "commitBlockState success", "number", blockHeader->number(),
+                "hash", blockHeader->hash().abridged(), "executedBlock",
+                downloadingQueue->m_config->executedBlock(), "commitBlockTimeCost",
+                (utcTime() - startT), "node", downloadingQueue->m_config->nodeID()->shortHex(),
+                "txsSize", _block->transactionsSize(), "sealer", blockHeader->sealer());
         }
         catch (std::exception const& e)
         {
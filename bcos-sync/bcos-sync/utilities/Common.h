@@ -20,9 +20,13 @@
  */
 #pragma once
 #include <bcos-framework/Common.h>
+#include <bcos-utilities/BinaryLog.h>
 #include <tbb/parallel_for.h>
 
 #define BLKSYNC_LOG(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE("BLOCK SYNC")
+// deferred-format BLKSYNC_LOG for the hot paths, see BCOS_BINARY_LOG
+#define BLKSYNC_METRIC_LOG(LEVEL, ...) \
+    BCOS_BINARY_LOG(LEVEL, "BLOCK SYNC", "[METRIC]" __VA_ARGS__)
 namespace bcos::sync
 {
 static constexpr const size_t MAX_DOWNLOAD_BLOCK_QUEUE_SIZE = 256;
@@ -59,7 +59,13 @@ void KeyPageStorage::asyncGetPrimaryKeys(std::string_view tableView,
     auto readLock = meta->rLock();
     auto& pageInfo = meta->getAllPageInfoNoLock();
     auto [offset, total] = _condition->getLimit();
-    ret.reserve(total);
+    // the count may be unbounded, do not reserve more than the pages hold
+    size_t pageKeys = 0;
+    for (auto& info : pageInfo)
+    {
+        pageKeys += info.getCount();
+    }
+    ret.reserve(std::min<size_t>(total, pageKeys));
     size_t validCount = 0;
     for (auto& info : pageInfo)
     {
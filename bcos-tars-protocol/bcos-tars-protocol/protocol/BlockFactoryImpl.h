@@ -58,7 +58,7 @@ public:
         auto block = std::make_shared<BlockImpl>();
         block->decode(_data, _calculateHash, _checkSig);
 
-        if (block->inner().blockHeader.dataHash.empty())
+        if (block->innerBlockHeader().dataHash.empty())
         {
             block->blockHeader()->calculateHash(*m_cryptoSuite->hashImpl());
         }
@@ -22,17 +22,133 @@
 #include "BlockImpl.h"
 #include "../impl/TarsSerializable.h"
 #include <bcos-concepts/Serialize.h>
+#include <tbb/parallel_invoke.h>
 
 using namespace bcostars;
 using namespace bcostars::protocol;
 
-void BlockImpl::decode(bcos::bytesConstRef _data, bool, bool)
+// the tags of bcostars::Block, see Block.tars
+constexpr static uint8_t BLOCK_TRANSACTIONS_TAG = 4;
+constexpr static uint8_t BLOCK_RECEIPTS_TAG = 5;
+
+// the encoded bytes of the field _tag, empty if it is absent; skipping the field walks the framing
+// of every element, so a truncated or malformed body throws here
+static bcos::bytesConstRef encodedField(
+    tars::TarsInputStream<tars::BufferReader>& _input, bcos::bytesConstRef _data, uint8_t _tag)
+{
+    if (!_input.skipToTag(_tag))
+    {
+        return {};
+    }
+    auto begin = _input.tellp();
+    _input.skipField();
+    return _data.getCroppedData(begin, _input.tellp() - begin);
+}
+
+static void decodeField(bcos::bytesConstRef _encoded, auto& _field, uint8_t _tag)
+{
+    if (_encoded.empty())
+    {
+        return;
+    }
+    tars::TarsInputStream<tars::BufferReader> input;
+    input.setBuffer((const char*)_encoded.data(), _encoded.size());
+    input.read(_field, _tag, false);
+}
+
+void BlockImpl::decode(bcos::bytesConstRef _data, bool, bool _checkSig)
+{
+    std::unique_lock lock(x_encodedBody);
+    bcostars::Block block;
+    tars::TarsInputStream<tars::BufferReader> input;
+    input.setBuffer((const char*)_data.data(), _data.size());
+    // the fields must be read by increasing tag
+    input.read(block.version, 1, false);
+    input.read(block.type, 2, false);
+    input.read(block.blockHeader, 3, false);
+    auto transactions = encodedField(input, _data, BLOCK_TRANSACTIONS_TAG);
+    auto receipts = encodedField(input, _data, BLOCK_RECEIPTS_TAG);
+    input.read(block.transactionsMetaData, 6, false);
+    input.read(block.receiptsHash, 7, false);
+    input.read(block.nonceList, 8, false);
+    input.read(block.transactionsMerkle, 9, false);
+    input.read(block.receiptsMerkle, 10, false);
+
+    if (_checkSig)
+    {
+        // a block received from a peer is decoded whole, so an element that does not decode throws
+        // to the caller of createBlock instead of to the first reader of the body
+        tbb::parallel_invoke(
+            [&]() { decodeField(transactions, block.transactions, BLOCK_TRANSACTIONS_TAG); },
+            [&]() { decodeField(receipts, block.receipts, BLOCK_RECEIPTS_TAG); });
+        transactions = {};
+        receipts = {};
+    }
+    *m_inner = std::move(block);
+
+    m_encodedTransactions.assign(transactions.begin(), transactions.end());
+    m_encodedReceipts.assign(receipts.begin(), receipts.end());
+    m_transactionsDecoded.store(transactions.empty(), std::memory_order_release);
+    m_receiptsDecoded.store(receipts.empty(), std::memory_order_release);
+}
+
+void BlockImpl::decodeBody(bool _transactions, bool _receipts) const
 {
-    bcos::concepts::serialize::decode(_data, *m_inner);
+    auto pending = [&]() {
+        return (_transactions && !m_transactionsDecoded.load(std::memory_order_acquire)) ||
+               (_receipts && !m_receiptsDecoded.load(std::memory_order_acquire));
+    };
+    if (!pending())
+    {
+        return;
+    }
+    std::unique_lock lock(x_encodedBody);
+    auto decodeTransactions = _transactions && !m_transactionsDecoded;
+    auto decodeReceipts = _receipts && !m_receiptsDecoded;
+    if (decodeTransactions && decodeReceipts)
+    {
+        tbb::parallel_invoke(
+            [&]() {
+                decodeField(bcos::ref(m_encodedTransactions), m_inner->transactions,
+                    BLOCK_TRANSACTIONS_TAG);
+            },
+            [&]() {
+                decodeField(bcos::ref(m_encodedReceipts), m_inner->receipts, BLOCK_RECEIPTS_TAG);
+            });
+    }
+    else if (decodeTransactions)
+    {
+        decodeField(
+            bcos::ref(m_encodedTransactions), m_inner->transactions, BLOCK_TRANSACTIONS_TAG);
+    }
+    else if (decodeReceipts)
+    {
+        decodeField(bcos::ref(m_encodedReceipts), m_inner->receipts, BLOCK_RECEIPTS_TAG);
+    }
+    if (decodeTransactions)
+    {
+        bcos::bytes().swap(m_encodedTransactions);
+        m_transactionsDecoded.store(true, std::memory_order_release);
+    }
+    if (decodeReceipts)
+    {
+        bcos::bytes().swap(m_encodedReceipts);
+        m_receiptsDecoded.store(true, std::memory_order_release);
+    }
+}
+
+void BlockImpl::resetEncodedBody()
+{
+    std::unique_lock lock(x_encodedBody);
+    bcos::bytes().swap(m_encodedTransactions);
+    bcos::bytes().swap(m_encodedReceipts);
+    m_transactionsDecoded.store(true, std::memory_order_release);
+    m_receiptsDecoded.store(true, std::memory_order_release);
 }
 
 void BlockImpl::encode(bcos::bytes& _encodeData) const
 {
+    decodeBody(true, true);
     bcos::concepts::serialize::encode(*m_inner, _encodeData);
 }
 
@@ -52,6 +168,7 @@ bcos::protocol::BlockHeader::ConstPtr BlockImpl::blockHeaderConst() const
 
 bcos::protocol::Transaction::ConstPtr BlockImpl::transaction(uint64_t _index) const
 {
+    decodeTransactions();
     return std::make_shared<const bcostars::protocol::TransactionImpl>(
         [inner = m_inner, _index]() { return &(inner->transactions[_index]); });
 }
@@ -59,6 +176,7 @@ bcos::protocol::Transaction::ConstPtr BlockImpl::transaction(uint64_t _index) co
 // TODO: return struct instead of pointer
 bcos::protocol::TransactionReceipt::ConstPtr BlockImpl::receipt(uint64_t _index) const
 {
+    decodeReceipts();
     return std::make_shared<const bcostars::protocol::TransactionReceiptImpl>(
         [inner = m_inner, _index]() { return &(inner->receipts[_index]); });
 }
@@ -75,6 +193,7 @@ void BlockImpl::setBlockHeader(bcos::protocol::BlockHeader::Ptr _blockHeader)
 
 void BlockImpl::setReceipt(uint64_t _index, bcos::protocol::TransactionReceipt::Ptr _receipt)
 {
+    decodeBody(true, true);
     if (_index >= m_inner->receipts.size())
     {
         m_inner->receipts.resize(m_inner->transactions.size());
@@ -86,6 +205,7 @@ void BlockImpl::setReceipt(uint64_t _index, bcos::protocol::TransactionReceipt::
 
 void BlockImpl::appendReceipt(bcos::protocol::TransactionReceipt::Ptr _receipt)
 {
+    decodeReceipts();
     m_inner->receipts.emplace_back(
         std::dynamic_pointer_cast<bcostars::protocol::TransactionReceiptImpl>(_receipt)->inner());
 }
@@ -151,28 +271,38 @@ void bcostars::protocol::BlockImpl::setBlockType(bcos::protocol::BlockType _bloc
 void bcostars::protocol::BlockImpl::setTransaction(
     uint64_t _index, bcos::protocol::Transaction::Ptr _transaction)
 {
+    decodeTransactions();
     m_inner->transactions[_index] =
         std::dynamic_pointer_cast<bcostars::protocol::TransactionImpl>(_transaction)->inner();
 }
 void bcostars::protocol::BlockImpl::appendTransaction(bcos::protocol::Transaction::Ptr _transaction)
 {
+    decodeTransactions();
     m_inner->transactions.emplace_back(
         std::dynamic_pointer_cast<bcostars::protocol::TransactionImpl>(_transaction)->inner());
 }
 uint64_t bcostars::protocol::BlockImpl::transactionsSize() const
 {
+    decodeTransactions();
     return m_inner->transactions.size();
 }
 uint64_t bcostars::protocol::BlockImpl::receiptsSize() const
 {
+    decodeReceipts();
     return m_inner->receipts.size();
 }
 const bcostars::Block& bcostars::protocol::BlockImpl::inner() const
 {
+    decodeBody(true, true);
     return *m_inner;
 }
+const bcostars::BlockHeader& bcostars::protocol::BlockImpl::innerBlockHeader() const
+{
+    return m_inner->blockHeader;
+}
 void bcostars::protocol::BlockImpl::setInner(bcostars::Block inner)
 {
+    resetEncodedBody();
     *m_inner = std::move(inner);
 }
 bcos::crypto::HashType bcostars::protocol::BlockImpl::calculateTransactionRoot(
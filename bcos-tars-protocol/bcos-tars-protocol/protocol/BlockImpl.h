@@ -41,7 +41,9 @@
 #include <bcos-framework/protocol/Block.h>
 #include <bcos-framework/protocol/BlockHeader.h>
 #include <gsl/span>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <ranges>
 #include <type_traits>
 
@@ -54,6 +56,9 @@ public:
     BlockImpl(bcostars::Block _block) : BlockImpl() { *m_inner = std::move(_block); }
     ~BlockImpl() override = default;
 
+    // decode the header and the small fields, the transactions and receipts are kept encoded and
+    // decoded on first access, so the header-only readers never pay for the body; with _checkSig,
+    // for the blocks from peers, the body is decoded at once so a malformed one throws here
     void decode(bcos::bytesConstRef _data, bool _calculateHash, bool _checkSig) override;
     void encode(bcos::bytes& _encodeData) const override;
 
@@ -94,7 +99,10 @@ public:
     void setNonceList(RANGES::any_view<std::string> nonces) override;
     RANGES::any_view<std::string> nonceList() const override;
 
+    // decode the whole block, the transactions and receipts in parallel
     const bcostars::Block& inner() const;
+    // the header without decoding the body
+    const bcostars::BlockHeader& innerBlockHeader() const;
     void setInner(bcostars::Block inner);
 
     bcos::crypto::HashType calculateTransactionRoot(
@@ -103,7 +111,20 @@ public:
     bcos::crypto::HashType calculateReceiptRoot(const bcos::crypto::Hash& hashImpl) const override;
 
 private:
+    void decodeTransactions() const { decodeBody(true, false); }
+    void decodeReceipts() const { decodeBody(false, true); }
+    void decodeBody(bool _transactions, bool _receipts) const;
+    void resetEncodedBody();
+
     std::shared_ptr<bcostars::Block> m_inner;
     mutable bcos::SharedMutex x_blockHeader;
+
+    // the encoded transactions and receipts fields, each released once it is decoded, so the
+    // receipts never read pin only their own bytes
+    mutable bcos::bytes m_encodedTransactions;
+    mutable bcos::bytes m_encodedReceipts;
+    mutable std::atomic_bool m_transactionsDecoded = true;
+    mutable std::atomic_bool m_receiptsDecoded = true;
+    mutable std::mutex x_encodedBody;
 };
 }  // namespace bcostars::protocol
\ No newline at end of file
@@ -74,6 +74,9 @@ public:
     std::string_view source() const override { return m_inner()->source; }
     void setSource(std::string source) override { m_inner()->source = std::move(source); }
 
+    uint32_t conflictKey() const override { return m_inner()->conflictKey; }
+    void setConflictKey(uint32_t conflictKey) override { m_inner()->conflictKey = conflictKey; }
+
     const bcostars::TransactionMetaData& inner() const { return *m_inner(); }
     bcostars::TransactionMetaData& mutableInner() { return *m_inner(); }
     bcostars::TransactionMetaData takeInner() { return std::move(*m_inner()); }
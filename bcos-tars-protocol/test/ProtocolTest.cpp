@@ -432,6 +432,52 @@ BOOST_AUTO_TEST_CASE(block)
     }
 }
 
+BOOST_AUTO_TEST_CASE(lazyBlockDecode)
+{
+    auto block = blockFactory->createBlock();
+    block->blockHeader()->setNumber(100);
+    bcos::bytes input(bcos::asBytes("Arguments"));
+    bcos::bytes output(bcos::asBytes("Output!"));
+    for (size_t i = 0; i < 10; ++i)
+    {
+        block->appendTransaction(transactionFactory->createTransaction(
+            0, "Target", input, std::to_string(i), i, "testChain", "testGroup", 1000));
+        block->appendReceipt(transactionReceiptFactory->createReceipt(
+            1000, "contract", {}, 0, bcos::ref(output), i));
+    }
+    bcos::bytes buffer;
+    block->encode(buffer);
+
+    // the header is read before the body is decoded
+    auto decodedBlock = std::dynamic_pointer_cast<bcostars::protocol::BlockImpl>(
+        blockFactory->createBlock(bcos::ref(buffer), false, false));
+    BOOST_CHECK_EQUAL(decodedBlock->blockHeaderConst()->number(), 100);
+    BOOST_CHECK_EQUAL(decodedBlock->receiptsSize(), 10);
+    BOOST_CHECK_EQUAL(decodedBlock->receipt(9)->hash(), block->receipt(9)->hash());
+    BOOST_CHECK_EQUAL(decodedBlock->transactionsSize(), 10);
+    BOOST_CHECK_EQUAL(decodedBlock->transaction(9)->hash(), block->transaction(9)->hash());
+
+    // a block never accessed encodes the same
+    auto untouched = blockFactory->createBlock(bcos::ref(buffer), false, false);
+    bcos::bytes reencoded;
+    untouched->encode(reencoded);
+    BOOST_CHECK(reencoded == buffer);
+    BOOST_CHECK_EQUAL(std::dynamic_pointer_cast<bcostars::protocol::BlockImpl>(untouched)
+                          ->inner()
+                          .transactions.size(),
+        10);
+
+    // a block from a peer is decoded at once
+    auto checkedBlock = blockFactory->createBlock(bcos::ref(buffer));
+    BOOST_CHECK_EQUAL(checkedBlock->receipt(9)->hash(), block->receipt(9)->hash());
+    BOOST_CHECK_EQUAL(checkedBlock->transaction(9)->hash(), block->transaction(9)->hash());
+
+    // a truncated body throws from createBlock, not from the first reader of the body
+    auto truncated = bcos::ref(buffer).getCroppedData(0, buffer.size() / 2);
+    BOOST_CHECK_THROW(blockFactory->createBlock(truncated), std::exception);
+    BOOST_CHECK_THROW(blockFactory->createBlock(truncated, false, false), std::exception);
+}
+
 BOOST_AUTO_TEST_CASE(blockHeader)
 {
     auto header = blockHeaderFactory->createBlockHeader();
@@ -358,6 +358,7 @@ void NodeConfig::loadRpcConfig(boost::property_tree::ptree const& _pt)
         thread_count=16
         sm_ssl=false
         disable_ssl=false
+        metrics_path=/metrics
     */
     std::string listenIP = _pt.get<std::string>("rpc.listen_ip", "0.0.0.0");
     int listenPort = _pt.get<int>("rpc.listen_port", 20200);
@@ -365,18 +366,22 @@ void NodeConfig::loadRpcConfig(boost::property_tree::ptree const& _pt)
     bool smSsl = _pt.get<bool>("rpc.sm_ssl", false);
     bool disableSsl = _pt.get<bool>("rpc.disable_ssl", false);
     bool needRetInput = _pt.get<bool>("rpc.return_input_params", true);
+    // empty to disable the prometheus endpoint
+    std::string metricsPath = _pt.get<std::string>("rpc.metrics_path", "");
 
     m_rpcListenIP = listenIP;
     m_rpcListenPort = listenPort;
     m_rpcThreadPoolSize = threadCount;
     m_rpcDisableSsl = disableSsl;
     m_rpcSmSsl = smSsl;
+    m_rpcMetricsPath = metricsPath;
     g_BCOSConfig.setNeedRetInput(needRetInput);
 
     NodeConfig_LOG(INFO) << LOG_DESC("loadRpcConfig") << LOG_KV("listenIP", listenIP)
                          << LOG_KV("listenPort", listenPort) << LOG_KV("listenPort", listenPort)
                          << LOG_KV("smSsl", smSsl) << LOG_KV("disableSsl", disableSsl)
-                         << LOG_KV("needRetInput", needRetInput);
+                         << LOG_KV("needRetInput", needRetInput)
+                         << LOG_KV("metricsPath", metricsPath);
 }
 
 void NodeConfig::loadGatewayConfig(boost::property_tree::ptree const& _pt)
@@ -657,6 +662,8 @@ void NodeConfig::loadStorageConfig(boost::property_tree::ptree const& _pt)
     m_blockCacheSize = _pt.get<size_t>("storage.block_cache_size", 128 << 20);
     m_enableDBStatistics = _pt.get<bool>("storage.enable_statistics", false);
     m_enableRocksDBBlob = _pt.get<bool>("storage.enable_rocksdb_blob", false);
+    m_enableColumnFamilies = _pt.get<bool>("storage.enable_column_families", false);
+    m_headerBlockCacheSize = _pt.get<size_t>("storage.header_block_cache_size", 256 << 20);
     m_pdCaPath = _pt.get<std::string>("storage.pd_ssl_ca_path", "");
     m_pdCertPath = _pt.get<std::string>("storage.pd_ssl_cert_path", "");
     m_pdKeyPath = _pt.get<std::string>("storage.pd_ssl_key_path", "");
@@ -667,6 +674,20 @@ void NodeConfig::loadStorageConfig(boost::property_tree::ptree const& _pt)
         m_archiveListenPort = _pt.get<uint16_t>("storage.archive_port");
     }
 
+    m_enableSegmentStore = _pt.get<bool>("storage.enable_segment_store", false);
+    m_segmentStorePath = _pt.get<std::string>("storage.segment_path", m_storagePath + "/segments");
+    m_segmentFileSize = _pt.get<uint64_t>("storage.segment_file_size", 256 << 20);
+    // the archive service moves and deletes s_hash_2_tx and s_hash_2_receipt in the state db,
+    // the segment files are append only and have nothing it could delete
+    if (m_enableSegmentStore && m_enableArchive)
+    {
+        BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                  "storage.enable_segment_store can not work with "
+                                  "storage.enable_archive, please disable one of them"));
+    }
+
+    m_ledgerHotCacheSize = _pt.get<size_t>("storage.ledger_hot_cache_size", 128 << 20);
+
     // if (m_keyPageSize < 4096 || m_keyPageSize > (1 << 25))
     // {
     //     BOOST_THROW_EXCEPTION(
@@ -684,6 +705,11 @@ void NodeConfig::loadStorageConfig(boost::property_tree::ptree const& _pt)
                          << LOG_KV("archiveListenIP", m_archiveListenIP)
                          << LOG_KV("archiveListenPort", m_archiveListenPort)
                          << LOG_KV("enable_rocksdb_blob", m_enableRocksDBBlob)
+                         << LOG_KV("enableColumnFamilies", m_enableColumnFamilies)
+                         << LOG_KV("headerBlockCacheSize", m_headerBlockCacheSize)
+                         << LOG_KV("enableSegmentStore", m_enableSegmentStore)
+                         << LOG_KV("segmentStorePath", m_segmentStorePath)
+                         << LOG_KV("ledgerHotCacheSize", m_ledgerHotCacheSize)
                          << LOG_KV("enableLRUCacheStorage", m_enableLRUCacheStorage);
 }
 
@@ -729,6 +755,14 @@ void NodeConfig::loadOthersConfig(boost::property_tree::ptree const& _pt)
     m_baselineSchedulerConfig.maxThread = _pt.get<int>("executor.baseline_scheduler_maxthread", 16);
     m_baselineSchedulerConfig.parallel =
         _pt.get<bool>("executor.baseline_scheduler_parallel", false);
+    m_baselineSchedulerConfig.callThread = _pt.get<int>(
+        "executor.baseline_scheduler_call_thread", std::thread::hardware_concurrency());
+    m_baselineSchedulerConfig.callResultCacheSize =
+        _pt.get<size_t>("executor.baseline_scheduler_call_cache_size", 10000);
+    m_baselineSchedulerConfig.maxImmutableLayers =
+        _pt.get<size_t>("executor.baseline_scheduler_max_immutable_layers", 0);
+    m_baselineSchedulerConfig.maxImmutableBytes =
+        _pt.get<int64_t>("executor.baseline_scheduler_max_immutable_size", 0);
 
     m_tarsRPCConfig.host = _pt.get<std::string>("rpc.tars_rpc_host", "127.0.0.1");
     m_tarsRPCConfig.port = _pt.get<int>("rpc.tars_rpc_port", 0);
@@ -133,6 +133,8 @@ public:
     int minWriteBufferNumberToMerge() const { return m_minWriteBufferNumberToMerge; }
     size_t blockCacheSize() const { return m_blockCacheSize; }
     bool enableRocksDBBlob() const { return m_enableRocksDBBlob; }
+    bool enableColumnFamilies() const { return m_enableColumnFamilies; }
+    size_t headerBlockCacheSize() const { return m_headerBlockCacheSize; }
     std::vector<std::string> const& pdAddrs() const { return m_pd_addrs; }
     std::string const& pdCaPath() const { return m_pdCaPath; }
     std::string const& pdCertPath() const { return m_pdCertPath; }
@@ -142,6 +144,10 @@ public:
     bool enableArchive() const { return m_enableArchive; }
     std::string const& archiveListenIP() const { return m_archiveListenIP; }
     uint16_t archiveListenPort() const { return m_archiveListenPort; }
+    bool enableSegmentStore() const { return m_enableSegmentStore; }
+    std::string const& segmentStorePath() const { return m_segmentStorePath; }
+    uint64_t segmentFileSize() const { return m_segmentFileSize; }
+    size_t ledgerHotCacheSize() const { return m_ledgerHotCacheSize; }
 
     bcos::crypto::KeyFactory::Ptr keyFactory() { return m_keyFactory; }
 
@@ -179,6 +185,7 @@ public:
     uint32_t rpcThreadPoolSize() const { return m_rpcThreadPoolSize; }
     bool rpcSmSsl() const { return m_rpcSmSsl; }
     bool rpcDisableSsl() const { return m_rpcDisableSsl; }
+    std::string const& rpcMetricsPath() const { return m_rpcMetricsPath; }
 
     // the gateway configurations
     const std::string& p2pListenIP() const { return m_p2pListenIP; }
@@ -256,6 +263,11 @@ public:
         bool parallel = false;
         int chunkSize = 0;
         int maxThread = 0;
+        int callThread = 0;
+        size_t callResultCacheSize = 0;
+        // executed blocks waiting for commit, the execution stalls when either is reached
+        size_t maxImmutableLayers = 0;
+        int64_t maxImmutableBytes = 0;
     };
     BaselineSchedulerConfig const& baselineSchedulerConfig() const
     {
@@ -368,11 +380,20 @@ private:
     int m_minWriteBufferNumberToMerge = 2;
     size_t m_blockCacheSize = 128 << 20;
     bool m_enableRocksDBBlob = false;
+    bool m_enableColumnFamilies = false;
+    size_t m_headerBlockCacheSize = 256 << 20;
 
     bool m_enableArchive = false;
     std::string m_archiveListenIP;
     uint16_t m_archiveListenPort = 0;
 
+    // store the transactions and receipts in append-only segment files
+    bool m_enableSegmentStore = false;
+    std::string m_segmentStorePath;
+    uint64_t m_segmentFileSize = 256 << 20;
+    // bytes of the recently written transactions and receipts the ledger keeps decoded
+    size_t m_ledgerHotCacheSize = 128 << 20;
+
     std::string m_storageDBName = "storage";
     std::string m_stateDBName = "state";
 
@@ -403,6 +424,7 @@ private:
     uint32_t m_rpcThreadPoolSize;
     bool m_rpcSmSsl;
     bool m_rpcDisableSsl = false;
+    std::string m_rpcMetricsPath;
 
     // config for gateway
     std::string m_p2pListenIP;
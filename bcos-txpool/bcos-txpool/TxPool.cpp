@@ -46,9 +46,9 @@ bcos::txpool::TxPool::TxPool(TxPoolConfig::Ptr config, TxPoolStorageInterface::P
     m_transactionFactory(m_config->blockFactory()->transactionFactory()),
     m_ledger(m_config->ledger())
 {
-    m_worker = std::make_shared<ThreadPool>("submitter", verifierWorkerNum);
-    m_verifier = std::make_shared<ThreadPool>("verifier", 2);
-    m_sealer = std::make_shared<ThreadPool>("txsSeal", 1);
+    m_worker = std::make_shared<WorkStealingThreadPool>("submitter", verifierWorkerNum);
+    m_verifier = std::make_shared<WorkStealingThreadPool>("verifier", 2);
+    m_sealer = std::make_shared<WorkStealingThreadPool>("txsSeal", 1);
     // worker to pre-store-txs
     m_txsPreStore = std::make_shared<ThreadPool>("txsPreStore", 1);
     TXPOOL_LOG(INFO) << LOG_DESC("create TxPool") << LOG_KV("submitterNum", verifierWorkerNum);
@@ -415,36 +415,40 @@ void TxPool::notifyObserverNodeList(
 void TxPool::getTxsFromLocalLedger(HashListPtr _txsHash, HashListPtr _missedTxs,
     std::function<void(Error::Ptr, ConstTransactionsPtr)> _onBlockFilled)
 {
-    // fetch from the local ledger
+    // fetch from the local ledger, the consensus is waiting on it, run before the txs removal
     auto self = weak_from_this();
-    m_worker->enqueue([self, _txsHash, _missedTxs, _onBlockFilled]() {
-        auto txpool = self.lock();
-        if (!txpool)
-        {
-            _onBlockFilled(
-                BCOS_ERROR_PTR(CommonError::TransactionsMissing, "TransactionsMissing"), nullptr);
-            return;
-        }
-        auto sync = txpool->m_transactionSync;
-        sync->requestMissedTxs(nullptr, _missedTxs, nullptr,
-            [txpool, _txsHash, _onBlockFilled](Error::Ptr _error, bool _verifyResult) {
-                if (_error || !_verifyResult)
-                {
-                    TXPOOL_LOG(WARNING)
-                        << LOG_DESC("getTxsFromLocalLedger failed")
-                        << LOG_KV("code", _error ? _error->errorCode() : 0)
-                        << LOG_KV("msg", _error ? _error->errorMessage() : "fetchSucc")
-                        << LOG_KV("verifyResult", _verifyResult);
-                    _onBlockFilled(
-                        BCOS_ERROR_PTR(CommonError::TransactionsMissing, "TransactionsMissing"),
-                        nullptr);
-                    return;
-                }
-                TXPOOL_LOG(INFO) << LOG_DESC(
-                    "asyncFillBlock miss and try to get the transaction from the ledger success");
-                txpool->fillBlock(_txsHash, _onBlockFilled, false);
-            });
-    });
+    m_worker->enqueue(
+        [self, _txsHash, _missedTxs, _onBlockFilled]() {
+            auto txpool = self.lock();
+            if (!txpool)
+            {
+                _onBlockFilled(BCOS_ERROR_PTR(CommonError::TransactionsMissing,
+                                   "TransactionsMissing"),
+                    nullptr);
+                return;
+            }
+            auto sync = txpool->m_transactionSync;
+            sync->requestMissedTxs(nullptr, _missedTxs, nullptr,
+                [txpool, _txsHash, _onBlockFilled](Error::Ptr _error, bool _verifyResult) {
+                    if (_error || !_verifyResult)
+                    {
+                        TXPOOL_LOG(WARNING)
+                            << LOG_DESC("getTxsFromLocalLedger failed")
+                            << LOG_KV("code", _error ? _error->errorCode() : 0)
+                            << LOG_KV("msg", _error ? _error->errorMessage() : "fetchSucc")
+                            << LOG_KV("verifyResult", _verifyResult);
+                        _onBlockFilled(
+                            BCOS_ERROR_PTR(CommonError::TransactionsMissing, "TransactionsMissing"),
+                            nullptr);
+                        return;
+                    }
+                    TXPOOL_LOG(INFO) << LOG_DESC(
+                        "asyncFillBlock miss and try to get the transaction from the ledger "
+                        "success");
+                    txpool->fillBlock(_txsHash, _onBlockFilled, false);
+                });
+        },
+        WorkStealingThreadPool::Priority::HIGH);
 }
 
 // Note: the transaction must be all hit in local txpool
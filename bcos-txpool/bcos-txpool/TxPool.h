@@ -29,6 +29,7 @@
 #include <bcos-framework/txpool/TxPoolInterface.h>
 #include <bcos-tool/TreeTopology.h>
 #include <bcos-utilities/ThreadPool.h>
+#include <bcos-utilities/WorkStealingThreadPool.h>
 #include <thread>
 namespace bcos::txpool
 {
@@ -163,9 +164,9 @@ private:
     std::function<void(std::string const&, int, bcos::crypto::NodeIDPtr, bytesConstRef)>
         m_sendResponseHandler;
 
-    ThreadPool::Ptr m_worker;
-    ThreadPool::Ptr m_verifier;
-    ThreadPool::Ptr m_sealer;
+    WorkStealingThreadPool::Ptr m_worker;
+    WorkStealingThreadPool::Ptr m_verifier;
+    WorkStealingThreadPool::Ptr m_sealer;
     ThreadPool::Ptr m_txsPreStore;
     tool::TreeTopology::Ptr m_treeRouter = nullptr;
     std::atomic_bool m_running = {false};
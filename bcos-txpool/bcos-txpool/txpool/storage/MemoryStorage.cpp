@@ -20,6 +20,7 @@
  */
 #include "bcos-txpool/txpool/storage/MemoryStorage.h"
 #include "bcos-utilities/Common.h"
+#include "bcos-utilities/Metrics.h"
 #include <oneapi/tbb/blocked_range.h>
 #include <oneapi/tbb/parallel_for_each.h>
 #include <tbb/parallel_for.h>
@@ -314,6 +315,9 @@ TransactionStatus MemoryStorage::enforceSubmitTransaction(Transaction::Ptr _tx)
 TransactionStatus MemoryStorage::verifyAndSubmitTransaction(
     Transaction::Ptr transaction, TxSubmitCallback txSubmitCallback, bool checkPoolLimit, bool lock)
 {
+    static auto& submitTime = metrics::Registry::instance().histogram(
+        "bcos_txpool_submit_us", "time to verify and insert a transaction into the txpool");
+    metrics::ScopedTimer timer(submitTime);
     size_t txsSize = m_txsTable.size();
 
     auto result = txpoolStorageCheck(*transaction, txSubmitCallback);
@@ -627,12 +631,10 @@ void MemoryStorage::batchRemove(BlockNumber batchId, TransactionSubmitResults co
     //     notifyTxResult(*tx, std::move(txResult));
     // }
 
-    TXPOOL_LOG(INFO) << METRIC << LOG_DESC("batchRemove txs success")
-                     << LOG_KV("expectedSize", txsResult.size()) << LOG_KV("succCount", succCount)
-                     << LOG_KV("batchId", batchId) << LOG_KV("timecost", (utcTime() - recordT))
-                     << LOG_KV("lockT", lockT) << LOG_KV("removeT", removeT)
-                     << LOG_KV("updateLedgerNonceT", updateLedgerNonceT)
-                     << LOG_KV("updateTxPoolNonceT", updateTxPoolNonceT);
+    TXPOOL_METRIC_LOG(INFO, "batchRemove txs success", "expectedSize", txsResult.size(),
+        "succCount", succCount, "batchId", batchId, "timecost", (utcTime() - recordT), "lockT",
+        lockT, "removeT", removeT, "updateLedgerNonceT", updateLedgerNonceT, "updateTxPoolNonceT",
+        updateTxPoolNonceT);
 }
 
 ConstTransactionsPtr MemoryStorage::fetchTxs(HashList& _missedTxs, HashList const& _txs)
@@ -688,8 +690,8 @@ ConstTransactionsPtr MemoryStorage::fetchNewTxs(size_t _txsLimit)
 void MemoryStorage::batchFetchTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList, size_t _txsLimit,
     TxsHashSetPtr _avoidTxs, bool _avoidDuplicate)
 {
-    TXPOOL_LOG(INFO) << LOG_DESC("begin batchFetchTxs") << LOG_KV("pendingTxs", m_txsTable.size())
-                     << LOG_KV("limit", _txsLimit);
+    TXPOOL_BINARY_LOG(
+        INFO, "begin batchFetchTxs", "pendingTxs", m_txsTable.size(), "limit", _txsLimit);
     auto blockFactory = m_config->blockFactory();
     auto recordT = utcTime();
     auto startT = utcTime();
@@ -762,6 +764,7 @@ void MemoryStorage::batchFetchTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList, s
         txMetaData->setHash(tx->hash());
         txMetaData->setTo(std::string(tx->to()));
         txMetaData->setAttribute(tx->attribute());
+        txMetaData->setConflictKey(protocol::conflictKeyOf(tx->to(), tx->sender()));
         if (tx->systemTx())
         {
             _sysTxsList->appendTransactionMetaData(std::move(txMetaData));
@@ -814,15 +817,17 @@ void MemoryStorage::batchFetchTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList, s
     removeInvalidTxs(true);
 
     auto fetchTxsT = utcTime() - startT;
-    TXPOOL_LOG(INFO) << METRIC << LOG_DESC("batchFetchTxs success")
-                     << LOG_KV("time", (utcTime() - recordT))
-                     << LOG_KV("txsSize", _txsList->transactionsMetaDataSize())
-                     << LOG_KV("sysTxsSize", _sysTxsList->transactionsMetaDataSize())
-                     << LOG_KV("pendingTxs", m_txsTable.size()) << LOG_KV("limit", _txsLimit)
-                     << LOG_KV("fetchTxsT", fetchTxsT) << LOG_KV("lockT", lockT)
-                     << LOG_KV("invalidBefore", invalidTxsSize)
-                     << LOG_KV("invalidNow", m_invalidTxs.size()) << LOG_KV("sealed", sealed)
-                     << LOG_KV("traverseCount", traverseCount);
+    static auto& batchFetchTxsTime = metrics::Registry::instance().histogram(
+        "bcos_txpool_batch_fetch_txs_us", "time to fetch the transactions of a proposal");
+    static auto& pendingTxs = metrics::Registry::instance().gauge(
+        "bcos_txpool_pending_txs", "transactions in the txpool");
+    batchFetchTxsTime.observe((utcTime() - recordT) * 1000);
+    pendingTxs.set((int64_t)m_txsTable.size());
+    TXPOOL_METRIC_LOG(INFO, "batchFetchTxs success", "time", (utcTime() - recordT), "txsSize",
+        _txsList->transactionsMetaDataSize(), "sysTxsSize",
+        _sysTxsList->transactionsMetaDataSize(), "pendingTxs", m_txsTable.size(), "limit",
+        _txsLimit, "fetchTxsT", fetchTxsT, "lockT", lockT, "invalidBefore", invalidTxsSize,
+        "invalidNow", m_invalidTxs.size(), "sealed", sealed, "traverseCount", traverseCount);
 }
 #endif
 
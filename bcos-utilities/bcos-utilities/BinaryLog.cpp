@@ -0,0 +1,599 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file: BinaryLog.cpp
+ */
+#include "BinaryLog.h"
+#include "Common.h"
+#include <boost/date_time/c_local_time_adjustor.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/log/attributes/constant.hpp>
+#include <boost/log/attributes/scoped_attribute.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+using namespace bcos;
+
+namespace
+{
+constexpr std::string_view FILE_MAGIC = "BCOSBLG1";
+constexpr char FORMAT_ENTRY = 'F';
+constexpr char THREAD_ENTRY = 'T';
+constexpr char RECORD_ENTRY = 'R';
+// u32 size, u32 format id, i64 timestamp, u8 arg count
+constexpr size_t RECORD_HEADER_SIZE = 4 + 4 + 8 + 1;
+
+template <class Value>
+void append(std::string& out, Value value)
+{
+    out.append((char const*)&value, sizeof(value));
+}
+
+void appendString(std::string& out, std::string_view value)
+{
+    append<uint32_t>(out, value.size());
+    out.append(value);
+}
+
+// reads the fields of a record or a file entry, fails on truncated input
+class Reader
+{
+public:
+    explicit Reader(std::string_view data) : m_data(data) {}
+
+    template <class Value>
+    bool read(Value& value)
+    {
+        if (m_data.size() < sizeof(value))
+        {
+            return false;
+        }
+        std::memcpy(&value, m_data.data(), sizeof(value));
+        m_data.remove_prefix(sizeof(value));
+        return true;
+    }
+    bool readString(std::string_view& value)
+    {
+        uint32_t size = 0;
+        if (!read(size) || m_data.size() < size)
+        {
+            return false;
+        }
+        value = m_data.substr(0, size);
+        m_data.remove_prefix(size);
+        return true;
+    }
+
+private:
+    std::string_view m_data;
+};
+
+boost::posix_time::ptime toLocalTime(int64_t timestamp)
+{
+    auto utc = boost::posix_time::from_time_t(timestamp / 1000000000) +
+               boost::posix_time::microseconds((timestamp % 1000000000) / 1000);
+    return boost::date_time::c_local_adjustor<boost::posix_time::ptime>::utc_to_local(utc);
+}
+
+// the message of BCOS_LOG: [module]description,key=value...
+bool formatMessage(std::ostream& stream, BinaryLogger::Format const& format, Reader& reader,
+    uint8_t argCount)
+{
+    stream << LOG_BADGE(format.module) << LOG_DESC(format.description);
+    for (uint8_t i = 0; i < argCount; ++i)
+    {
+        uint8_t type = 0;
+        if (!reader.read(type))
+        {
+            return false;
+        }
+        stream << "," << (i < format.keys.size() ? format.keys[i] : "?") << "=";
+        switch ((BinaryLogger::ArgType)type)
+        {
+        case BinaryLogger::ArgType::INT64:
+        {
+            int64_t value = 0;
+            if (!reader.read(value))
+            {
+                return false;
+            }
+            stream << value;
+            break;
+        }
+        case BinaryLogger::ArgType::UINT64:
+        {
+            uint64_t value = 0;
+            if (!reader.read(value))
+            {
+                return false;
+            }
+            stream << value;
+            break;
+        }
+        case BinaryLogger::ArgType::DOUBLE:
+        {
+            double value = 0;
+            if (!reader.read(value))
+            {
+                return false;
+            }
+            stream << value;
+            break;
+        }
+        case BinaryLogger::ArgType::STRING:
+        {
+            std::string_view value;
+            if (!reader.readString(value))
+            {
+                return false;
+            }
+            stream << value;
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t roundUpPowerOf2(size_t value)
+{
+    size_t result = 1;
+    while (result < value)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+}  // namespace
+
+BinaryLogger::Site::Site(LogLevel level, char const* module)
+  : m_level(level), m_module(module), m_enabled(instance().moduleFlag(module))
+{}
+
+BinaryLogger::Ring::Ring(size_t _capacity)
+  : buffer(std::make_unique<char[]>(_capacity)), capacity(_capacity)
+{}
+
+BinaryLogger::RingHolder::~RingHolder()
+{
+    if (ring)
+    {
+        ring->closed = true;
+    }
+}
+
+BinaryLogger& BinaryLogger::instance()
+{
+    static BinaryLogger logger;
+    return logger;
+}
+
+void BinaryLogger::start(Config config)
+{
+    std::unique_lock lock(m_mutex);
+    if (m_running)
+    {
+        return;
+    }
+    config.bufferSize = roundUpPowerOf2(std::max<size_t>(config.bufferSize, 4096));
+    m_config = std::move(config);
+    if (m_config.mode == Mode::BINARY)
+    {
+        boost::filesystem::create_directories(m_config.path);
+        auto fileName = m_config.path + "/binary_log_" +
+                        boost::posix_time::to_iso_string(
+                            boost::posix_time::second_clock::local_time()) +
+                        ".blog";
+        m_file.open(fileName, std::ios::binary | std::ios::app);
+        if (!m_file)
+        {
+            BCOS_LOG(WARNING) << LOG_BADGE("BinaryLogger") << LOG_DESC("open binary log failed")
+                              << LOG_KV("file", fileName);
+            return;
+        }
+        m_file.write(FILE_MAGIC.data(), FILE_MAGIC.size());
+        m_writtenFormats.assign(m_formats.size() + 1, false);
+        m_writtenRings.assign(m_nextRingID, false);
+    }
+    m_running = true;
+    m_thread = std::thread([this]() { run(); });
+    for (auto const& module : m_config.modules)
+    {
+        auto it = m_modules.find(module);
+        if (it == m_modules.end())
+        {
+            it = m_modules.emplace(module, std::make_unique<std::atomic_bool>(false)).first;
+        }
+        it->second->store(true);
+    }
+    BCOS_LOG(INFO) << LOG_BADGE("BinaryLogger") << LOG_DESC("start")
+                   << LOG_KV("mode", m_config.mode == Mode::BINARY ? "binary" : "text")
+                   << LOG_KV("modules", m_config.modules.size())
+                   << LOG_KV("bufferSize", m_config.bufferSize);
+}
+
+void BinaryLogger::stop()
+{
+    {
+        std::unique_lock lock(m_mutex);
+        if (!m_running)
+        {
+            return;
+        }
+        for (auto& [name, flag] : m_modules)
+        {
+            flag->store(false);
+        }
+        m_running = false;
+    }
+    m_condition.notify_all();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+    std::unique_lock lock(m_mutex);
+    if (m_file.is_open())
+    {
+        m_file.close();
+    }
+}
+
+std::atomic_bool const& BinaryLogger::moduleFlag(std::string_view module)
+{
+    std::unique_lock lock(m_mutex);
+    auto it = m_modules.find(module);
+    if (it == m_modules.end())
+    {
+        bool enabled = m_running && std::find(m_config.modules.begin(), m_config.modules.end(),
+                                        module) != m_config.modules.end();
+        it = m_modules.emplace(std::string(module), std::make_unique<std::atomic_bool>(enabled))
+                 .first;
+    }
+    return *it->second;
+}
+
+uint32_t BinaryLogger::registerFormat(Format format)
+{
+    std::unique_lock lock(m_mutex);
+    m_formats.push_back(std::move(format));
+    return m_formats.size();
+}
+
+BinaryLogger::Format const* BinaryLogger::format(uint32_t formatID)
+{
+    std::unique_lock lock(m_mutex);
+    if (formatID == 0 || formatID > m_formats.size())
+    {
+        return nullptr;
+    }
+    // deque keeps the references valid on push_back
+    return &m_formats[formatID - 1];
+}
+
+BinaryLogger::Ring* BinaryLogger::localRing()
+{
+    thread_local RingHolder holder;
+    if (!holder.ring)
+    {
+        auto ring = std::make_shared<Ring>(m_config.bufferSize);
+        ring->threadName = pthread_getThreadName();
+        std::unique_lock lock(m_mutex);
+        ring->id = m_nextRingID++;
+        m_rings.push_back(ring);
+        holder.ring = std::move(ring);
+    }
+    return holder.ring.get();
+}
+
+void BinaryLogger::push(uint32_t formatID, Arg const* args, size_t count)
+{
+    auto* ring = localRing();
+    size_t size = RECORD_HEADER_SIZE;
+    for (size_t i = 0; i < count; ++i)
+    {
+        size += 1 + (args[i].type == ArgType::STRING ? 4 + args[i].str.size() : 8);
+    }
+    auto head = ring->head.load(std::memory_order_relaxed);
+    if (size > ring->capacity - (head - ring->tail.load(std::memory_order_acquire)))
+    {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto mask = ring->capacity - 1;
+    auto write = [&](void const* data, size_t length) {
+        auto offset = head & mask;
+        auto first = std::min(length, ring->capacity - offset);
+        std::memcpy(ring->buffer.get() + offset, data, first);
+        std::memcpy(ring->buffer.get(), (char const*)data + first, length - first);
+        head += length;
+    };
+    auto recordSize = (uint32_t)size;
+    auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch())
+                         .count();
+    auto argCount = (uint8_t)count;
+    write(&recordSize, sizeof(recordSize));
+    write(&formatID, sizeof(formatID));
+    write(&timestamp, sizeof(timestamp));
+    write(&argCount, sizeof(argCount));
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto const& arg = args[i];
+        write(&arg.type, sizeof(arg.type));
+        if (arg.type == ArgType::STRING)
+        {
+            auto length = (uint32_t)arg.str.size();
+            write(&length, sizeof(length));
+            write(arg.str.data(), arg.str.size());
+        }
+        else
+        {
+            write(&arg.u64, sizeof(arg.u64));
+        }
+    }
+    ring->head.store(head, std::memory_order_release);
+}
+
+void BinaryLogger::run()
+{
+    bcos::pthread_setThreadName("binaryLog");
+    while (true)
+    {
+        bool running = m_running;
+        std::vector<std::shared_ptr<Ring>> rings;
+        {
+            std::unique_lock lock(m_mutex);
+            rings = m_rings;
+        }
+        bool drained = false;
+        for (auto& ring : rings)
+        {
+            // read closed before draining, a record pushed before the close is not missed
+            bool closed = ring->closed;
+            drained = drain(*ring) || drained;
+            if (closed)
+            {
+                std::unique_lock lock(m_mutex);
+                std::erase(m_rings, ring);
+            }
+        }
+        if (m_file.is_open())
+        {
+            m_file.flush();
+        }
+        if (!running)
+        {
+            break;
+        }
+        if (!drained)
+        {
+            std::unique_lock lock(m_mutex);
+            m_condition.wait_for(
+                lock, std::chrono::milliseconds(1), [this]() { return !m_running; });
+        }
+    }
+}
+
+bool BinaryLogger::drain(Ring& ring)
+{
+    auto tail = ring.tail.load(std::memory_order_relaxed);
+    auto head = ring.head.load(std::memory_order_acquire);
+    if (tail == head)
+    {
+        return false;
+    }
+    auto mask = ring.capacity - 1;
+    std::string record;
+    while (tail != head)
+    {
+        auto read = [&](uint64_t position, char* out, size_t length) {
+            auto offset = position & mask;
+            auto first = std::min(length, ring.capacity - offset);
+            std::memcpy(out, ring.buffer.get() + offset, first);
+            std::memcpy(out + first, ring.buffer.get(), length - first);
+        };
+        uint32_t size = 0;
+        read(tail, (char*)&size, sizeof(size));
+        record.resize(size);
+        read(tail, record.data(), size);
+        handle(ring, record);
+        tail += size;
+    }
+    ring.tail.store(tail, std::memory_order_release);
+    return true;
+}
+
+void BinaryLogger::handle(Ring const& ring, std::string_view record)
+{
+    Reader reader(record);
+    uint32_t size = 0;
+    uint32_t formatID = 0;
+    int64_t timestamp = 0;
+    uint8_t argCount = 0;
+    reader.read(size);
+    reader.read(formatID);
+    reader.read(timestamp);
+    reader.read(argCount);
+    auto const* format = this->format(formatID);
+    if (format == nullptr)
+    {
+        return;
+    }
+
+    if (m_config.mode == Mode::TEXT)
+    {
+        // the timestamp and thread name of the logging thread, not of this one
+        BOOST_LOG_SCOPED_THREAD_ATTR(
+            "TimeStamp", boost::log::attributes::constant<boost::posix_time::ptime>(
+                             toLocalTime(timestamp)));
+        BOOST_LOG_SCOPED_THREAD_ATTR(
+            "ThreadName", boost::log::attributes::constant<std::string>(ring.threadName));
+        std::ostringstream message;
+        formatMessage(message, *format, reader, argCount);
+        BOOST_LOG_SEV(FileLoggerHandler, (boost::log::trivial::severity_level)(format->level))
+            << message.str();
+        return;
+    }
+
+    if (!m_file.is_open())
+    {
+        return;
+    }
+    std::string entry;
+    if (formatID >= m_writtenFormats.size())
+    {
+        m_writtenFormats.resize(formatID + 1, false);
+    }
+    if (!m_writtenFormats[formatID])
+    {
+        entry.push_back(FORMAT_ENTRY);
+        append<uint32_t>(entry, formatID);
+        append<uint8_t>(entry, format->level);
+        appendString(entry, format->module);
+        appendString(entry, format->description);
+        append<uint8_t>(entry, format->keys.size());
+        for (auto const& key : format->keys)
+        {
+            appendString(entry, key);
+        }
+        m_writtenFormats[formatID] = true;
+    }
+    if (ring.id >= m_writtenRings.size())
+    {
+        m_writtenRings.resize(ring.id + 1, false);
+    }
+    if (!m_writtenRings[ring.id])
+    {
+        entry.push_back(THREAD_ENTRY);
+        append<uint32_t>(entry, ring.id);
+        appendString(entry, ring.threadName);
+        m_writtenRings[ring.id] = true;
+    }
+    entry.push_back(RECORD_ENTRY);
+    append<uint32_t>(entry, ring.id);
+    entry.append(record);
+    m_file.write(entry.data(), entry.size());
+}
+
+size_t BinaryLogger::decode(std::istream& input, std::ostream& output)
+{
+    std::string data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    std::string_view view(data);
+    if (!view.starts_with(FILE_MAGIC))
+    {
+        return 0;
+    }
+    view.remove_prefix(FILE_MAGIC.size());
+
+    std::map<uint32_t, Format> formats;
+    std::map<uint32_t, std::string> threads;
+    size_t count = 0;
+    while (!view.empty())
+    {
+        auto type = view.front();
+        Reader reader(view.substr(1));
+        size_t consumed = 1;
+        if (type == FORMAT_ENTRY)
+        {
+            uint32_t formatID = 0;
+            uint8_t level = 0;
+            uint8_t keyCount = 0;
+            std::string_view module;
+            std::string_view description;
+            if (!reader.read(formatID) || !reader.read(level) || !reader.readString(module) ||
+                !reader.readString(description) || !reader.read(keyCount))
+            {
+                break;
+            }
+            Format format{.level = (LogLevel)level,
+                .module = std::string(module),
+                .description = std::string(description)};
+            consumed += 4 + 1 + 4 + module.size() + 4 + description.size() + 1;
+            bool valid = true;
+            for (uint8_t i = 0; i < keyCount; ++i)
+            {
+                std::string_view key;
+                if (!reader.readString(key))
+                {
+                    valid = false;
+                    break;
+                }
+                format.keys.emplace_back(key);
+                consumed += 4 + key.size();
+            }
+            if (!valid)
+            {
+                break;
+            }
+            formats[formatID] = std::move(format);
+        }
+        else if (type == THREAD_ENTRY)
+        {
+            uint32_t ringID = 0;
+            std::string_view name;
+            if (!reader.read(ringID) || !reader.readString(name))
+            {
+                break;
+            }
+            threads[ringID] = std::string(name);
+            consumed += 4 + 4 + name.size();
+        }
+        else if (type == RECORD_ENTRY)
+        {
+            uint32_t ringID = 0;
+            uint32_t size = 0;
+            if (!reader.read(ringID) || !reader.read(size) || view.size() < 1 + 4 + size ||
+                size < RECORD_HEADER_SIZE)
+            {
+                break;
+            }
+            Reader record(view.substr(1 + 4, size));
+            uint32_t formatID = 0;
+            int64_t timestamp = 0;
+            uint8_t argCount = 0;
+            record.read(size);
+            record.read(formatID);
+            record.read(timestamp);
+            record.read(argCount);
+            consumed += 4 + size;
+
+            auto it = formats.find(formatID);
+            if (it != formats.end())
+            {
+                // log-level|timestamp|thread-name|message, like the default formatter
+                std::ostringstream line;
+                line << (boost::log::trivial::severity_level)it->second.level << "|"
+                     << boost::posix_time::to_iso_extended_string(toLocalTime(timestamp)) << "|"
+                     << threads[ringID] << "|";
+                if (formatMessage(line, it->second, record, argCount))
+                {
+                    output << line.str() << "\n";
+                    ++count;
+                }
+            }
+        }
+        else
+        {
+            break;
+        }
+        view.remove_prefix(consumed);
+    }
+    return count;
+}
@@ -0,0 +1,290 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: deferred-format logging for the hot paths
+ *
+ * @file: BinaryLog.h
+ */
+#pragma once
+
+#include "Log.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// the same line as BCOS_LOG(LEVEL) << LOG_BADGE(MODULE) << LOG_DESC(DESC) << LOG_KV(K1, V1) ...
+// written as BCOS_BINARY_LOG(LEVEL, MODULE, DESC, K1, V1, ...), DESC and the keys must outlive
+// the process (string literals); when MODULE is listed in log.binary_log_modules only the format
+// id and the raw values are copied into a per-thread ring buffer, the line is formatted by a
+// background thread, or offline by binary-log-decoder
+#define BCOS_BINARY_LOG(LEVEL, MODULE, ...)                                             \
+    do                                                                                  \
+    {                                                                                   \
+        if (bcos::LogLevel::LEVEL >= bcos::c_fileLogLevel)                              \
+        {                                                                               \
+            static bcos::BinaryLogger::Site binaryLogSite(bcos::LogLevel::LEVEL, MODULE); \
+            binaryLogSite.log(__VA_ARGS__);                                             \
+        }                                                                               \
+    } while (0)
+
+namespace bcos
+{
+class BinaryLogger
+{
+public:
+    enum class Mode
+    {
+        // formatted by the background thread and written through boost.log
+        TEXT,
+        // raw records appended to <path>/binary_log_<time>.blog
+        BINARY,
+    };
+    struct Config
+    {
+        Mode mode = Mode::TEXT;
+        std::string path;
+        std::vector<std::string> modules;
+        // bytes of the ring buffer of each thread, rounded up to a power of 2
+        size_t bufferSize = 1024 * 1024;
+    };
+
+    enum class ArgType : uint8_t
+    {
+        INT64 = 0,
+        UINT64 = 1,
+        DOUBLE = 2,
+        STRING = 3,
+    };
+    // a value ready for the ring buffer, the types without a raw encoding are formatted by
+    // operator<< into owned, so the decoded line is the same as the one of BCOS_LOG
+    struct Arg
+    {
+        ArgType type = ArgType::INT64;
+        union
+        {
+            int64_t i64;
+            uint64_t u64;
+            double f64;
+        };
+        std::string_view str;
+        std::string owned;
+    };
+
+    // the format of one call site, registered when it is first logged in binary
+    struct Format
+    {
+        LogLevel level = LogLevel::INFO;
+        std::string module;
+        std::string description;
+        std::vector<std::string> keys;
+    };
+
+    class Site
+    {
+    public:
+        Site(LogLevel level, char const* module);
+
+        template <class... KeyValues>
+        void log(char const* description, KeyValues const&... keyValues)
+        {
+            static_assert(sizeof...(KeyValues) % 2 == 0, "the keys and values must be paired");
+            auto pairs = std::forward_as_tuple(keyValues...);
+            constexpr auto indexes = std::make_index_sequence<sizeof...(KeyValues) / 2>();
+            if (!m_enabled.load(std::memory_order_relaxed))
+            {
+                BOOST_LOG_SEV(FileLoggerHandler, (boost::log::trivial::severity_level)(m_level))
+                    << LOG_BADGE(m_module) << LOG_DESC(description)
+                    << KeyValuePrinter<decltype(pairs)>{pairs};
+                return;
+            }
+
+            auto formatID = m_formatID.load(std::memory_order_acquire);
+            if (formatID == 0)
+            {
+                formatID = registerFormat(description, pairs, indexes);
+            }
+            std::array<Arg, sizeof...(KeyValues) / 2> args;
+            fillArgs(args, pairs, indexes);
+            instance().push(formatID, args.data(), args.size());
+        }
+
+    private:
+        template <class Tuple>
+        struct KeyValuePrinter
+        {
+            Tuple const& pairs;
+
+            template <size_t... I>
+            void print(std::ostream& stream, std::index_sequence<I...>) const
+            {
+                ((stream << LOG_KV(std::get<I * 2>(pairs), std::get<I * 2 + 1>(pairs))), ...);
+            }
+            friend std::ostream& operator<<(std::ostream& stream, KeyValuePrinter const& printer)
+            {
+                printer.print(
+                    stream, std::make_index_sequence<std::tuple_size_v<Tuple> / 2>());
+                return stream;
+            }
+        };
+
+        template <class Tuple, size_t... I>
+        uint32_t registerFormat(
+            char const* description, Tuple const& pairs, std::index_sequence<I...>)
+        {
+            Format format{.level = m_level,
+                .module = m_module,
+                .description = description,
+                .keys = {std::string(std::get<I * 2>(pairs))...}};
+            auto formatID = instance().registerFormat(std::move(format));
+            // a racing thread may register the site twice, both ids decode the same
+            m_formatID.store(formatID, std::memory_order_release);
+            return formatID;
+        }
+
+        template <class Args, class Tuple, size_t... I>
+        static void fillArgs(Args& args, Tuple const& pairs, std::index_sequence<I...>)
+        {
+            (toArg(args[I], std::get<I * 2 + 1>(pairs)), ...);
+        }
+
+        LogLevel m_level;
+        char const* m_module;
+        std::atomic_bool const& m_enabled;
+        std::atomic_uint32_t m_formatID{0};
+    };
+
+    template <class Value>
+    static void toArg(Arg& arg, Value const& value)
+    {
+        using Type = std::remove_cvref_t<Value>;
+        // bool and the char types are printed as text by ostream
+        if constexpr (std::is_integral_v<Type> && !std::is_same_v<Type, bool> &&
+                      sizeof(Type) > 1)
+        {
+            if constexpr (std::is_signed_v<Type>)
+            {
+                arg.type = ArgType::INT64;
+                arg.i64 = value;
+            }
+            else
+            {
+                arg.type = ArgType::UINT64;
+                arg.u64 = value;
+            }
+        }
+        else if constexpr (std::is_floating_point_v<Type>)
+        {
+            arg.type = ArgType::DOUBLE;
+            arg.f64 = value;
+        }
+        else if constexpr (std::is_convertible_v<Type const&, std::string_view>)
+        {
+            arg.type = ArgType::STRING;
+            arg.str = value;
+        }
+        else
+        {
+            std::ostringstream stream;
+            stream << value;
+            arg.type = ArgType::STRING;
+            arg.owned = stream.str();
+            arg.str = arg.owned;
+        }
+    }
+
+    static BinaryLogger& instance();
+
+    BinaryLogger(const BinaryLogger&) = delete;
+    BinaryLogger(BinaryLogger&&) = delete;
+    BinaryLogger& operator=(const BinaryLogger&) = delete;
+    BinaryLogger& operator=(BinaryLogger&&) = delete;
+    ~BinaryLogger() { stop(); }
+
+    void start(Config config);
+    // drains the ring buffers, the modules go back to BCOS_LOG
+    void stop();
+    bool running() const { return m_running; }
+
+    // the records dropped because the ring buffer of the logging thread was full
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    // decodes a file of the BINARY mode into text lines, returns the number of records
+    static size_t decode(std::istream& input, std::ostream& output);
+
+private:
+    BinaryLogger() = default;
+
+    // single producer single consumer, the logging thread moves head and the background thread
+    // moves tail
+    struct Ring
+    {
+        explicit Ring(size_t capacity);
+
+        std::unique_ptr<char[]> buffer;
+        size_t capacity;
+        std::atomic_uint64_t head{0};
+        std::atomic_uint64_t tail{0};
+        uint32_t id = 0;
+        std::string threadName;
+        std::atomic_bool closed{false};
+    };
+    struct RingHolder
+    {
+        ~RingHolder();
+        std::shared_ptr<Ring> ring;
+    };
+
+    std::atomic_bool const& moduleFlag(std::string_view module);
+    uint32_t registerFormat(Format format);
+    Format const* format(uint32_t formatID);
+    void push(uint32_t formatID, Arg const* args, size_t count);
+    Ring* localRing();
+    void run();
+    bool drain(Ring& ring);
+    void handle(Ring const& ring, std::string_view record);
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    Config m_config;
+    std::atomic_bool m_running{false};
+    std::atomic_uint64_t m_dropped{0};
+    std::thread m_thread;
+
+    // never erased, the sites keep references to the flags
+    std::map<std::string, std::unique_ptr<std::atomic_bool>, std::less<>> m_modules;
+    std::deque<Format> m_formats;
+    std::vector<std::shared_ptr<Ring>> m_rings;
+    uint32_t m_nextRingID = 0;
+
+    // BINARY mode, the formats and threads are defined once per file before their first record
+    std::ofstream m_file;
+    std::vector<bool> m_writtenFormats;
+    std::vector<bool> m_writtenRings;
+};
+
+}  // namespace bcos
@@ -19,11 +19,15 @@
  * @author: yujiechen
  */
 #include "BoostLogInitializer.h"
+#include "BinaryLog.h"
 #include "BoostLogThreadNameAttribute.h"
 #include "bcos-framework/bcos-framework/Common.h"
 #include "bcos-utilities/BoostLog.h"
 #include <bcos-framework/bcos-framework/protocol/GlobalConfig.h>
 #include <bcos-utilities/RateCollector.h>
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
 #include <boost/core/null_deleter.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/log/core/core.hpp>
@@ -226,6 +230,11 @@ void BoostLogInitializer::initLog(boost::property_tree::ptree const& _pt,
     setFileLogLevel((LogLevel)m_logLevel);
     boost::log::core::get()->add_global_attribute("ThreadName", bcos::log::thread_name());
 
+    if (_logger == bcos::FileLogger)
+    {
+        initBinaryLog(_pt);
+    }
+
     auto enableRateCollector = _pt.get<bool>("log.enable_rate_collector", false);
     if (enableRateCollector)
     {
@@ -237,6 +246,34 @@ void BoostLogInitializer::initLog(boost::property_tree::ptree const& _pt,
     }
 }
 
+// the modules logged by BCOS_BINARY_LOG in the deferred-format mode, e.g.
+// binary_log_modules=TXPOOL,LEDGER,CONSENSUS
+void BoostLogInitializer::initBinaryLog(boost::property_tree::ptree const& _pt)
+{
+    auto modulesStr = _pt.get<std::string>("log.binary_log_modules", "");
+    std::vector<std::string> modules;
+    boost::split(modules, modulesStr, boost::is_any_of(","));
+    for (auto& module : modules)
+    {
+        boost::trim(module);
+    }
+    std::erase(modules, "");
+    if (modules.empty())
+    {
+        return;
+    }
+    BinaryLogger::Config config;
+    config.modules = std::move(modules);
+    // text: formatted by a background thread into the log file
+    // binary: raw records in <log_path>/binary_log_*.blog, decoded by binary-log-decoder
+    auto mode = _pt.get<std::string>("log.binary_log_mode", "text");
+    config.mode = (mode == "binary") ? BinaryLogger::Mode::BINARY : BinaryLogger::Mode::TEXT;
+    config.path = m_logPath.empty() ? _pt.get<std::string>("log.log_path", "log") : m_logPath;
+    // KB per thread
+    config.bufferSize = _pt.get<size_t>("log.binary_log_buffer_size", 1024) * 1024;
+    BinaryLogger::instance().start(std::move(config));
+}
+
 // rotate the log file the log every hour
 boost::shared_ptr<bcos::BoostLogInitializer::sink_t> BoostLogInitializer::initHourLogSink(
     std::string const& _logPath, std::string const& _logPrefix, std::string const& channel)
@@ -350,6 +387,8 @@ void BoostLogInitializer::stopLogging()
         return;
     }
     m_running.store(false);
+    // flush the deferred records before the sinks go away
+    BinaryLogger::instance().stop();
     for (auto const& sink : m_sinks)
     {
         stopLogging(sink);
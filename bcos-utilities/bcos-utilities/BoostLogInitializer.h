@@ -76,6 +76,7 @@ private:
     void initStatLog(const std::string& _configFile,
         std::string const& _logger = bcos::StatFileLogger, std::string const& _logPrefix = "stat");
     bool canRotate(size_t const& _index);
+    void initBinaryLog(boost::property_tree::ptree const& _pt);
 
     boost::shared_ptr<sink_t> initLogSink(std::string const& _logPath, std::string const& channel);
 
@@ -0,0 +1,207 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: process wide counters, gauges and histograms, exported in the prometheus text format
+ *
+ * @file: Metrics.cpp
+ */
+#include "Metrics.h"
+#include "Exceptions.h"
+#include <cmath>
+#include <sstream>
+
+using namespace bcos;
+using namespace bcos::metrics;
+
+namespace
+{
+// key="value",... without the braces, so the quantile label can be appended
+std::string labelsBody(Labels const& labels)
+{
+    std::string body;
+    for (auto const& [key, value] : labels)
+    {
+        if (!body.empty())
+        {
+            body += ',';
+        }
+        body += key;
+        body += "=\"";
+        for (auto c : value)
+        {
+            switch (c)
+            {
+            case '\\':
+                body += "\\\\";
+                break;
+            case '"':
+                body += "\\\"";
+                break;
+            case '\n':
+                body += "\\n";
+                break;
+            default:
+                body += c;
+            }
+        }
+        body += '"';
+    }
+    return body;
+}
+
+void writeSeries(std::ostream& output, std::string_view name, std::string_view labels)
+{
+    output << name;
+    if (!labels.empty())
+    {
+        output << '{' << labels << '}';
+    }
+    output << ' ';
+}
+
+template <class Metric>
+Metric& findOrInsert(
+    std::map<std::string, std::unique_ptr<Metric>>& metrics, std::string labels)
+{
+    auto& metric = metrics[std::move(labels)];
+    if (!metric)
+    {
+        metric = std::make_unique<Metric>();
+    }
+    return *metric;
+}
+}  // namespace
+
+uint64_t Histogram::quantile(double quantile) const
+{
+    auto total = count();
+    if (total == 0)
+    {
+        return 0;
+    }
+    auto rank = std::max<uint64_t>(1, (uint64_t)std::ceil(quantile * (double)total));
+    uint64_t seen = 0;
+    for (size_t index = 0; index < BUCKET_COUNT; ++index)
+    {
+        seen += m_buckets[index].load(std::memory_order_relaxed);
+        if (seen >= rank)
+        {
+            return bucketUpperBound(index);
+        }
+    }
+    // count is updated after the buckets, a racing observe may leave the buckets short
+    for (size_t index = BUCKET_COUNT; index > 0; --index)
+    {
+        if (m_buckets[index - 1].load(std::memory_order_relaxed) > 0)
+        {
+            return bucketUpperBound(index - 1);
+        }
+    }
+    return 0;
+}
+
+Registry& Registry::instance()
+{
+    static Registry registry;
+    return registry;
+}
+
+Registry::Family& Registry::family(std::string const& name, std::string const& help, Type type)
+{
+    auto [it, inserted] = m_families.try_emplace(name);
+    if (inserted)
+    {
+        it->second.type = type;
+        it->second.help = help;
+    }
+    else if (it->second.type != type)
+    {
+        BOOST_THROW_EXCEPTION(InvalidParameter("metric " + name + " registered as another type"));
+    }
+    return it->second;
+}
+
+Counter& Registry::counter(std::string const& name, std::string const& help, Labels const& labels)
+{
+    std::unique_lock lock(m_mutex);
+    return findOrInsert(family(name, help, Type::COUNTER).counters, labelsBody(labels));
+}
+
+Gauge& Registry::gauge(std::string const& name, std::string const& help, Labels const& labels)
+{
+    std::unique_lock lock(m_mutex);
+    return findOrInsert(family(name, help, Type::GAUGE).gauges, labelsBody(labels));
+}
+
+Histogram& Registry::histogram(
+    std::string const& name, std::string const& help, Labels const& labels)
+{
+    std::unique_lock lock(m_mutex);
+    return findOrInsert(family(name, help, Type::SUMMARY).histograms, labelsBody(labels));
+}
+
+std::string Registry::exportPrometheus() const
+{
+    constexpr static std::array<std::pair<double, std::string_view>, 4> quantiles{
+        {{0.5, "0.5"}, {0.9, "0.9"}, {0.99, "0.99"}, {0.999, "0.999"}}};
+
+    std::ostringstream output;
+    std::unique_lock lock(m_mutex);
+    for (auto const& [name, family] : m_families)
+    {
+        output << "# HELP " << name << ' ' << family.help << '\n';
+        switch (family.type)
+        {
+        case Type::COUNTER:
+            output << "# TYPE " << name << " counter\n";
+            for (auto const& [labels, counter] : family.counters)
+            {
+                writeSeries(output, name, labels);
+                output << counter->value() << '\n';
+            }
+            break;
+        case Type::GAUGE:
+            output << "# TYPE " << name << " gauge\n";
+            for (auto const& [labels, gauge] : family.gauges)
+            {
+                writeSeries(output, name, labels);
+                output << gauge->value() << '\n';
+            }
+            break;
+        case Type::SUMMARY:
+            output << "# TYPE " << name << " summary\n";
+            for (auto const& [labels, histogram] : family.histograms)
+            {
+                for (auto const& [quantile, text] : quantiles)
+                {
+                    auto quantileLabels = std::string(labels);
+                    if (!quantileLabels.empty())
+                    {
+                        quantileLabels += ',';
+                    }
+                    quantileLabels.append("quantile=\"").append(text).append("\"");
+                    writeSeries(output, name, quantileLabels);
+                    output << histogram->quantile(quantile) << '\n';
+                }
+                writeSeries(output, name + "_sum", labels);
+                output << histogram->sum() << '\n';
+                writeSeries(output, name + "_count", labels);
+                output << histogram->count() << '\n';
+            }
+            break;
+        }
+    }
+    return output.str();
+}
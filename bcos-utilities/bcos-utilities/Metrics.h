@@ -0,0 +1,179 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: process wide counters, gauges and histograms, exported in the prometheus text format
+ *
+ * @file: Metrics.h
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bcos::metrics
+{
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+class Counter
+{
+public:
+    void inc(uint64_t value = 1) { m_value.fetch_add(value, std::memory_order_relaxed); }
+    uint64_t value() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic_uint64_t m_value{0};
+};
+
+class Gauge
+{
+public:
+    void set(int64_t value) { m_value.store(value, std::memory_order_relaxed); }
+    void add(int64_t value) { m_value.fetch_add(value, std::memory_order_relaxed); }
+    int64_t value() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic_int64_t m_value{0};
+};
+
+/**
+ * log-linear buckets in the way of HdrHistogram, the values below 2^SUB_BUCKET_BITS have a bucket
+ * each, every power of 2 above is split into 2^SUB_BUCKET_BITS buckets, so a quantile is off by
+ * at most 1/2^SUB_BUCKET_BITS of its value whatever the range
+ */
+class Histogram
+{
+public:
+    constexpr static size_t SUB_BUCKET_BITS = 4;
+    constexpr static size_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    constexpr static size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    void observe(uint64_t value)
+    {
+        m_buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(value, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t count() const { return m_count.load(std::memory_order_relaxed); }
+    uint64_t sum() const { return m_sum.load(std::memory_order_relaxed); }
+    // the highest value of the bucket holding the quantile, 0 if empty
+    uint64_t quantile(double quantile) const;
+
+    constexpr static size_t bucketIndex(uint64_t value)
+    {
+        if (value < SUB_BUCKET_COUNT)
+        {
+            return value;
+        }
+        auto shift = std::bit_width(value) - 1 - SUB_BUCKET_BITS;
+        return (shift + 1) * SUB_BUCKET_COUNT + ((value >> shift) - SUB_BUCKET_COUNT);
+    }
+    constexpr static uint64_t bucketUpperBound(size_t index)
+    {
+        if (index < SUB_BUCKET_COUNT)
+        {
+            return index;
+        }
+        auto shift = index / SUB_BUCKET_COUNT - 1;
+        auto lower = (uint64_t)(index % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT) << shift;
+        return lower + (((uint64_t)1 << shift) - 1);
+    }
+
+private:
+    std::array<std::atomic_uint64_t, BUCKET_COUNT> m_buckets{};
+    std::atomic_uint64_t m_sum{0};
+    std::atomic_uint64_t m_count{0};
+};
+
+// observes the microseconds between construction and destruction
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(Histogram& histogram)
+      : m_histogram(histogram), m_start(std::chrono::steady_clock::now())
+    {}
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer(ScopedTimer&&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(ScopedTimer&&) = delete;
+    ~ScopedTimer()
+    {
+        m_histogram.observe(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - m_start)
+                                .count());
+    }
+
+private:
+    Histogram& m_histogram;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/**
+ * the metrics are registered once, usually into a static reference at the call site, and never
+ * removed, so the returned references stay valid and the updates never take a lock; the same
+ * name and labels return the same metric
+ */
+class Registry
+{
+public:
+    static Registry& instance();
+
+    Registry() = default;
+    Registry(const Registry&) = delete;
+    Registry(Registry&&) = delete;
+    Registry& operator=(const Registry&) = delete;
+    Registry& operator=(Registry&&) = delete;
+    ~Registry() = default;
+
+    Counter& counter(std::string const& name, std::string const& help, Labels const& labels = {});
+    Gauge& gauge(std::string const& name, std::string const& help, Labels const& labels = {});
+    // exported as a summary of the quantiles 0.5, 0.9, 0.99 and 0.999
+    Histogram& histogram(
+        std::string const& name, std::string const& help, Labels const& labels = {});
+
+    // text exposition format 0.0.4
+    std::string exportPrometheus() const;
+
+private:
+    enum class Type
+    {
+        COUNTER,
+        GAUGE,
+        SUMMARY,
+    };
+    struct Family
+    {
+        Type type;
+        std::string help;
+        std::map<std::string, std::unique_ptr<Counter>> counters;
+        std::map<std::string, std::unique_ptr<Gauge>> gauges;
+        std::map<std::string, std::unique_ptr<Histogram>> histograms;
+    };
+
+    Family& family(std::string const& name, std::string const& help, Type type);
+
+    mutable std::mutex m_mutex;
+    std::map<std::string, Family> m_families;
+};
+}  // namespace bcos::metrics
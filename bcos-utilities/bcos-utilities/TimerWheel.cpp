@@ -0,0 +1,162 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file TimerWheel.cpp
+ */
+#include "TimerWheel.h"
+#include "Common.h"
+#include "Log.h"
+#include <boost/exception/diagnostic_information.hpp>
+
+using namespace bcos;
+
+TimerWheel::TimerWheel(std::string threadName, std::chrono::milliseconds tick, size_t slotCount)
+  : m_threadName(std::move(threadName)),
+    m_tick(std::max(tick, std::chrono::milliseconds(1))),
+    m_slots(std::max<size_t>(slotCount, 1))
+{
+    m_thread = std::thread([this] { run(); });
+}
+
+TimerWheel::Handle TimerWheel::add(std::chrono::milliseconds timeout, Task task)
+{
+    auto ticks = std::max<uint64_t>(
+        1, (uint64_t)((timeout.count() + m_tick.count() - 1) / m_tick.count()));
+    auto id = m_nextID.fetch_add(1, std::memory_order_relaxed);
+    while (true)
+    {
+        auto current = m_currentTick.load(std::memory_order_acquire);
+        auto slotIndex = (current + ticks) % m_slots.size();
+        auto& slot = m_slots[slotIndex];
+        std::unique_lock lock(slot.mutex);
+        // the wheel moved on while locking, the slot may have been passed
+        if (m_currentTick.load(std::memory_order_acquire) != current)
+        {
+            continue;
+        }
+        slot.entries.emplace(
+            id, Entry{.rounds = (ticks - 1) / m_slots.size(), .task = std::move(task)});
+        m_size.fetch_add(1, std::memory_order_relaxed);
+        return Handle{.id = id, .slot = slotIndex};
+    }
+}
+
+bool TimerWheel::cancel(Handle handle)
+{
+    if (handle.id == 0 || handle.slot >= m_slots.size())
+    {
+        return false;
+    }
+    auto& slot = m_slots[handle.slot];
+    std::unique_lock lock(slot.mutex);
+    if (slot.entries.erase(handle.id) == 0)
+    {
+        return false;
+    }
+    m_size.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+void TimerWheel::stop()
+{
+    {
+        std::unique_lock lock(m_stopMutex);
+        if (m_stopped)
+        {
+            return;
+        }
+        m_stopped = true;
+    }
+    m_stopCondition.notify_all();
+    if (m_thread.joinable())
+    {
+        if (m_thread.get_id() == std::this_thread::get_id())
+        {
+            // stopped by one of its tasks
+            m_thread.detach();
+        }
+        else
+        {
+            m_thread.join();
+        }
+    }
+    for (auto& slot : m_slots)
+    {
+        std::unique_lock lock(slot.mutex);
+        m_size.fetch_sub(slot.entries.size(), std::memory_order_relaxed);
+        slot.entries.clear();
+    }
+}
+
+void TimerWheel::run()
+{
+    bcos::pthread_setThreadName(m_threadName);
+    auto start = std::chrono::steady_clock::now();
+    uint64_t tick = 0;
+    std::unique_lock lock(m_stopMutex);
+    while (!m_stopped)
+    {
+        if (m_stopCondition.wait_until(
+                lock, start + m_tick * (tick + 1), [this]() { return m_stopped; }))
+        {
+            break;
+        }
+        lock.unlock();
+        // catch up the ticks missed by a late wakeup or slow tasks
+        auto now = std::chrono::steady_clock::now();
+        while (start + m_tick * (tick + 1) <= now)
+        {
+            ++tick;
+            m_currentTick.store(tick, std::memory_order_release);
+            expire(tick);
+        }
+        lock.lock();
+    }
+}
+
+void TimerWheel::expire(uint64_t tick)
+{
+    std::vector<Task> tasks;
+    {
+        auto& slot = m_slots[tick % m_slots.size()];
+        std::unique_lock lock(slot.mutex);
+        for (auto it = slot.entries.begin(); it != slot.entries.end();)
+        {
+            if (it->second.rounds > 0)
+            {
+                --it->second.rounds;
+                ++it;
+                continue;
+            }
+            tasks.emplace_back(std::move(it->second.task));
+            it = slot.entries.erase(it);
+        }
+    }
+    m_size.fetch_sub(tasks.size(), std::memory_order_relaxed);
+
+    for (auto& task : tasks)
+    {
+        try
+        {
+            task();
+        }
+        catch (std::exception const& e)
+        {
+            BCOS_LOG(WARNING) << LOG_BADGE("TimerWheel") << LOG_DESC("task exception")
+                              << LOG_KV("name", m_threadName)
+                              << LOG_KV("message", boost::diagnostic_information(e));
+        }
+    }
+}
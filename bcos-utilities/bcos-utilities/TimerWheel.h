@@ -0,0 +1,102 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: hashed timer wheel for a large number of short timeouts that are mostly cancelled
+ *
+ * @file TimerWheel.h
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos
+{
+/**
+ * one thread advances the wheel every tick and runs the tasks of the slot it reaches, a task
+ * whose timeout is longer than a turn waits for its remaining rounds; adding and cancelling only
+ * lock the target slot, so unlike one asio timer per timeout nothing is allocated in the reactor
+ * and a cancel is a hash erase; the tasks run on the wheel thread and should only dispatch
+ */
+class TimerWheel
+{
+public:
+    using Ptr = std::shared_ptr<TimerWheel>;
+    using Task = std::function<void()>;
+
+    struct Handle
+    {
+        // 0 for no timer
+        uint64_t id = 0;
+        size_t slot = 0;
+    };
+
+    explicit TimerWheel(std::string threadName,
+        std::chrono::milliseconds tick = std::chrono::milliseconds(10), size_t slotCount = 512);
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel(TimerWheel&&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+    TimerWheel& operator=(TimerWheel&&) = delete;
+    ~TimerWheel() { stop(); }
+
+    // run task after timeout, rounded up to the tick
+    Handle add(std::chrono::milliseconds timeout, Task task);
+    // true if the task is removed before it runs
+    bool cancel(Handle handle);
+    // the tasks not run yet are dropped
+    void stop();
+
+    // the tasks waiting in the wheel
+    size_t size() const { return m_size.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry
+    {
+        // the turns to wait when the slot is reached
+        uint64_t rounds;
+        Task task;
+    };
+    struct Slot
+    {
+        std::mutex mutex;
+        std::unordered_map<uint64_t, Entry> entries;
+    };
+
+    void run();
+    void expire(uint64_t tick);
+
+    std::string m_threadName;
+    std::chrono::milliseconds m_tick;
+    std::vector<Slot> m_slots;
+    // the last tick the wheel reached
+    std::atomic_uint64_t m_currentTick{0};
+    std::atomic_uint64_t m_nextID{1};
+    std::atomic_size_t m_size{0};
+
+    std::mutex m_stopMutex;
+    std::condition_variable m_stopCondition;
+    bool m_stopped = false;
+    std::thread m_thread;
+};
+
+}  // namespace bcos
@@ -0,0 +1,289 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file WorkStealingThreadPool.cpp
+ */
+#include "WorkStealingThreadPool.h"
+#include "Log.h"
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/lexical_cast.hpp>
+#include <fstream>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace bcos;
+
+namespace
+{
+// the pool and the worker index of the current thread, tasks enqueued by a worker stay local
+thread_local WorkStealingThreadPool const* t_currentPool = nullptr;
+thread_local size_t t_currentWorker = 0;
+}  // namespace
+
+WorkStealingThreadPool::WorkStealingThreadPool(std::string threadName, size_t size, bool)
+  : WorkStealingThreadPool(std::move(threadName), size, Options{})
+{}
+
+WorkStealingThreadPool::WorkStealingThreadPool(
+    std::string threadName, size_t size, Options options)
+  : m_threadName(std::move(threadName)), m_options(std::move(options))
+{
+    size = std::max<size_t>(size, 1);
+    m_workers.reserve(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        m_workers.emplace_back(std::make_unique<Worker>());
+    }
+    // start after all workers exist, a worker steals from the others right away
+    for (size_t i = 0; i < size; ++i)
+    {
+        m_workers[i]->thread = std::thread([this, i] { run(i); });
+    }
+}
+
+void WorkStealingThreadPool::stop()
+{
+    {
+        std::unique_lock lock(m_sleepMutex);
+        if (m_stopped.exchange(true))
+        {
+            return;
+        }
+    }
+    m_sleepCondition.notify_all();
+
+    auto currentThread = std::this_thread::get_id();
+    for (auto& worker : m_workers)
+    {
+        if (worker->thread.get_id() == currentThread)
+        {
+            // stopped by one of its own tasks, the thread exits after the task
+            worker->thread.detach();
+        }
+        else if (worker->thread.joinable())
+        {
+            worker->thread.join();
+        }
+    }
+}
+
+void WorkStealingThreadPool::push(std::unique_ptr<Task> task, Priority priority)
+{
+    if (m_stopped)
+    {
+        return;
+    }
+    task->enqueueTime = std::chrono::steady_clock::now();
+    // counted before it is visible, so that a worker never takes an uncounted task; pairs with the
+    // sleeping check in run(), either the worker sees the task or we see the worker asleep
+    m_pending.fetch_add(1);
+    auto index = (t_currentPool == this) ?
+                     t_currentWorker :
+                     m_nextWorker.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+    {
+        auto& worker = *m_workers[index];
+        std::unique_lock lock(worker.mutex);
+        worker.lanes[static_cast<size_t>(priority)].push_back(std::move(task));
+    }
+
+    if (m_sleeping.load() > 0)
+    {
+        {
+            std::unique_lock lock(m_sleepMutex);
+        }
+        m_sleepCondition.notify_one();
+    }
+}
+
+std::unique_ptr<WorkStealingThreadPool::Task> WorkStealingThreadPool::pop(
+    size_t index, bool blocking)
+{
+    for (size_t lane = 0; lane < PRIORITY_COUNT; ++lane)
+    {
+        {
+            auto& worker = *m_workers[index];
+            std::unique_lock lock(worker.mutex);
+            auto& tasks = worker.lanes[lane];
+            if (!tasks.empty())
+            {
+                auto task = std::move(tasks.front());
+                tasks.pop_front();
+                return task;
+            }
+        }
+        for (size_t i = 1; i < m_workers.size(); ++i)
+        {
+            auto& victim = *m_workers[(index + i) % m_workers.size()];
+            std::unique_lock lock(victim.mutex, std::defer_lock);
+            if (blocking)
+            {
+                lock.lock();
+            }
+            else if (!lock.try_lock())
+            {
+                continue;
+            }
+            auto& tasks = victim.lanes[lane];
+            if (!tasks.empty())
+            {
+                auto task = std::move(tasks.back());
+                tasks.pop_back();
+                m_stolen.fetch_add(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void WorkStealingThreadPool::run(size_t index)
+{
+    bcos::pthread_setThreadName(m_threadName);
+    pin(index);
+    t_currentPool = this;
+    t_currentWorker = index;
+
+    while (!m_stopped)
+    {
+        auto task = pop(index, false);
+        if (!task && m_pending.load() > 0)
+        {
+            // the steal skips the deques locked by others, one of them may hold the pending task
+            task = pop(index, true);
+        }
+        if (!task)
+        {
+            std::unique_lock lock(m_sleepMutex);
+            m_sleeping.fetch_add(1);
+            if (m_pending.load() > 0)
+            {
+                // counted but not pushed yet, or popped by another worker that has not uncounted
+                // it yet; the push may have missed this worker going to sleep, so do not wait
+                // for a notify, and do not spin either
+                m_sleepCondition.wait_for(lock, c_retryInterval);
+            }
+            else
+            {
+                m_sleepCondition.wait(
+                    lock, [this]() { return m_pending.load() > 0 || m_stopped; });
+            }
+            m_sleeping.fetch_sub(1);
+            continue;
+        }
+        m_pending.fetch_sub(1);
+
+        auto wait = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - task->enqueueTime)
+                        .count();
+        m_totalWait.fetch_add(wait, std::memory_order_relaxed);
+        auto maxWait = m_maxWait.load(std::memory_order_relaxed);
+        while (wait > maxWait &&
+               !m_maxWait.compare_exchange_weak(maxWait, wait, std::memory_order_relaxed))
+        {
+        }
+
+        try
+        {
+            task->run();
+        }
+        catch (std::exception const& e)
+        {
+            BCOS_LOG(WARNING) << LOG_BADGE("WorkStealingThreadPool")
+                              << LOG_DESC("task exception") << LOG_KV("name", m_threadName)
+                              << LOG_KV("message", boost::diagnostic_information(e));
+        }
+        m_executed.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void WorkStealingThreadPool::pin(size_t index) const
+{
+    if (m_options.cpus.empty())
+    {
+        return;
+    }
+#if defined(__linux__)
+    auto cpu = m_options.cpus[index % m_options.cpus.size()];
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    if (auto ret = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet); ret != 0)
+    {
+        BCOS_LOG(WARNING) << LOG_BADGE("WorkStealingThreadPool") << LOG_DESC("pin worker failed")
+                          << LOG_KV("name", m_threadName) << LOG_KV("cpu", cpu)
+                          << LOG_KV("code", ret);
+    }
+#endif
+}
+
+WorkStealingThreadPool::Statistics WorkStealingThreadPool::statistics() const
+{
+    Statistics statistics;
+    statistics.pending = m_pending.load(std::memory_order_relaxed);
+    statistics.executed = m_executed.load(std::memory_order_relaxed);
+    statistics.stolen = m_stolen.load(std::memory_order_relaxed);
+    statistics.totalWait =
+        std::chrono::nanoseconds(m_totalWait.load(std::memory_order_relaxed));
+    statistics.maxWait = std::chrono::nanoseconds(m_maxWait.load(std::memory_order_relaxed));
+    return statistics;
+}
+
+std::vector<int> WorkStealingThreadPool::numaNodeCPUs(int node)
+{
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::string cpuList;
+    if (!file || !std::getline(file, cpuList))
+    {
+        return {};
+    }
+    return parseCPUList(cpuList);
+}
+
+std::vector<int> WorkStealingThreadPool::parseCPUList(std::string_view cpuList)
+{
+    std::vector<int> cpus;
+    std::vector<std::string> ranges;
+    boost::split(ranges, cpuList, boost::is_any_of(","));
+    try
+    {
+        for (auto& range : ranges)
+        {
+            boost::trim(range);
+            if (range.empty())
+            {
+                continue;
+            }
+            auto pos = range.find('-');
+            auto first = boost::lexical_cast<int>(range.substr(0, pos));
+            auto last =
+                pos == std::string::npos ? first : boost::lexical_cast<int>(range.substr(pos + 1));
+            for (auto cpu = first; cpu <= last; ++cpu)
+            {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+    catch (boost::bad_lexical_cast const&)
+    {
+        return {};
+    }
+    return cpus;
+}
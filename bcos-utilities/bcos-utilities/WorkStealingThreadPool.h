@@ -0,0 +1,160 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief: work stealing threadpool, a drop-in replacement of ThreadPool
+ *
+ * @file WorkStealingThreadPool.h
+ */
+
+#pragma once
+#include "Common.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bcos
+{
+/**
+ * every worker owns one deque per priority lane, the tasks enqueued by a worker go to its own
+ * deque and the others are spread round-robin, an idle worker takes the front of its own deque
+ * and steals from the back of the others, the high lane of all workers is drained before the
+ * normal one
+ */
+class WorkStealingThreadPool
+{
+public:
+    using Ptr = std::shared_ptr<WorkStealingThreadPool>;
+
+    enum class Priority : uint8_t
+    {
+        HIGH = 0,
+        NORMAL = 1,
+    };
+    constexpr static size_t PRIORITY_COUNT = 2;
+
+    struct Options
+    {
+        // pin worker i to cpus[i % cpus.size()], no pinning if empty
+        std::vector<int> cpus;
+    };
+
+    struct Statistics
+    {
+        // tasks enqueued but not started
+        size_t pending = 0;
+        size_t executed = 0;
+        size_t stolen = 0;
+        // time between enqueue and start, of the executed tasks
+        std::chrono::nanoseconds totalWait{0};
+        std::chrono::nanoseconds maxWait{0};
+    };
+
+    WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+    WorkStealingThreadPool(WorkStealingThreadPool&&) = delete;
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+    WorkStealingThreadPool& operator=(WorkStealingThreadPool&&) = delete;
+
+    // same as ThreadPool, dispatch is unused and only kept for the drop-in
+    explicit WorkStealingThreadPool(std::string threadName, size_t size, bool dispatch = true);
+    WorkStealingThreadPool(std::string threadName, size_t size, Options options);
+    ~WorkStealingThreadPool() { stop(); }
+
+    // the tasks not started yet are dropped, like ThreadPool
+    void stop();
+    bool hasStopped() const { return m_stopped; }
+
+    // Add new work item to the pool.
+    template <class F>
+    void enqueue(F f)
+    {
+        enqueue(std::move(f), Priority::NORMAL);
+    }
+
+    template <class F>
+    void enqueue(F f, Priority priority)
+    {
+        push(std::make_unique<TaskImpl<F>>(std::move(f)), priority);
+    }
+
+    size_t size() const { return m_workers.size(); }
+    Statistics statistics() const;
+
+    // the cpus of a numa node listed by /sys/devices/system/node, empty if unavailable
+    static std::vector<int> numaNodeCPUs(int node);
+    // parse a kernel cpu list like "0-3,8,10-11"
+    static std::vector<int> parseCPUList(std::string_view cpuList);
+
+private:
+    struct Task
+    {
+        Task() = default;
+        Task(const Task&) = delete;
+        Task(Task&&) = delete;
+        Task& operator=(const Task&) = delete;
+        Task& operator=(Task&&) = delete;
+        virtual ~Task() = default;
+        virtual void run() = 0;
+
+        std::chrono::steady_clock::time_point enqueueTime;
+    };
+
+    template <class F>
+    struct TaskImpl : public Task
+    {
+        explicit TaskImpl(F&& f) : m_f(std::move(f)) {}
+        void run() override { m_f(); }
+        F m_f;
+    };
+
+    struct Worker
+    {
+        std::mutex mutex;
+        std::array<std::deque<std::unique_ptr<Task>>, PRIORITY_COUNT> lanes;
+        std::thread thread;
+    };
+
+    void push(std::unique_ptr<Task> task, Priority priority);
+    // without blocking, the deques of the other workers are only stolen from if not locked
+    std::unique_ptr<Task> pop(size_t index, bool blocking);
+    void run(size_t index);
+    void pin(size_t index) const;
+
+    // how long an idle worker waits before looking again for a task that is counted but not found
+    constexpr static std::chrono::microseconds c_retryInterval{200};
+
+    std::string m_threadName;
+    Options m_options;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic_size_t m_nextWorker{0};
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCondition;
+    std::atomic_size_t m_sleeping{0};
+    std::atomic_size_t m_pending{0};
+    std::atomic_bool m_stopped{false};
+
+    std::atomic_size_t m_executed{0};
+    std::atomic_size_t m_stolen{0};
+    std::atomic_int64_t m_totalWait{0};
+    std::atomic_int64_t m_maxWait{0};
+};
+
+}  // namespace bcos
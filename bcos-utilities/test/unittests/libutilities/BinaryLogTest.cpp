@@ -0,0 +1,110 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file BinaryLogTest.cpp
+ */
+
+#include "bcos-utilities/BinaryLog.h"
+#include "bcos-utilities/testutils/TestPromptFixture.h"
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+
+using namespace bcos;
+
+namespace bcos::test
+{
+struct BinaryLogFixture
+{
+    BinaryLogFixture()
+      : path((boost::filesystem::temp_directory_path() /
+              boost::filesystem::unique_path("binary-log-%%%%-%%%%"))
+                 .string())
+    {}
+    ~BinaryLogFixture()
+    {
+        BinaryLogger::instance().stop();
+        boost::filesystem::remove_all(path);
+    }
+
+    std::string decode()
+    {
+        std::stringstream output;
+        for (auto const& entry : boost::filesystem::directory_iterator(path))
+        {
+            std::ifstream input(entry.path().string(), std::ios::binary);
+            BinaryLogger::decode(input, output);
+        }
+        return output.str();
+    }
+
+    std::string path;
+};
+
+BOOST_FIXTURE_TEST_SUITE(BinaryLogTest, BinaryLogFixture)
+
+BOOST_AUTO_TEST_CASE(binaryMode)
+{
+    BinaryLogger::Config config;
+    config.mode = BinaryLogger::Mode::BINARY;
+    config.path = path;
+    config.modules = {"BINARY_TEST"};
+    BinaryLogger::instance().start(config);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([i]() {
+            bcos::pthread_setThreadName("logger" + std::to_string(i));
+            for (int j = 0; j < 100; ++j)
+            {
+                BCOS_BINARY_LOG(INFO, "BINARY_TEST", "binaryMode", "thread", i, "index",
+                    (uint64_t)j, "name", std::string("value"), "ratio", 0.5, "flag", true);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    // not listed, formatted in place
+    BCOS_BINARY_LOG(INFO, "PLAIN_TEST", "plain", "key", 1);
+    BinaryLogger::instance().stop();
+
+    auto lines = decode();
+    BOOST_CHECK_EQUAL(std::count(lines.begin(), lines.end(), '\n') +
+                          (int64_t)BinaryLogger::instance().dropped(),
+        400);
+    BOOST_CHECK(lines.find("|logger2|[BINARY_TEST]binaryMode,thread=2,index=99,name=value,"
+                           "ratio=0.5,flag=1") != std::string::npos);
+    BOOST_CHECK(lines.starts_with("info|"));
+    BOOST_CHECK(lines.find("plain") == std::string::npos);
+
+    // stopped, back to BCOS_LOG
+    BCOS_BINARY_LOG(INFO, "BINARY_TEST", "binaryMode", "thread", 5);
+    BOOST_CHECK(decode() == lines);
+}
+
+BOOST_AUTO_TEST_CASE(decodeTruncated)
+{
+    std::stringstream input("BCOSBLG1F\x01");
+    std::stringstream output;
+    BOOST_CHECK_EQUAL(BinaryLogger::decode(input, output), 0);
+    std::stringstream invalid("not a binary log");
+    BOOST_CHECK_EQUAL(BinaryLogger::decode(invalid, output), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
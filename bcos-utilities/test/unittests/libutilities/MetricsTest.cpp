@@ -0,0 +1,108 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file MetricsTest.cpp
+ */
+
+#include "bcos-utilities/Exceptions.h"
+#include "bcos-utilities/Metrics.h"
+#include "bcos-utilities/testutils/TestPromptFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::metrics;
+
+namespace bcos::test
+{
+BOOST_FIXTURE_TEST_SUITE(MetricsTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(histogramBuckets)
+{
+    for (uint64_t value : {0UL, 1UL, 15UL, 16UL, 17UL, 31UL, 32UL, 1000UL, 123456789UL,
+             std::numeric_limits<uint64_t>::max()})
+    {
+        auto index = Histogram::bucketIndex(value);
+        BOOST_CHECK_LT(index, Histogram::BUCKET_COUNT);
+        BOOST_CHECK_GE(Histogram::bucketUpperBound(index), value);
+        // relative error bounded by the sub buckets
+        BOOST_CHECK_LE(Histogram::bucketUpperBound(index) - value,
+            value / Histogram::SUB_BUCKET_COUNT);
+        if (index > 0)
+        {
+            BOOST_CHECK_LT(Histogram::bucketUpperBound(index - 1), value);
+        }
+    }
+
+    Histogram histogram;
+    BOOST_CHECK_EQUAL(histogram.quantile(0.5), 0);
+    for (uint64_t i = 1; i <= 1000; ++i)
+    {
+        histogram.observe(i);
+    }
+    BOOST_CHECK_EQUAL(histogram.count(), 1000);
+    BOOST_CHECK_EQUAL(histogram.sum(), 500500);
+    BOOST_CHECK_GE(histogram.quantile(0.5), 500);
+    BOOST_CHECK_LE(histogram.quantile(0.5), 500 + 500 / Histogram::SUB_BUCKET_COUNT);
+    BOOST_CHECK_GE(histogram.quantile(0.99), 990);
+    BOOST_CHECK_EQUAL(histogram.quantile(1), Histogram::bucketUpperBound(
+                                                  Histogram::bucketIndex(1000)));
+}
+
+BOOST_AUTO_TEST_CASE(registry)
+{
+    Registry registry;
+    auto& counter = registry.counter("test_total", "test counter", {{"module", "a"}});
+    BOOST_CHECK_EQUAL(&counter, &registry.counter("test_total", "", {{"module", "a"}}));
+    BOOST_CHECK_NE(&counter, &registry.counter("test_total", "", {{"module", "b\""}}));
+    BOOST_CHECK_THROW(registry.gauge("test_total", ""), InvalidParameter);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < 1000; ++j)
+            {
+                counter.inc();
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    BOOST_CHECK_EQUAL(counter.value(), 4000);
+
+    registry.gauge("test_gauge", "test gauge").set(-3);
+    auto& histogram = registry.histogram("test_us", "test histogram");
+    {
+        ScopedTimer timer(histogram);
+    }
+    histogram.observe(100);
+
+    auto text = registry.exportPrometheus();
+    BOOST_CHECK(text.find("# HELP test_total test counter\n"
+                          "# TYPE test_total counter\n"
+                          "test_total{module=\"a\"} 4000\n"
+                          "test_total{module=\"b\\\"\"} 0\n") != std::string::npos);
+    BOOST_CHECK(text.find("# TYPE test_gauge gauge\ntest_gauge -3\n") != std::string::npos);
+    BOOST_CHECK(text.find("# TYPE test_us summary\n") != std::string::npos);
+    // the upper bound of the bucket of 100
+    BOOST_CHECK(text.find("test_us{quantile=\"0.999\"} 103\n") != std::string::npos);
+    BOOST_CHECK(text.find("test_us_count 2\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
@@ -0,0 +1,79 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file TimerWheelTest.cpp
+ */
+
+#include "bcos-utilities/TimerWheel.h"
+#include "bcos-utilities/testutils/TestPromptFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <future>
+
+using namespace bcos;
+using namespace std::chrono_literals;
+
+namespace bcos::test
+{
+BOOST_FIXTURE_TEST_SUITE(TimerWheelTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(expire)
+{
+    // 4 slots of 5ms, the 50ms timer waits for 2 more rounds
+    TimerWheel wheel("test", 5ms, 4);
+    std::promise<std::chrono::steady_clock::time_point> shortFired;
+    std::promise<std::chrono::steady_clock::time_point> longFired;
+    auto start = std::chrono::steady_clock::now();
+    wheel.add(10ms, [&]() { shortFired.set_value(std::chrono::steady_clock::now()); });
+    wheel.add(50ms, [&]() { longFired.set_value(std::chrono::steady_clock::now()); });
+    BOOST_CHECK_EQUAL(wheel.size(), 2);
+
+    BOOST_CHECK_GE(shortFired.get_future().get() - start, 10ms);
+    BOOST_CHECK_GE(longFired.get_future().get() - start, 50ms);
+    BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(cancel)
+{
+    TimerWheel wheel("test", 1ms, 8);
+    std::atomic_int fired = 0;
+    std::vector<TimerWheel::Handle> handles;
+    for (int i = 0; i < 1000; ++i)
+    {
+        handles.push_back(wheel.add(200ms, [&]() { ++fired; }));
+    }
+    std::promise<void> last;
+    wheel.add(400ms, [&]() { last.set_value(); });
+
+    size_t cancelled = 0;
+    for (size_t i = 0; i < handles.size(); i += 2)
+    {
+        cancelled += wheel.cancel(handles[i]) ? 1 : 0;
+    }
+    BOOST_CHECK_EQUAL(cancelled, 500);
+    BOOST_CHECK(!wheel.cancel(handles[0]));
+    BOOST_CHECK(!wheel.cancel(TimerWheel::Handle{}));
+
+    last.get_future().wait();
+    BOOST_CHECK_EQUAL(fired, 500);
+    // already run
+    BOOST_CHECK(!wheel.cancel(handles[1]));
+
+    wheel.add(1h, []() {});
+    wheel.stop();
+    BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
@@ -0,0 +1,106 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file WorkStealingThreadPoolTest.cpp
+ */
+
+#include "bcos-utilities/WorkStealingThreadPool.h"
+#include "bcos-utilities/testutils/TestPromptFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <future>
+
+using namespace bcos;
+
+namespace bcos::test
+{
+BOOST_FIXTURE_TEST_SUITE(WorkStealingThreadPoolTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(enqueue)
+{
+    WorkStealingThreadPool pool("test", 4);
+    constexpr static int count = 10000;
+    std::atomic_int executed = 0;
+    std::promise<void> finished;
+    for (int i = 0; i < count; ++i)
+    {
+        // move only task, nested enqueue goes to the deque of the current worker
+        pool.enqueue([&, holder = std::make_unique<int>(i)]() {
+            pool.enqueue([&]() {
+                if (executed.fetch_add(1) + 1 == count * 2)
+                {
+                    finished.set_value();
+                }
+            });
+            if (executed.fetch_add(1) + 1 == count * 2)
+            {
+                finished.set_value();
+            }
+        });
+    }
+    finished.get_future().get();
+
+    auto statistics = pool.statistics();
+    BOOST_CHECK_EQUAL(statistics.pending, 0);
+    BOOST_CHECK_GE(statistics.executed, count * 2 - 4);
+    BOOST_CHECK_GE(statistics.maxWait.count(), 0);
+    pool.stop();
+    BOOST_CHECK(pool.hasStopped());
+    // dropped after stop
+    pool.enqueue([&]() { executed.fetch_add(1); });
+    BOOST_CHECK_EQUAL(executed, count * 2);
+}
+
+BOOST_AUTO_TEST_CASE(priority)
+{
+    WorkStealingThreadPool pool("test", 1);
+    std::promise<void> started;
+    std::promise<void> blocker;
+    auto blockerFuture = blocker.get_future();
+    pool.enqueue([&]() {
+        started.set_value();
+        blockerFuture.wait();
+    });
+    started.get_future().wait();
+
+    std::vector<int> order;
+    std::promise<void> finished;
+    pool.enqueue([&]() { order.push_back(1); });
+    pool.enqueue([&]() { order.push_back(2); }, WorkStealingThreadPool::Priority::HIGH);
+    pool.enqueue([&]() {
+        order.push_back(3);
+        finished.set_value();
+    });
+    blocker.set_value();
+    finished.get_future().wait();
+    BOOST_CHECK((order == std::vector<int>{2, 1, 3}));
+}
+
+BOOST_AUTO_TEST_CASE(parseCPUList)
+{
+    BOOST_CHECK((WorkStealingThreadPool::parseCPUList("0-3,8,10-11\n") ==
+                 std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    BOOST_CHECK(WorkStealingThreadPool::parseCPUList("").empty());
+    BOOST_CHECK(WorkStealingThreadPool::parseCPUList("a-b").empty());
+
+    // pinning to the cpus of node 0, if any
+    WorkStealingThreadPool::Options options{.cpus = WorkStealingThreadPool::numaNodeCPUs(0)};
+    WorkStealingThreadPool pool("test", 2, options);
+    std::promise<void> finished;
+    pool.enqueue([&]() { finished.set_value(); });
+    finished.get_future().wait();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
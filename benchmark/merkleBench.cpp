@@ -66,13 +66,54 @@ void testNewMerkle(const std::vector<bcos::bytes>& datas)
               << std::endl;
 }
 
+// hash the merkle nodes of width 2 one by one and in batches, the keccak batch runs in simd lanes
+template <class BatchHasher>
+void testBatchHash(const std::vector<bcos::bytes>& datas, std::string_view name)
+{
+    std::vector<bcos::bytes> nodes;
+    nodes.reserve(datas.size() / 2);
+    for (size_t i = 0; i + 1 < datas.size(); i += 2)
+    {
+        auto& node = nodes.emplace_back(datas[i]);
+        node.insert(node.end(), datas[i + 1].begin(), datas[i + 1].end());
+    }
+    std::vector<std::span<std::byte const>> inputs;
+    inputs.reserve(nodes.size());
+    for (auto& node : nodes)
+    {
+        inputs.emplace_back((std::byte const*)node.data(), node.size());
+    }
+
+    BatchHasher hasher;
+    std::vector<std::byte> scalarOutputs(inputs.size() * BatchHasher::HASH_SIZE);
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        hasher.update(inputs[i]);
+        hasher.final(std::span<std::byte>(
+            scalarOutputs.data() + i * BatchHasher::HASH_SIZE, BatchHasher::HASH_SIZE));
+    }
+    auto scalarDuration = std::chrono::high_resolution_clock::now() - timePoint;
+
+    std::vector<std::byte> batchOutputs(inputs.size() * BatchHasher::HASH_SIZE);
+    timePoint = std::chrono::high_resolution_clock::now();
+    bcos::crypto::hasher::batchHash(hasher, inputs, batchOutputs);
+    auto batchDuration = std::chrono::high_resolution_clock::now() - timePoint;
+
+    std::cout << name << " nodes: " << inputs.size() << " scalar: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(scalarDuration).count()
+              << "us batch: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(batchDuration).count()
+              << "us match: " << (scalarOutputs == batchOutputs) << std::endl;
+}
+
 int main(int argc, char* argv[])
 {
     boost::program_options::options_description options("Merkle benchmark");
 
     // clang-format off
     options.add_options()
-        ("type,t", boost::program_options::value<int>()->default_value(0), "0 for old merkle, 1 for new merkle")
+        ("type,t", boost::program_options::value<int>()->default_value(0), "0 for old merkle, 1 for new merkle, 2 for batch hash")
         ("prepare,p", boost::program_options::value<int>()->default_value(0), "Prepare test data, count of hashes")
         ("filename,f", boost::program_options::value<std::string>()->default_value("merkle_test.data"), "Test data file name")
         ;
@@ -116,13 +157,21 @@ int main(int argc, char* argv[])
     }
 
     auto type = vm["type"].as<int>();
-    if (type)
+    switch (type)
     {
+    case 2:
+        testBatchHash<bcos::crypto::hasher::openssl::OpenSSL_Keccak256_Hasher>(
+            inputDatas, "Keccak256");
+        testBatchHash<bcos::crypto::hasher::openssl::OpenSSL_SHA3_256_Hasher>(
+            inputDatas, "SHA3_256");
+        testBatchHash<Hasher>(inputDatas, "SM3");
+        break;
+    case 1:
         testNewMerkle(inputDatas);
-    }
-    else
-    {
+        break;
+    default:
         testOldMerkle(inputDatas);
+        break;
     }
     fileInput.close();
 }
\ No newline at end of file
@@ -13,6 +13,7 @@
 std::tuple<std::function<std::shared_ptr<bcos::scheduler::SchedulerInterface>()>,
     std::function<void(std::function<void(bcos::protocol::BlockNumber)>)>>
 bcos::transaction_scheduler::BaselineSchedulerInitializer::build(::rocksdb::DB& rocksDB,
+    std::vector<::rocksdb::ColumnFamilyHandle*> columnFamilies,
     std::shared_ptr<protocol::BlockFactory> blockFactory,
     std::shared_ptr<txpool::TxPoolInterface> txpool,
     std::shared_ptr<protocol::TransactionSubmitResultFactory> transactionSubmitResultFactory,
@@ -30,7 +31,7 @@ bcos::transaction_scheduler::BaselineSchedulerInitializer::build(::rocksdb::DB&
             transaction_executor::StateValue,
             storage2::memory_storage::Attribute(storage2::memory_storage::ORDERED |
                                                 storage2::memory_storage::CONCURRENT |
-                                                storage2::memory_storage::MRU),
+                                                storage2::memory_storage::CLOCK),
             std::hash<bcos::transaction_executor::StateKey>>;
 
         CacheStorage m_cacheStorage;
@@ -44,16 +45,21 @@ bcos::transaction_scheduler::BaselineSchedulerInitializer::build(::rocksdb::DB&
         transaction_executor::PrecompiledManager m_precompiledManager;
         transaction_executor::TransactionExecutorImpl m_transactionExecutor;
 
-        Data(::rocksdb::DB& rocksDB, protocol::BlockFactory& blockFactory)
+        // the ledger rows written by prewriteBlock go to the same column families the ledger
+        // reads them from
+        Data(::rocksdb::DB& rocksDB, std::vector<::rocksdb::ColumnFamilyHandle*> columnFamilies,
+            protocol::BlockFactory& blockFactory)
           : m_rocksDBStorage(rocksDB, storage2::rocksdb::StateKeyResolver{},
-                storage2::rocksdb::StateValueResolver{}),
+                storage2::rocksdb::StateValueResolver{}, std::move(columnFamilies)),
             m_multiLayerStorage(m_rocksDBStorage, m_cacheStorage),
             m_precompiledManager(blockFactory.cryptoSuite()->hashImpl()),
             m_transactionExecutor(
                 *blockFactory.receiptFactory(), blockFactory.cryptoSuite()->hashImpl())
         {}
     };
-    auto data = std::make_shared<Data>(rocksDB, *blockFactory);
+    auto data = std::make_shared<Data>(rocksDB, std::move(columnFamilies), *blockFactory);
+    data->m_multiLayerStorage.setImmutableLimit(
+        config.maxImmutableLayers, config.maxImmutableBytes);
 
     auto buildBaselineHolder = [&](auto scheduler) {
         auto baselineScheduler =
@@ -61,7 +67,8 @@ bcos::transaction_scheduler::BaselineSchedulerInitializer::build(::rocksdb::DB&
                 decltype(data->m_transactionExecutor), decltype(*scheduler),
                 ledger::LedgerInterface>>(data->m_multiLayerStorage, *scheduler,
                 data->m_transactionExecutor, *blockFactory->blockHeaderFactory(), *ledger, *txpool,
-                *transactionSubmitResultFactory, *blockFactory->cryptoSuite()->hashImpl());
+                *transactionSubmitResultFactory, *blockFactory->cryptoSuite()->hashImpl(),
+                config.callThread, config.callResultCacheSize);
         baselineScheduler->registerTransactionNotifier(
             [txpool](bcos::protocol::BlockNumber blockNumber,
                 bcos::protocol::TransactionSubmitResultsPtr result,
@@ -94,7 +101,11 @@ bcos::transaction_scheduler::BaselineSchedulerInitializer::build(::rocksdb::DB&
 
     INITIALIZER_LOG(INFO) << "Initialize baseline scheduler, parallel: " << config.parallel
                           << ", chunkSize: " << config.chunkSize
-                          << ", maxThread: " << config.maxThread;
+                          << ", maxThread: " << config.maxThread
+                          << ", callThread: " << config.callThread
+                          << ", callResultCacheSize: " << config.callResultCacheSize
+                          << ", maxImmutableLayers: " << config.maxImmutableLayers
+                          << ", maxImmutableBytes: " << config.maxImmutableBytes;
 
     return buildBaselineHolder(std::move(scheduler));
 }
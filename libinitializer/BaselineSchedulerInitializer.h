@@ -7,6 +7,7 @@
 #include "bcos-tool/NodeConfig.h"
 #include <rocksdb/db.h>
 #include <memory>
+#include <vector>
 
 namespace bcos::transaction_scheduler
 {
@@ -16,7 +17,8 @@ class BaselineSchedulerInitializer
 public:
     static std::tuple<std::function<std::shared_ptr<scheduler::SchedulerInterface>()>,
         std::function<void(std::function<void(protocol::BlockNumber)>)>>
-    build(::rocksdb::DB& rocksDB, std::shared_ptr<protocol::BlockFactory> blockFactory,
+    build(::rocksdb::DB& rocksDB, std::vector<::rocksdb::ColumnFamilyHandle*> columnFamilies,
+        std::shared_ptr<protocol::BlockFactory> blockFactory,
         std::shared_ptr<txpool::TxPoolInterface> txpool,
         std::shared_ptr<protocol::TransactionSubmitResultFactory> transactionSubmitResultFactory,
         std::shared_ptr<ledger::LedgerInterface> ledger,
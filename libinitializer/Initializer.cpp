@@ -167,6 +167,8 @@ void Initializer::init(bcos::protocol::NodeArchitectureType _nodeArchType,
         option.minWriteBufferNumberToMerge = m_nodeConfig->minWriteBufferNumberToMerge();
         option.blockCacheSize = m_nodeConfig->blockCacheSize();
         option.enable_blob_files = m_nodeConfig->enableRocksDBBlob();
+        option.enableColumnFamilies = m_nodeConfig->enableColumnFamilies();
+        option.headerBlockCacheSize = m_nodeConfig->headerBlockCacheSize();
 
         // m_protocolInitializer->dataEncryption() will return nullptr when storage_security = false
         storage =
@@ -246,8 +248,9 @@ void Initializer::init(bcos::protocol::NodeArchitectureType _nodeArchType,
         auto baselineSchedulerConfig = m_nodeConfig->baselineSchedulerConfig();
         std::tie(m_baselineSchedulerHolder, m_setBaselineSchedulerBlockNumberNotifier) =
             transaction_scheduler::BaselineSchedulerInitializer::build(existsRocksDB->rocksDB(),
-                m_protocolInitializer->blockFactory(), m_txpoolInitializer->txpool(),
-                transactionSubmitResultFactory, ledger, baselineSchedulerConfig);
+                existsRocksDB->columnFamilies(), m_protocolInitializer->blockFactory(),
+                m_txpoolInitializer->txpool(), transactionSubmitResultFactory, ledger,
+                baselineSchedulerConfig);
         m_scheduler = m_baselineSchedulerHolder();
     }
     else
@@ -410,6 +413,8 @@ void Initializer::init(bcos::protocol::NodeArchitectureType _nodeArchType,
         std::make_shared<bcos::ledger::LedgerImpl<Hasher, decltype(storageWrapper)>>(hasher.clone(),
             std::move(storageWrapper), m_protocolInitializer->blockFactory(), storage);
     lightNodeLedger->setKeyPageSize(m_nodeConfig->keyPageSize());
+    // serve the transactions and receipts appended to the segment store as well
+    lightNodeLedger->setSegmentStore(ledger->segmentStore());
 
     auto txpool = m_txpoolInitializer->txpool();
     auto transactionPool =
@@ -44,14 +44,20 @@ public:
             ledger = std::make_shared<bcos::ledger::LedgerImpl<
                 bcos::crypto::hasher::openssl::OpenSSL_SM3_Hasher, decltype(storageWrapper)>>(
                 bcos::crypto::hasher::openssl::OpenSSL_SM3_Hasher{}, std::move(storageWrapper),
-                blockFactory, storage);
+                blockFactory, storage, nodeConfig->ledgerHotCacheSize());
         }
         else
         {
             ledger = std::make_shared<bcos::ledger::LedgerImpl<
                 bcos::crypto::hasher::openssl::OpenSSL_Keccak256_Hasher, decltype(storageWrapper)>>(
                 bcos::crypto::hasher::openssl::OpenSSL_Keccak256_Hasher{},
-                std::move(storageWrapper), blockFactory, storage);
+                std::move(storageWrapper), blockFactory, storage,
+                nodeConfig->ledgerHotCacheSize());
+        }
+        if (nodeConfig->enableSegmentStore())
+        {
+            ledger->setSegmentStore(std::make_shared<bcos::ledger::SegmentStore>(
+                nodeConfig->segmentStorePath(), nodeConfig->segmentFileSize()));
         }
 
         ledger->buildGenesisBlock(nodeConfig->genesisConfig(), *nodeConfig->ledgerConfig());
@@ -23,11 +23,14 @@
  * @date 2021-10-14
  */
 #pragma once
+#include "bcos-storage/ColumnFamily.h"
 #include "bcos-storage/RocksDBStorage.h"
 #include "bcos-storage/TiKVStorage.h"
 #include "boost/filesystem.hpp"
 #include "rocksdb/convenience.h"
 #include "rocksdb/filter_policy.h"
+#include "rocksdb/slice_transform.h"
+#include "rocksdb/table.h"
 #include "rocksdb/write_batch.h"
 #include <bcos-framework/security/DataEncryptInterface.h>
 #include <bcos-framework/storage/StorageInterface.h>
@@ -43,16 +46,32 @@ struct RocksDBOption
     int minWriteBufferNumberToMerge = 1;
     size_t blockCacheSize = 128 << 20;  // 128MB
     bool enable_blob_files = false;
+    // store each storage::DataClass in its own column family with tuned options
+    bool enableColumnFamilies = false;
+    size_t headerBlockCacheSize = 256 << 20;  // 256MB, the cache of the headers column family
+};
+
+// the table name part of a db key, used as the bloom prefix of the state column family
+class TableNamePrefix : public rocksdb::SliceTransform
+{
+public:
+    const char* Name() const override { return "bcos.TableNamePrefix"; }
+    rocksdb::Slice Transform(const rocksdb::Slice& key) const override
+    {
+        auto view = std::string_view(key.data(), key.size());
+        auto pos = view.find(bcos::storage::TABLE_KEY_SPLIT);
+        return {key.data(), pos == std::string_view::npos ? key.size() : pos + 1};
+    }
+    bool InDomain(const rocksdb::Slice& /*key*/) const override { return true; }
 };
 
 class StorageInitializer
 {
 public:
-    static auto createRocksDB(
-        const std::string& _path, RocksDBOption& rocksDBOption, bool _enableDBStatistics = false)
+    using UniqueDB = std::unique_ptr<rocksdb::DB, std::function<void(rocksdb::DB*)>>;
+
+    static rocksdb::Options createOptions(RocksDBOption& rocksDBOption, bool _enableDBStatistics)
     {
-        boost::filesystem::create_directories(_path);
-        rocksdb::DB* db = nullptr;
         rocksdb::Options options;
         // Note: This option will increase much memory
         // options.IncreaseParallelism(std::thread::hardware_concurrency());
@@ -86,15 +105,111 @@ public:
         }
         // block cache 128MB
         std::shared_ptr<rocksdb::Cache> cache = rocksdb::NewLRUCache(rocksDBOption.blockCacheSize);
+        options.table_factory.reset(rocksdb::NewBlockBasedTableFactory(tableOptions(cache, true)));
+        return options;
+    }
+
+    static rocksdb::BlockBasedTableOptions tableOptions(
+        std::shared_ptr<rocksdb::Cache> cache, bool bloomFilter)
+    {
         rocksdb::BlockBasedTableOptions table_options;
-        table_options.block_cache = cache;
-        // use bloom filter to optimize point lookup, i.e. get
-        table_options.filter_policy.reset(rocksdb::NewBloomFilterPolicy(10, false));
-        table_options.optimize_filters_for_memory = true;
+        table_options.block_cache = std::move(cache);
+        if (bloomFilter)
+        {
+            // use bloom filter to optimize point lookup, i.e. get
+            table_options.filter_policy.reset(rocksdb::NewBloomFilterPolicy(10, false));
+            table_options.optimize_filters_for_memory = true;
+        }
         table_options.block_size = 64 * 1024;
         // table_options.cache_index_and_filter_blocks = true; // this will increase memory and
         // lower performance
-        options.table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
+        return table_options;
+    }
+
+    // the column families indexed by storage::DataClass, all derived from the db options
+    static std::vector<rocksdb::ColumnFamilyDescriptor> columnFamilyDescriptors(
+        rocksdb::Options const& options, RocksDBOption& rocksDBOption)
+    {
+        auto sharedCache = rocksdb::NewLRUCache(rocksDBOption.blockCacheSize);
+        std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
+        descriptors.reserve(storage::DATA_CLASS_COUNT);
+
+        // state: seeks and gets stay in one table, bloom on the table name as well as the key
+        rocksdb::ColumnFamilyOptions state(options);
+        state.prefix_extractor = std::make_shared<TableNamePrefix>();
+        state.memtable_prefix_bloom_size_ratio = 0.1;
+        state.table_factory.reset(
+            rocksdb::NewBlockBasedTableFactory(tableOptions(sharedCache, true)));
+        descriptors.emplace_back(std::string(storage::COLUMN_FAMILY_NAMES[0]), state);
+
+        // transactions and receipts: large values only read by hash after they are written, kept
+        // in blob files so compaction doesn't rewrite them, a lookup almost always hits so no
+        // bloom filter
+        rocksdb::ColumnFamilyOptions blob(options);
+        blob.enable_blob_files = true;
+        blob.min_blob_size = 512;
+        blob.blob_compression_type = rocksdb::kZSTD;
+        blob.enable_blob_garbage_collection = true;
+        blob.table_factory.reset(
+            rocksdb::NewBlockBasedTableFactory(tableOptions(sharedCache, false)));
+        descriptors.emplace_back(std::string(storage::COLUMN_FAMILY_NAMES[1]), blob);
+        descriptors.emplace_back(std::string(storage::COLUMN_FAMILY_NAMES[2]), blob);
+
+        // headers and nonces: small and read by every module, their own cache so a burst of
+        // receipts doesn't evict them
+        rocksdb::ColumnFamilyOptions header(options);
+        header.table_factory.reset(rocksdb::NewBlockBasedTableFactory(
+            tableOptions(rocksdb::NewLRUCache(rocksDBOption.headerBlockCacheSize), true)));
+        descriptors.emplace_back(std::string(storage::COLUMN_FAMILY_NAMES[3]), header);
+        return descriptors;
+    }
+
+    // true if the default column family still holds the rows of a ledger table
+    static bool hasLedgerRowsInDefault(rocksdb::DB& db)
+    {
+        rocksdb::ReadOptions readOptions;
+        readOptions.total_order_seek = true;
+        std::unique_ptr<rocksdb::Iterator> it(
+            db.NewIterator(readOptions, db.DefaultColumnFamily()));
+        for (auto table : storage::COLUMN_FAMILY_TABLES)
+        {
+            auto prefix = std::string(table) + storage::TABLE_KEY_SPLIT;
+            it->Seek(prefix);
+            if (it->Valid() && it->key().starts_with(prefix))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static UniqueDB wrapRocksDB(
+        rocksdb::DB* db, std::vector<rocksdb::ColumnFamilyHandle*> columnFamilies)
+    {
+        return UniqueDB(db, [columnFamilies = std::move(columnFamilies)](rocksdb::DB* db) {
+            CancelAllBackgroundWork(db, true);
+            for (auto* handle : columnFamilies)
+            {
+                db->DestroyColumnFamilyHandle(handle);
+            }
+            db->Close();
+            delete db;
+        });
+    }
+
+    /**
+     * open the db at _path, with rocksDBOption.enableColumnFamilies the handles of the column
+     * families are returned in _columnFamilies; a db with the ledger rows still in the default
+     * column family is refused unless _migrating, run storage-tool --migrateColumnFamilies first
+     */
+    static UniqueDB createRocksDB(const std::string& _path, RocksDBOption& rocksDBOption,
+        bool _enableDBStatistics = false,
+        std::vector<rocksdb::ColumnFamilyHandle*>* _columnFamilies = nullptr,
+        bool _migrating = false)
+    {
+        boost::filesystem::create_directories(_path);
+        rocksdb::DB* db = nullptr;
+        auto options = createOptions(rocksDBOption, _enableDBStatistics);
 
         if (boost::filesystem::space(_path).available < 1 << 30)
         {
@@ -102,27 +217,159 @@ public:
             throw std::runtime_error("available disk space is less than 1GB");
         }
 
-        // open DB
-        rocksdb::Status status = rocksdb::DB::Open(options, _path, &db);
+        // fails for a new db, which has no column family yet
+        std::vector<std::string> existingFamilies;
+        rocksdb::DB::ListColumnFamilies(options, _path, &existingFamilies);
+        if (!rocksDBOption.enableColumnFamilies || _columnFamilies == nullptr)
+        {
+            if (existingFamilies.size() > 1)
+            {
+                throw std::runtime_error(
+                    "the db stores the ledger in column families, please set "
+                    "storage.enable_column_families=true");
+            }
+            // open DB
+            rocksdb::Status status = rocksdb::DB::Open(options, _path, &db);
+            if (!status.ok())
+            {
+                BCOS_LOG(INFO) << LOG_DESC("open rocksDB failed")
+                               << LOG_KV("message", status.ToString());
+                throw std::runtime_error("open rocksDB failed, msg:" + status.ToString());
+            }
+            return wrapRocksDB(db, {});
+        }
+
+        options.create_missing_column_families = true;
+        std::vector<rocksdb::ColumnFamilyHandle*> handles;
+        rocksdb::Status status = rocksdb::DB::Open(rocksdb::DBOptions(options), _path,
+            columnFamilyDescriptors(options, rocksDBOption), &handles, &db);
         if (!status.ok())
         {
-            BCOS_LOG(INFO) << LOG_DESC("open rocksDB failed")
+            BCOS_LOG(INFO) << LOG_DESC("open rocksDB with column families failed")
                            << LOG_KV("message", status.ToString());
             throw std::runtime_error("open rocksDB failed, msg:" + status.ToString());
         }
-        return std::unique_ptr<rocksdb::DB, std::function<void(rocksdb::DB*)>>(
-            db, [](rocksdb::DB* db) {
-                CancelAllBackgroundWork(db, true);
-                db->Close();
-                delete db;
-            });
+        auto uniqueDB = wrapRocksDB(db, handles);
+        if (!_migrating && hasLedgerRowsInDefault(*uniqueDB))
+        {
+            throw std::runtime_error(
+                "the ledger data is not in column families, please run storage-tool "
+                "--migrateColumnFamilies first");
+        }
+        BCOS_LOG(INFO) << LOG_DESC("open rocksDB with column families")
+                       << LOG_KV("existing", existingFamilies.size())
+                       << LOG_KV("families", handles.size());
+        *_columnFamilies = std::move(handles);
+        return uniqueDB;
+    }
+
+    /**
+     * move the ledger tables of a db written without column families into their column families,
+     * every row is put and deleted in one batch so an interrupted migration can be run again
+     *
+     * @return the count of moved rows
+     */
+    static size_t migrateToColumnFamilies(const std::string& _path, RocksDBOption rocksDBOption)
+    {
+        constexpr static size_t MIGRATE_BATCH_ROWS = 10000;
+        rocksDBOption.enableColumnFamilies = true;
+        std::vector<rocksdb::ColumnFamilyHandle*> columnFamilies;
+        auto db = createRocksDB(_path, rocksDBOption, false, &columnFamilies, true);
+        auto* defaultFamily = db->DefaultColumnFamily();
+
+        size_t moved = 0;
+        for (auto table : storage::COLUMN_FAMILY_TABLES)
+        {
+            auto prefix = std::string(table) + storage::TABLE_KEY_SPLIT;
+            auto* family = columnFamilies[(size_t)storage::dataClassOf(table)];
+            rocksdb::ReadOptions readOptions;
+            readOptions.total_order_seek = true;
+            std::unique_ptr<rocksdb::Iterator> it(db->NewIterator(readOptions, defaultFamily));
+            rocksdb::WriteBatch writeBatch;
+            auto flush = [&]() {
+                auto status = db->Write(rocksdb::WriteOptions(), &writeBatch);
+                if (!status.ok())
+                {
+                    throw std::runtime_error("migrate rows failed, msg:" + status.ToString());
+                }
+                writeBatch.Clear();
+            };
+            size_t tableRows = 0;
+            for (it->Seek(prefix); it->Valid() && it->key().starts_with(prefix); it->Next())
+            {
+                writeBatch.Put(family, it->key(), it->value());
+                writeBatch.Delete(defaultFamily, it->key());
+                if (++tableRows % MIGRATE_BATCH_ROWS == 0)
+                {
+                    flush();
+                }
+            }
+            if (!it->status().ok())
+            {
+                throw std::runtime_error("iterate rows failed, msg:" + it->status().ToString());
+            }
+            flush();
+            moved += tableRows;
+            BCOS_LOG(INFO) << LOG_DESC("migrate table to column family") << LOG_KV("table", table)
+                           << LOG_KV("columnFamily", family->GetName())
+                           << LOG_KV("rows", tableRows);
+        }
+        // drop the tombstones of the moved rows
+        db->CompactRange(rocksdb::CompactRangeOptions(), defaultFamily, nullptr, nullptr);
+        return moved;
+    }
+
+    // open the db read only as a secondary instance with the column families it has
+    static bcos::storage::RocksDBStorage::Ptr buildSecondary(const std::string& _path,
+        const std::string& _secondaryPath,
+        const bcos::security::DataEncryptInterface::Ptr& _dataEncrypt)
+    {
+        rocksdb::Options options;
+        options.create_if_missing = false;
+        options.max_open_files = -1;
+        std::vector<std::string> existingFamilies;
+        rocksdb::DB::ListColumnFamilies(options, _path, &existingFamilies);
+
+        rocksdb::DB* db = nullptr;
+        std::vector<rocksdb::ColumnFamilyHandle*> handles;
+        rocksdb::Status status;
+        if (existingFamilies.size() > 1)
+        {
+            std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
+            for (auto name : storage::COLUMN_FAMILY_NAMES)
+            {
+                descriptors.emplace_back(std::string(name), rocksdb::ColumnFamilyOptions(options));
+            }
+            status = rocksdb::DB::OpenAsSecondary(
+                options, _path, _secondaryPath, descriptors, &handles, &db);
+        }
+        else
+        {
+            status = rocksdb::DB::OpenAsSecondary(options, _path, _secondaryPath, &db);
+        }
+        if (!status.ok())
+        {
+            throw std::runtime_error("open secondary rocksDB failed, msg:" + status.ToString());
+        }
+        auto uniqueDB = wrapRocksDB(db, handles);
+        status = uniqueDB->TryCatchUpWithPrimary();
+        if (!status.ok())
+        {
+            throw std::runtime_error("TryCatchUpWithPrimary failed, msg:" + status.ToString());
+        }
+        return std::make_shared<bcos::storage::RocksDBStorage>(
+            std::move(uniqueDB), _dataEncrypt, std::move(handles));
     }
+
     static bcos::storage::TransactionalStorageInterface::Ptr build(const std::string& _storagePath,
         RocksDBOption& rocksDBOption, const bcos::security::DataEncryptInterface::Ptr& _dataEncrypt,
         [[maybe_unused]] size_t keyPageSize = 0, bool _enableDBStatistics = false)
     {
-        auto unique_db = createRocksDB(_storagePath, rocksDBOption, _enableDBStatistics);
-        return std::make_shared<bcos::storage::RocksDBStorage>(std::move(unique_db), _dataEncrypt);
+        std::vector<rocksdb::ColumnFamilyHandle*> columnFamilies;
+        auto unique_db =
+            createRocksDB(_storagePath, rocksDBOption, _enableDBStatistics, &columnFamilies);
+        return std::make_shared<bcos::storage::RocksDBStorage>(
+            std::move(unique_db), _dataEncrypt, std::move(columnFamilies));
     }
 
 #ifdef WITH_TIKV
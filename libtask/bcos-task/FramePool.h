@@ -0,0 +1,216 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <new>
+
+namespace bcos::task
+{
+
+struct FramePoolStatistics
+{
+    uint64_t allocations = 0;
+    // allocations served from the free lists
+    uint64_t pooledAllocations = 0;
+    uint64_t deallocations = 0;
+    // deallocations kept in the free lists
+    uint64_t pooledDeallocations = 0;
+};
+
+// Coroutine frames are allocated and freed at a high rate, most of them are small and of a few
+// sizes. FramePool rounds the frame sizes up to size classes and keeps the freed frames in thread
+// local free lists. A frame freed on another thread goes to the free list of that thread, each
+// list is bounded so that a consumer thread does not hold memory forever.
+class FramePool
+{
+public:
+    constexpr static size_t SIZE_CLASS_GRANULARITY = 64;
+    constexpr static size_t SIZE_CLASS_COUNT = 32;
+    constexpr static size_t MAX_POOLED_SIZE = SIZE_CLASS_GRANULARITY * SIZE_CLASS_COUNT;
+    constexpr static size_t MAX_FREE_FRAMES = 256;
+
+    static void* allocate(size_t size)
+    {
+        auto* local = localCache();
+        if (local != nullptr)
+        {
+            increase(local->counters.allocations);
+        }
+        if (size > MAX_POOLED_SIZE)
+        {
+            return ::operator new(size);
+        }
+
+        auto sizeClass = toSizeClass(size);
+        if (local != nullptr && local->freeFrames[sizeClass] != nullptr && enabled())
+        {
+            auto* frame = local->freeFrames[sizeClass];
+            local->freeFrames[sizeClass] = frame->next;
+            --local->freeCount[sizeClass];
+            increase(local->counters.pooledAllocations);
+            return frame;
+        }
+        // always allocate the whole size class, the frame may be pooled when it is freed
+        return ::operator new((sizeClass + 1) * SIZE_CLASS_GRANULARITY);
+    }
+
+    static void deallocate(void* pointer, size_t size) noexcept
+    {
+        auto* local = localCache();
+        if (local != nullptr)
+        {
+            increase(local->counters.deallocations);
+        }
+        if (size > MAX_POOLED_SIZE || local == nullptr)
+        {
+            ::operator delete(pointer);
+            return;
+        }
+
+        auto sizeClass = toSizeClass(size);
+        if (local->freeCount[sizeClass] < MAX_FREE_FRAMES && enabled())
+        {
+            auto* frame = static_cast<FreeFrame*>(pointer);
+            frame->next = local->freeFrames[sizeClass];
+            local->freeFrames[sizeClass] = frame;
+            ++local->freeCount[sizeClass];
+            increase(local->counters.pooledDeallocations);
+            return;
+        }
+        ::operator delete(pointer);
+    }
+
+    // the frames are still rounded to the size classes when disabled, only the free lists are
+    // bypassed, so frames allocated before and after a switch can be freed either way
+    static void setEnabled(bool value) { enabledFlag().store(value, std::memory_order_relaxed); }
+    static bool enabled() { return enabledFlag().load(std::memory_order_relaxed); }
+
+    // sum of the counters of all threads, including the exited ones
+    static FramePoolStatistics statistics()
+    {
+        auto& registry = counterRegistry();
+        std::unique_lock lock(registry.mutex);
+        auto statistics = registry.retired;
+        for (auto* counters : registry.alive)
+        {
+            counters->addTo(statistics);
+        }
+        return statistics;
+    }
+
+private:
+    struct FreeFrame
+    {
+        FreeFrame* next;
+    };
+
+    struct Counters
+    {
+        std::atomic_uint64_t allocations{0};
+        std::atomic_uint64_t pooledAllocations{0};
+        std::atomic_uint64_t deallocations{0};
+        std::atomic_uint64_t pooledDeallocations{0};
+
+        void addTo(FramePoolStatistics& statistics) const
+        {
+            statistics.allocations += allocations.load(std::memory_order_relaxed);
+            statistics.pooledAllocations += pooledAllocations.load(std::memory_order_relaxed);
+            statistics.deallocations += deallocations.load(std::memory_order_relaxed);
+            statistics.pooledDeallocations += pooledDeallocations.load(std::memory_order_relaxed);
+        }
+    };
+
+    struct CounterRegistry
+    {
+        std::mutex mutex;
+        std::list<Counters const*> alive;
+        FramePoolStatistics retired;
+    };
+
+    struct LocalCache
+    {
+        LocalCache()
+        {
+            auto& registry = counterRegistry();
+            std::unique_lock lock(registry.mutex);
+            registry.alive.push_back(&counters);
+        }
+        ~LocalCache()
+        {
+            s_localCacheDestroyed = true;
+            for (auto* head : freeFrames)
+            {
+                while (head != nullptr)
+                {
+                    auto* next = head->next;
+                    ::operator delete(head);
+                    head = next;
+                }
+            }
+            auto& registry = counterRegistry();
+            std::unique_lock lock(registry.mutex);
+            registry.alive.remove(&counters);
+            counters.addTo(registry.retired);
+        }
+        LocalCache(const LocalCache&) = delete;
+        LocalCache(LocalCache&&) = delete;
+        LocalCache& operator=(const LocalCache&) = delete;
+        LocalCache& operator=(LocalCache&&) = delete;
+
+        std::array<FreeFrame*, SIZE_CLASS_COUNT> freeFrames{};
+        std::array<size_t, SIZE_CLASS_COUNT> freeCount{};
+        Counters counters;
+    };
+
+    static size_t toSizeClass(size_t size)
+    {
+        return size == 0 ? 0 : (size - 1) / SIZE_CLASS_GRANULARITY;
+    }
+
+    // only the owner thread writes its counters, a plain store is enough
+    static void increase(std::atomic_uint64_t& counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // nullptr once the cache is destroyed at thread exit, the frames freed by the other thread
+    // local destructors go to the heap directly
+    static LocalCache* localCache()
+    {
+        if (s_localCacheDestroyed)
+        {
+            return nullptr;
+        }
+        thread_local LocalCache cache;
+        return &cache;
+    }
+    static inline thread_local bool s_localCacheDestroyed = false;
+
+    static CounterRegistry& counterRegistry()
+    {
+        // never destroyed, the thread local caches of the detached threads may outlive it
+        static auto* registry = new CounterRegistry;
+        return *registry;
+    }
+
+    static std::atomic_bool& enabledFlag()
+    {
+        static std::atomic_bool flag{true};
+        return flag;
+    }
+};
+
+// Inherited by the promise types, the compiler allocates the coroutine frame through them
+struct PooledFrame
+{
+    static void* operator new(size_t size) { return FramePool::allocate(size); }
+    static void operator delete(void* pointer, size_t size) noexcept
+    {
+        FramePool::deallocate(pointer, size);
+    }
+};
+
+}  // namespace bcos::task
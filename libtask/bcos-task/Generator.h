@@ -4,6 +4,7 @@
 // Can be replace with std::generator
 
 #include "Coroutine.h"
+#include "FramePool.h"
 #include <exception>
 #include <iterator>
 #include <utility>
@@ -14,7 +15,7 @@ template <typename Ref, typename Value = std::remove_cvref_t<Ref>>
 class Generator
 {
 public:
-    class promise_type
+    class promise_type : public PooledFrame
     {
     public:
         promise_type() : m_promise(this) {}
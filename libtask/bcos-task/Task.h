@@ -1,5 +1,6 @@
 #pragma once
 #include "Coroutine.h"
+#include "FramePool.h"
 #include <bcos-concepts/Exception.h>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/throw_exception.hpp>
@@ -81,7 +82,7 @@ public:
     Awaitable operator co_await() { return Awaitable(*static_cast<Task*>(this)); }
 
     template <class PromiseImpl>
-    struct PromiseBase
+    struct PromiseBase : public PooledFrame
     {
         constexpr CO_STD::suspend_always initial_suspend() const noexcept { return {}; }
         constexpr auto final_suspend() noexcept
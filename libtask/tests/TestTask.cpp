@@ -1,3 +1,4 @@
+#include "bcos-task/FramePool.h"
 #include "bcos-task/Generator.h"
 #include "bcos-utilities/Overloaded.h"
 #include <bcos-task/Task.h>
@@ -217,4 +218,28 @@ BOOST_AUTO_TEST_CASE(generator)
     std::cout << "All outputed" << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE(framePool)
+{
+    auto before = FramePool::statistics();
+    // the frames freed by the first run are reused by the second one on the same thread
+    BOOST_CHECK_EQUAL(syncWait(level3()), 100);
+    BOOST_CHECK_EQUAL(syncWait(level3()), 100);
+    for (auto i : genInt())
+    {
+        BOOST_CHECK_GT(i, 0);
+    }
+
+    auto after = FramePool::statistics();
+    BOOST_CHECK_GT(after.allocations, before.allocations);
+    BOOST_CHECK_GT(after.pooledAllocations, before.pooledAllocations);
+    BOOST_CHECK_EQUAL(after.allocations - before.allocations,
+        after.deallocations - before.deallocations);
+
+    FramePool::setEnabled(false);
+    auto disabled = FramePool::statistics();
+    BOOST_CHECK_EQUAL(syncWait(level3()), 100);
+    BOOST_CHECK_EQUAL(FramePool::statistics().pooledAllocations, disabled.pooledAllocations);
+    FramePool::setEnabled(true);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
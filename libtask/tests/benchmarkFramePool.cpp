@@ -0,0 +1,82 @@
+#include "bcos-task/FramePool.h"
+#include "bcos-task/Generator.h"
+#include "bcos-task/Task.h"
+#include "bcos-task/Wait.h"
+#include <benchmark/benchmark.h>
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
+
+using namespace bcos::task;
+
+constexpr static int DEPTH = 8;
+constexpr static int TASK_COUNT = 10000;
+
+Task<int> nested(int depth)
+{
+    if (depth == 0)
+    {
+        co_return 1;
+    }
+    co_return (co_await nested(depth - 1)) + 1;
+}
+
+Generator<int> numbers(int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        co_yield i;
+    }
+}
+
+static void reportStatistics(benchmark::State& state, FramePoolStatistics const& before)
+{
+    auto after = FramePool::statistics();
+    state.counters["allocations"] = (double)(after.allocations - before.allocations);
+    state.counters["pooledAllocations"] =
+        (double)(after.pooledAllocations - before.pooledAllocations);
+}
+
+// state.range(0) == 1 for the frame pool, 0 for the default allocator
+static void nestedTask(benchmark::State& state)
+{
+    FramePool::setEnabled(state.range(0) != 0);
+    auto before = FramePool::statistics();
+    for (auto const& it : state)
+    {
+        tbb::parallel_for(tbb::blocked_range<int>(0, TASK_COUNT), [](auto const& range) {
+            for (auto i = range.begin(); i != range.end(); ++i)
+            {
+                benchmark::DoNotOptimize(syncWait(nested(DEPTH)));
+            }
+        });
+    }
+    state.SetItemsProcessed(state.iterations() * TASK_COUNT * (DEPTH + 1));
+    reportStatistics(state, before);
+    FramePool::setEnabled(true);
+}
+
+static void generator(benchmark::State& state)
+{
+    FramePool::setEnabled(state.range(0) != 0);
+    auto before = FramePool::statistics();
+    for (auto const& it : state)
+    {
+        tbb::parallel_for(tbb::blocked_range<int>(0, TASK_COUNT), [](auto const& range) {
+            for (auto i = range.begin(); i != range.end(); ++i)
+            {
+                int sum = 0;
+                for (auto number : numbers(DEPTH))
+                {
+                    sum += number;
+                }
+                benchmark::DoNotOptimize(sum);
+            }
+        });
+    }
+    state.SetItemsProcessed(state.iterations() * TASK_COUNT);
+    reportStatistics(state, before);
+    FramePool::setEnabled(true);
+}
+
+BENCHMARK(nestedTask)->Arg(0)->Arg(1)->UseRealTime();
+BENCHMARK(generator)->Arg(0)->Arg(1)->UseRealTime();
@@ -29,8 +29,12 @@
 #include <bcos-framework/dispatcher/SchedulerInterface.h>
 #include <bcos-gateway/GatewayFactory.h>
 #include <bcos-task/Wait.h>
+#include <bcos-front/FrontService.h>
 #include <execinfo.h>
+#include <future>
+#include <numeric>
 #include <stdexcept>
+#include <string_view>
 #include <thread>
 
 using namespace bcos;
@@ -101,7 +105,76 @@ void createTxs(bcos::initializer::Initializer::Ptr const& init)
     }
 }
 
-void initAndStart(std::string const& _configFilePath, std::string const& _genesisFile)
+// round trips N self-addressed request/response pairs through the front service, each is two
+// hops, prints the latency of a hop
+void measureHopLatency(bcos::front::FrontServiceInterface::Ptr const& _front,
+    bcos::crypto::NodeIDPtr const& _nodeID, size_t _count)
+{
+    constexpr static int PROBE_MODULE_ID = 9999;
+    auto front = std::dynamic_pointer_cast<bcos::front::FrontService>(_front);
+    if (!front)
+    {
+        return;
+    }
+    front->registerModuleMessageDispatcher(PROBE_MODULE_ID,
+        [weakFront = std::weak_ptr<bcos::front::FrontService>(front)](
+            bcos::crypto::NodeIDPtr _nodeID, const std::string& _id, bytesConstRef _data) {
+            if (auto front = weakFront.lock())
+            {
+                front->asyncSendResponse(_id, PROBE_MODULE_ID, _nodeID, _data, nullptr);
+            }
+        });
+
+    bytes payload(256, 0);
+    std::vector<std::chrono::nanoseconds> latencies;
+    latencies.reserve(_count);
+    for (size_t i = 0; i < _count; ++i)
+    {
+        std::promise<void> done;
+        auto start = std::chrono::steady_clock::now();
+        front->asyncSendMessageByNodeID(PROBE_MODULE_ID, _nodeID, ref(payload), 1000,
+            [&done](Error::Ptr, bcos::crypto::NodeIDPtr, bytesConstRef, const std::string&,
+                std::function<void(bytesConstRef)>) { done.set_value(); });
+        done.get_future().wait();
+        latencies.emplace_back((std::chrono::steady_clock::now() - start) / 2);
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto total = std::accumulate(latencies.begin(), latencies.end(), std::chrono::nanoseconds(0));
+    std::cout << "front hop latency, count: " << _count
+              << " avg(us): " << (double)total.count() / _count / 1000
+              << " p50(us): " << (double)latencies[_count / 2].count() / 1000
+              << " p99(us): " << (double)latencies[_count * 99 / 100].count() / 1000 << std::endl;
+}
+
+// --hopLatency[=count] round trips count (10000 by default) messages before the load starts, it is
+// off by default as the round trips block the start; the flag is taken out of the arguments
+// before they are parsed by the node command line
+size_t takeHopLatencyFlag(int& argc, const char* argv[])
+{
+    constexpr static std::string_view FLAG = "--hopLatency";
+    size_t count = 0;
+    int kept = 0;
+    for (int i = 0; i < argc; ++i)
+    {
+        std::string_view arg(argv[i]);
+        if (arg == FLAG)
+        {
+            count = 10000;
+            continue;
+        }
+        if (arg.starts_with(FLAG) && arg[FLAG.size()] == '=')
+        {
+            count = std::stoul(std::string(arg.substr(FLAG.size() + 1)));
+            continue;
+        }
+        argv[kept++] = argv[i];
+    }
+    argc = kept;
+    return count;
+}
+
+void initAndStart(std::string const& _configFilePath, std::string const& _genesisFile,
+    size_t _hopLatencyCount)
 {
     boost::property_tree::ptree pt;
     boost::property_tree::read_ini(_configFilePath, pt);
@@ -151,6 +224,11 @@ void initAndStart(std::string const& _configFilePath, std::string const& _genesi
         pbftInitializer->pbft(), pbftInitializer->blockSync(), txpoolInitializer->txpool());
     nodeInitializer->start();
     gateway->start();
+    if (_hopLatencyCount > 0)
+    {
+        measureHopLatency(frontServiceInitializer->front(),
+            nodeInitializer->protocolInitializer()->keyPair()->publicKey(), _hopLatencyCount);
+    }
     createTxs(nodeInitializer);
 }
 
@@ -164,9 +242,10 @@ int main(int argc, const char* argv[])
     // Note: the initializer must exist in the lifetime of the whole program
     try
     {
+        auto hopLatencyCount = takeHopLatencyFlag(argc, argv);
         auto param = bcos::initializer::initAirNodeCommandLine(argc, argv, false);
         bcos::initializer::showNodeVersionMetric();
-        initAndStart(param.configFilePath, param.genesisFilePath);
+        initAndStart(param.configFilePath, param.genesisFilePath, hopLatencyCount);
     }
     catch (std::exception const& e)
     {
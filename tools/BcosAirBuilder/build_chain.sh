@@ -1372,6 +1372,8 @@ generate_config_ini() {
     ${disable_ssl_content}
     ; return input params in sendTransaction() return, default: true
     ; return_input_params=false
+    ; serve the metrics in prometheus text format on GET of this path, disabled by default
+    ; metrics_path=/metrics
 
 [cert]
     ; directory the certificates located in
@@ -1533,6 +1535,10 @@ generate_common_ini() {
     ; rotate the log every hour
     ;enable_rotate_by_hour=true
     enable_rate_collector=false
+    ; the modules logged in deferred format, e.g. TXPOOL,LEDGER,CONSENSUS
+    ;binary_log_modules=
+    ; text: formatted by a background thread, binary: decoded offline by binary-log-decoder
+    ;binary_log_mode=text
 EOF
 }
 
@@ -1580,6 +1586,8 @@ generate_sm_config_ini() {
     ${disable_ssl_content}
     ; return input params in sendTransaction() return, default: true
     ; return_input_params=false
+    ; serve the metrics in prometheus text format on GET of this path, disabled by default
+    ; metrics_path=/metrics
 
 [cert]
     ; directory the certificates located in
@@ -26,6 +26,7 @@
 #include "bcos-ledger/src/libledger/Ledger.h"
 #include "bcos-rpc/jsonrpc/Common.h"
 #include "bcos-rpc/jsonrpc/JsonRpcInterface.h"
+#include "bcos-storage/RocksDBStorage.h"
 #include <bcos-framework/storage/StorageInterface.h>
 #include <bcos-utilities/Error.h>
 #include <json/json.h>
@@ -163,14 +164,16 @@ public:
                     });
                 callback(nullptr, result);
             }
-            // TODO: should call compaction
-            // delete nonces of historical blocks
+            // delete nonces of historical blocks, the previous archiving ran at a current block
+            // not less than startBlock, so the nonces before startBlock - 5000 are deleted already
             auto lastBlockToDeleteNonces =
                 currentBlock > 5000 ? currentBlock - 5000 : 1;  // MAX_BLOCK_LIMIT is 5000
-            if (lastBlockToDeleteNonces != 1)
+            auto firstBlockToDeleteNonces =
+                archivedBlockNumber > 5000 ? archivedBlockNumber - 5000 : 1;
+            if (lastBlockToDeleteNonces > firstBlockToDeleteNonces)
             {
-                auto numberRange =
-                    RANGES::iota_view<uint64_t, uint64_t>(1, lastBlockToDeleteNonces);
+                auto numberRange = RANGES::iota_view<uint64_t, uint64_t>(
+                    firstBlockToDeleteNonces, lastBlockToDeleteNonces);
                 auto numberList = numberRange |
                                   RANGES::views::transform([](protocol::BlockNumber blockNumber) {
                                       return boost::lexical_cast<std::string>(blockNumber);
@@ -209,49 +212,65 @@ public:
 
     Error::Ptr deleteArchivedData(int64_t startBlock, int64_t endBlock)
     {
-        auto blockFlag = bcos::ledger::HEADER;
-        for (int64_t blockNumber = startBlock; blockNumber < endBlock; blockNumber++)
+        // the hashes of a batch of blocks are read in parallel and deleted in one write batch per
+        // table, the keys are hashes so the block range is not a key range for a range tombstone
+        constexpr static int64_t DELETE_BATCH_BLOCKS = 100;
+        for (auto batchStart = startBlock; batchStart < endBlock;
+             batchStart += DELETE_BATCH_BLOCKS)
         {
-            std::promise<Error::Ptr> promise;
-            m_ledger->asyncGetBlockTransactionHashes(
-                blockNumber, [&](Error::Ptr&& error, std::vector<std::string>&& txHashes) {
-                    if (error)
-                    {
-                        std::cerr << "get block failed: " << error->errorMessage();
-                        promise.set_value(error);
-                        return;
-                    }
-                    ARCHIVE_SERVICE_LOG(INFO)
-                        << LOG_BADGE("deleteArchivedData") << LOG_KV("number", blockNumber)
-                        << LOG_KV("size", txHashes.size());
-                    // delete block data: txs, receipts
-                    auto err = m_storage->deleteRows(ledger::SYS_HASH_2_TX, txHashes);
-                    if (err)
-                    {
-                        ARCHIVE_SERVICE_LOG(WARNING)
-                            << LOG_BADGE("delete transactions") << LOG_KV("number", blockNumber)
-                            << LOG_KV("message", err->errorMessage());
-                        promise.set_value(error);
-                        return;
-                    }
-                    err = m_storage->deleteRows(ledger::SYS_HASH_2_RECEIPT, txHashes);
-                    if (err)
-                    {
-                        ARCHIVE_SERVICE_LOG(WARNING)
-                            << LOG_BADGE("delete receipts") << LOG_KV("number", blockNumber)
-                            << LOG_KV("message", err->errorMessage());
-                        promise.set_value(error);
-                        return;
-                    }
-                    promise.set_value(nullptr);
-                });
-            auto error = promise.get_future().get();
-            if (error)
+            auto batchEnd = std::min(batchStart + DELETE_BATCH_BLOCKS, endBlock);
+            std::vector<std::promise<std::pair<Error::Ptr, std::vector<std::string>>>> promises(
+                batchEnd - batchStart);
+            for (auto blockNumber = batchStart; blockNumber < batchEnd; ++blockNumber)
             {
-                ARCHIVE_SERVICE_LOG(WARNING)
-                    << LOG_BADGE("deleteArchivedData failed") << LOG_KV("number", blockNumber)
-                    << LOG_KV("message", error->errorMessage());
-                return error;
+                m_ledger->asyncGetBlockTransactionHashes(blockNumber,
+                    [&promise = promises[blockNumber - batchStart]](
+                        Error::Ptr&& error, std::vector<std::string>&& txHashes) {
+                        promise.set_value(std::make_pair(std::move(error), std::move(txHashes)));
+                    });
+            }
+            std::vector<std::string> txHashes;
+            for (auto& promise : promises)
+            {
+                auto [error, hashes] = promise.get_future().get();
+                if (error)
+                {
+                    ARCHIVE_SERVICE_LOG(WARNING)
+                        << LOG_BADGE("deleteArchivedData get block failed")
+                        << LOG_KV("batchStart", batchStart)
+                        << LOG_KV("message", error->errorMessage());
+                    return std::move(error);
+                }
+                txHashes.insert(txHashes.end(), std::make_move_iterator(hashes.begin()),
+                    std::make_move_iterator(hashes.end()));
+            }
+            if (txHashes.empty())
+            {
+                continue;
+            }
+            // delete block data: txs, receipts
+            for (auto table : {ledger::SYS_HASH_2_TX, ledger::SYS_HASH_2_RECEIPT})
+            {
+                if (auto err = m_storage->deleteRows(table, txHashes))
+                {
+                    ARCHIVE_SERVICE_LOG(WARNING)
+                        << LOG_BADGE("deleteArchivedData delete rows failed")
+                        << LOG_KV("table", table) << LOG_KV("batchStart", batchStart)
+                        << LOG_KV("message", err->errorMessage());
+                    return err;
+                }
+            }
+            ARCHIVE_SERVICE_LOG(INFO)
+                << LOG_BADGE("deleteArchivedData") << LOG_KV("start", batchStart)
+                << LOG_KV("end", batchEnd) << LOG_KV("size", txHashes.size());
+        }
+        // the tombstones are dropped by a background compaction of the two tables, the request
+        // returns once the rows are deleted
+        if (auto rocksDBStorage = std::dynamic_pointer_cast<storage::RocksDBStorage>(m_storage))
+        {
+            for (auto table : {ledger::SYS_HASH_2_TX, ledger::SYS_HASH_2_RECEIPT})
+            {
+                rocksDBStorage->asyncCompactTable(table);
             }
         }
         return nullptr;
@@ -58,6 +58,7 @@
 #include <boost/program_options.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/throw_exception.hpp>
+#include <oneapi/tbb/parallel_pipeline.h>
 #include <cstdlib>
 #include <fstream>
 #include <functional>
@@ -163,14 +164,23 @@ TransactionalStorageInterface::Ptr createBackendStorage(
             option.writeBufferSize = nodeConfig->writeBufferSize();
             option.minWriteBufferNumberToMerge = nodeConfig->minWriteBufferNumberToMerge();
             option.blockCacheSize = nodeConfig->blockCacheSize();
+            option.enableColumnFamilies = nodeConfig->enableColumnFamilies();
+            option.headerBlockCacheSize = nodeConfig->headerBlockCacheSize();
             storage = StorageInitializer::build(
                 nodeConfig->storagePath(), option, dataEncryption, nodeConfig->keyPageSize());
         }
         else
         {
-            auto* rocksdb = createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
-            storage = std::make_shared<RocksDBStorage>(
-                std::unique_ptr<rocksdb::DB>(rocksdb), dataEncryption);
+            try
+            {
+                storage = StorageInitializer::buildSecondary(
+                    nodeConfig->storagePath(), secondaryPath, dataEncryption);
+            }
+            catch (std::exception const& e)
+            {
+                std::cout << "open rocksDB failed: " << e.what() << std::endl;
+                exit(1);
+            }
         }
     }
     else if (boost::iequals(nodeConfig->storageType(), "TiKV"))
@@ -260,11 +270,49 @@ void deleteArchivedBlocksInNode(const std::string& endpoint, int64_t startBlock,
     }
 }
 
-void archiveBlocks(auto archiveStorage, auto ledger,
+// the archive progress is kept in the archive database so an interrupted archiving resumes from it
+int64_t getArchiveProgress(const StorageInterface::Ptr& archiveStorage)
+{
+    auto [error, entry] =
+        archiveStorage->getRow(ledger::SYS_CURRENT_STATE, ledger::SYS_KEY_ARCHIVED_NUMBER);
+    if (error || !entry)
+    {
+        return 0;
+    }
+    return boost::lexical_cast<int64_t>(entry->get());
+}
+
+void setArchiveProgress(const StorageInterface::Ptr& archiveStorage, int64_t blockNumber)
+{
+    bcos::storage::Entry progress;
+    progress.importFields({std::to_string(blockNumber)});
+    std::promise<Error::UniquePtr> promise;
+    archiveStorage->asyncSetRow(ledger::SYS_CURRENT_STATE, ledger::SYS_KEY_ARCHIVED_NUMBER,
+        std::move(progress),
+        [&promise](Error::UniquePtr error) { promise.set_value(std::move(error)); });
+    if (auto error = promise.get_future().get())
+    {
+        std::cerr << "write archive progress failed: " << error->errorMessage() << endl;
+        exit(1);
+    }
+}
+
+struct ArchivedBlock
+{
+    int64_t number = 0;
+    std::vector<std::string> keys;
+    std::vector<std::string> transactionValues;
+    std::vector<std::string> receiptValues;
+};
+
+void archiveBlocks(const StorageInterface::Ptr& archiveStorage, auto ledger,
     const std::shared_ptr<bcos::tool::NodeConfig>& nodeConfig, int64_t startBlockNumber,
     int64_t endBlockNumber)
 {
-    // auto receiptFlag = bcos::ledger::RECEIPTS;
+    // blocks read and encoded concurrently, bounds the memory of the pipeline
+    constexpr static size_t MAX_BLOCKS_IN_FLIGHT = 32;
+    // blocks written to the archive database in one batch, the progress is saved after each batch
+    constexpr static size_t WRITE_BATCH_BLOCKS = 64;
     bcos::crypto::Hash::Ptr hashImpl = nullptr;
     if (nodeConfig->smCryptoType())
     {
@@ -276,59 +324,104 @@ void archiveBlocks(auto archiveStorage, auto ledger,
     }
     auto blockFlag = bcos::ledger::FULL_BLOCK;
 
-    for (int64_t i = startBlockNumber; i < endBlockNumber; ++i)
-    {
-        // getBlockByNumber
-        std::promise<bcos::protocol::Block::Ptr> promise;
-        ledger->asyncGetBlockDataByNumber(
-            i, blockFlag, [&promise](const Error::Ptr& error, bcos::protocol::Block::Ptr block) {
-                if (error)
-                {
-                    std::cerr << "get block failed: " << error->errorMessage() << endl;
-                    exit(1);
-                }
-                promise.set_value(std::move(block));
-            });
-        auto block = promise.get_future().get();
-        auto size = block->receiptsSize();
-        std::vector<std::string> keys(size, "");
-        std::vector<std::string> transactionValues(size, "");
-        std::vector<std::string> receiptValues(size, "");
-        // read the transaction and store to archive database use json format
-        tbb::parallel_for(
-            tbb::blocked_range<size_t>(0, size), [&](const tbb::blocked_range<size_t>& range) {
-                for (size_t j = range.begin(); j < range.end(); ++j)
+    std::vector<ArchivedBlock> batch;
+    auto writeBatch = [&]() {
+        if (batch.empty())
+        {
+            return;
+        }
+        std::vector<std::string> keys;
+        std::vector<std::string> transactionValues;
+        std::vector<std::string> receiptValues;
+        for (auto& archivedBlock : batch)
+        {
+            std::move(archivedBlock.keys.begin(), archivedBlock.keys.end(),
+                std::back_inserter(keys));
+            std::move(archivedBlock.transactionValues.begin(),
+                archivedBlock.transactionValues.end(), std::back_inserter(transactionValues));
+            std::move(archivedBlock.receiptValues.begin(), archivedBlock.receiptValues.end(),
+                std::back_inserter(receiptValues));
+        }
+        auto toView = RANGES::views::transform(
+            [](const std::string& str) { return std::string_view{str}; });
+        for (auto [table, values] :
+            {std::make_pair(ledger::SYS_HASH_2_TX, &transactionValues),
+                std::make_pair(ledger::SYS_HASH_2_RECEIPT, &receiptValues)})
+        {
+            if (auto error = archiveStorage->setRows(table, keys | toView, *values | toView))
+            {
+                std::cerr << "write archive database failed: " << error->errorMessage() << endl;
+                exit(1);
+            }
+        }
+        // the blocks arrive in order, everything before the next block is archived
+        auto archivedNumber = batch.back().number + 1;
+        setArchiveProgress(archiveStorage, archivedNumber);
+        std::cout << "\r"
+                  << "write block " << archivedNumber - 1 << " size: " << keys.size()
+                  << std::flush;
+        batch.clear();
+    };
+
+    auto nextBlockNumber = startBlockNumber;
+    tbb::parallel_pipeline(MAX_BLOCKS_IN_FLIGHT,
+        tbb::make_filter<void, int64_t>(tbb::filter_mode::serial_in_order,
+            [&](tbb::flow_control& control) -> int64_t {
+                if (nextBlockNumber >= endBlockNumber)
                 {
-                    Json::Value value;
-                    auto receipt = block->receipt(j);
-                    auto transaction = block->transaction(j);
-                    auto transactionHash = transaction->hash();
-                    keys[j] = std::string((char*)transactionHash.data(), transactionHash.size());
-                    // write transactions and receipts to archive database
-                    Json::Value transactionJson;
-                    bcos::rpc::toJsonResp(transactionJson, *transaction);
-                    transactionValues[j] = transactionJson.toStyledString();
-                    // read the receipt and store to archive database use json format
-                    Json::Value receiptJson;
-                    bcos::rpc::toJsonResp(receiptJson, toHex(keys[j], "0x"),
-                        protocol::TransactionStatus::None, *receipt, nodeConfig->isWasm(),
-                        *hashImpl);
-                    receiptValues[j] = receiptJson.toStyledString();
+                    control.stop();
+                    return 0;
                 }
-            });
-        archiveStorage->setRows(ledger::SYS_HASH_2_TX,
-            keys | RANGES::views::transform(
-                       [](const std::string& str) { return std::string_view{str}; }),
-            transactionValues | RANGES::views::transform(
-                                    [](const std::string& str) { return std::string_view{str}; }));
-        archiveStorage->setRows(ledger::SYS_HASH_2_RECEIPT,
-            keys | RANGES::views::transform(
-                       [](const std::string& str) { return std::string_view{str}; }),
-            receiptValues | RANGES::views::transform(
-                                [](const std::string& str) { return std::string_view{str}; }));
-        std::cout << "\r"
-                  << "write block " << i << " size: " << size << std::flush;
-    }
+                return nextBlockNumber++;
+            }) &
+            // read the blocks and encode the transactions and receipts in json concurrently
+            tbb::make_filter<int64_t, ArchivedBlock>(tbb::filter_mode::parallel,
+                [&](int64_t number) {
+                    std::promise<bcos::protocol::Block::Ptr> promise;
+                    ledger->asyncGetBlockDataByNumber(number, blockFlag,
+                        [&promise](const Error::Ptr& error, bcos::protocol::Block::Ptr block) {
+                            if (error)
+                            {
+                                std::cerr << "get block failed: " << error->errorMessage()
+                                          << endl;
+                                exit(1);
+                            }
+                            promise.set_value(std::move(block));
+                        });
+                    auto block = promise.get_future().get();
+                    auto size = block->receiptsSize();
+                    ArchivedBlock archivedBlock{.number = number,
+                        .keys = std::vector<std::string>(size),
+                        .transactionValues = std::vector<std::string>(size),
+                        .receiptValues = std::vector<std::string>(size)};
+                    for (size_t j = 0; j < size; ++j)
+                    {
+                        auto receipt = block->receipt(j);
+                        auto transaction = block->transaction(j);
+                        auto transactionHash = transaction->hash();
+                        auto& key = archivedBlock.keys[j];
+                        key = std::string((char*)transactionHash.data(), transactionHash.size());
+                        Json::Value transactionJson;
+                        bcos::rpc::toJsonResp(transactionJson, *transaction);
+                        archivedBlock.transactionValues[j] = transactionJson.toStyledString();
+                        Json::Value receiptJson;
+                        bcos::rpc::toJsonResp(receiptJson, toHex(key, "0x"),
+                            protocol::TransactionStatus::None, *receipt, nodeConfig->isWasm(),
+                            *hashImpl);
+                        archivedBlock.receiptValues[j] = receiptJson.toStyledString();
+                    }
+                    return archivedBlock;
+                }) &
+            // write the blocks in order so the saved progress never skips a block
+            tbb::make_filter<ArchivedBlock, void>(
+                tbb::filter_mode::serial_in_order, [&](ArchivedBlock archivedBlock) {
+                    batch.emplace_back(std::move(archivedBlock));
+                    if (batch.size() >= WRITE_BATCH_BLOCKS)
+                    {
+                        writeBatch();
+                    }
+                }));
+    writeBatch();
     std::cout << std::endl
               << "write to archive database, block range [" << startBlockNumber << ","
               << endBlockNumber << ")" << std::endl;
@@ -635,6 +728,14 @@ int main(int argc, const char* argv[])
     {
         nodeConfig->loadGenesisConfig(genesisFilePath);
     }
+    // the transactions and receipts are not in the state db when the segment store is enabled
+    if (nodeConfig->enableSegmentStore())
+    {
+        cerr << "the archive tool does not support storage.enable_segment_store, the transactions "
+                "and receipts are stored in "
+             << nodeConfig->segmentStorePath() << endl;
+        return 1;
+    }
 
     // create ledger to get block data
     auto localStorage =
@@ -709,7 +810,17 @@ int main(int argc, const char* argv[])
     }
     if (isArchive)
     {
-        archiveBlocks(archiveStorage, ledger, nodeConfig, startBlockNumber, endBlockNumber);
+        // resume an interrupted archiving of the same range, the node deletes the whole range
+        auto archivedNumber = getArchiveProgress(archiveStorage);
+        if (archivedNumber > startBlockNumber && archivedNumber < endBlockNumber)
+        {
+            std::cout << "resume archiving from block " << archivedNumber << std::endl;
+            archiveBlocks(archiveStorage, ledger, nodeConfig, archivedNumber, endBlockNumber);
+        }
+        else if (archivedNumber < endBlockNumber)
+        {
+            archiveBlocks(archiveStorage, ledger, nodeConfig, startBlockNumber, endBlockNumber);
+        }
         deleteArchivedBlocksInNode(endpoint, startBlockNumber, endBlockNumber);
     }
     else
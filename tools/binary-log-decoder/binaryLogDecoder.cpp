@@ -0,0 +1,79 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief decode the binary_log_*.blog files written by binary_log_mode=binary
+ * @file binaryLogDecoder.cpp
+ */
+
+#include <bcos-utilities/BinaryLog.h>
+#include <boost/program_options.hpp>
+#include <fstream>
+#include <iostream>
+
+namespace po = boost::program_options;
+
+int main(int argc, const char* argv[])
+{
+    po::options_description options("Decode the binary log files");
+    options.add_options()("help,h", "help of binary-log-decoder")("input,i",
+        po::value<std::vector<std::string>>()->multitoken(), "binary log files")(
+        "output,o", po::value<std::string>()->default_value(""), "output file, stdout if empty");
+    po::positional_options_description positional;
+    positional.add("input", -1);
+
+    po::variables_map vm;
+    try
+    {
+        po::store(
+            po::command_line_parser(argc, argv).options(options).positional(positional).run(), vm);
+        po::notify(vm);
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "invalid input: " << e.what() << std::endl;
+        return 1;
+    }
+    if (vm.count("help") || !vm.count("input"))
+    {
+        std::cout << options << std::endl;
+        return 0;
+    }
+
+    std::ofstream outputFile;
+    auto const& outputPath = vm["output"].as<std::string>();
+    if (!outputPath.empty())
+    {
+        outputFile.open(outputPath);
+        if (!outputFile)
+        {
+            std::cerr << "open " << outputPath << " failed" << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& output = outputPath.empty() ? std::cout : outputFile;
+
+    for (auto const& inputPath : vm["input"].as<std::vector<std::string>>())
+    {
+        std::ifstream input(inputPath, std::ios::binary);
+        if (!input)
+        {
+            std::cerr << "open " << inputPath << " failed" << std::endl;
+            return 1;
+        }
+        auto count = bcos::BinaryLogger::decode(input, output);
+        std::cerr << inputPath << ": " << count << " records" << std::endl;
+    }
+    return 0;
+}
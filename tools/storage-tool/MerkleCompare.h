@@ -0,0 +1,235 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief compare the tables of two rocksdb by the hashes of key prefix buckets
+ * @file MerkleCompare.h
+ */
+#pragma once
+#include <bcos-crypto/hasher/OpenSSLHasher.h>
+#include <bcos-framework/storage/Common.h>
+#include <bcos-storage/RocksDBStorage.h>
+#include <oneapi/tbb/parallel_for.h>
+#include <oneapi/tbb/parallel_invoke.h>
+#include <rocksdb/db.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace bcos::tool
+{
+/**
+ * the rows of a table are split into 256 buckets by the first byte of the key, the buckets are
+ * hashed on both sides in parallel and only the ones with different hashes are split again by the
+ * next byte; a bucket small enough is compared row by row, so the cost follows the divergent rows
+ * instead of the table size
+ */
+class MerkleComparer
+{
+public:
+    MerkleComparer(storage::RocksDBStorage& local, storage::RocksDBStorage& remote,
+        size_t maxDiffs = 100, size_t leafRows = 1024)
+      : m_local(local), m_remote(remote), m_maxDiffs(maxDiffs), m_leafRows(leafRows)
+    {}
+
+    // the keys of the table which differ, missing on one side or with different values, at most
+    // maxDiffs, the values are compared as stored so both sides must use the same encryption
+    std::vector<std::string> compare(std::string_view table)
+    {
+        m_diffs.clear();
+        m_full = false;
+        auto tablePrefix = std::string(table) + storage::TABLE_KEY_SPLIT;
+        compareChildren(table, tablePrefix);
+        std::sort(m_diffs.begin(), m_diffs.end());
+        for (auto& key : m_diffs)
+        {
+            key.erase(0, tablePrefix.size());
+        }
+        return std::move(m_diffs);
+    }
+
+private:
+    // stop splitting at this depth and compare the rows, a bucket deeper than it is a long run of
+    // keys sharing a prefix
+    constexpr static size_t MAX_DEPTH = 32;
+
+    struct BucketDigest
+    {
+        std::array<std::byte, 32> hash{};
+        size_t rows = 0;
+        bool operator==(const BucketDigest&) const = default;
+    };
+
+    // the first key after all the keys starting with the prefix, empty if there is none
+    static std::string prefixEnd(std::string prefix)
+    {
+        while (!prefix.empty() && (uint8_t)prefix.back() == 0xff)
+        {
+            prefix.pop_back();
+        }
+        if (!prefix.empty())
+        {
+            prefix.back() = (char)((uint8_t)prefix.back() + 1);
+        }
+        return prefix;
+    }
+
+    template <class Function>
+    static void forEachRow(
+        storage::RocksDBStorage& storage, std::string_view table, const std::string& prefix,
+        Function&& function)
+    {
+        auto end = prefixEnd(prefix);
+        rocksdb::Slice upperBound(end);
+        rocksdb::ReadOptions options;
+        // a one pass scan, keep the block cache for the node
+        options.fill_cache = false;
+        if (!end.empty())
+        {
+            options.iterate_upper_bound = &upperBound;
+        }
+        std::unique_ptr<rocksdb::Iterator> it(
+            storage.rocksDB().NewIterator(options, storage.columnFamily(table)));
+        for (it->Seek(prefix); it->Valid(); it->Next())
+        {
+            if (!function(it->key(), it->value()))
+            {
+                break;
+            }
+        }
+    }
+
+    static BucketDigest digest(
+        storage::RocksDBStorage& storage, std::string_view table, const std::string& prefix)
+    {
+        BucketDigest digest;
+        bcos::crypto::hasher::openssl::OpenSSL_SHA2_256_Hasher hasher;
+        hasher.update(prefix);
+        forEachRow(storage, table, prefix, [&](rocksdb::Slice key, rocksdb::Slice value) {
+            // the sizes keep the boundaries of the keys and values in the hash
+            hasher.update((uint64_t)key.size());
+            hasher.update(std::string_view(key.data(), key.size()));
+            hasher.update((uint64_t)value.size());
+            hasher.update(std::string_view(value.data(), value.size()));
+            ++digest.rows;
+            return true;
+        });
+        hasher.final(std::span<std::byte>(digest.hash));
+        return digest;
+    }
+
+    void compareChildren(std::string_view table, const std::string& prefix)
+    {
+        // the key equal to the prefix belongs to no child
+        compareRows(table, prefix, true);
+        tbb::parallel_for(0, 256, [&](int byte) {
+            if (m_full)
+            {
+                return;
+            }
+            compareBucket(table, prefix + (char)byte);
+        });
+    }
+
+    void compareBucket(std::string_view table, const std::string& prefix)
+    {
+        BucketDigest local;
+        BucketDigest remote;
+        tbb::parallel_invoke([&]() { local = digest(m_local, table, prefix); },
+            [&]() { remote = digest(m_remote, table, prefix); });
+        if (local == remote || m_full)
+        {
+            return;
+        }
+        if ((local.rows <= m_leafRows && remote.rows <= m_leafRows) ||
+            prefix.size() >= MAX_DEPTH + table.size() + 1)
+        {
+            compareRows(table, prefix, false);
+            return;
+        }
+        compareChildren(table, prefix);
+    }
+
+    // merge the sorted rows of both sides, only the key equal to the prefix if exact
+    void compareRows(std::string_view table, const std::string& prefix, bool exact)
+    {
+        auto collect = [&](storage::RocksDBStorage& storage) {
+            std::vector<std::pair<std::string, std::string>> rows;
+            forEachRow(storage, table, prefix, [&](rocksdb::Slice key, rocksdb::Slice value) {
+                if (exact && key.size() != prefix.size())
+                {
+                    return false;
+                }
+                rows.emplace_back(key.ToString(), value.ToString());
+                return !exact;
+            });
+            return rows;
+        };
+        std::vector<std::pair<std::string, std::string>> localRows;
+        std::vector<std::pair<std::string, std::string>> remoteRows;
+        tbb::parallel_invoke([&]() { localRows = collect(m_local); },
+            [&]() { remoteRows = collect(m_remote); });
+
+        auto localIt = localRows.begin();
+        auto remoteIt = remoteRows.begin();
+        while (localIt != localRows.end() || remoteIt != remoteRows.end())
+        {
+            if (remoteIt == remoteRows.end() ||
+                (localIt != localRows.end() && localIt->first < remoteIt->first))
+            {
+                addDiff(std::move(localIt->first));
+                ++localIt;
+            }
+            else if (localIt == localRows.end() || remoteIt->first < localIt->first)
+            {
+                addDiff(std::move(remoteIt->first));
+                ++remoteIt;
+            }
+            else
+            {
+                if (localIt->second != remoteIt->second)
+                {
+                    addDiff(std::move(localIt->first));
+                }
+                ++localIt;
+                ++remoteIt;
+            }
+        }
+    }
+
+    void addDiff(std::string key)
+    {
+        std::unique_lock lock(m_diffsMutex);
+        if (m_diffs.size() >= m_maxDiffs)
+        {
+            m_full = true;
+            return;
+        }
+        m_diffs.emplace_back(std::move(key));
+    }
+
+    storage::RocksDBStorage& m_local;
+    storage::RocksDBStorage& m_remote;
+    size_t m_maxDiffs;
+    size_t m_leafRows;
+    std::mutex m_diffsMutex;
+    std::vector<std::string> m_diffs;
+    std::atomic_bool m_full = false;
+};
+}  // namespace bcos::tool
@@ -19,8 +19,10 @@
  * @date 2022-07-13
  */
 
+#include "MerkleCompare.h"
 #include "bcos-framework/ledger/LedgerTypeDef.h"
 #include "bcos-framework/storage/StorageInterface.h"
+#include "bcos-ledger/src/libledger/SegmentStore.h"
 #include "bcos-ledger/src/libledger/utilities/Common.h"
 #include "bcos-tars-protocol/protocol/TransactionImpl.h"
 #include "bcos-tool/bcos-tool/BfsFileFactory.h"
@@ -45,6 +47,7 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/filesystem/operations.hpp>
+#include <boost/lexical_cast.hpp>
 #include <boost/program_options.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/throw_exception.hpp>
@@ -85,7 +88,15 @@ po::variables_map initCommandLine(int argc, const char* argv[])
         po::value<std::vector<std::string>>()->multitoken(),
         "[RocksDB] [path] [Table] or [TiKV] [pd addresses] [Table]/[ca path if use ssl] [cert path "
         "if use ssl] [Table], eg RocksDB ../node0/data s_hash_2_tx"
-        "[key path if use ssl]")("config,c",
+        "[key path if use ssl]")("merkleCompare,D",
+        po::value<std::vector<std::string>>()->multitoken(),
+        "[path] [Table], compare with the RocksDB at path by the hashes of key prefix buckets and "
+        "print the first divergent keys, eg ../node1/data or a backup")("migrateSegment,m",
+        po::value<bool>()->implicit_value(false),
+        "move the transactions and receipts into the segment store, true to delete the rows from "
+        "the state db after moving")("migrateColumnFamilies,M",
+        "move the ledger tables of the rocksdb into their column families, the node must be "
+        "stopped")("config,c",
         boost::program_options::value<std::string>()->default_value("./config.ini"),
         "config file path")("genesis,g",
         boost::program_options::value<std::string>()->default_value("./config.genesis"),
@@ -176,33 +187,30 @@ void writeKeys(std::ostream& output, const std::vector<std::string>& keys, bool
     output << (hex ? toHex(keys.back()) : keys.back()) << "]" << endl;
 }
 
-DB* createSecondaryRocksDB(
+// the column families are opened too, so the tables are read from the family they are in
+RocksDBStorage::Ptr createSecondaryRocksDB(
     const std::string& path, const std::string& secondaryPath = "./rocksdb_secondary/")
 {
-    Options options;
-    options.create_if_missing = false;
-    options.max_open_files = -1;
-    DB* db_secondary = nullptr;
-    Status status = DB::OpenAsSecondary(options, path, secondaryPath, &db_secondary);
-    if (!status.ok())
+    try
     {
-        std::cout << "open rocksDB failed: " << status.ToString() << std::endl;
-        exit(1);
+        return StorageInitializer::buildSecondary(path, secondaryPath, nullptr);
     }
-    status = db_secondary->TryCatchUpWithPrimary();
-    if (!status.ok())
+    catch (std::exception const& e)
     {
-        std::cout << "TryCatchUpWithPrimary failed: " << status.ToString() << std::endl;
+        std::cout << "open rocksDB failed: " << e.what() << std::endl;
         exit(1);
     }
-    return db_secondary;
 }
 
-void getTableSize(DB* db, const string_view& table)
+void getTableSize(RocksDBStorage& storage, const string_view& table)
 {
     std::string tableName(table);
     double size = 0;
-    rocksdb::Iterator* it = db->NewIterator(rocksdb::ReadOptions());
+    // the prefix bloom filter of the table name may skip the seek without total order
+    rocksdb::ReadOptions readOptions;
+    readOptions.total_order_seek = true;
+    rocksdb::Iterator* it =
+        storage.rocksDB().NewIterator(readOptions, storage.columnFamily(std::string_view(table)));
     it->Seek(tableName);
     while (it->Valid())
     {
@@ -260,15 +268,24 @@ TransactionalStorageInterface::Ptr createBackendStorage(
             option.writeBufferSize = nodeConfig->writeBufferSize();
             option.minWriteBufferNumberToMerge = nodeConfig->minWriteBufferNumberToMerge();
             option.blockCacheSize = nodeConfig->blockCacheSize();
+            option.enableColumnFamilies = nodeConfig->enableColumnFamilies();
+            option.headerBlockCacheSize = nodeConfig->headerBlockCacheSize();
 
             storage = StorageInitializer::build(
                 nodeConfig->storagePath(), option, dataEncryption, nodeConfig->keyPageSize());
         }
         else
         {
-            auto* rocksdb = createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
-            storage = std::make_shared<RocksDBStorage>(
-                std::unique_ptr<rocksdb::DB>(rocksdb), dataEncryption);
+            try
+            {
+                storage = StorageInitializer::buildSecondary(
+                    nodeConfig->storagePath(), secondaryPath, dataEncryption);
+            }
+            catch (std::exception const& e)
+            {
+                std::cout << "open rocksDB failed: " << e.what() << std::endl;
+                exit(1);
+            }
         }
     }
     else if (boost::iequals(nodeConfig->storageType(), "TiKV"))
@@ -670,8 +687,11 @@ int main(int argc, const char* argv[])
             if (boost::iequals(nodeConfig->storageType(), "RocksDB"))
             {
                 // rocksdb
-                auto* rocksdb = createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
-                rocksdb::Iterator* it = rocksdb->NewIterator(rocksdb::ReadOptions());
+                auto rocksdb = createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
+                rocksdb::ReadOptions readOptions;
+                readOptions.total_order_seek = true;
+                rocksdb::Iterator* it = rocksdb->rocksDB().NewIterator(
+                    readOptions, rocksdb->columnFamily(std::string_view(tableName)));
                 it->Seek(tableName);
                 while (it->Valid())
                 {
@@ -742,27 +762,27 @@ int main(int argc, const char* argv[])
         {
             if (params.count("statistic") || params.count("s"))
             {  // statistics
-                auto* db = createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
-                getTableSize(db, storage::StorageInterface::SYS_TABLES);
-                getTableSize(db, ledger::SYS_CONSENSUS);
-                getTableSize(db, ledger::SYS_CONFIG);
-                getTableSize(db, ledger::SYS_CURRENT_STATE);
-                getTableSize(db, ledger::SYS_HASH_2_NUMBER);
-                getTableSize(db, ledger::SYS_NUMBER_2_HASH);
-                getTableSize(db, ledger::SYS_BLOCK_NUMBER_2_NONCES);
-                getTableSize(db, ledger::SYS_NUMBER_2_BLOCK_HEADER);
-                getTableSize(db, ledger::SYS_NUMBER_2_TXS);
+                auto db = createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
+                getTableSize(*db, storage::StorageInterface::SYS_TABLES);
+                getTableSize(*db, ledger::SYS_CONSENSUS);
+                getTableSize(*db, ledger::SYS_CONFIG);
+                getTableSize(*db, ledger::SYS_CURRENT_STATE);
+                getTableSize(*db, ledger::SYS_HASH_2_NUMBER);
+                getTableSize(*db, ledger::SYS_NUMBER_2_HASH);
+                getTableSize(*db, ledger::SYS_BLOCK_NUMBER_2_NONCES);
+                getTableSize(*db, ledger::SYS_NUMBER_2_BLOCK_HEADER);
+                getTableSize(*db, ledger::SYS_NUMBER_2_TXS);
                 // calculate transactions data size
-                getTableSize(db, ledger::SYS_HASH_2_TX);
+                getTableSize(*db, ledger::SYS_HASH_2_TX);
                 // calculate receipts data size
-                getTableSize(db, ledger::SYS_HASH_2_RECEIPT);
-                getTableSize(db, ledger::SYS_CODE_BINARY);
-                getTableSize(db, ledger::SYS_CONTRACT_ABI);
+                getTableSize(*db, ledger::SYS_HASH_2_RECEIPT);
+                getTableSize(*db, ledger::SYS_CODE_BINARY);
+                getTableSize(*db, ledger::SYS_CONTRACT_ABI);
             }
             if (params.count("stateSize") || params.count("S"))
             {  // calculate contract data size
-                auto* db = createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
-                getTableSize(db, storage::FS_APPS);
+                auto db = createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
+                getTableSize(*db, storage::FS_APPS);
             }
         }
         else if (boost::iequals(nodeConfig->storageType(), "TiKV"))
@@ -788,9 +808,7 @@ int main(int argc, const char* argv[])
         {
             auto remoteDBPath = compareParameters[1];
             std::cout << "remoteDBPath:" << remoteDBPath << std::endl;
-            auto* rocksdb = createSecondaryRocksDB(remoteDBPath, remoteSecondaryPath);
-            remoteStorage =
-                std::make_shared<RocksDBStorage>(std::unique_ptr<rocksdb::DB>(rocksdb), nullptr);
+            remoteStorage = createSecondaryRocksDB(remoteDBPath, remoteSecondaryPath);
         }
         else if (boost::iequals(DBtype, "TiKV"))
         {
@@ -862,6 +880,197 @@ int main(int argc, const char* argv[])
         }
         std::cout << std::endl << "compare data success, all data is same" << std::endl;
     }
+    else if (params.count("merkleCompare") != 0U)
+    {
+        auto compareParameters = params["merkleCompare"].as<vector<string>>();
+        if (compareParameters.empty() || !boost::iequals(nodeConfig->storageType(), "RocksDB"))
+        {
+            cerr << "merkle compare needs the path of a RocksDB and a RocksDB node" << endl;
+            return -1;
+        }
+        auto localStorage = StorageInitializer::buildSecondary(
+            nodeConfig->storagePath(), secondaryPath, nullptr);
+        auto remoteStorage = StorageInitializer::buildSecondary(
+            compareParameters[0], "./rocksdb_secondary_remote/", nullptr);
+        std::vector<std::string> tableList;
+        if (compareParameters.size() >= 2)
+        {
+            tableList.emplace_back(compareParameters[1]);
+        }
+        else
+        {
+            tableList.emplace_back(StorageInterface::SYS_TABLES);
+            std::promise<std::vector<std::string>> localKeysPromise;
+            localStorage->asyncGetPrimaryKeys(StorageInterface::SYS_TABLES, std::nullopt,
+                [&localKeysPromise](Error::UniquePtr error, std::vector<std::string> keys) {
+                    if (error)
+                    {
+                        std::cout << "get local primary keys failed: " << error << std::endl;
+                        exit(1);
+                    }
+                    localKeysPromise.set_value(std::move(keys));
+                });
+            auto tables = localKeysPromise.get_future().get();
+            tableList.insert(tableList.end(), std::make_move_iterator(tables.begin()),
+                std::make_move_iterator(tables.end()));
+        }
+        bcos::tool::MerkleComparer comparer(*localStorage, *remoteStorage);
+        bool equal = true;
+        for (auto& tableName : tableList)
+        {
+            auto diffs = comparer.compare(tableName);
+            for (auto& key : diffs)
+            {
+                std::cout << tableName << ", value not equal, key: " << toHex(key) << std::endl;
+            }
+            if (!diffs.empty())
+            {
+                // the first divergent table is reported, the later ones are likely caused by it
+                equal = false;
+                break;
+            }
+            cout << "The data of table " << std::setw(64) << tableName << " is same\r" << flush;
+        }
+        if (fs::exists("./rocksdb_secondary_remote/"))
+        {
+            fs::remove_all("./rocksdb_secondary_remote/");
+        }
+        if (!equal)
+        {
+            std::cout << std::endl << "compare data failed" << std::endl;
+            return -1;
+        }
+        std::cout << std::endl << "compare data success, all data is same" << std::endl;
+    }
+    else if (params.count("migrateColumnFamilies") != 0U)
+    {
+        if (!boost::iequals(nodeConfig->storageType(), "RocksDB"))
+        {
+            cerr << "only RocksDB supports column families" << endl;
+            return -1;
+        }
+        RocksDBOption option;
+        option.maxWriteBufferNumber = nodeConfig->maxWriteBufferNumber();
+        option.maxBackgroundJobs = nodeConfig->maxBackgroundJobs();
+        option.writeBufferSize = nodeConfig->writeBufferSize();
+        option.minWriteBufferNumberToMerge = nodeConfig->minWriteBufferNumberToMerge();
+        option.blockCacheSize = nodeConfig->blockCacheSize();
+        option.headerBlockCacheSize = nodeConfig->headerBlockCacheSize();
+        auto moved =
+            StorageInitializer::migrateToColumnFamilies(nodeConfig->storagePath(), option);
+        std::cout << "migrate column families success, moved rows: " << moved << std::endl
+                  << "please set storage.enable_column_families=true before starting the node"
+                  << std::endl;
+    }
+    else if (params.count("migrateSegment") != 0U)
+    {
+        auto prune = params["migrateSegment"].as<bool>();
+        auto protocolInitializer = std::make_shared<ProtocolInitializer>();
+        protocolInitializer->init(nodeConfig);
+        auto blockFactory = protocolInitializer->blockFactory();
+        StorageInterface::Ptr storage =
+            createBackendStorage(nodeConfig, logInitializer->logPath(), true);
+        auto segmentStore = std::make_shared<ledger::SegmentStore>(
+            nodeConfig->segmentStorePath(), nodeConfig->segmentFileSize());
+        auto getRow = [&storage](std::string_view table, std::string_view key) {
+            std::promise<std::optional<Entry>> getPromise;
+            storage->asyncGetRow(
+                table, key, [&](Error::UniquePtr err, std::optional<Entry> entry) {
+                    if (err)
+                    {
+                        cerr << "get row failed, err:" << err->errorMessage() << endl;
+                        exit(1);
+                    }
+                    getPromise.set_value(std::move(entry));
+                });
+            return getPromise.get_future().get();
+        };
+        auto deleteRow = [&storage](std::string_view table, std::string_view key) {
+            std::promise<Error::UniquePtr> setPromise;
+            Entry deleted;
+            deleted.setStatus(Entry::Status::DELETED);
+            storage->asyncSetRow(table, key, std::move(deleted),
+                [&](Error::UniquePtr err) { setPromise.set_value(std::move(err)); });
+            if (auto err = setPromise.get_future().get())
+            {
+                cerr << "delete row failed, err:" << err->errorMessage() << endl;
+                exit(1);
+            }
+        };
+
+        auto numberEntry = getRow(ledger::SYS_CURRENT_STATE, ledger::SYS_KEY_CURRENT_NUMBER);
+        if (!numberEntry)
+        {
+            cerr << "current block number not found" << endl;
+            return -1;
+        }
+        auto currentNumber = boost::lexical_cast<protocol::BlockNumber>(numberEntry->get());
+        size_t migratedTxs = 0;
+        size_t migratedReceipts = 0;
+        for (protocol::BlockNumber number = 0; number <= currentNumber; ++number)
+        {
+            auto txsEntry = getRow(ledger::SYS_NUMBER_2_TXS, std::to_string(number));
+            if (!txsEntry)
+            {
+                continue;
+            }
+            auto value = txsEntry->get();
+            auto block = blockFactory->createBlock(
+                bcos::bytesConstRef((bcos::byte*)value.data(), value.size()), false, false);
+            for (auto [table, kind, counter] :
+                {std::tuple{ledger::SYS_HASH_2_TX, ledger::SegmentStore::TRANSACTION,
+                     &migratedTxs},
+                    std::tuple{ledger::SYS_HASH_2_RECEIPT, ledger::SegmentStore::RECEIPT,
+                        &migratedReceipts}})
+            {
+                std::vector<crypto::HashType> hashes;
+                std::vector<std::string> values;
+                for (size_t i = 0; i < block->transactionsHashSize(); ++i)
+                {
+                    auto hash = block->transactionHash(i);
+                    if (segmentStore->contains(kind, hash))
+                    {
+                        continue;
+                    }
+                    auto entry = getRow(table, hash.toRawString());
+                    if (!entry)
+                    {
+                        continue;
+                    }
+                    hashes.push_back(hash);
+                    values.emplace_back(entry->get());
+                }
+                std::vector<std::string_view> keys;
+                keys.reserve(hashes.size());
+                for (auto const& hash : hashes)
+                {
+                    keys.emplace_back((const char*)hash.data(), hash.size());
+                }
+                if (auto error = segmentStore->append(
+                        kind, keys, std::vector<std::string_view>(values.begin(), values.end())))
+                {
+                    cerr << "append segment failed, err:" << error->errorMessage() << endl;
+                    return -1;
+                }
+                // delete only after the segment append is durable
+                if (prune)
+                {
+                    for (auto key : keys)
+                    {
+                        deleteRow(table, key);
+                    }
+                }
+                *counter += keys.size();
+            }
+            if (number % 1000 == 0)
+            {
+                cout << "\rmigrate block " << number << "/" << currentNumber << std::flush;
+            }
+        }
+        cout << endl
+             << "migrate segment success, transactions: " << migratedTxs
+             << ", receipts: " << migratedReceipts << ", path: " << segmentStore->path() << endl;
+    }
     else
     {
         std::cout << "invalid parameters" << std::endl;
@@ -81,13 +81,29 @@ private:
         Executable(storage::Entry code)
           : m_code(std::make_optional(std::move(code))),
             m_vmInstance(VMFactory::create(VMKind::evmone,
-                bytesConstRef((const uint8_t*)m_code->data(), m_code->size()), mode))
+                bytesConstRef((const uint8_t*)m_code->data(), m_code->size()), mode)),
+            m_analysisBytes(VMFactory::analysisBytes(m_code->size()))
         {}
-        Executable(bytesConstRef code) : m_vmInstance(VMFactory::create(VMKind::evmone, code, mode))
+        Executable(bytesConstRef code)
+          : m_vmInstance(VMFactory::create(VMKind::evmone, code, mode)),
+            m_analysisBytes(VMFactory::analysisBytes(code.size()))
         {}
 
         std::optional<storage::Entry> m_code;
         VMInstance m_vmInstance;
+        int64_t m_analysisBytes;
+
+        friend int64_t tag_invoke(storage2::memory_storage::GetSize /*unused*/,
+            Executable const& executable) noexcept
+        {
+            auto bytes = (int64_t)sizeof(Executable) + executable.m_analysisBytes;
+            if (executable.m_code)
+            {
+                bytes += storage2::memory_storage::getSize(*executable.m_code) -
+                         (int64_t)sizeof(storage::Entry);
+            }
+            return bytes;
+        }
     };
 
     Storage& m_rollbackableStorage;
@@ -351,7 +367,7 @@ private:
     {
         static storage2::memory_storage::MemoryStorage<evmc_address, std::shared_ptr<Executable>,
             storage2::memory_storage::Attribute(
-                storage2::memory_storage::MRU | storage2::memory_storage::CONCURRENT),
+                storage2::memory_storage::CLOCK | storage2::memory_storage::CONCURRENT),
             std::hash<evmc_address>>
             cachedExecutables;
 
@@ -57,5 +57,14 @@ public:
             BOOST_THROW_EXCEPTION(UnknownVMError{});
         }
     }
+
+    // The memory held by the analysis of a code, evmone keeps a copy of the code padded for the
+    // interpreter and a bit per byte for the jump destinations
+    static int64_t analysisBytes(size_t codeSize)
+    {
+        constexpr static size_t CODE_PADDING = 33;
+        return sizeof(evmone::baseline::CodeAnalysis) + codeSize + CODE_PADDING +
+               (codeSize + 7) / 8;
+    }
 };
 }  // namespace bcos::transaction_executor
\ No newline at end of file
@@ -21,6 +21,26 @@ bcos::transaction_scheduler::getTransactions(
             [&block](uint64_t index) { return block.transactionHash(index); }));
 }
 
+std::vector<uint32_t> bcos::transaction_scheduler::getConflictKeys(protocol::Block const& block)
+{
+    // the blocks from the ledger or the sync carry no metadata
+    auto count = block.transactionsMetaDataSize();
+    if (count == 0 || (block.transactionsSize() > 0 && block.transactionsSize() != count))
+    {
+        return {};
+    }
+    auto conflictKeys = RANGES::views::iota(0LU, count) |
+                        RANGES::views::transform([&block](uint64_t index) {
+                            return block.transactionMetaData(index)->conflictKey();
+                        }) |
+                        RANGES::to<std::vector<uint32_t>>();
+    if (RANGES::all_of(conflictKeys, [](uint32_t key) { return key == 0; }))
+    {
+        return {};
+    }
+    return conflictKeys;
+}
+
 bcos::h256 bcos::transaction_scheduler::calcauteTransactionRoot(
     protocol::Block const& block, crypto::Hash const& hashImpl)
 {
@@ -51,3 +71,37 @@ std::chrono::milliseconds::rep bcos::transaction_scheduler::current()
         std::chrono::steady_clock::now().time_since_epoch())
         .count();
 }
+
+bcos::h256 bcos::transaction_scheduler::calculateCallKey(
+    int64_t stateVersion, protocol::Transaction const& transaction, crypto::Hash const& hashImpl)
+{
+    // every field the execution may read, the nonce, the block limit, the import time and the
+    // signature are left out so that repeated calls of a client still hit the cache; each field
+    // is length prefixed, so different transactions never share the same encoding
+    bcos::bytes keyData;
+    auto appendInteger = [&keyData](auto value) {
+        for (size_t i = 0; i < sizeof(value); ++i)
+        {
+            keyData.push_back(static_cast<bcos::byte>(value >> (i * 8)));
+        }
+    };
+    auto appendBytes = [&keyData, &appendInteger](auto const& bytes) {
+        appendInteger(static_cast<uint32_t>(bytes.size()));
+        keyData.insert(keyData.end(), bytes.begin(), bytes.end());
+    };
+    appendInteger(stateVersion);
+    appendInteger(transaction.version());
+    appendInteger(static_cast<uint8_t>(transaction.type()));
+    appendInteger(transaction.attribute());
+    appendBytes(transaction.to());
+    appendBytes(transaction.sender());
+    appendBytes(transaction.input());
+    appendBytes(transaction.abi());
+    appendBytes(transaction.value());
+    appendBytes(transaction.gasPrice());
+    appendInteger(transaction.gasLimit());
+    appendBytes(transaction.maxFeePerGas());
+    appendBytes(transaction.maxPriorityFeePerGas());
+    appendBytes(transaction.extension());
+    return hashImpl.hash(keyData);
+}
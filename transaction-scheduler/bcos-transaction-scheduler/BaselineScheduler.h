@@ -16,6 +16,7 @@
 #include "bcos-framework/transaction-executor/TransactionExecutor.h"
 #include "bcos-framework/transaction-scheduler/TransactionScheduler.h"
 #include "bcos-ledger/src/libledger/LedgerMethods.h"
+#include "bcos-ledger/src/libledger/utilities/ShardedCache.h"
 #include "bcos-task/TBBWait.h"
 #include "bcos-tool/VersionConverter.h"
 #include "bcos-utilities/Common.h"
@@ -27,6 +28,8 @@
 #include <bcos-framework/txpool/TxPoolInterface.h>
 #include <bcos-task/Wait.h>
 #include <bcos-utilities/ITTAPI.h>
+#include <bcos-utilities/Metrics.h>
+#include <bcos-utilities/ThreadPool.h>
 #include <fmt/format.h>
 #include <ittnotify.h>
 #include <oneapi/tbb/blocked_range.h>
@@ -37,6 +40,7 @@
 #include <oneapi/tbb/task_group.h>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/throw_exception.hpp>
+#include <atomic>
 #include <chrono>
 #include <exception>
 #include <memory>
@@ -60,6 +64,14 @@ struct NotFoundTransactionError: public bcos::Error {};
 task::Task<std::vector<protocol::Transaction::ConstPtr>> getTransactions(
     txpool::TxPoolInterface& txpool, protocol::Block& block);
 
+/**
+ * Returns the conflict keys the sealer attached to the transactions of the block.
+ *
+ * @param block The block to execute.
+ * @return One key per transaction, empty if the block carries no keys.
+ */
+std::vector<uint32_t> getConflictKeys(protocol::Block const& block);
+
 /**
  * Calculates the transaction root hash for a given block using the specified hash
  * implementation.
@@ -77,6 +89,19 @@ bcos::h256 calcauteTransactionRoot(protocol::Block const& block, crypto::Hash co
  */
 std::chrono::milliseconds::rep current();
 
+/**
+ * Calculates the key of a call result from the state version and every field of the call the
+ * execution may read: the callee, the caller, the input, the abi, the value, the gas fields, the
+ * version, the type, the attribute and the extension.
+ *
+ * @param stateVersion The version of the state the call reads.
+ * @param transaction The call.
+ * @param hashImpl The hash implementation used to calculate the key.
+ * @return The key of the call result.
+ */
+bcos::h256 calculateCallKey(
+    int64_t stateVersion, protocol::Transaction const& transaction, crypto::Hash const& hashImpl);
+
 
 /**
  * Calculates the state root of the given storage using the specified hash implementation.
@@ -101,7 +126,9 @@ task::Task<h256> calculateStateRoot(auto& storage, crypto::Hash const& hashImpl)
     {
         hashGroup.run([index = index, subrange = std::forward<decltype(subrange)>(subrange),
                           &hashes, &deletedEntry, &hashImpl]() {
-            auto& localHash = hashes[index];
+            // Same as xor of Entry::hash() over the chunk, the entries are hashed in one batch
+            bcos::bytes buffer;
+            std::vector<size_t> offsets{0};
             for (auto [key, entry] : subrange)
             {
                 transaction_executor::StateKeyView view(*key);
@@ -111,8 +138,28 @@ task::Task<h256> calculateStateRoot(auto& storage, crypto::Hash const& hashImpl)
                     entry = std::addressof(deletedEntry);
                 }
 
-                localHash ^= entry->hash(tableName, keyName, hashImpl,
-                    static_cast<uint32_t>(bcos::protocol::BlockVersion::V3_1_VERSION));
+                if (entry->appendHashInput(tableName, keyName, buffer))
+                {
+                    offsets.push_back(buffer.size());
+                }
+            }
+
+            std::vector<std::span<std::byte const>> inputs;
+            inputs.reserve(offsets.size() - 1);
+            for (size_t i = 0; i + 1 < offsets.size(); ++i)
+            {
+                inputs.emplace_back(
+                    (std::byte const*)buffer.data() + offsets[i], offsets[i + 1] - offsets[i]);
+            }
+            std::vector<h256> entryHashes(inputs.size());
+            auto hasher = hashImpl.hasher();
+            crypto::hasher::batchHash(hasher, inputs,
+                std::as_writable_bytes(std::span<h256>(entryHashes.data(), entryHashes.size())));
+
+            auto& localHash = hashes[index];
+            for (auto const& entryHash : entryHashes)
+            {
+                localHash ^= entryHash;
             }
         });
         ++index;
@@ -232,6 +279,13 @@ private:
     crypto::Hash const& m_hashImpl;
     ledger::LedgerConfig::Ptr m_ledgerConfig;
 
+    // calls run on a snapshot of the state, in their own pool and out of the execute and commit
+    // path; m_stateVersion changes whenever the state seen by a call may change, results computed
+    // on an unchanged version are reused
+    bcos::ThreadPool m_callPool;
+    std::atomic_int64_t m_stateVersion = 0;
+    ledger::ShardedCache<h256, protocol::TransactionReceipt::Ptr> m_callResults;
+
     int64_t m_lastExecutedBlockNumber = -1;
     std::mutex m_executeMutex;
     int64_t m_lastcommittedBlockNumber = -1;
@@ -318,9 +372,16 @@ private:
             }
 
             auto now = current();
-            scheduler.m_multiLayerStorage.newMutable();
+            {
+                // Stalls here while the executed blocks waiting for commit are over the limit
+                static auto& stallTime = metrics::Registry::instance().histogram(
+                    "bcos_scheduler_execute_stall_us", "time to wait for a free immutable layer");
+                metrics::ScopedTimer timer(stallTime);
+                scheduler.m_multiLayerStorage.newMutable();
+            }
             auto view = scheduler.m_multiLayerStorage.fork(true);
             auto constTransactions = co_await getTransactions(scheduler.m_txpool, *block);
+            auto conflictKeys = getConflictKeys(*block);
 
             auto ledgerConfig = scheduler.m_ledgerConfig;
             auto receipts = co_await transaction_scheduler::executeBlock(scheduler.m_schedulerImpl,
@@ -329,7 +390,7 @@ private:
                     RANGES::views::transform(
                         [](protocol::Transaction::ConstPtr const& transactionPtr)
                             -> protocol::Transaction const& { return *transactionPtr; }),
-                *ledgerConfig);
+                *ledgerConfig, std::span<uint32_t const>(conflictKeys));
 
             auto executedBlockHeader =
                 scheduler.m_blockHeaderFactory.populateBlockHeader(blockHeader);
@@ -348,7 +409,9 @@ private:
             }
 
             scheduler.m_multiLayerStorage.pushMutableToImmutableFront();
+            scheduler.updateLayerMetrics();
             scheduler.m_lastExecutedBlockNumber = blockHeader->number();
+            scheduler.updateStateVersion();
             scheduler.m_asyncGroup.run([view = std::move(view)]() {});
 
             bool sysBlock = false;
@@ -433,8 +496,9 @@ private:
             }
 
             auto now = current();
-            auto result = std::move(scheduler.m_results.back());
-            scheduler.m_results.pop_back();
+            // the result stays queued until its layer is merged, a commit that throws is retried
+            // with the same result and the same immutable layer, both writes are idempotent
+            auto result = scheduler.m_results.back();
             resultsLock.unlock();
 
             result.m_block->setBlockHeader(header);
@@ -447,15 +511,31 @@ private:
                 co_await ledger::prewriteBlock(
                     scheduler.m_ledger, result.m_transactions, result.m_block, false, *lastStorage);
             }
-            co_await scheduler.m_multiLayerStorage.mergeAndPopImmutableBack();
+            {
+                static auto& mergeTime = metrics::Registry::instance().histogram(
+                    "bcos_scheduler_commit_merge_us", "time to merge a block into the backend");
+                metrics::ScopedTimer timer(mergeTime);
+                co_await scheduler.m_multiLayerStorage.mergeAndPopImmutableBack();
+            }
+            resultsLock.lock();
+            scheduler.m_results.pop_back();
+            resultsLock.unlock();
+            scheduler.updateLayerMetrics();
             co_await ledger::storeTransactionsAndReceipts(
                 scheduler.m_ledger, result.m_transactions, result.m_block);
 
             auto ledgerConfig = co_await ledger::getLedgerConfig(scheduler.m_ledger);
             ledgerConfig->setHash(header->hash());
             scheduler.m_ledgerConfig = ledgerConfig;
-            BASELINE_SCHEDULER_LOG(INFO) << "Commit block finished: " << header->number()
-                                         << " | elapsed: " << (current() - now) << "ms";
+            // the calls read the block number from the ledger config
+            scheduler.updateStateVersion();
+            static auto& commitTime = metrics::Registry::instance().histogram(
+                "bcos_scheduler_commit_block_us", "time to commit a block");
+            commitTime.observe((current() - now) * 1000);
+            BASELINE_SCHEDULER_LOG(INFO)
+                << "Commit block finished: " << header->number()
+                << " | elapsed: " << (current() - now) << "ms"
+                << " | p99: " << commitTime.quantile(0.99) / 1000 << "ms";
             commitLock.unlock();
 
             scheduler.m_asyncGroup.run([&, result = std::move(result),
@@ -512,12 +592,79 @@ private:
         }
     }
 
+    void updateStateVersion()
+    {
+        ++m_stateVersion;
+        m_callResults.clear();
+    }
+
+    void updateLayerMetrics()
+    {
+        static auto& layers = metrics::Registry::instance().gauge(
+            "bcos_scheduler_immutable_layers", "executed blocks waiting for commit");
+        static auto& bytes = metrics::Registry::instance().gauge(
+            "bcos_scheduler_immutable_bytes", "bytes of the executed blocks waiting for commit");
+        layers.set((int64_t)m_multiLayerStorage.immutableLayers());
+        bytes.set(m_multiLayerStorage.immutableBytes());
+    }
+
+    /**
+     * Executes a call on a snapshot of the latest state, the snapshot holds the immutable layers
+     * and the backend storage, so the call neither takes the mutable view nor blocks the block
+     * execution.
+     *
+     * @param transaction The call to execute.
+     * @return A task that resolves to the receipt of the call.
+     */
+    friend task::Task<protocol::TransactionReceipt::Ptr> coCall(
+        BaselineScheduler& scheduler, protocol::Transaction const& transaction)
+    {
+        auto stateVersion = scheduler.m_stateVersion.load();
+        auto callKey = calculateCallKey(stateVersion, transaction, scheduler.m_hashImpl);
+        if (auto receipt = scheduler.m_callResults.get(callKey))
+        {
+            co_return std::move(*receipt);
+        }
+
+        auto view = scheduler.m_multiLayerStorage.fork(false);
+        view.newTemporaryMutable();
+        auto blockHeader = scheduler.m_blockHeaderFactory.createBlockHeader();
+        auto ledgerConfig = scheduler.m_ledgerConfig;
+
+        protocol::TransactionReceipt::Ptr receipt;
+        if (ledgerConfig)
+        {
+            blockHeader->setVersion(ledgerConfig->compatibilityVersion());
+            blockHeader->setNumber(ledgerConfig->blockNumber());
+            receipt = co_await transaction_executor::executeTransaction(scheduler.m_executor, view,
+                *blockHeader, transaction, 0, *ledgerConfig, task::syncWait);
+        }
+        else
+        {
+            ledger::LedgerConfig emptyLedgerConfig;
+            blockHeader->setVersion((uint32_t)bcos::protocol::BlockVersion::V3_2_4_VERSION);
+            receipt = co_await transaction_executor::executeTransaction(scheduler.m_executor, view,
+                *blockHeader, transaction, 0, emptyLedgerConfig, task::syncWait);
+        }
+
+        // a block was executed or committed during the call, the snapshot may be older than the
+        // version the call started with
+        if (receipt && scheduler.m_stateVersion.load() == stateVersion)
+        {
+            scheduler.m_callResults.insert(callKey, receipt);
+        }
+        co_return receipt;
+    }
+
 public:
+    constexpr static size_t DEFAULT_CALL_RESULT_CACHE_SIZE = 10000;
+
     BaselineScheduler(MultiLayerStorage& multiLayerStorage, SchedulerImpl& schedulerImpl,
         Executor& executor, protocol::BlockHeaderFactory& blockFactory, Ledger& ledger,
         txpool::TxPoolInterface& txPool,
         protocol::TransactionSubmitResultFactory& transactionSubmitResultFactory,
-        crypto::Hash const& hashImpl)
+        crypto::Hash const& hashImpl, size_t callThreads = std::thread::hardware_concurrency(),
+        size_t callResultCacheSize = DEFAULT_CALL_RESULT_CACHE_SIZE)
       : m_multiLayerStorage(multiLayerStorage),
         m_schedulerImpl(schedulerImpl),
         m_executor(executor),
@@ -526,13 +673,19 @@ public:
         m_txpool(txPool),
         m_transactionSubmitResultFactory(transactionSubmitResultFactory),
         m_hashImpl(hashImpl),
-        m_ledgerConfig(task::syncWait(ledger::getLedgerConfig(m_ledger)))
+        m_ledgerConfig(task::syncWait(ledger::getLedgerConfig(m_ledger))),
+        m_callPool("baselineCall", std::max<size_t>(callThreads, 1)),
+        m_callResults(callResultCacheSize)
     {}
     BaselineScheduler(const BaselineScheduler&) = delete;
     BaselineScheduler(BaselineScheduler&&) noexcept = default;
     BaselineScheduler& operator=(const BaselineScheduler&) = delete;
     BaselineScheduler& operator=(BaselineScheduler&&) noexcept = default;
-    ~BaselineScheduler() noexcept override { m_asyncGroup.wait(); }
+    ~BaselineScheduler() noexcept override
+    {
+        m_callPool.stop();
+        m_asyncGroup.wait();
+    }
 
     void executeBlock(bcos::protocol::Block::Ptr block, bool verify,
         std::function<void(bcos::Error::Ptr&&, bcos::protocol::BlockHeader::Ptr&&, bool sysBlock)>
@@ -563,32 +716,27 @@ public:
     void call(protocol::Transaction::Ptr transaction,
         std::function<void(Error::Ptr&&, protocol::TransactionReceipt::Ptr&&)> callback) override
     {
-        task::wait([](decltype(this) self, protocol::Transaction::Ptr transaction,
-                       decltype(callback) callback) -> task::Task<void> {
-            auto view = self->m_multiLayerStorage.fork(false);
-            view.newTemporaryMutable();
-            auto blockHeader = self->m_blockHeaderFactory.createBlockHeader();
-            auto ledgerConfig = self->m_ledgerConfig;
-
-            protocol::TransactionReceipt::Ptr receipt;
-            if (ledgerConfig)
-            {
-                blockHeader->setVersion(ledgerConfig->compatibilityVersion());
-                blockHeader->setNumber(ledgerConfig->blockNumber());
-                receipt = co_await transaction_executor::executeTransaction(self->m_executor, view,
-                    *blockHeader, *transaction, 0, *ledgerConfig, task::syncWait);
-            }
-            else
-            {
-                ledger::LedgerConfig emptyLedgerConfig;
-                blockHeader->setVersion((uint32_t)bcos::protocol::BlockVersion::V3_2_4_VERSION);
-                receipt = co_await transaction_executor::executeTransaction(self->m_executor, view,
-                    *blockHeader, *transaction, 0, emptyLedgerConfig, task::syncWait);
-            }
-
-
-            callback(nullptr, std::move(receipt));
-        }(this, std::move(transaction), std::move(callback)));
+        m_callPool.enqueue([this, transaction = std::move(transaction),
+                               callback = std::move(callback)]() mutable {
+            task::wait([](decltype(this) self, protocol::Transaction::Ptr transaction,
+                           decltype(callback) callback) -> task::Task<void> {
+                protocol::TransactionReceipt::Ptr receipt;
+                try
+                {
+                    receipt = co_await coCall(*self, *transaction);
+                }
+                catch (std::exception& e)
+                {
+                    auto message =
+                        fmt::format("Call failed! {}", boost::diagnostic_information(e));
+                    BASELINE_SCHEDULER_LOG(WARNING) << message;
+                    callback(
+                        BCOS_ERROR_PTR(scheduler::SchedulerError::UnknownError, message), nullptr);
+                    co_return;
+                }
+                callback(nullptr, std::move(receipt));
+            }(this, std::move(transaction), std::move(callback)));
+        });
     }
 
     void reset([[maybe_unused]] std::function<void(Error::Ptr&&)> callback) override
@@ -7,6 +7,7 @@
 #include "transaction-executor/bcos-transaction-executor/RollbackableStorage.h"
 #include <oneapi/tbb/parallel_invoke.h>
 #include <boost/throw_exception.hpp>
+#include <condition_variable>
 #include <functional>
 #include <iterator>
 #include <stdexcept>
@@ -41,6 +42,14 @@ private:
     std::mutex m_listMutex;
     std::mutex m_mergeMutex;
 
+    // 提交跟不上执行时限制不可变层的数量和字节数，0为不限制
+    // Bound the immutable layers when the commit falls behind the execution, 0 for no limit
+    size_t m_maxImmutableLayers = 0;
+    int64_t m_maxImmutableBytes = 0;
+    std::deque<int64_t> m_immutableLayerBytes;
+    int64_t m_immutableBytes = 0;
+    std::condition_variable m_immutablesPopped;
+
     BackendStorage& m_backendStorage;
     [[no_unique_address]] std::conditional_t<withCacheStorage,
         std::add_lvalue_reference_t<CachedStorage>, std::monostate>
@@ -50,6 +59,14 @@ private:
     // Only one view that can be modified is allowed at a time
     std::mutex m_mutableMutex;
 
+    bool immutableFull() const
+    {
+        // Never full without a layer, so a block larger than the byte limit still gets through
+        return !m_immutableStorages.empty() &&
+               ((m_maxImmutableLayers > 0 && m_immutableStorages.size() >= m_maxImmutableLayers) ||
+                   (m_maxImmutableBytes > 0 && m_immutableBytes >= m_maxImmutableBytes));
+    }
+
 public:
     using MutableStorage = MutableStorageType;
 
@@ -355,6 +372,26 @@ public:
         }
     }
 
+    void setImmutableLimit(size_t maxLayers, int64_t maxBytes)
+    {
+        std::unique_lock lock(m_listMutex);
+        m_maxImmutableLayers = maxLayers;
+        m_maxImmutableBytes = maxBytes;
+        m_immutablesPopped.notify_all();
+    }
+
+    size_t immutableLayers()
+    {
+        std::unique_lock lock(m_listMutex);
+        return m_immutableStorages.size();
+    }
+    int64_t immutableBytes()
+    {
+        std::unique_lock lock(m_listMutex);
+        return m_immutableBytes;
+    }
+
+    // Wait for mergeAndPopImmutableBack while the immutable layers are over the limit
     template <class... Args>
     void newMutable(Args... args)
     {
@@ -363,6 +400,7 @@ public:
         {
             BOOST_THROW_EXCEPTION(DuplicateMutableStorageError{});
         }
+        m_immutablesPopped.wait(lock, [this]() { return !immutableFull(); });
 
         m_mutableStorage = std::make_shared<MutableStorageType>(args...);
     }
@@ -373,8 +411,18 @@ public:
         {
             BOOST_THROW_EXCEPTION(NotExistsMutableStorageError{});
         }
+        int64_t bytes = 0;
+        if constexpr (requires(MutableStorageType storage) {
+                          { storage.bytes() } -> std::integral;
+                      })
+        {
+            bytes = m_mutableStorage->bytes();
+        }
+
         std::unique_lock lock(m_listMutex);
         m_immutableStorages.push_front(std::move(m_mutableStorage));
+        m_immutableLayerBytes.push_front(bytes);
+        m_immutableBytes += bytes;
         m_mutableStorage.reset();
     }
 
@@ -402,6 +450,9 @@ public:
 
         immutablesLock.lock();
         m_immutableStorages.pop_back();
+        m_immutableBytes -= m_immutableLayerBytes.back();
+        m_immutableLayerBytes.pop_back();
+        m_immutablesPopped.notify_all();
     }
 
     std::shared_ptr<MutableStorageType> frontImmutableStorage()
@@ -23,7 +23,9 @@
 #include <cstddef>
 #include <iterator>
 #include <limits>
+#include <span>
 #include <stdexcept>
+#include <unordered_set>
 
 namespace bcos::transaction_scheduler
 {
@@ -118,28 +120,66 @@ private:
         co_await storage2::merge(storage, std::forward<decltype(lastStorage)>(lastStorage));
     }
 
+    /**
+     * the end of the wave of transactions starting at offset, the wave stops before the first
+     * transaction whose conflict key is in an earlier chunk of the wave; a pass stopping there
+     * avoids executing the chunks after a predicted RAW conflict, the RAW detection still guards
+     * the result when the keys are wrong
+     */
+    static size_t waveEnd(std::span<uint32_t const> conflictKeys, size_t offset, size_t count,
+        size_t chunkSize)
+    {
+        if (conflictKeys.size() != count)
+        {
+            return count;
+        }
+        std::unordered_set<uint32_t> earlierKeys;
+        std::unordered_set<uint32_t> chunkKeys;
+        for (auto index = offset; index < count; ++index)
+        {
+            if (index > offset && (index - offset) % chunkSize == 0)
+            {
+                earlierKeys.merge(chunkKeys);
+                chunkKeys.clear();
+            }
+            auto key = conflictKeys[index];
+            if (key == 0)
+            {
+                continue;
+            }
+            if (earlierKeys.contains(key))
+            {
+                return index;
+            }
+            chunkKeys.insert(key);
+        }
+        return count;
+    }
+
     static void executeSinglePass(SchedulerParallelImpl& scheduler, auto& storage, auto& executor,
         protocol::BlockHeader const& blockHeader, RANGES::input_range auto const& transactions,
         ledger::LedgerConfig const& ledgerConfig, size_t offset,
-        std::vector<protocol::TransactionReceipt::Ptr>& receipts)
+        std::vector<protocol::TransactionReceipt::Ptr>& receipts,
+        std::span<uint32_t const> conflictKeys)
     {
         ittapi::Report report(ittapi::ITT_DOMAINS::instance().PARALLEL_SCHEDULER,
             ittapi::ITT_DOMAINS::instance().SINGLE_PASS);
 
+        auto count = RANGES::size(transactions);
+        auto chunkSize = std::max(
+            MIN_CHUNK_SIZE, RANGES::size(transactions) / (std::thread::hardware_concurrency() * 2));
+        auto passEnd = waveEnd(conflictKeys, offset, count, chunkSize);
         auto currentTransactionAndReceipts =
-            RANGES::views::iota(offset, (size_t)RANGES::size(receipts)) |
+            RANGES::views::iota(offset, passEnd) |
             RANGES::views::transform([&](auto index) {
                 return std::make_tuple(
                     index, std::addressof(transactions[index]), std::addressof(receipts[index]));
             });
 
-        auto count = RANGES::size(transactions);
         std::atomic_int64_t lastChunkIndex{std::numeric_limits<int64_t>::max()};
         int64_t chunkIndex = 0;
         ReadWriteSetStorage<decltype(storage), transaction_executor::StateKey> writeSet(storage);
 
-        auto chunkSize = std::max(
-            MIN_CHUNK_SIZE, RANGES::size(transactions) / (std::thread::hardware_concurrency() * 2));
         auto chunks = currentTransactionAndReceipts | RANGES::views::chunk(chunkSize);
         using Chunk = SchedulerParallelImpl::ChunkStatus<std::decay_t<decltype(storage)>,
             std::decay_t<decltype(executor)>, RANGES::range_value_t<decltype(chunks)>>;
@@ -208,7 +248,7 @@ private:
                                 task::tbb::syncWait(
                                     mergeLastStorage(scheduler, storage, std::move(lastStorage)));
                                 executeSinglePass(scheduler, storage, executor, blockHeader,
-                                    transactions, ledgerConfig, offset, receipts);
+                                    transactions, ledgerConfig, offset, receipts, conflictKeys);
 
                                 scheduler.m_asyncTaskGroup->run(
                                     [chunk = std::move(chunk), readWriteSet =
@@ -237,7 +277,7 @@ private:
 
                         // 成功执行到最后一个chunk，合并数据并结束
                         // Successfully executes to the last chunk, merges the data, and ends
-                        if (offset == count)
+                        if (offset == passEnd)
                         {
                             task::tbb::syncWait(
                                 mergeLastStorage(scheduler, storage, std::move(lastStorage)));
@@ -246,12 +286,20 @@ private:
                                 });
                         }
                     }));
+
+        // the wave stopped before a predicted conflict, run the next one out of the pipeline
+        if (offset == passEnd && passEnd < count)
+        {
+            executeSinglePass(scheduler, storage, executor, blockHeader, transactions, ledgerConfig,
+                offset, receipts, conflictKeys);
+        }
     }
 
     friend task::Task<std::vector<protocol::TransactionReceipt::Ptr>> tag_invoke(
         tag_t<executeBlock> /*unused*/, SchedulerParallelImpl& scheduler, auto& storage,
         auto& executor, protocol::BlockHeader const& blockHeader,
-        RANGES::input_range auto const& transactions, ledger::LedgerConfig const& ledgerConfig)
+        RANGES::input_range auto const& transactions, ledger::LedgerConfig const& ledgerConfig,
+        std::span<uint32_t const> conflictKeys = {})
     {
         ittapi::Report report(ittapi::ITT_DOMAINS::instance().PARALLEL_SCHEDULER,
             ittapi::ITT_DOMAINS::instance().PARALLEL_EXECUTE);
@@ -261,7 +309,7 @@ private:
         size_t retryCount = 0;
 
         executeSinglePass(scheduler, storage, executor, blockHeader, transactions, ledgerConfig,
-            offset, receipts);
+            offset, receipts, conflictKeys);
 
         PARALLEL_SCHEDULER_LOG(INFO)
             << "Parallel scheduler execute finished, retry counts: " << retryCount;
@@ -5,6 +5,7 @@
 #include "bcos-framework/transaction-executor/TransactionExecutor.h"
 #include "bcos-framework/transaction-scheduler/TransactionScheduler.h"
 #include "bcos-task/Wait.h"
+#include <span>
 
 namespace bcos::transaction_scheduler
 {
@@ -17,7 +18,8 @@ private:
     friend task::Task<std::vector<protocol::TransactionReceipt::Ptr>> tag_invoke(
         tag_t<executeBlock> /*unused*/, SchedulerSerialImpl& /*unused*/, auto& storage,
         auto& executor, protocol::BlockHeader const& blockHeader,
-        RANGES::input_range auto const& transactions, ledger::LedgerConfig const& ledgerConfig)
+        RANGES::input_range auto const& transactions, ledger::LedgerConfig const& ledgerConfig,
+        std::span<uint32_t const> /*conflictKeys*/ = {})
     {
         std::vector<protocol::TransactionReceipt::Ptr> receipts;
         if constexpr (RANGES::sized_range<decltype(transactions)>)
@@ -1,4 +1,5 @@
 #include "bcos-framework/protocol/Transaction.h"
+#include "bcos-framework/storage/Common.h"
 #include "bcos-framework/storage2/MemoryStorage.h"
 #include "bcos-framework/transaction-scheduler/TransactionScheduler.h"
 #include "bcos-framework/txpool/TxPoolInterface.h"
@@ -13,17 +14,24 @@
 #include "bcos-transaction-scheduler/MultiLayerStorage.h"
 #include <bcos-crypto/hash/Keccak256.h>
 #include <bcos-protocol/TransactionSubmitResultFactoryImpl.h>
+#include <bcos-storage/ColumnFamily.h>
+#include <bcos-storage/RocksDBStorage2.h>
+#include <bcos-storage/StateKVResolver.h>
 #include <bcos-transaction-scheduler/BaselineScheduler.h>
 #include <bcos-transaction-scheduler/SchedulerSerialImpl.h>
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 
 using namespace bcos;
 using namespace bcos::storage2;
 using namespace bcos::transaction_executor;
 using namespace bcos::transaction_scheduler;
+using namespace std::string_view_literals;
 
 struct MockExecutor
 {
+    std::atomic_int executedCount = 0;
+
     friend task::Task<protocol::TransactionReceipt::Ptr> tag_invoke(
         bcos::transaction_executor::tag_t<
             bcos::transaction_executor::executeTransaction> /*unused*/,
@@ -31,7 +39,9 @@ struct MockExecutor
         protocol::Transaction const& transaction, int contextID, ledger::LedgerConfig const&,
         auto&& waitOperator)
     {
-        co_return std::shared_ptr<protocol::TransactionReceipt>();
+        ++executor.executedCount;
+        co_return std::make_shared<bcostars::protocol::TransactionReceiptImpl>(
+            [inner = bcostars::TransactionReceipt()]() mutable { return std::addressof(inner); });
     }
 };
 struct MockScheduler
@@ -40,7 +50,7 @@ struct MockScheduler
         transaction_scheduler::tag_t<transaction_scheduler::executeBlock> /*unused*/,
         MockScheduler& /*unused*/, auto& storage, auto& executor,
         protocol::BlockHeader const& blockHeader, RANGES::input_range auto const& transactions,
-        ledger::LedgerConfig const&)
+        ledger::LedgerConfig const&, std::span<uint32_t const> /*conflictKeys*/)
     {
         auto receipts =
             RANGES::iota_view<size_t, size_t>(0, RANGES::size(transactions)) |
@@ -83,6 +93,38 @@ task::AwaitableValue<void> tag_invoke(ledger::tag_t<ledger::storeTransactionsAnd
     return {};
 }
 
+// writes a ledger row and a state row like prewriteBlockToStorage does
+struct ColumnFamilyLedger
+{
+};
+
+inline task::Task<void> tag_invoke(ledger::tag_t<bcos::ledger::prewriteBlock> /*unused*/,
+    ColumnFamilyLedger& /*unused*/, bcos::protocol::ConstTransactionsPtr /*unused*/,
+    bcos::protocol::Block::ConstPtr block, bool /*unused*/, auto& storage)
+{
+    auto number = std::to_string(block->blockHeaderConst()->number());
+    storage::Entry header;
+    header.set("header");
+    co_await storage2::writeOne(storage,
+        StateKey{ledger::SYS_NUMBER_2_BLOCK_HEADER, std::string_view(number)}, std::move(header));
+    storage::Entry state;
+    state.set("state");
+    co_await storage2::writeOne(storage, StateKey{"s_test"sv, "key"sv}, std::move(state));
+}
+
+inline task::AwaitableValue<ledger::LedgerConfig::Ptr> tag_invoke(
+    ledger::tag_t<bcos::ledger::getLedgerConfig> /*unused*/, ColumnFamilyLedger& /*unused*/)
+{
+    return {std::make_shared<ledger::LedgerConfig>()};
+}
+
+inline task::AwaitableValue<void> tag_invoke(ledger::tag_t<ledger::storeTransactionsAndReceipts>,
+    ColumnFamilyLedger& /*unused*/, bcos::protocol::ConstTransactionsPtr /*unused*/,
+    bcos::protocol::Block::ConstPtr /*unused*/)
+{
+    return {};
+}
+
 struct MockTxPool : public txpool::TxPoolInterface
 {
     void start() override {}
@@ -252,4 +294,133 @@ BOOST_AUTO_TEST_CASE(sameBlock)
     BOOST_CHECK(!error2);
 }
 
+BOOST_AUTO_TEST_CASE(callResultCache)
+{
+    auto call = [this](protocol::Transaction::Ptr transaction) {
+        std::promise<protocol::TransactionReceipt::Ptr> end;
+        baselineScheduler.call(std::move(transaction),
+            [&](bcos::Error::Ptr&& error, protocol::TransactionReceipt::Ptr&& receipt) {
+                BOOST_CHECK(!error);
+                end.set_value(std::move(receipt));
+            });
+        return end.get_future().get();
+    };
+
+    bcos::bytes input{1, 2, 3};
+    auto receipt = call(
+        transactionFactory->createTransaction(0, "to", input, "12345", 100, "chain", "group", 0));
+    BOOST_CHECK(receipt);
+    BOOST_CHECK_EQUAL(mockExecutor.executedCount, 1);
+
+    // the same call on the same state is served from the cache
+    auto cachedReceipt = call(
+        transactionFactory->createTransaction(0, "to", input, "54321", 100, "chain", "group", 0));
+    BOOST_CHECK_EQUAL(cachedReceipt.get(), receipt.get());
+    BOOST_CHECK_EQUAL(mockExecutor.executedCount, 1);
+
+    bcos::bytes otherInput{4, 5, 6};
+    call(transactionFactory->createTransaction(
+        0, "to", otherInput, "12345", 100, "chain", "group", 0));
+    BOOST_CHECK_EQUAL(mockExecutor.executedCount, 2);
+
+    // the value and the gas are part of the key
+    call(transactionFactory->createTransaction(
+        0, "to", input, "12345", 100, "chain", "group", 0, "", "100"));
+    BOOST_CHECK_EQUAL(mockExecutor.executedCount, 3);
+    call(transactionFactory->createTransaction(
+        0, "to", input, "12345", 100, "chain", "group", 0, "", "", "", 30000));
+    BOOST_CHECK_EQUAL(mockExecutor.executedCount, 4);
+
+    // a new executed block changes the state, the cached result is dropped
+    auto block = std::make_shared<bcostars::protocol::BlockImpl>();
+    block->blockHeader()->setNumber(500);
+    block->blockHeader()->setVersion(200);
+    block->blockHeader()->calculateHash(*hashImpl);
+    std::promise<void> executed;
+    baselineScheduler.executeBlock(block, false,
+        [&](bcos::Error::Ptr&& error, bcos::protocol::BlockHeader::Ptr&&, bool) {
+            BOOST_CHECK(!error);
+            executed.set_value();
+        });
+    executed.get_future().get();
+
+    call(transactionFactory->createTransaction(0, "to", input, "12345", 100, "chain", "group", 0));
+    BOOST_CHECK_EQUAL(mockExecutor.executedCount, 5);
+}
+
+BOOST_AUTO_TEST_CASE(commitWithColumnFamilies)
+{
+    constexpr static std::string_view path = "./baselinecfdb";
+    ::rocksdb::Options options;
+    options.create_if_missing = true;
+    options.create_missing_column_families = true;
+    std::vector<::rocksdb::ColumnFamilyDescriptor> descriptors;
+    for (auto name : storage::COLUMN_FAMILY_NAMES)
+    {
+        descriptors.emplace_back(std::string(name), ::rocksdb::ColumnFamilyOptions(options));
+    }
+    ::rocksdb::DB* db = nullptr;
+    std::vector<::rocksdb::ColumnFamilyHandle*> handles;
+    auto status = ::rocksdb::DB::Open(
+        ::rocksdb::DBOptions(options), std::string(path), descriptors, &handles, &db);
+    BOOST_REQUIRE(status.ok());
+
+    {
+        storage2::rocksdb::RocksDBStorage2<StateKey, StateValue,
+            storage2::rocksdb::StateKeyResolver, storage2::rocksdb::StateValueResolver>
+            rocksDBStorage(*db, storage2::rocksdb::StateKeyResolver{},
+                storage2::rocksdb::StateValueResolver{}, handles);
+        MultiLayerStorage<MutableStorage, void, decltype(rocksDBStorage)> storage(rocksDBStorage);
+        ColumnFamilyLedger ledger;
+        BaselineScheduler<decltype(storage), MockExecutor, MockScheduler, ColumnFamilyLedger>
+            scheduler(storage, mockScheduler, mockExecutor, *blockHeaderFactory, ledger,
+                mockTxPool, *transactionSubmitResultFactory, *hashImpl);
+        scheduler.registerBlockNumberNotifier([](protocol::BlockNumber) {});
+        scheduler.registerTransactionNotifier(
+            [](protocol::BlockNumber, protocol::TransactionSubmitResultsPtr,
+                std::function<void(Error::Ptr)> callback) { callback(nullptr); });
+
+        auto block = std::make_shared<bcostars::protocol::BlockImpl>();
+        block->blockHeader()->setNumber(1);
+        block->blockHeader()->setVersion(200);
+        block->blockHeader()->calculateHash(*hashImpl);
+        std::promise<protocol::BlockHeader::Ptr> executed;
+        scheduler.executeBlock(block, false,
+            [&](bcos::Error::Ptr&& error, bcos::protocol::BlockHeader::Ptr&& blockHeader, bool) {
+                BOOST_CHECK(!error);
+                executed.set_value(std::move(blockHeader));
+            });
+        auto executedHeader = executed.get_future().get();
+
+        std::promise<void> committed;
+        scheduler.commitBlock(
+            executedHeader, [&](bcos::Error::Ptr&& error, ledger::LedgerConfig::Ptr&&) {
+                BOOST_CHECK(!error);
+                committed.set_value();
+            });
+        committed.get_future().get();
+    }
+
+    // every row is in the column family RocksDBStorage reads its table from, and nothing of the
+    // ledger is left in the default one for the startup check to refuse
+    auto check = [&](std::string_view table, std::string_view key, storage::DataClass dataClass) {
+        auto dbKey = storage::toDBKey(table, key);
+        for (size_t i = 0; i < storage::DATA_CLASS_COUNT; ++i)
+        {
+            std::string value;
+            BOOST_CHECK_EQUAL(db->Get(::rocksdb::ReadOptions(), handles[i], dbKey, &value).ok(),
+                i == (size_t)dataClass);
+        }
+    };
+    check(ledger::SYS_NUMBER_2_BLOCK_HEADER, "1", storage::DataClass::HEADER);
+    check("s_test", "key", storage::DataClass::STATE);
+
+    for (auto* handle : handles)
+    {
+        db->DestroyColumnFamilyHandle(handle);
+    }
+    delete db;
+    boost::filesystem::remove_all(std::string(path));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
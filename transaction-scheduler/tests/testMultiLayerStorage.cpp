@@ -5,6 +5,7 @@
 #include <bcos-task/Wait.h>
 #include <fmt/format.h>
 #include <boost/test/unit_test.hpp>
+#include <future>
 #include <type_traits>
 
 using namespace bcos;
@@ -147,4 +148,50 @@ BOOST_AUTO_TEST_CASE(oneMutable)
     auto view4 = multiLayerStorage.fork(true);
 }
 
+BOOST_AUTO_TEST_CASE(immutableLimit)
+{
+    task::syncWait([this]() -> task::Task<void> {
+        multiLayerStorage.setImmutableLimit(2, 0);
+        StateKey key{"test_table"sv, "test_key"sv};
+        storage::Entry entry;
+        entry.set("Hello world!");
+
+        multiLayerStorage.newMutable();
+        co_await storage2::writeOne(multiLayerStorage.mutableStorage(), key, entry);
+        multiLayerStorage.pushMutableToImmutableFront();
+        BOOST_CHECK_EQUAL(multiLayerStorage.immutableBytes(),
+            memory_storage::getSize(key) + memory_storage::getSize(entry));
+
+        multiLayerStorage.newMutable();
+        multiLayerStorage.pushMutableToImmutableFront();
+        BOOST_CHECK_EQUAL(multiLayerStorage.immutableLayers(), 2);
+
+        // The third block waits for the commit of the first one
+        auto stalled = std::async(std::launch::async, [this]() { multiLayerStorage.newMutable(); });
+        BOOST_CHECK(stalled.wait_for(std::chrono::milliseconds(50)) == std::future_status::timeout);
+        co_await multiLayerStorage.mergeAndPopImmutableBack();
+        stalled.get();
+        BOOST_CHECK_EQUAL(multiLayerStorage.immutableLayers(), 1);
+        BOOST_CHECK_EQUAL(multiLayerStorage.immutableBytes(), 0);
+
+        // Over the byte limit with the only layer
+        multiLayerStorage.pushMutableToImmutableFront();
+        co_await multiLayerStorage.mergeAndPopImmutableBack();
+        co_await multiLayerStorage.mergeAndPopImmutableBack();
+        multiLayerStorage.setImmutableLimit(0, 1);
+        multiLayerStorage.newMutable();
+        co_await storage2::writeOne(multiLayerStorage.mutableStorage(), key, entry);
+        multiLayerStorage.pushMutableToImmutableFront();
+        auto stalledByBytes =
+            std::async(std::launch::async, [this]() { multiLayerStorage.newMutable(); });
+        BOOST_CHECK(
+            stalledByBytes.wait_for(std::chrono::milliseconds(50)) == std::future_status::timeout);
+        co_await multiLayerStorage.mergeAndPopImmutableBack();
+        stalledByBytes.get();
+        BOOST_CHECK_EQUAL(multiLayerStorage.immutableLayers(), 0);
+
+        co_return;
+    }());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
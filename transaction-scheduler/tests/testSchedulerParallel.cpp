@@ -171,4 +171,58 @@ BOOST_AUTO_TEST_CASE(conflict)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(conflictKeys)
+{
+    task::syncWait([&, this]() -> task::Task<void> {
+        MockConflictExecutor executor;
+        SchedulerParallelImpl scheduler;
+        scheduler.setMaxToken(std::thread::hardware_concurrency());
+
+        multiLayerStorage.newMutable();
+        constexpr static int INITIAL_VALUE = 100000;
+        for (auto i : RANGES::views::iota(0LU, MOCK_USER_COUNT))
+        {
+            StateKey key{"t_test"sv, boost::lexical_cast<std::string>(i)};
+            storage::Entry entry;
+            entry.set(boost::lexical_cast<std::string>(INITIAL_VALUE));
+            co_await storage2::writeOne(multiLayerStorage.mutableStorage(), key, std::move(entry));
+        }
+
+        bcostars::protocol::BlockHeaderImpl blockHeader(
+            [inner = bcostars::BlockHeader()]() mutable { return std::addressof(inner); });
+        constexpr static auto TRANSACTION_COUNT = 1000;
+        auto transactions =
+            RANGES::views::iota(0, TRANSACTION_COUNT) | RANGES::views::transform([](int index) {
+                auto transaction = std::make_unique<bcostars::protocol::TransactionImpl>(
+                    [inner = bcostars::Transaction()]() mutable { return std::addressof(inner); });
+                auto num = boost::lexical_cast<std::string>(index);
+                transaction->mutableInner().data.input.assign(num.begin(), num.end());
+
+                return transaction;
+            }) |
+            RANGES::to<std::vector<std::unique_ptr<bcostars::protocol::TransactionImpl>>>();
+        // the keys only cover a part of the real conflicts, the result must not depend on them
+        auto keys = RANGES::views::iota(0, TRANSACTION_COUNT) |
+                    RANGES::views::transform([](int index) { return (uint32_t)(index % 7); }) |
+                    RANGES::to<std::vector<uint32_t>>();
+
+        auto transactionRefs =
+            transactions | RANGES::views::transform([](auto& ptr) -> auto& { return *ptr; });
+        auto view = multiLayerStorage.fork(true);
+        ledger::LedgerConfig ledgerConfig;
+        auto receipts = co_await bcos::transaction_scheduler::executeBlock(scheduler, view,
+            executor, blockHeader, transactionRefs, ledgerConfig, std::span<uint32_t const>(keys));
+        BOOST_CHECK_EQUAL(receipts.size(), TRANSACTION_COUNT);
+
+        for (auto i : RANGES::views::iota(0LU, MOCK_USER_COUNT))
+        {
+            StateKey key{"t_test"sv, boost::lexical_cast<std::string>(i)};
+            auto entry = co_await storage2::readOne(multiLayerStorage.mutableStorage(), key);
+            BOOST_CHECK_EQUAL(boost::lexical_cast<int>(entry->get()), INITIAL_VALUE);
+        }
+
+        co_return;
+    }());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file